@@ -0,0 +1,306 @@
+/**
+ * BestResponse.cpp
+ * Implementation of the best-response search and exploitability runner
+ */
+
+#include "BestResponse.h"
+#include "Bot.h"
+#include "MoveGenerator.h"
+#include "PositionHash.h"
+#include "Simulator.h"
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+    std::uint64_t mix64(std::uint64_t value) {
+        value ^= value >> 30;
+        value *= 0xBF58476D1CE4E5B9ull;
+        value ^= value >> 27;
+        value *= 0x94D049BB133111EBull;
+        value ^= value >> 31;
+        return value;
+    }
+
+} // namespace
+
+/**
+ * Constructor
+ */
+SolvedPositionTable::SolvedPositionTable(unsigned log2Entries) {
+    size_t size = size_t{ 1 } << std::max(log2Entries, 2u);
+    entries_ = std::make_unique<std::atomic<std::uint64_t>[]>(size);
+    for (size_t i = 0; i < size; ++i) {
+        entries_[i].store(0, std::memory_order_relaxed);
+    }
+    mask_ = size - 1;
+}
+
+/**
+ * Look up a position
+ */
+bool SolvedPositionTable::lookup(std::uint64_t key, bool& win) const {
+    std::uint64_t tag = key & ~std::uint64_t{ 1 };
+    size_t bucket = static_cast<size_t>(key) & mask_ & ~(BUCKET_SIZE - 1);
+    for (size_t i = 0; i < BUCKET_SIZE; ++i) {
+        std::uint64_t entry = entries_[bucket + i].load(std::memory_order_relaxed);
+        if (entry != 0 && (entry & ~std::uint64_t{ 1 }) == tag) {
+            win = (entry & 1) != 0;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Store a solved position
+ */
+void SolvedPositionTable::store(std::uint64_t key, bool win) {
+    std::uint64_t entry = (key & ~std::uint64_t{ 1 }) | (win ? 1 : 0);
+    size_t bucket = static_cast<size_t>(key) & mask_ & ~(BUCKET_SIZE - 1);
+    for (size_t i = 0; i < BUCKET_SIZE; ++i) {
+        std::uint64_t current = entries_[bucket + i].load(std::memory_order_relaxed);
+        if (current == 0 || (current & ~std::uint64_t{ 1 }) == (entry & ~std::uint64_t{ 1 })) {
+            entries_[bucket + i].store(entry, std::memory_order_relaxed);
+            return;
+        }
+    }
+    // Bucket full: replace an entry picked by the key's top bits
+    entries_[bucket + (key >> 62)].store(entry, std::memory_order_relaxed);
+}
+
+/**
+ * Constructor
+ */
+BestResponseSolver::BestResponseSolver(SolvedPositionTable& table, std::uint64_t nodeBudget)
+    : table_(table), nodeBudget_(nodeBudget) {
+}
+
+/**
+ * Solve the current position for the responder
+ */
+BestResponseSolver::Outcome BestResponseSolver::solve(GameState& state, size_t responder) {
+    nodes_ = 0;
+    Outcome outcome = search(state, responder);
+    totalNodes_ += nodes_;
+    return outcome;
+}
+
+/**
+ * Play the bots' turns, search, then take the bots' turns back
+ */
+BestResponseSolver::Outcome BestResponseSolver::search(GameState& state, size_t responder) {
+    size_t applied = 0;
+    bool stuck = false;
+    while (state.getPhase() == GamePhase::InProgress && state.getCurrentPlayerIndex() != responder) {
+        size_t seat = state.getCurrentPlayerIndex();
+        const SeatTable& seats = state.getSeats();
+        bool mustInclude3D = state.isFirstPlayOfGame() && seats.holds(seat, Card(Rank::Three, Suit::Diamonds));
+        PlayCards play = Bot::choosePlay(seats.getCards(seat), state.getLastPlay(), mustInclude3D);
+
+        if (!play.empty() && state.applyTurn(TurnAction::Play, play) != TurnResult::Rejected) {
+            ++applied;
+        }
+        else if (state.applyTurn(TurnAction::Pass) != TurnResult::Rejected) {
+            ++applied;
+        }
+        else {
+            stuck = true;   // Leading seat without a play; cannot happen with a non-empty hand
+            break;
+        }
+    }
+
+    Outcome outcome;
+    if (stuck) {
+        outcome = Outcome::Loss;
+    }
+    else if (state.getPhase() != GamePhase::InProgress) {
+        outcome = state.getSeats().getCardCount(responder) == 0 ? Outcome::Win : Outcome::Loss;
+    }
+    else {
+        outcome = searchResponder(state, responder);
+    }
+
+    for (size_t i = 0; i < applied; ++i) {
+        state.undoTurn();
+    }
+    return outcome;
+}
+
+/**
+ * Try the responder's moves until one wins
+ */
+BestResponseSolver::Outcome BestResponseSolver::searchResponder(GameState& state, size_t responder) {
+    if (++nodes_ > nodeBudget_) {
+        return Outcome::Unresolved;
+    }
+
+    std::uint64_t key = positionKey(state, responder);
+    bool win = false;
+    if (table_.lookup(key, win)) {
+        ++tableHits_;
+        return win ? Outcome::Win : Outcome::Loss;
+    }
+
+    const SeatTable& seats = state.getSeats();
+    HandCards hand = seats.getCards(responder);
+    PlayCards lastPlay(state.getLastPlay());
+    bool mustInclude3D = state.isFirstPlayOfGame() && seats.holds(responder, Card(Rank::Three, Suit::Diamonds));
+
+    // The bot's own choice first, then plays shedding the most cards
+    auto plays = MoveGenerator::generatePlays(hand, lastPlay, mustInclude3D);
+    PlayCards preferred = Bot::choosePlay(hand, lastPlay, mustInclude3D);
+    std::stable_sort(plays.begin(), plays.end(),
+        [](const std::vector<Card>& a, const std::vector<Card>& b) { return a.size() > b.size(); });
+    auto first = std::find_if(plays.begin(), plays.end(), [&](const std::vector<Card>& play) {
+        return std::equal(play.begin(), play.end(), preferred.begin(), preferred.end());
+        });
+    if (first != plays.end()) {
+        std::rotate(plays.begin(), first, first + 1);
+    }
+
+    bool unresolved = false;
+    auto tryTurn = [&](TurnAction action, std::span<const Card> cards) {
+        if (state.applyTurn(action, cards) == TurnResult::Rejected) {
+            return Outcome::Loss;
+        }
+        Outcome outcome = search(state, responder);
+        state.undoTurn();
+        return outcome;
+    };
+
+    // Passing first when it is the bot's choice
+    bool passFirst = preferred.empty() && !lastPlay.empty();
+    if (passFirst) {
+        Outcome outcome = tryTurn(TurnAction::Pass, {});
+        if (outcome == Outcome::Win) {
+            table_.store(key, true);
+            return outcome;
+        }
+        unresolved = unresolved || outcome == Outcome::Unresolved;
+    }
+
+    for (const auto& play : plays) {
+        Outcome outcome = tryTurn(TurnAction::Play, play);
+        if (outcome == Outcome::Win) {
+            table_.store(key, true);
+            return outcome;
+        }
+        unresolved = unresolved || outcome == Outcome::Unresolved;
+    }
+
+    if (!passFirst && !lastPlay.empty()) {
+        Outcome outcome = tryTurn(TurnAction::Pass, {});
+        if (outcome == Outcome::Win) {
+            table_.store(key, true);
+            return outcome;
+        }
+        unresolved = unresolved || outcome == Outcome::Unresolved;
+    }
+
+    if (unresolved) {
+        return Outcome::Unresolved;
+    }
+    table_.store(key, false);
+    return Outcome::Loss;
+}
+
+/**
+ * Position key
+ */
+std::uint64_t BestResponseSolver::positionKey(const GameState& state, size_t responder) {
+    std::uint64_t trick = static_cast<std::uint64_t>(state.getPassedSeats())
+        | (static_cast<std::uint64_t>(state.getLastPlayingPlayer() ? state.getLastPlayingPlayer()->getSeat() : 0) << 16)
+        | (static_cast<std::uint64_t>(state.isFirstPlayOfGame()) << 24)
+        | (static_cast<std::uint64_t>(responder) << 32);
+    return PositionHash::hash(state) ^ mix64(trick + 0x9E3779B97F4A7C15ull);
+}
+
+/**
+ * Constructor
+ */
+ExploitabilityRunner::ExploitabilityRunner(const ExploitabilityConfig& config) : config_(config) {
+    if (config_.numThreads == 0) {
+        config_.numThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+}
+
+/**
+ * Solve every seat of every deal
+ */
+ExploitabilityStats ExploitabilityRunner::run(const std::function<void(std::uint64_t)>& progress) {
+    auto start = std::chrono::steady_clock::now();
+
+    SolvedPositionTable table(config_.tableLog2Entries);
+    std::atomic<std::uint64_t> nextDeal{ 0 };
+    std::atomic<std::uint64_t> dealsDone{ 0 };
+    std::mutex statsMutex;
+
+    ExploitabilityStats stats;
+    stats.seats.resize(static_cast<size_t>(config_.numPlayers));
+
+    auto worker = [&]() {
+        GameState state;
+        state.initializePlayers(config_.numPlayers, 0);
+        BestResponseSolver solver(table, config_.nodeBudget);
+        std::vector<SeatExploitability> local(stats.seats.size());
+
+        while (true) {
+            std::uint64_t deal = nextDeal.fetch_add(1, std::memory_order_relaxed);
+            if (deal >= config_.numDeals) {
+                break;
+            }
+            std::uint64_t seed = config_.seed + deal;
+            int winner = SimulationRunner::playGame(state, deal, seed).winner;
+
+            for (size_t seat = 0; seat < local.size(); ++seat) {
+                state.getDeck().seed(seed);
+                state.startNewGame();
+                BestResponseSolver::Outcome outcome = solver.solve(state, seat);
+
+                bool policyWin = winner == static_cast<int>(seat);
+                SeatExploitability& result = local[seat];
+                ++result.deals;
+                result.policyWins += policyWin;
+                if (outcome == BestResponseSolver::Outcome::Unresolved) {
+                    ++result.unresolved;
+                    result.responseWins += policyWin;
+                }
+                else {
+                    bool responseWin = outcome == BestResponseSolver::Outcome::Win;
+                    result.responseWins += responseWin;
+                    result.inconsistent += policyWin && !responseWin;
+                }
+            }
+
+            std::uint64_t done = dealsDone.fetch_add(1, std::memory_order_relaxed) + 1;
+            if (progress) {
+                progress(done);
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(statsMutex);
+        for (size_t seat = 0; seat < local.size(); ++seat) {
+            stats.seats[seat].deals += local[seat].deals;
+            stats.seats[seat].policyWins += local[seat].policyWins;
+            stats.seats[seat].responseWins += local[seat].responseWins;
+            stats.seats[seat].unresolved += local[seat].unresolved;
+            stats.seats[seat].inconsistent += local[seat].inconsistent;
+        }
+        stats.nodes += solver.getNodes();
+        stats.tableHits += solver.getTableHits();
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned i = 0; i < config_.numThreads; ++i) {
+        threads.emplace_back(worker);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return stats;
+}
@@ -0,0 +1,153 @@
+/**
+ * BestResponse.hpp
+ * Best response against the fixed bot policy, for exploitability estimates
+ *
+ * One seat (the responder) may make any legal move while every other seat
+ * plays Bot::choosePlay. The bot is deterministic, so the game tree only
+ * branches at the responder's turns and the search asks whether some line
+ * of play wins. The responder sees every hand (a clairvoyant best
+ * response), so the gap between its win rate and the bot's own win rate in
+ * that seat is an upper bound on how far the bot can be exploited on the
+ * sampled deals. Solved positions go to a lock-free table shared by every
+ * worker thread; each solve has a node budget and reports Unresolved past it.
+ */
+
+#ifndef BESTRESPONSE_H
+#define BESTRESPONSE_H
+
+#include "GameState.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+/**
+ * Solved positions shared across threads (win/loss for the responder)
+ */
+class SolvedPositionTable {
+public:
+    static constexpr size_t BUCKET_SIZE = 4;
+
+    /**
+     * Constructor - 2^log2Entries entries of 8 bytes
+     */
+    explicit SolvedPositionTable(unsigned log2Entries);
+
+    /**
+     * Look up a position
+     * @return false if it has not been solved (or was overwritten)
+     */
+    bool lookup(std::uint64_t key, bool& win) const;
+
+    /**
+     * Store a solved position, replacing an entry of its bucket when full
+     */
+    void store(std::uint64_t key, bool win);
+
+    size_t getCapacity() const { return mask_ + 1; }
+
+private:
+    std::unique_ptr<std::atomic<std::uint64_t>[]> entries_;     // Key with the low bit replaced by the result
+    size_t mask_ = 0;
+};
+
+/**
+ * BestResponseSolver class
+ */
+class BestResponseSolver {
+public:
+    enum class Outcome {
+        Loss,
+        Win,
+        Unresolved      // Node budget exhausted
+    };
+
+    BestResponseSolver(SolvedPositionTable& table, std::uint64_t nodeBudget);
+
+    /**
+     * Can the responder force a win from the current position against the bot?
+     * The state is restored before returning.
+     */
+    Outcome solve(GameState& state, size_t responder);
+
+    /**
+     * Totals over every solve of this solver
+     */
+    std::uint64_t getNodes() const { return totalNodes_; }
+    std::uint64_t getTableHits() const { return tableHits_; }
+
+private:
+    SolvedPositionTable& table_;
+    std::uint64_t nodeBudget_;
+    std::uint64_t nodes_ = 0;
+    std::uint64_t totalNodes_ = 0;
+    std::uint64_t tableHits_ = 0;
+
+    /**
+     * Let the bots move until the responder is to move or the game ends, then search
+     */
+    Outcome search(GameState& state, size_t responder);
+
+    /**
+     * Try the responder's moves (the bot's own choice first)
+     */
+    Outcome searchResponder(GameState& state, size_t responder);
+
+    /**
+     * Position key: hands, play to beat, seat to move, trick state and responder
+     */
+    static std::uint64_t positionKey(const GameState& state, size_t responder);
+};
+
+/**
+ * Exploitability run settings
+ */
+struct ExploitabilityConfig {
+    std::uint64_t numDeals = 100;
+    int numPlayers = 4;
+    unsigned numThreads = 0;            // 0 = hardware concurrency
+    std::uint64_t seed = 1;             // Deal i uses seed + i, as in SimulationRunner
+    std::uint64_t nodeBudget = 1000000; // Per deal and seat
+    unsigned tableLog2Entries = 24;     // 128 MB shared table
+};
+
+/**
+ * Results of one seat over all deals
+ */
+struct SeatExploitability {
+    std::uint64_t deals = 0;
+    std::uint64_t policyWins = 0;       // Bot in every seat
+    std::uint64_t responseWins = 0;     // Best response in this seat
+    std::uint64_t unresolved = 0;       // Budget exhausted; counted as the bot's result
+    std::uint64_t inconsistent = 0;     // Bot won but the search found no win (must stay 0)
+};
+
+/**
+ * Exploitability run results
+ */
+struct ExploitabilityStats {
+    std::vector<SeatExploitability> seats;
+    std::uint64_t nodes = 0;
+    std::uint64_t tableHits = 0;
+    double seconds = 0.0;
+};
+
+/**
+ * ExploitabilityRunner class
+ */
+class ExploitabilityRunner {
+public:
+    explicit ExploitabilityRunner(const ExploitabilityConfig& config);
+
+    /**
+     * Solve every seat of every deal across worker threads
+     * @param progress called from worker threads after each deal (may be empty)
+     */
+    ExploitabilityStats run(const std::function<void(std::uint64_t dealsDone)>& progress = {});
+
+private:
+    ExploitabilityConfig config_;
+};
+
+#endif // BESTRESPONSE_HPP
@@ -0,0 +1,148 @@
+/**
+ * Bot.cpp
+ * Implementation of the heuristic computer player
+ */
+
+#include "Bot.h"
+#include "MoveGenerator.h"
+#include "TraceRecorder.h"
+#include <algorithm>
+
+namespace {
+
+    bool hasTwo(std::span<const Card> cards) {
+        return std::any_of(cards.begin(), cards.end(), [](const Card& card) { return card.getRank() == Rank::Two; });
+    }
+
+} // namespace
+
+ /**
+  * Choose a play for the given hand
+  */
+PlayCards Bot::choosePlay(
+    std::span<const Card> hand,
+    std::span<const Card> lastPlay,
+    bool mustIncludeThreeOfDiamonds
+) {
+    return choosePlay(hand, lastPlay, mustIncludeThreeOfDiamonds, {});
+}
+
+/**
+ * Choose a play adjusted to opponent tendencies
+ */
+PlayCards Bot::choosePlay(
+    std::span<const Card> hand,
+    std::span<const Card> lastPlay,
+    bool mustIncludeThreeOfDiamonds,
+    std::span<const OpponentProfile> opponents
+) {
+    THIRTEEN_TRACE_SCOPE("Bot::choosePlay");
+    return choosePlayUntraced(hand, lastPlay, mustIncludeThreeOfDiamonds, opponents);
+}
+
+/**
+ * Choose a play adjusted to opponent tendencies, without a trace event
+ */
+PlayCards Bot::choosePlayUntraced(
+    std::span<const Card> hand,
+    std::span<const Card> lastPlay,
+    bool mustIncludeThreeOfDiamonds,
+    std::span<const OpponentProfile> opponents
+) {
+    if (hand.empty()) {
+        return {};
+    }
+    auto plays = MoveGenerator::generatePlays(hand, lastPlay, mustIncludeThreeOfDiamonds);
+    return selectPlay(hand, lastPlay, plays, opponents);
+}
+
+/**
+ * The selection every choosePlay shares
+ */
+PlayCards Bot::selectPlay(
+    std::span<const Card> hand,
+    std::span<const Card> lastPlay,
+    const std::vector<std::vector<Card>>& plays,
+    std::span<const OpponentProfile> opponents
+) {
+    if (plays.empty()) {
+        return {};
+    }
+
+    // Following: weakest play (plays are ordered weakest first), but hold 2s
+    // against opponents who answer with theirs
+    if (!lastPlay.empty()) {
+        if (opponents.empty() || hand.size() <= KEEP_TWOS_HAND_SIZE) {
+            return PlayCards(plays.front());
+        }
+        float earlyTwos = 0.0f;
+        for (const auto& profile : opponents) {
+            earlyTwos += profile.earlyTwoRate;
+        }
+        earlyTwos /= static_cast<float>(opponents.size());
+
+        if (earlyTwos < KEEP_TWOS_EARLY_RATE) {
+            return PlayCards(plays.front());
+        }
+        auto withoutTwo = std::find_if(plays.begin(), plays.end(),
+            [](const std::vector<Card>& play) { return !hasTwo(play); });
+        return withoutTwo != plays.end() ? PlayCards(*withoutTwo) : PlayCards();
+    }
+
+    // Leading: get rid of the lowest card, taking as many cards with it as
+    // possible, favoured towards play types the opponents pass on
+    Card lowest = *std::min_element(hand.begin(), hand.end());
+    const std::vector<Card>* best = nullptr;
+    float bestScore = 0.0f;
+
+    for (const auto& play : plays) {
+        if (std::find(play.begin(), play.end(), lowest) == play.end()) {
+            continue;
+        }
+        float score = static_cast<float>(play.size());
+        if (!opponents.empty()) {
+            PlayType type = GameRules::determinePlayType(play);
+            float passRate = 0.0f;
+            for (const auto& profile : opponents) {
+                passRate += profile.getPassRate(type);
+            }
+            score += LEAD_PASS_WEIGHT * passRate / static_cast<float>(opponents.size());
+        }
+        if (!best || score > bestScore) {
+            best = &play;
+            bestScore = score;
+        }
+    }
+
+    return PlayCards(best ? *best : plays.front());
+}
+
+/**
+ * Choose a play knowing the equity of the seat's dealt hand
+ */
+PlayCards Bot::choosePlay(
+    std::span<const Card> hand,
+    std::span<const Card> lastPlay,
+    bool mustIncludeThreeOfDiamonds,
+    std::span<const OpponentProfile> opponents,
+    std::optional<double> dealtEquity,
+    size_t numPlayers
+) {
+    THIRTEEN_TRACE_SCOPE("Bot::choosePlay");
+
+    if (hand.empty()) {
+        return {};
+    }
+    auto plays = MoveGenerator::generatePlays(hand, lastPlay, mustIncludeThreeOfDiamonds);
+    PlayCards play = selectPlay(hand, lastPlay, plays, opponents);
+
+    bool favoured = dealtEquity && numPlayers > 0 && *dealtEquity > 1.0 / static_cast<double>(numPlayers);
+    if (!favoured || lastPlay.empty() || hand.size() <= KEEP_TWOS_HAND_SIZE || !hasTwo(play)) {
+        return play;
+    }
+
+    // Following with a 2: take the weakest play without one, or pass
+    auto withoutTwo = std::find_if(plays.begin(), plays.end(),
+        [](const std::vector<Card>& candidate) { return !hasTwo(candidate); });
+    return withoutTwo != plays.end() ? PlayCards(*withoutTwo) : PlayCards();
+}
@@ -0,0 +1,90 @@
+/**
+ * Bot.hpp
+ * Simple heuristic computer player
+ */
+
+#ifndef BOT_H
+#define BOT_H
+
+#include "Card.h"
+#include "Hand.h"
+#include "OpponentModel.h"
+#include <optional>
+#include <span>
+#include <vector>
+
+/**
+ * Bot class
+ */
+class Bot {
+public:
+    /**
+     * Choose a play for the given hand
+     * Leading: shed the lowest card in the largest combination that contains it.
+     * Following: play the weakest play that beats the last play.
+     * @return Cards to play, or an empty vector to pass
+     */
+    static PlayCards choosePlay(
+        std::span<const Card> hand,
+        std::span<const Card> lastPlay,
+        bool mustIncludeThreeOfDiamonds
+    );
+
+    /**
+     * Choose a play adjusted to the opponents still in the trick
+     * Following: while the hand is large, keep 2s back from opponents who spend 2s early.
+     * Leading: among plays shedding the lowest card, favour play types the opponents pass on.
+     * Without profiles this is the plain choosePlay.
+     */
+    static PlayCards choosePlay(
+        std::span<const Card> hand,
+        std::span<const Card> lastPlay,
+        bool mustIncludeThreeOfDiamonds,
+        std::span<const OpponentProfile> opponents
+    );
+
+    /**
+     * choosePlay with opponents, without a trace event: for callers making
+     * thousands of choices per decision (rollout playouts), which would
+     * otherwise fill the thread's trace buffer
+     */
+    static PlayCards choosePlayUntraced(
+        std::span<const Card> hand,
+        std::span<const Card> lastPlay,
+        bool mustIncludeThreeOfDiamonds,
+        std::span<const OpponentProfile> opponents = {}
+    );
+
+    /**
+     * Choose a play knowing the win probability of the seat's dealt hand
+     * (EquityTable): while the hand is large, a seat dealt better than its
+     * fair share (1 / numPlayers) keeps 2s back when following, as it can
+     * afford to give up a trick. Without an equity this is choosePlay with opponents.
+     */
+    static PlayCards choosePlay(
+        std::span<const Card> hand,
+        std::span<const Card> lastPlay,
+        bool mustIncludeThreeOfDiamonds,
+        std::span<const OpponentProfile> opponents,
+        std::optional<double> dealtEquity,
+        size_t numPlayers
+    );
+
+    static constexpr size_t KEEP_TWOS_HAND_SIZE = 8;        // Hands above this size keep 2s back
+    static constexpr float KEEP_TWOS_EARLY_RATE = 0.5f;     // Opponents' mean early-2 rate to keep them
+    static constexpr float LEAD_PASS_WEIGHT = 4.0f;         // Lead score: cards shed + weight * pass rate
+
+private:
+    /**
+     * The selection every choosePlay shares, over the hand's generated plays
+     * (MoveGenerator order). Without profiles it is the plain heuristic.
+     */
+    static PlayCards selectPlay(
+        std::span<const Card> hand,
+        std::span<const Card> lastPlay,
+        const std::vector<std::vector<Card>>& plays,
+        std::span<const OpponentProfile> opponents
+    );
+};
+
+#endif // BOT_HPP
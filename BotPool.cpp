@@ -0,0 +1,149 @@
+/**
+ * BotPool.cpp
+ * Implementation of BotPool
+ */
+
+#include "BotPool.h"
+#include <algorithm>
+
+namespace {
+
+    /**
+     * Spin, then yield, then sleep while the queue is empty
+     */
+    class Backoff {
+    public:
+        void wait() {
+            if (rounds_ < 64) {
+                ++rounds_;
+            }
+            else if (rounds_ < 1024) {
+                ++rounds_;
+                std::this_thread::yield();
+            }
+            else {
+                std::this_thread::sleep_for(std::chrono::microseconds(50));
+            }
+        }
+
+        void reset() { rounds_ = 0; }
+
+    private:
+        unsigned rounds_ = 0;
+    };
+
+} // namespace
+
+/**
+ * Constructor - start the workers
+ */
+BotPool::BotPool(const BotPoolConfig& config, OverloadController& controller)
+    : config_(config), controller_(controller), queue_(config.queueCapacity) {
+    unsigned numThreads = config_.numThreads > 0 ? config_.numThreads : std::max(1u, std::thread::hardware_concurrency());
+    threads_.reserve(numThreads);
+    for (unsigned i = 0; i < numThreads; ++i) {
+        threads_.emplace_back(&BotPool::workerLoop, this);
+    }
+}
+
+/**
+ * Destructor
+ */
+BotPool::~BotPool() {
+    stopping_.store(true, std::memory_order_release);
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+}
+
+/**
+ * Ask for the move of the seat to move
+ */
+void BotPool::submit(const GameState& state, Clock::time_point deadline, std::uint64_t seed, Callback done) {
+    auto job = std::make_unique<Job>(Job{ state, controller_.getClock().now(), deadline, seed, std::move(done) });
+    queued_.fetch_add(1, std::memory_order_relaxed);
+    if (!queue_.tryPush(std::move(job))) {
+        queued_.fetch_sub(1, std::memory_order_relaxed);
+        inlineAnswers_.fetch_add(1, std::memory_order_relaxed);
+        answer(*job, false);    // tryPush leaves the job with us when the queue is full
+    }
+}
+
+void BotPool::workerLoop() {
+    Backoff backoff;
+    std::unique_ptr<Job> job;
+    for (;;) {
+        if (queue_.tryPop(job)) {
+            queued_.fetch_sub(1, std::memory_order_relaxed);
+            answer(*job, true);
+            job.reset();
+            backoff.reset();
+        }
+        else if (stopping_.load(std::memory_order_acquire)) {
+            if (!queue_.tryPop(job)) {
+                break;
+            }
+            queued_.fetch_sub(1, std::memory_order_relaxed);
+            answer(*job, false);
+            job.reset();
+        }
+        else {
+            backoff.wait();
+        }
+        controller_.update(getQueueDepth(), controller_.getClock().now());
+    }
+}
+
+/**
+ * Choose the move, hand it over and count the decision
+ */
+void BotPool::answer(Job& job, bool mayQueue) {
+    const GameClock& clock = controller_.getClock();
+    DegradationLevel level = controller_.getLevel();
+    Clock::time_point searchDeadline = job.deadline - config_.answerMargin;
+
+    PlayCards play;
+    if (!mayQueue || level >= DegradationLevel::Heuristic) {
+        play = RolloutSearch::heuristicPlay(job.state);
+        level = std::max(level, DegradationLevel::Heuristic);
+    }
+    else if (clock.now() >= searchDeadline) {
+        play = RolloutSearch::heuristicPlay(job.state);
+        level = DegradationLevel::Heuristic;
+        expired_.fetch_add(1, std::memory_order_relaxed);
+    }
+    else {
+        SearchResult result = RolloutSearch::choosePlay(job.state, controller_.getBudget(level), job.seed, searchDeadline, clock);
+        play = result.play;
+        if (result.heuristic) {
+            level = DegradationLevel::Heuristic;
+        }
+        else {
+            searched_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    Clock::time_point answered = clock.now();
+    auto latency = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(answered - job.submitted).count());
+    controller_.recordDecision(latency, level);
+    decisions_.fetch_add(1, std::memory_order_relaxed);
+    if (answered > job.deadline) {
+        late_.fetch_add(1, std::memory_order_relaxed);
+    }
+    std::uint64_t seen = maxLatencyNs_.load(std::memory_order_relaxed);
+    while (latency > seen && !maxLatencyNs_.compare_exchange_weak(seen, latency, std::memory_order_relaxed)) {
+    }
+
+    job.done(play, level);
+}
+
+BotPoolStats BotPool::getStats() const {
+    BotPoolStats stats;
+    stats.decisions = decisions_.load(std::memory_order_relaxed);
+    stats.searched = searched_.load(std::memory_order_relaxed);
+    stats.expired = expired_.load(std::memory_order_relaxed);
+    stats.inlineAnswers = inlineAnswers_.load(std::memory_order_relaxed);
+    stats.late = late_.load(std::memory_order_relaxed);
+    stats.maxLatencyNs = maxLatencyNs_.load(std::memory_order_relaxed);
+    return stats;
+}
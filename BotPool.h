@@ -0,0 +1,117 @@
+/**
+ * BotPool.hpp
+ * Worker threads answering bot decisions for many tables, on time
+ *
+ * Tables submit the position and a deadline; a worker takes it from a
+ * bounded lock-free queue and searches with the budget of the overload
+ * controller's current level, stopping in time to answer by the deadline.
+ * A decision that waited in the queue past the point where a search could
+ * finish gets the heuristic play at once, and a submit that finds the queue
+ * full is answered on the caller's thread with the heuristic play, so every
+ * table gets a move whatever the load. Deadlines are on the controller's
+ * clock.
+ */
+
+#ifndef BOTPOOL_H
+#define BOTPOOL_H
+
+#include "MpmcQueue.h"
+#include "OverloadController.h"
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+/**
+ * Pool settings
+ */
+struct BotPoolConfig {
+    unsigned numThreads = 0;                        // 0 = hardware concurrency
+    size_t queueCapacity = 1024;
+    std::chrono::microseconds answerMargin{ 2000 }; // Kept free before a deadline to answer heuristically
+};
+
+/**
+ * Pool counters
+ */
+struct BotPoolStats {
+    std::uint64_t decisions = 0;
+    std::uint64_t searched = 0;                     // Answered by a search that finished at least one sample
+    std::uint64_t expired = 0;                      // Waited too long to search; heuristic answer
+    std::uint64_t inlineAnswers = 0;                // Queue full; answered on the submitting thread
+    std::uint64_t late = 0;                         // Answered after the deadline
+    std::uint64_t maxLatencyNs = 0;
+};
+
+/**
+ * BotPool class
+ */
+class BotPool {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * Receives the move (empty to pass) and the level it was chosen at;
+     * runs on a worker thread, or on the submitting thread if the queue was full
+     */
+    using Callback = std::function<void(const PlayCards& play, DegradationLevel level)>;
+
+    BotPool(const BotPoolConfig& config, OverloadController& controller);
+
+    /**
+     * Destructor - answers what is still queued, then stops the workers
+     */
+    ~BotPool();
+
+    BotPool(const BotPool&) = delete;
+    BotPool& operator=(const BotPool&) = delete;
+
+    /**
+     * Ask for the move of the seat to move (the state is copied)
+     * @param seed Seeds the search's samples
+     */
+    void submit(const GameState& state, Clock::time_point deadline, std::uint64_t seed, Callback done);
+
+    /**
+     * Whether a new table may open (the controller's admission decision)
+     */
+    bool admitTable() { return controller_.admitTable(); }
+
+    size_t getQueueDepth() const { return queued_.load(std::memory_order_relaxed); }
+    unsigned getThreadCount() const { return static_cast<unsigned>(threads_.size()); }
+    BotPoolStats getStats() const;
+
+private:
+    struct Job {
+        GameState state;
+        Clock::time_point submitted;
+        Clock::time_point deadline;
+        std::uint64_t seed = 0;
+        Callback done;
+    };
+
+    BotPoolConfig config_;
+    OverloadController& controller_;
+    MpmcQueue<std::unique_ptr<Job>> queue_;
+    std::atomic<size_t> queued_{ 0 };
+    std::atomic<bool> stopping_{ false };
+    std::vector<std::thread> threads_;
+
+    std::atomic<std::uint64_t> decisions_{ 0 };
+    std::atomic<std::uint64_t> searched_{ 0 };
+    std::atomic<std::uint64_t> expired_{ 0 };
+    std::atomic<std::uint64_t> inlineAnswers_{ 0 };
+    std::atomic<std::uint64_t> late_{ 0 };
+    std::atomic<std::uint64_t> maxLatencyNs_{ 0 };
+
+    void workerLoop();
+
+    /**
+     * Choose the move, hand it over and count the decision
+     */
+    void answer(Job& job, bool mayQueue);
+};
+
+#endif // BOTPOOL_HPP
@@ -46,6 +46,24 @@ Card::Card(const std::string& cardStr) {
     suit_ = charToSuit(cardStr[suitPos]);
 }
 
+/**
+ * Dense card index: (rank - 3) * 4 + suit
+ */
+int Card::getIndex() const {
+    return (static_cast<int>(rank_) - static_cast<int>(Rank::Three)) * 4 + static_cast<int>(suit_);
+}
+
+/**
+ * Build a card from its dense index
+ */
+Card Card::fromIndex(int index) {
+    if (index < 0 || index >= 52) {
+        throw std::invalid_argument("Invalid card index: " + std::to_string(index));
+    }
+    return Card(static_cast<Rank>(index / 4 + static_cast<int>(Rank::Three)),
+        static_cast<Suit>(index % 4));
+}
+
 /**
  * Convert to string (e.g., "3H", "10S")
  */
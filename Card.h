@@ -10,8 +10,9 @@
 
 #include <string>
 #include <ostream>
+#include <cstdint>
 
-enum class Rank {
+enum class Rank : std::uint8_t {
     Three = 3,
     Four = 4,
     Five = 5,
@@ -27,7 +28,7 @@ enum class Rank {
     Two = 15  // Highest rank in Thirteen
 };
 
-enum class Suit {
+enum class Suit : std::uint8_t {
     Diamonds = 0,  // Lowest suit (Big two), Highest suit (Thirteen)
     Clubs = 1,
     Hearts = 2,
@@ -48,6 +49,12 @@ public:
     Rank getRank() const { return rank_; }
     Suit getSuit() const { return suit_; }
 
+    /**
+     * Dense card index 0..51 (rank-major, so index order matches operator<)
+     */
+    int getIndex() const;
+    static Card fromIndex(int index);
+
     /**
      * String representations
      */
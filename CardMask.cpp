@@ -0,0 +1,33 @@
+/**
+ * CardMask.cpp
+ * Conversions between card lists and card masks
+ */
+
+#include "CardMask.h"
+#include <bit>
+
+ /**
+  * Build a mask from a list of cards
+  */
+CardMask toCardMask(std::span<const Card> cards) {
+    CardMask mask = 0;
+    for (const auto& card : cards) {
+        mask |= cardBit(card);
+    }
+    return mask;
+}
+
+/**
+ * Expand a mask into cards, lowest card first
+ */
+std::vector<Card> fromCardMask(CardMask mask) {
+    std::vector<Card> cards;
+    cards.reserve(std::popcount(mask));
+
+    while (mask != 0) {
+        cards.push_back(Card::fromIndex(std::countr_zero(mask)));
+        mask &= mask - 1;
+    }
+
+    return cards;
+}
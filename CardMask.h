@@ -0,0 +1,38 @@
+/**
+ * CardMask.hpp
+ * 64-bit card set representation (bit i = card with dense index i)
+ */
+
+#ifndef CARDMASK_H
+#define CARDMASK_H
+
+#include "Card.h"
+#include <cstdint>
+#include <span>
+#include <vector>
+
+using CardMask = std::uint64_t;
+
+/**
+ * Mask with a single card set
+ */
+inline CardMask cardBit(const Card& card) {
+    return CardMask{ 1 } << card.getIndex();
+}
+
+/**
+ * Mask of all 52 cards
+ */
+constexpr CardMask FULL_DECK_MASK = (CardMask{ 1 } << 52) - 1;
+
+/**
+ * Build a mask from a list of cards
+ */
+CardMask toCardMask(std::span<const Card> cards);
+
+/**
+ * Expand a mask into cards, lowest card first
+ */
+std::vector<Card> fromCardMask(CardMask mask);
+
+#endif // CARDMASK_HPP
@@ -0,0 +1,121 @@
+/**
+ * CardSet.cpp
+ * Implementation of CardSet
+ */
+
+#include "CardSet.h"
+#include <bit>
+#include <stdexcept>
+
+/**
+ * Build from a list of cards
+ */
+CardSet::CardSet(std::span<const Card> cards) {
+    for (const auto& card : cards) {
+        add(card);
+    }
+}
+
+/**
+ * Build from a single-deck mask, plus the cards held a second time
+ */
+CardSet CardSet::fromMask(CardMask mask, CardMask copies) {
+    CardSet set;
+    set.planes_[0] = mask | copies;
+    set.planes_[1] = copies;
+    return set;
+}
+
+/**
+ * Add one copy of a card (set the bit in the first plane without it)
+ */
+void CardSet::add(const Card& card) {
+    CardMask bit = cardBit(card);
+    for (auto& plane : planes_) {
+        if (!(plane & bit)) {
+            plane |= bit;
+            return;
+        }
+    }
+    throw std::length_error("Too many copies of " + card.toString());
+}
+
+/**
+ * Remove one copy of a card (clear the bit in the last plane with it)
+ */
+bool CardSet::remove(const Card& card) {
+    CardMask bit = cardBit(card);
+    for (size_t k = MAX_COPIES; k > 0; --k) {
+        if (planes_[k - 1] & bit) {
+            planes_[k - 1] &= ~bit;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Copies of a card in the set
+ */
+int CardSet::count(const Card& card) const {
+    CardMask bit = cardBit(card);
+    int copies = 0;
+    for (CardMask plane : planes_) {
+        copies += (plane & bit) != 0;
+    }
+    return copies;
+}
+
+/**
+ * Multiset inclusion: a card held more than k times in other must be held
+ * more than k times here, for every plane k
+ */
+bool CardSet::contains(const CardSet& other) const {
+    for (size_t k = 0; k < MAX_COPIES; ++k) {
+        if (other.planes_[k] & ~planes_[k]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Total number of cards
+ */
+size_t CardSet::size() const {
+    size_t total = 0;
+    for (CardMask plane : planes_) {
+        total += static_cast<size_t>(std::popcount(plane));
+    }
+    return total;
+}
+
+/**
+ * Expand into cards, lowest card first
+ */
+std::vector<Card> CardSet::toCards() const {
+    std::vector<Card> cards;
+    cards.reserve(size());
+
+    CardMask mask = planes_[0];
+    while (mask != 0) {
+        Card card = Card::fromIndex(std::countr_zero(mask));
+        for (int copy = count(card); copy > 0; --copy) {
+            cards.push_back(card);
+        }
+        mask &= mask - 1;
+    }
+    return cards;
+}
+
+/**
+ * Hash functor for unordered containers
+ */
+size_t CardSet::Hash::operator()(const CardSet& set) const {
+    std::uint64_t h = 0;
+    for (CardMask plane : set.planes_) {
+        h = (h ^ plane) * 0x9E3779B97F4A7C15ull;
+        h ^= h >> 32;
+    }
+    return static_cast<size_t>(h);
+}
@@ -0,0 +1,90 @@
+/**
+ * CardSet.hpp
+ * Card multiset for multi-deck tables, stored as bit planes
+ *
+ * Plane k holds the cards present more than k times, so plane 0 is the
+ * ordinary CardMask and each extra deck adds one 64-bit plane. Counting,
+ * inclusion and equality work plane by plane without per-card loops.
+ */
+
+#ifndef CARDSET_H
+#define CARDSET_H
+
+#include "CardMask.h"
+#include <array>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+/**
+ * CardSet class
+ */
+class CardSet {
+public:
+    static constexpr size_t MAX_COPIES = 2;     // Decks per table (GameState deals at most two)
+
+    CardSet() = default;
+
+    /**
+     * Build from a list of cards (duplicates counted)
+     */
+    explicit CardSet(std::span<const Card> cards);
+
+    /**
+     * Build from a single-deck mask, plus the cards held a second time
+     */
+    static CardSet fromMask(CardMask mask, CardMask copies = 0);
+
+    /**
+     * Add one copy of a card
+     * @throws std::length_error if the card is already present MAX_COPIES times
+     */
+    void add(const Card& card);
+
+    /**
+     * Remove one copy of a card
+     * @return false if the card is not present
+     */
+    bool remove(const Card& card);
+
+    /**
+     * Copies of a card in the set
+     */
+    int count(const Card& card) const;
+
+    /**
+     * Check whether every card of other (with multiplicity) is in this set
+     */
+    bool contains(const CardSet& other) const;
+
+    /**
+     * Total number of cards
+     */
+    size_t size() const;
+
+    bool empty() const { return planes_[0] == 0; }
+
+    /**
+     * Cards present more than copy times (plane 0 = distinct cards)
+     */
+    CardMask plane(size_t copy) const { return planes_[copy]; }
+
+    /**
+     * Expand into cards, lowest card first
+     */
+    std::vector<Card> toCards() const;
+
+    bool operator==(const CardSet& other) const = default;
+
+    /**
+     * Hash functor for unordered containers
+     */
+    struct Hash {
+        size_t operator()(const CardSet& set) const;
+    };
+
+private:
+    std::array<CardMask, MAX_COPIES> planes_{};
+};
+
+#endif // CARDSET_HPP
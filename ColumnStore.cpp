@@ -0,0 +1,305 @@
+/**
+ * ColumnStore.cpp
+ * Implementation of the column file format
+ */
+
+#include "ColumnStore.h"
+#include <algorithm>
+#include <bit>
+
+static_assert(std::endian::native == std::endian::little,
+    "Column files are stored little-endian");
+
+namespace {
+
+    constexpr char COLUMN_MAGIC[8] = { 'T', 'H', 'C', 'O', 'L', '0', '1', '\0' };
+    constexpr std::uint32_t COLUMN_VERSION = 1;
+    constexpr std::uint64_t CHUNK_ALIGNMENT = 64;
+
+    /**
+     * Store the low valueWidth bytes of a value
+     */
+    void storeValue(std::uint8_t* dst, std::uint64_t value, std::uint32_t valueWidth) {
+        std::memcpy(dst, &value, valueWidth);
+    }
+
+    size_t roundUp(size_t value, size_t alignment) {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+} // namespace
+
+/**
+ * Encode values, picking the smallest encoding
+ */
+EncodedChunk ColumnCodec::encode(const std::vector<std::uint64_t>& values, std::uint32_t valueWidth) {
+    EncodedChunk chunk;
+    chunk.info.rowCount = static_cast<std::uint32_t>(values.size());
+
+    if (values.empty()) {
+        chunk.info.encoding = static_cast<std::uint8_t>(ColumnEncoding::Plain);
+        return chunk;
+    }
+
+    // Zone map and run count in one pass
+    std::uint64_t minValue = values[0];
+    std::uint64_t maxValue = values[0];
+    size_t runs = 1;
+    for (size_t i = 1; i < values.size(); ++i) {
+        minValue = std::min(minValue, values[i]);
+        maxValue = std::max(maxValue, values[i]);
+        if (values[i] != values[i - 1]) {
+            ++runs;
+        }
+    }
+    chunk.info.minValue = minValue;
+    chunk.info.maxValue = maxValue;
+
+    std::uint8_t bitWidth = static_cast<std::uint8_t>(std::bit_width(maxValue - minValue));
+
+    size_t plainSize = values.size() * valueWidth;
+    size_t runLengthSize = 8 + roundUp(runs * valueWidth, 4) + runs * 4;
+    size_t bitPackedSize = (values.size() * bitWidth + 63) / 64 * 8;
+
+    ColumnEncoding encoding = ColumnEncoding::Plain;
+    size_t bestSize = plainSize * 3 / 4;
+    if (runLengthSize < bestSize) {
+        encoding = ColumnEncoding::RunLength;
+        bestSize = runLengthSize;
+    }
+    if (bitPackedSize < bestSize) {
+        encoding = ColumnEncoding::BitPacked;
+    }
+
+    chunk.info.encoding = static_cast<std::uint8_t>(encoding);
+
+    switch (encoding) {
+    case ColumnEncoding::Plain:
+        chunk.bytes.resize(plainSize);
+        for (size_t i = 0; i < values.size(); ++i) {
+            storeValue(chunk.bytes.data() + i * valueWidth, values[i], valueWidth);
+        }
+        break;
+
+    case ColumnEncoding::RunLength: {
+        chunk.bytes.assign(runLengthSize, 0);
+        std::uint32_t runCount = static_cast<std::uint32_t>(runs);
+        std::memcpy(chunk.bytes.data(), &runCount, sizeof(runCount));
+
+        std::uint8_t* runValues = chunk.bytes.data() + 8;
+        std::uint8_t* runLengths = runValues + roundUp(runs * valueWidth, 4);
+
+        size_t run = 0;
+        std::uint32_t length = 1;
+        for (size_t i = 1; i <= values.size(); ++i) {
+            if (i < values.size() && values[i] == values[i - 1]) {
+                ++length;
+                continue;
+            }
+            storeValue(runValues + run * valueWidth, values[i - 1], valueWidth);
+            std::memcpy(runLengths + run * 4, &length, sizeof(length));
+            ++run;
+            length = 1;
+        }
+        break;
+    }
+
+    case ColumnEncoding::BitPacked: {
+        chunk.info.bitWidth = bitWidth;
+        std::vector<std::uint64_t> words((values.size() * bitWidth + 63) / 64, 0);
+        for (size_t i = 0; i < values.size() && bitWidth > 0; ++i) {
+            std::uint64_t delta = values[i] - minValue;
+            size_t bit = i * bitWidth;
+            words[bit / 64] |= delta << (bit % 64);
+            if (bit % 64 + bitWidth > 64) {
+                words[bit / 64 + 1] |= delta >> (64 - bit % 64);
+            }
+        }
+        chunk.bytes.resize(words.size() * 8);
+        std::memcpy(chunk.bytes.data(), words.data(), chunk.bytes.size());
+        break;
+    }
+    }
+
+    chunk.info.byteSize = chunk.bytes.size();
+    return chunk;
+}
+
+/**
+ * Decode a chunk
+ */
+void ColumnCodec::decode(const ColumnChunkInfo& info, const std::uint8_t* data,
+    std::uint32_t valueWidth, void* out) {
+    std::uint8_t* dst = static_cast<std::uint8_t*>(out);
+
+    switch (static_cast<ColumnEncoding>(info.encoding)) {
+    case ColumnEncoding::Plain:
+        std::memcpy(dst, data, static_cast<size_t>(info.rowCount) * valueWidth);
+        break;
+
+    case ColumnEncoding::RunLength: {
+        std::uint32_t runCount = 0;
+        std::memcpy(&runCount, data, sizeof(runCount));
+        const std::uint8_t* runValues = data + 8;
+        const std::uint8_t* runLengths = runValues + roundUp(static_cast<size_t>(runCount) * valueWidth, 4);
+
+        size_t row = 0;
+        for (std::uint32_t run = 0; run < runCount; ++run) {
+            std::uint32_t length = 0;
+            std::memcpy(&length, runLengths + run * 4, sizeof(length));
+            const std::uint8_t* value = runValues + static_cast<size_t>(run) * valueWidth;
+            for (std::uint32_t i = 0; i < length && row < info.rowCount; ++i, ++row) {
+                std::memcpy(dst + row * valueWidth, value, valueWidth);
+            }
+        }
+        break;
+    }
+
+    case ColumnEncoding::BitPacked: {
+        const std::uint32_t bitWidth = info.bitWidth;
+        const std::uint64_t mask = bitWidth >= 64 ? ~std::uint64_t{ 0 } : (std::uint64_t{ 1 } << bitWidth) - 1;
+
+        for (size_t i = 0; i < info.rowCount; ++i) {
+            std::uint64_t delta = 0;
+            if (bitWidth > 0) {
+                size_t bit = i * bitWidth;
+                std::uint64_t lo = 0;
+                std::memcpy(&lo, data + bit / 64 * 8, 8);
+                delta = lo >> (bit % 64);
+                if (bit % 64 + bitWidth > 64) {
+                    std::uint64_t hi = 0;
+                    std::memcpy(&hi, data + (bit / 64 + 1) * 8, 8);
+                    delta |= hi << (64 - bit % 64);
+                }
+                delta &= mask;
+            }
+            storeValue(dst + i * valueWidth, info.minValue + delta, valueWidth);
+        }
+        break;
+    }
+
+    default:
+        throw std::runtime_error("Unknown column encoding");
+    }
+}
+
+/**
+ * Create a column file
+ */
+ColumnWriter::ColumnWriter(const std::string& path, std::uint32_t valueWidth)
+    : out_(path, std::ios::binary | std::ios::trunc),
+    path_(path),
+    valueWidth_(valueWidth) {
+    if (!out_) {
+        throw std::runtime_error("Cannot create column file: " + path);
+    }
+    if (valueWidth != 1 && valueWidth != 2 && valueWidth != 4 && valueWidth != 8) {
+        throw std::invalid_argument("Column width must be 1, 2, 4 or 8 bytes");
+    }
+
+    // Placeholder header, rewritten by close()
+    ColumnFileHeader header{};
+    out_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    position_ = sizeof(header);
+}
+
+ColumnWriter::~ColumnWriter() {
+    try {
+        close();
+    }
+    catch (const std::exception&) {
+        // Destructors must not throw
+    }
+}
+
+/**
+ * Append an encoded chunk
+ */
+void ColumnWriter::writeChunk(const EncodedChunk& chunk) {
+    padTo(CHUNK_ALIGNMENT);
+
+    ColumnChunkInfo info = chunk.info;
+    info.offset = position_;
+    info.byteSize = chunk.bytes.size();
+    directory_.push_back(info);
+
+    out_.write(reinterpret_cast<const char*>(chunk.bytes.data()),
+        static_cast<std::streamsize>(chunk.bytes.size()));
+    position_ += chunk.bytes.size();
+    rowCount_ += info.rowCount;
+
+    if (!out_) {
+        throw std::runtime_error("Write failed: " + path_);
+    }
+}
+
+/**
+ * Write the chunk directory and final header
+ */
+void ColumnWriter::close() {
+    if (closed_) {
+        return;
+    }
+    closed_ = true;
+
+    padTo(8);
+    std::uint64_t directoryOffset = position_;
+    out_.write(reinterpret_cast<const char*>(directory_.data()),
+        static_cast<std::streamsize>(directory_.size() * sizeof(ColumnChunkInfo)));
+
+    ColumnFileHeader header{};
+    std::memcpy(header.magic, COLUMN_MAGIC, sizeof(header.magic));
+    header.version = COLUMN_VERSION;
+    header.valueWidth = valueWidth_;
+    header.rowCount = rowCount_;
+    header.chunkCount = directory_.size();
+    header.directoryOffset = directoryOffset;
+
+    out_.seekp(0);
+    out_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out_.close();
+
+    if (!out_) {
+        throw std::runtime_error("Write failed: " + path_);
+    }
+}
+
+/**
+ * Pad the file with zeros up to an alignment boundary
+ */
+void ColumnWriter::padTo(std::uint64_t alignment) {
+    static const char zeros[CHUNK_ALIGNMENT] = {};
+    std::uint64_t padding = roundUp(position_, alignment) - position_;
+    out_.write(zeros, static_cast<std::streamsize>(padding));
+    position_ += padding;
+}
+
+/**
+ * Map and validate a column file
+ */
+ColumnReader::ColumnReader(const std::string& path) : file_(path) {
+    if (file_.size() < sizeof(ColumnFileHeader)) {
+        throw std::runtime_error("Column file too small: " + path);
+    }
+
+    std::memcpy(&header_, file_.data(), sizeof(header_));
+    if (std::memcmp(header_.magic, COLUMN_MAGIC, sizeof(COLUMN_MAGIC)) != 0 ||
+        header_.version != COLUMN_VERSION) {
+        throw std::runtime_error("Not a column file: " + path);
+    }
+
+    std::uint64_t directoryEnd = header_.directoryOffset + header_.chunkCount * sizeof(ColumnChunkInfo);
+    if (directoryEnd > file_.size()) {
+        throw std::runtime_error("Truncated column file: " + path);
+    }
+
+    directory_.resize(header_.chunkCount);
+    std::memcpy(directory_.data(), file_.data() + header_.directoryOffset,
+        directory_.size() * sizeof(ColumnChunkInfo));
+
+    for (const auto& info : directory_) {
+        if (info.offset + info.byteSize > file_.size()) {
+            throw std::runtime_error("Truncated column chunk: " + path);
+        }
+    }
+}
@@ -0,0 +1,176 @@
+/**
+ * ColumnStore.hpp
+ * Column file format for game history analytics
+ *
+ * A column file holds one fixed-width unsigned column (1, 2, 4 or 8 bytes)
+ * split into row-group chunks. Layout:
+ *   [ColumnFileHeader][chunk 0][chunk 1]...[ColumnChunkInfo x chunkCount]
+ * Chunks start on 64-byte boundaries so plain chunks can be scanned in place
+ * from a memory mapping. Values are stored little-endian.
+ */
+
+#ifndef COLUMNSTORE_H
+#define COLUMNSTORE_H
+
+#include "MappedFile.h"
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * Chunk encoding
+ */
+enum class ColumnEncoding : std::uint8_t {
+    Plain = 0,      // Raw little-endian values (zero-copy)
+    RunLength = 1,  // u32 run count, run values, u32 run lengths
+    BitPacked = 2   // Frame of reference: (value - min) packed into bitWidth bits
+};
+
+/**
+ * File header (64 bytes)
+ */
+struct ColumnFileHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t valueWidth;
+    std::uint64_t rowCount;
+    std::uint64_t chunkCount;
+    std::uint64_t directoryOffset;
+    std::uint8_t reserved[24];
+};
+
+/**
+ * Per-chunk directory entry (40 bytes)
+ */
+struct ColumnChunkInfo {
+    std::uint64_t offset;       // Byte offset of the chunk in the file
+    std::uint64_t byteSize;     // Encoded size
+    std::uint32_t rowCount;
+    std::uint8_t encoding;      // ColumnEncoding
+    std::uint8_t bitWidth;      // BitPacked only
+    std::uint16_t reserved;
+    std::uint64_t minValue;     // Zone map for chunk skipping
+    std::uint64_t maxValue;
+};
+
+static_assert(sizeof(ColumnFileHeader) == 64, "ColumnFileHeader must be 64 bytes");
+static_assert(sizeof(ColumnChunkInfo) == 40, "ColumnChunkInfo must be 40 bytes");
+
+/**
+ * An encoded chunk ready to be written
+ */
+struct EncodedChunk {
+    ColumnChunkInfo info{};
+    std::vector<std::uint8_t> bytes;
+};
+
+/**
+ * Encoding and decoding of chunks
+ */
+class ColumnCodec {
+public:
+    /**
+     * Encode values, picking the smallest encoding.
+     * Plain is kept unless another encoding saves at least a quarter,
+     * since plain chunks are read without decoding.
+     */
+    static EncodedChunk encode(const std::vector<std::uint64_t>& values, std::uint32_t valueWidth);
+
+    /**
+     * Decode a chunk into out (rowCount values of valueWidth bytes)
+     */
+    static void decode(const ColumnChunkInfo& info, const std::uint8_t* data,
+        std::uint32_t valueWidth, void* out);
+};
+
+/**
+ * Sequential writer for one column file
+ */
+class ColumnWriter {
+public:
+    /**
+     * Create (truncate) a column file
+     * @throws std::runtime_error if the file cannot be created
+     */
+    ColumnWriter(const std::string& path, std::uint32_t valueWidth);
+    ~ColumnWriter();
+
+    ColumnWriter(const ColumnWriter&) = delete;
+    ColumnWriter& operator=(const ColumnWriter&) = delete;
+
+    /**
+     * Append an encoded chunk
+     */
+    void writeChunk(const EncodedChunk& chunk);
+
+    /**
+     * Write the chunk directory and final header
+     */
+    void close();
+
+    std::uint32_t getValueWidth() const { return valueWidth_; }
+
+private:
+    std::ofstream out_;
+    std::string path_;
+    std::uint32_t valueWidth_;
+    std::uint64_t rowCount_ = 0;
+    std::uint64_t position_ = 0;
+    std::vector<ColumnChunkInfo> directory_;
+    bool closed_ = false;
+
+    /**
+     * Pad the file with zeros up to an alignment boundary
+     */
+    void padTo(std::uint64_t alignment);
+};
+
+/**
+ * Memory-mapped reader for one column file
+ */
+class ColumnReader {
+public:
+    /**
+     * Map and validate a column file
+     * @throws std::runtime_error on a missing or malformed file
+     */
+    explicit ColumnReader(const std::string& path);
+
+    std::uint32_t getValueWidth() const { return header_.valueWidth; }
+    std::uint64_t getRowCount() const { return header_.rowCount; }
+    size_t getChunkCount() const { return directory_.size(); }
+    const ColumnChunkInfo& getChunkInfo(size_t index) const { return directory_[index]; }
+
+    /**
+     * Values of a chunk. Plain chunks are returned straight from the
+     * mapping; other encodings are decoded into scratch.
+     */
+    template <typename T>
+    std::span<const T> chunk(size_t index, std::vector<T>& scratch) const {
+        if (sizeof(T) != header_.valueWidth) {
+            throw std::runtime_error("Column width mismatch: " + file_.path());
+        }
+
+        const ColumnChunkInfo& info = directory_[index];
+        const std::uint8_t* data = file_.data() + info.offset;
+
+        if (static_cast<ColumnEncoding>(info.encoding) == ColumnEncoding::Plain) {
+            return std::span<const T>(reinterpret_cast<const T*>(data), info.rowCount);
+        }
+
+        scratch.resize(info.rowCount);
+        ColumnCodec::decode(info, data, header_.valueWidth, scratch.data());
+        return std::span<const T>(scratch.data(), scratch.size());
+    }
+
+private:
+    MappedFile file_;
+    ColumnFileHeader header_{};
+    std::vector<ColumnChunkInfo> directory_;
+};
+
+#endif // COLUMNSTORE_HPP
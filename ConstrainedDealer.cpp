@@ -0,0 +1,609 @@
+/**
+ * ConstrainedDealer.cpp
+ * Implementation of ConstrainedDealer
+ */
+
+#include "ConstrainedDealer.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+    constexpr int NUM_RANKS = 13;
+    constexpr int SUITS_PER_RANK = 4;
+    constexpr int BITS_PER_SUIT_BIN = 3;    // Bin of each suit in a packed rank assignment
+
+    double logFactorial(int n) {
+        return std::lgamma(static_cast<double>(n) + 1.0);
+    }
+
+    CardMask rankMask(int rank) {
+        return CardMask{ 0xF } << (rank * SUITS_PER_RANK);
+    }
+
+    /**
+     * Whether a hand holds all four cards of some rank (a full nibble)
+     */
+    bool hasFourOfAKind(CardMask hand) {
+        constexpr CardMask LOWEST_SUIT_BITS = 0x1111111111111;     // Bit 0 of each rank's nibble
+        CardMask pairs = hand & (hand >> 1);
+        return (pairs & (pairs >> 2) & LOWEST_SUIT_BITS) != 0;
+    }
+
+} // namespace
+
+/**
+ * Ways to spread one rank's four cards over the bins with the same per-bin counts
+ */
+struct ConstrainedDealer::RankMove {
+    std::array<std::uint8_t, MAX_BINS> counts{};
+    std::uint32_t delta = 0;                    // State index change
+    std::vector<std::uint16_t> assignments;     // Bin of each suit, packed
+};
+
+/**
+ * Completion counts for one case: ways[r][i] = ways to deal ranks r.. into
+ * the remaining capacities layers_[r][i]
+ */
+struct ConstrainedDealer::CompletionTable {
+    std::array<std::vector<RankMove>, NUM_RANKS> moves;
+    std::array<std::vector<double>, NUM_RANKS + 1> ways;
+    std::vector<std::uint32_t> const* slots = nullptr;     // State index -> position in its layer
+
+    double total(std::uint32_t fullState) const {
+        return ways[0][(*slots)[fullState]];
+    }
+};
+
+/**
+ * Seat must hold these cards
+ */
+DealConstraints& DealConstraints::require(size_t seat, std::span<const Card> cards) {
+    if (seat >= MAX_SEATS) {
+        throw std::invalid_argument("Constraint seat out of range: " + std::to_string(seat));
+    }
+    required[seat] |= toCardMask(cards);
+    return *this;
+}
+
+/**
+ * Seat must not hold these cards
+ */
+DealConstraints& DealConstraints::forbid(size_t seat, std::span<const Card> cards) {
+    if (seat >= MAX_SEATS) {
+        throw std::invalid_argument("Constraint seat out of range: " + std::to_string(seat));
+    }
+    forbidden[seat] |= toCardMask(cards);
+    return *this;
+}
+
+/**
+ * Seat must hold all cards of at least one option
+ */
+DealConstraints& DealConstraints::requireAnyOf(size_t seat, std::vector<CardMask> options) {
+    if (seat >= MAX_SEATS) {
+        throw std::invalid_argument("Constraint seat out of range: " + std::to_string(seat));
+    }
+    anyOf.push_back(DealAlternatives{ seat, std::move(options) });
+    return *this;
+}
+
+/**
+ * Seat must not hold all four cards of any rank
+ */
+DealConstraints& DealConstraints::forbidFourOfAKind(size_t seat) {
+    if (seat >= MAX_SEATS) {
+        throw std::invalid_argument("Constraint seat out of range: " + std::to_string(seat));
+    }
+    noFourOfAKindSeats |= 1u << seat;
+    return *this;
+}
+
+DealConstraints& DealConstraints::forbidFourOfAKindAnywhere() {
+    noFourOfAKindSeats = (1u << MAX_SEATS) - 1;
+    return *this;
+}
+
+/**
+ * Five consecutive ranks of one suit, as GameRules::isStraightFlush accepts them
+ */
+std::vector<CardMask> DealConstraints::straightFlushes() {
+    std::vector<CardMask> masks;
+    for (int suit = 0; suit < SUITS_PER_RANK; ++suit) {
+        for (int low = 0; low + 5 <= NUM_RANKS; ++low) {
+            CardMask mask = 0;
+            for (int rank = low; rank < low + 5; ++rank) {
+                mask |= CardMask{ 1 } << (rank * SUITS_PER_RANK + suit);
+            }
+            masks.push_back(mask);
+        }
+    }
+    return masks;
+}
+
+std::vector<CardMask> DealConstraints::fourOfAKinds() {
+    std::vector<CardMask> masks;
+    for (int rank = 0; rank < NUM_RANKS; ++rank) {
+        masks.push_back(rankMask(rank));
+    }
+    return masks;
+}
+
+/**
+ * Constructor - validates constraints and weighs every option combination
+ */
+ConstrainedDealer::ConstrainedDealer(const DealConstraints& constraints)
+    : constraints_(constraints) {
+    int numPlayers = constraints_.numPlayers;
+    if (numPlayers < 2 || numPlayers > static_cast<int>(DealConstraints::MAX_SEATS)) {
+        throw std::invalid_argument("Constrained deals support 2-4 players (one deck)");
+    }
+
+    std::uint32_t seatBits = (1u << numPlayers) - 1;
+    for (size_t seat = numPlayers; seat < DealConstraints::MAX_SEATS; ++seat) {
+        if (constraints_.required[seat] != 0 || constraints_.forbidden[seat] != 0) {
+            throw std::invalid_argument("Constraint on seat " + std::to_string(seat) + " outside the table");
+        }
+    }
+    constraints_.noFourOfAKindSeats &= seatBits;
+    for (const auto& alternatives : constraints_.anyOf) {
+        if (alternatives.seat >= static_cast<size_t>(numPlayers)) {
+            throw std::invalid_argument("Constraint on seat " + std::to_string(alternatives.seat) + " outside the table");
+        }
+        if (alternatives.options.empty()) {
+            throw std::invalid_argument("Deal constraints cannot be satisfied (no options)");
+        }
+    }
+
+    // Bins: one per seat, plus a pile for the cards dealCards leaves undealt
+    cardsPerPlayer_ = 52 / numPlayers;
+    int leftover = 52 - static_cast<int>(cardsPerPlayer_) * numPlayers;
+    numBins_ = static_cast<size_t>(numPlayers) + (leftover > 0 ? 1 : 0);
+    for (size_t bin = 0; bin < numBins_; ++bin) {
+        capacity_[bin] = bin < static_cast<size_t>(numPlayers) ? static_cast<int>(cardsPerPlayer_) : leftover;
+    }
+
+    for (size_t seat = 0; seat < static_cast<size_t>(numPlayers); ++seat) {
+        if (constraints_.forbidden[seat] != 0) {
+            shuffleOnly_ = false;
+        }
+    }
+    if (constraints_.noFourOfAKindSeats != 0) {
+        shuffleOnly_ = false;
+    }
+
+    if (!shuffleOnly_) {
+        // Remaining-capacity states, grouped by cards left before each rank
+        stateCount_ = 1;
+        for (size_t bin = 0; bin < numBins_; ++bin) {
+            stride_[bin] = stateCount_;
+            stateCount_ *= static_cast<std::uint32_t>(capacity_[bin] + 1);
+        }
+        slots_.assign(stateCount_, 0);
+        for (std::uint32_t state = 0; state < stateCount_; ++state) {
+            int remaining = 0;
+            for (size_t bin = 0; bin < numBins_; ++bin) {
+                remaining += static_cast<int>(state / stride_[bin]) % (capacity_[bin] + 1);
+            }
+            if (remaining % SUITS_PER_RANK == 0) {
+                auto& layer = layers_[NUM_RANKS - remaining / SUITS_PER_RANK];
+                slots_[state] = static_cast<std::uint32_t>(layer.size());
+                layer.push_back(state);
+            }
+        }
+        for (size_t bin = 0; bin < numBins_; ++bin) {
+            fullState_ += static_cast<std::uint32_t>(capacity_[bin]) * stride_[bin];
+        }
+    }
+
+    // Every combination of one option per "any of" requirement
+    size_t combinations = 1;
+    for (const auto& alternatives : constraints_.anyOf) {
+        combinations *= alternatives.options.size();
+        if (combinations > MAX_OPTION_COMBINATIONS) {
+            throw std::length_error("Too many option combinations in deal constraints");
+        }
+    }
+
+    std::vector<double> logWeights;
+    std::vector<size_t> choice(constraints_.anyOf.size(), 0);
+    for (size_t combination = 0; combination < combinations; ++combination) {
+        SeatCards fixed = constraints_.required;
+        for (size_t i = 0; i < choice.size(); ++i) {
+            const auto& alternatives = constraints_.anyOf[i];
+            fixed[alternatives.seat] |= alternatives.options[choice[i]];
+        }
+
+        double logWeight = -std::numeric_limits<double>::infinity();
+        std::unique_ptr<CompletionTable> table;
+        if (shuffleOnly_) {
+            logWeight = logShuffleCompletions(fixed);
+        }
+        else if ((table = buildTable(fixed)) != nullptr) {
+            double total = table->total(fullState_);
+            if (total > 0) {
+                logWeight = std::log(total);
+            }
+        }
+
+        if (std::isfinite(logWeight)) {
+            cases_.push_back(fixed);
+            logWeights.push_back(logWeight);
+            tables_.push_back(tables_.size() < MAX_CACHED_TABLES ? std::move(table) : nullptr);
+        }
+
+        // Next combination (mixed radix)
+        for (size_t i = 0; i < choice.size(); ++i) {
+            if (++choice[i] < constraints_.anyOf[i].options.size()) {
+                break;
+            }
+            choice[i] = 0;
+        }
+    }
+
+    if (cases_.empty()) {
+        throw std::invalid_argument("Deal constraints cannot be satisfied");
+    }
+
+    // A single case whose bans reject few shuffles is cheaper to sample by retrying
+    if (!shuffleOnly_ && cases_.size() == 1 && constraints_.anyOf.empty()) {
+        double acceptance = std::exp(logWeights[0] - logShuffleCompletions(cases_[0]));
+        shuffleAndCheck_ = acceptance >= MIN_SHUFFLE_ACCEPTANCE;
+    }
+    if (shuffleAndCheck_) {
+        CardMask taken = 0;
+        for (CardMask cards : cases_[0]) {
+            taken |= cards;
+        }
+        for (CardMask mask = FULL_DECK_MASK & ~taken; mask != 0; mask &= mask - 1) {
+            checkDeck_[checkDeckSize_++] = std::countr_zero(mask);
+        }
+    }
+
+    double maxLog = *std::max_element(logWeights.begin(), logWeights.end());
+    double running = 0.0;
+    for (double logWeight : logWeights) {
+        running += std::exp(logWeight - maxLog);
+        cumulative_.push_back(running);
+    }
+}
+
+ConstrainedDealer::~ConstrainedDealer() = default;
+
+/**
+ * Log of the completions of a case when the free cards are simply shuffled
+ */
+double ConstrainedDealer::logShuffleCompletions(const SeatCards& fixed) const {
+    CardMask seen = 0;
+    int freeCards = 52;
+    double logWays = 0.0;
+    for (size_t bin = 0; bin < numBins_; ++bin) {
+        CardMask cards = bin < DealConstraints::MAX_SEATS ? fixed[bin] : 0;
+        if (cards & seen) {
+            return -std::numeric_limits<double>::infinity();   // Card required in two seats
+        }
+        seen |= cards;
+
+        int slots = capacity_[bin] - std::popcount(cards);
+        if (slots < 0) {
+            return -std::numeric_limits<double>::infinity();
+        }
+        freeCards -= std::popcount(cards);
+        logWays -= logFactorial(slots);
+    }
+    return logWays + logFactorial(freeCards);
+}
+
+/**
+ * Completion table for a case (nullptr if its fixed cards contradict)
+ */
+std::unique_ptr<ConstrainedDealer::CompletionTable> ConstrainedDealer::buildTable(const SeatCards& fixed) const {
+    size_t numSeats = static_cast<size_t>(constraints_.numPlayers);
+    std::uint8_t allBins = static_cast<std::uint8_t>((1u << numBins_) - 1);
+
+    // Bins each card may go to
+    std::array<std::uint8_t, 52> allowed{};
+    for (int index = 0; index < 52; ++index) {
+        CardMask bit = CardMask{ 1 } << index;
+        std::uint8_t bins = allBins;
+        int owners = 0;
+        for (size_t seat = 0; seat < numSeats; ++seat) {
+            if (constraints_.forbidden[seat] & bit) {
+                bins &= static_cast<std::uint8_t>(~(1u << seat));
+            }
+        }
+        for (size_t seat = 0; seat < numSeats; ++seat) {
+            if (fixed[seat] & bit) {
+                bins &= static_cast<std::uint8_t>(1u << seat);
+                ++owners;
+            }
+        }
+        if (bins == 0 || owners > 1) {
+            return nullptr;
+        }
+        allowed[index] = bins;
+    }
+
+    auto table = std::make_unique<CompletionTable>();
+    table->slots = &slots_;
+
+    // Per rank: every assignment of its four cards, grouped by per-bin counts
+    for (int rank = 0; rank < NUM_RANKS; ++rank) {
+        auto& moves = table->moves[rank];
+        std::array<size_t, SUITS_PER_RANK> bin{};
+        size_t total = 1;
+        for (int suit = 0; suit < SUITS_PER_RANK; ++suit) {
+            total *= numBins_;
+        }
+
+        for (size_t code = 0; code < total; ++code) {
+            size_t rest = code;
+            bool valid = true;
+            std::array<std::uint8_t, MAX_BINS> counts{};
+            std::uint16_t packed = 0;
+            for (int suit = 0; suit < SUITS_PER_RANK; ++suit) {
+                bin[suit] = rest % numBins_;
+                rest /= numBins_;
+                if (!(allowed[rank * SUITS_PER_RANK + suit] & (1u << bin[suit]))) {
+                    valid = false;
+                    break;
+                }
+                ++counts[bin[suit]];
+                packed |= static_cast<std::uint16_t>(bin[suit] << (suit * BITS_PER_SUIT_BIN));
+            }
+            if (!valid) {
+                continue;
+            }
+            for (size_t seat = 0; seat < numSeats; ++seat) {
+                if ((constraints_.noFourOfAKindSeats & (1u << seat)) && counts[seat] == SUITS_PER_RANK) {
+                    valid = false;
+                }
+            }
+            if (!valid) {
+                continue;
+            }
+
+            auto it = std::find_if(moves.begin(), moves.end(),
+                [&](const RankMove& move) { return move.counts == counts; });
+            if (it == moves.end()) {
+                RankMove move;
+                move.counts = counts;
+                for (size_t b = 0; b < numBins_; ++b) {
+                    move.delta += counts[b] * stride_[b];
+                }
+                moves.push_back(std::move(move));
+                it = moves.end() - 1;
+            }
+            it->assignments.push_back(packed);
+        }
+    }
+
+    // Completion counts, last rank first
+    table->ways[NUM_RANKS].assign(layers_[NUM_RANKS].size(), 0.0);
+    table->ways[NUM_RANKS][slots_[0]] = 1.0;
+    for (int rank = NUM_RANKS - 1; rank >= 0; --rank) {
+        const auto& layer = layers_[rank];
+        auto& ways = table->ways[rank];
+        const auto& next = table->ways[rank + 1];
+        ways.assign(layer.size(), 0.0);
+
+        for (size_t i = 0; i < layer.size(); ++i) {
+            std::uint32_t state = layer[i];
+            std::array<int, MAX_BINS> remaining{};
+            for (size_t b = 0; b < numBins_; ++b) {
+                remaining[b] = static_cast<int>(state / stride_[b]) % (capacity_[b] + 1);
+            }
+
+            double sum = 0.0;
+            for (const auto& move : table->moves[rank]) {
+                if (fits(move, remaining)) {
+                    sum += static_cast<double>(move.assignments.size()) * next[slots_[state - move.delta]];
+                }
+            }
+            ways[i] = sum;
+        }
+    }
+    return table;
+}
+
+/**
+ * Does a rank move fit the remaining capacities
+ */
+bool ConstrainedDealer::fits(const RankMove& move, const std::array<int, MAX_BINS>& remaining) const {
+    for (size_t b = 0; b < numBins_; ++b) {
+        if (move.counts[b] > remaining[b]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Completion table of a case (built on demand past the cache limit)
+ */
+const ConstrainedDealer::CompletionTable& ConstrainedDealer::tableFor(size_t caseIndex) {
+    if (tables_[caseIndex]) {
+        return *tables_[caseIndex];
+    }
+    scratchTable_ = buildTable(cases_[caseIndex]);
+    return *scratchTable_;
+}
+
+/**
+ * Shuffle the free cards into the free slots
+ */
+void ConstrainedDealer::sampleShuffle(const SeatCards& fixed, std::mt19937& rng, std::array<CardMask, MAX_BINS>& bins) const {
+    CardMask taken = 0;
+    for (size_t seat = 0; seat < static_cast<size_t>(constraints_.numPlayers); ++seat) {
+        bins[seat] = fixed[seat];
+        taken |= fixed[seat];
+    }
+
+    // Card indices on the stack, as ints: shuffling and checking runs this once
+    // per try (from a prepared list), and std::shuffle moves ints faster than
+    // Cards or bytes. The list starts in the same order every time, so the
+    // same generator state gives the same deal.
+    std::array<int, 52> freeCards = checkDeck_;
+    size_t freeCount = checkDeckSize_;
+    if (!shuffleAndCheck_) {
+        freeCount = 0;
+        for (CardMask mask = FULL_DECK_MASK & ~taken; mask != 0; mask &= mask - 1) {
+            freeCards[freeCount++] = std::countr_zero(mask);
+        }
+    }
+    std::shuffle(freeCards.begin(), freeCards.begin() + static_cast<std::ptrdiff_t>(freeCount), rng);
+
+    size_t next = 0;
+    for (size_t bin = 0; bin < numBins_; ++bin) {
+        int slots = capacity_[bin] - std::popcount(bins[bin]);
+        for (int i = 0; i < slots; ++i) {
+            bins[bin] |= CardMask{ 1 } << freeCards[next++];
+        }
+    }
+}
+
+/**
+ * Walk the ranks, choosing each rank's spread in proportion to its completions
+ */
+void ConstrainedDealer::sampleTable(const CompletionTable& table, std::mt19937& rng, std::array<CardMask, MAX_BINS>& bins) const {
+    std::uint32_t state = fullState_;
+    for (int rank = 0; rank < NUM_RANKS; ++rank) {
+        std::array<int, MAX_BINS> remaining{};
+        for (size_t b = 0; b < numBins_; ++b) {
+            remaining[b] = static_cast<int>(state / stride_[b]) % (capacity_[b] + 1);
+        }
+
+        const auto& next = table.ways[rank + 1];
+        double target = std::uniform_real_distribution<double>(0.0, table.ways[rank][slots_[state]])(rng);
+        const RankMove* chosen = nullptr;
+        for (const auto& move : table.moves[rank]) {
+            if (!fits(move, remaining)) {
+                continue;
+            }
+            double weight = static_cast<double>(move.assignments.size()) * next[slots_[state - move.delta]];
+            if (weight <= 0.0) {
+                continue;
+            }
+            chosen = &move;     // Last positive move absorbs rounding
+            if (target < weight) {
+                break;
+            }
+            target -= weight;
+        }
+
+        size_t pick = std::uniform_int_distribution<size_t>(0, chosen->assignments.size() - 1)(rng);
+        std::uint16_t packed = chosen->assignments[pick];
+        for (int suit = 0; suit < SUITS_PER_RANK; ++suit) {
+            size_t bin = (packed >> (suit * BITS_PER_SUIT_BIN)) & ((1u << BITS_PER_SUIT_BIN) - 1);
+            bins[bin] |= CardMask{ 1 } << (rank * SUITS_PER_RANK + suit);
+        }
+        state -= chosen->delta;
+    }
+}
+
+/**
+ * Option combinations a deal contains
+ */
+std::uint64_t ConstrainedDealer::countCases(std::span<const CardMask> hands) const {
+    std::uint64_t count = 1;
+    for (const auto& alternatives : constraints_.anyOf) {
+        std::uint64_t held = 0;
+        for (CardMask option : alternatives.options) {
+            held += (hands[alternatives.seat] & option) == option;
+        }
+        count *= held;
+    }
+    return count;
+}
+
+/**
+ * Sample a deal uniformly among those satisfying the constraints
+ */
+std::vector<CardMask> ConstrainedDealer::deal(std::mt19937& rng) {
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    for (;;) {
+        size_t caseIndex = 0;
+        if (cases_.size() > 1) {
+            double target = unit(rng) * cumulative_.back();
+            caseIndex = static_cast<size_t>(
+                std::upper_bound(cumulative_.begin(), cumulative_.end(), target) - cumulative_.begin());
+            caseIndex = std::min(caseIndex, cases_.size() - 1);
+        }
+
+        std::array<CardMask, MAX_BINS> bins{};
+        if (shuffleAndCheck_) {
+            sampleShuffle(cases_[caseIndex], rng, bins);
+            if (!satisfies(std::span<const CardMask>(bins.data(), constraints_.numPlayers))) {
+                continue;
+            }
+        }
+        else if (shuffleOnly_) {
+            sampleShuffle(cases_[caseIndex], rng, bins);
+        }
+        else {
+            sampleTable(tableFor(caseIndex), rng, bins);
+        }
+
+        // A deal holding m combinations was proposed m times as often
+        std::vector<CardMask> hands(bins.begin(), bins.begin() + constraints_.numPlayers);
+        std::uint64_t proposals = countCases(hands);
+        if (proposals <= 1 || unit(rng) * static_cast<double>(proposals) < 1.0) {
+            return hands;
+        }
+    }
+}
+
+/**
+ * Sample a deal as a stacked deck (dealt from the back, card i to seat i % n)
+ */
+std::vector<Card> ConstrainedDealer::dealDeck(std::mt19937& rng) {
+    std::vector<CardMask> hands = deal(rng);
+    size_t numPlayers = hands.size();
+
+    CardMask dealt = 0;
+    std::vector<std::vector<Card>> seatCards;
+    for (CardMask hand : hands) {
+        seatCards.push_back(fromCardMask(hand));
+        dealt |= hand;
+    }
+
+    // Undealt cards at the front, then seats round-robin with the first card dealt last
+    std::vector<Card> deck = fromCardMask(FULL_DECK_MASK & ~dealt);
+    size_t dealtCount = cardsPerPlayer_ * numPlayers;
+    deck.reserve(deck.size() + dealtCount);
+    for (size_t i = dealtCount; i-- > 0;) {
+        deck.push_back(seatCards[i % numPlayers][i / numPlayers]);
+    }
+    return deck;
+}
+
+/**
+ * Check a deal against the constraints
+ */
+bool ConstrainedDealer::satisfies(std::span<const CardMask> hands) const {
+    if (hands.size() != static_cast<size_t>(constraints_.numPlayers)) {
+        return false;
+    }
+
+    CardMask seen = 0;
+    for (size_t seat = 0; seat < hands.size(); ++seat) {
+        CardMask hand = hands[seat];
+        if ((hand & seen) || std::popcount(hand) != static_cast<int>(cardsPerPlayer_)) {
+            return false;
+        }
+        seen |= hand;
+
+        if ((hand & constraints_.required[seat]) != constraints_.required[seat]
+            || (hand & constraints_.forbidden[seat]) != 0) {
+            return false;
+        }
+        if ((constraints_.noFourOfAKindSeats & (1u << seat)) && hasFourOfAKind(hand)) {
+            return false;
+        }
+    }
+    return countCases(hands) > 0;
+}
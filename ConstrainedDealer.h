@@ -0,0 +1,156 @@
+/**
+ * ConstrainedDealer.hpp
+ * Uniform random deals that satisfy constraints (scenario tests, puzzles)
+ *
+ * Required cards are fixed in their seats and the rest of the deck is
+ * sampled with exact completion counts, so rare scenarios cost no more
+ * than common ones. With only required cards the completion is a shuffle
+ * of the free cards. Forbidden cards and four-of-a-kind bans use a table
+ * of completion counts built rank by rank over the seats' remaining
+ * capacities; when the table shows that enough shuffles already pass, the
+ * dealer shuffles and checks instead. That is rejection sampling itself:
+ * it costs about what shuffling whole decks does, plus the vector the deal
+ * is returned in, and is never much faster. "Any of" requirements pick one option per requirement,
+ * weighted by its completion count, and accept the deal with probability
+ * 1 / (option combinations it contains), which keeps the result uniform.
+ *
+ * Single-deck tables only (2-4 seats); undealt cards form an extra pile.
+ */
+
+#ifndef CONSTRAINEDDEALER_H
+#define CONSTRAINEDDEALER_H
+
+#include "CardMask.h"
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <span>
+#include <vector>
+
+/**
+ * Seat must hold at least one of several card sets
+ */
+struct DealAlternatives {
+    size_t seat = 0;
+    std::vector<CardMask> options;
+};
+
+/**
+ * Requirements on a deal
+ */
+struct DealConstraints {
+    static constexpr size_t MAX_SEATS = 4;
+
+    int numPlayers = 4;
+    std::array<CardMask, MAX_SEATS> required{};     // Cards each seat must hold
+    std::array<CardMask, MAX_SEATS> forbidden{};    // Cards each seat must not hold
+    std::uint32_t noFourOfAKindSeats = 0;           // Seats that must not hold all four of a rank
+    std::vector<DealAlternatives> anyOf;
+
+    /**
+     * Builders (seat numbers are checked by ConstrainedDealer)
+     */
+    DealConstraints& require(size_t seat, std::span<const Card> cards);
+    DealConstraints& forbid(size_t seat, std::span<const Card> cards);
+    DealConstraints& requireAnyOf(size_t seat, std::vector<CardMask> options);
+    DealConstraints& forbidFourOfAKind(size_t seat);
+    DealConstraints& forbidFourOfAKindAnywhere();
+
+    /**
+     * Every straight flush (36) and every four of a kind without kicker (13)
+     */
+    static std::vector<CardMask> straightFlushes();
+    static std::vector<CardMask> fourOfAKinds();
+};
+
+/**
+ * ConstrainedDealer class
+ */
+class ConstrainedDealer {
+public:
+    static constexpr size_t MAX_OPTION_COMBINATIONS = 4096;
+
+    /**
+     * Prepare sampling for a set of constraints
+     * @throws std::invalid_argument for unsupported tables or unsatisfiable constraints
+     * @throws std::length_error if the "any of" requirements combine into too many cases
+     */
+    explicit ConstrainedDealer(const DealConstraints& constraints);
+    ~ConstrainedDealer();
+
+    ConstrainedDealer(const ConstrainedDealer&) = delete;
+    ConstrainedDealer& operator=(const ConstrainedDealer&) = delete;
+
+    /**
+     * Sample a deal uniformly among those satisfying the constraints
+     * @return one card mask per seat
+     */
+    std::vector<CardMask> deal(std::mt19937& rng);
+
+    /**
+     * Sample a deal as a stacked deck for GameState::startNewGame
+     * (round-robin dealing from the back, undealt cards at the front)
+     */
+    std::vector<Card> dealDeck(std::mt19937& rng);
+
+    /**
+     * Check a deal against the constraints
+     */
+    bool satisfies(std::span<const CardMask> hands) const;
+
+    int getNumPlayers() const { return constraints_.numPlayers; }
+    size_t getCardsPerPlayer() const { return cardsPerPlayer_; }
+
+private:
+    static constexpr size_t MAX_BINS = DealConstraints::MAX_SEATS + 1;     // Seats and the undealt pile
+    static constexpr size_t MAX_CACHED_TABLES = 256;
+    static constexpr double MIN_SHUFFLE_ACCEPTANCE = 0.35;  // Shuffle and check above this (a table walk costs ~3 tries)
+
+    struct RankMove;
+    struct CompletionTable;
+    using SeatCards = std::array<CardMask, DealConstraints::MAX_SEATS>;
+
+    DealConstraints constraints_;
+    size_t numBins_ = 0;
+    size_t cardsPerPlayer_ = 0;
+    std::array<int, MAX_BINS> capacity_{};
+    bool shuffleOnly_ = true;       // No forbidden cards or four-of-a-kind bans
+    bool shuffleAndCheck_ = false;  // Bans rarely matter: retry shuffles instead of walking the table
+
+    // Remaining-capacity states (mixed radix), grouped by cards left before each rank
+    std::array<std::uint32_t, MAX_BINS> stride_{};
+    std::uint32_t stateCount_ = 0;
+    std::uint32_t fullState_ = 0;
+    std::array<std::vector<std::uint32_t>, 14> layers_;
+    std::vector<std::uint32_t> slots_;      // State -> position in its layer
+
+    std::vector<SeatCards> cases_;      // Fixed cards of each option combination
+    std::vector<double> cumulative_;    // Running case weights
+    std::vector<std::unique_ptr<CompletionTable>> tables_;
+    std::unique_ptr<CompletionTable> scratchTable_;     // Cases past the cache limit
+    std::array<int, 52> checkDeck_{};   // Free cards when shuffling and checking (one case), in index order
+    size_t checkDeckSize_ = 0;
+
+    /**
+     * Log of a case's completions when only required cards are fixed (-inf if none)
+     */
+    double logShuffleCompletions(const SeatCards& fixed) const;
+
+    /**
+     * Completion table for a case (nullptr if its fixed cards contradict)
+     */
+    std::unique_ptr<CompletionTable> buildTable(const SeatCards& fixed) const;
+    const CompletionTable& tableFor(size_t caseIndex);
+    bool fits(const RankMove& move, const std::array<int, MAX_BINS>& remaining) const;
+
+    void sampleShuffle(const SeatCards& fixed, std::mt19937& rng, std::array<CardMask, MAX_BINS>& bins) const;
+    void sampleTable(const CompletionTable& table, std::mt19937& rng, std::array<CardMask, MAX_BINS>& bins) const;
+
+    /**
+     * Option combinations a deal contains
+     */
+    std::uint64_t countCases(std::span<const CardMask> hands) const;
+};
+
+#endif // CONSTRAINEDDEALER_HPP
@@ -0,0 +1,176 @@
+/**
+ * CpuTopology.cpp
+ * Implementation of CpuTopology
+ */
+
+#include "CpuTopology.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace {
+
+    /**
+     * Parse a sysfs CPU list such as "0-7,16-23"
+     */
+    std::vector<int> parseCpuList(const std::string& text) {
+        std::vector<int> cpus;
+        std::stringstream ranges(text);
+        std::string range;
+        while (std::getline(ranges, range, ',')) {
+            if (range.empty() || range == "\n") {
+                continue;
+            }
+            size_t dash = range.find('-');
+            try {
+                int first = std::stoi(range.substr(0, dash));
+                int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+                for (int cpu = first; cpu <= last; ++cpu) {
+                    cpus.push_back(cpu);
+                }
+            }
+            catch (const std::exception&) {
+                return {};
+            }
+        }
+        return cpus;
+    }
+
+    /**
+     * CPUs the process may run on (empty if unknown)
+     */
+    std::vector<int> allowedCpus() {
+        std::vector<int> cpus;
+#if defined(__linux__)
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+            for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+                if (CPU_ISSET(cpu, &set)) {
+                    cpus.push_back(cpu);
+                }
+            }
+        }
+#endif
+        return cpus;
+    }
+
+} // namespace
+
+/**
+ * Detect the topology of the running machine
+ */
+CpuTopology CpuTopology::detect() {
+    CpuTopology topology;
+    std::vector<int> allowed = allowedCpus();
+
+#if defined(__linux__)
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator("/sys/devices/system/node", error)) {
+        std::string name = entry.path().filename().string();
+        if (name.rfind("node", 0) != 0 || name.size() == 4
+            || !std::all_of(name.begin() + 4, name.end(), [](char c) { return c >= '0' && c <= '9'; })) {
+            continue;
+        }
+
+        std::ifstream file(entry.path() / "cpulist");
+        std::string text;
+        std::getline(file, text);
+
+        NumaNode node;
+        node.id = std::stoi(name.substr(4));
+        for (int cpu : parseCpuList(text)) {
+            if (allowed.empty() || std::find(allowed.begin(), allowed.end(), cpu) != allowed.end()) {
+                node.cpus.push_back(cpu);
+            }
+        }
+        if (!node.cpus.empty()) {
+            topology.nodes_.push_back(std::move(node));
+        }
+    }
+    std::sort(topology.nodes_.begin(), topology.nodes_.end(),
+        [](const NumaNode& a, const NumaNode& b) { return a.id < b.id; });
+#endif
+
+    if (topology.nodes_.empty()) {
+        NumaNode node;
+        node.cpus = allowed;
+        if (node.cpus.empty()) {
+            int count = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+            for (int cpu = 0; cpu < count; ++cpu) {
+                node.cpus.push_back(cpu);
+            }
+        }
+        topology.nodes_.push_back(std::move(node));
+    }
+    return topology;
+}
+
+size_t CpuTopology::getCpuCount() const {
+    size_t count = 0;
+    for (const auto& node : nodes_) {
+        count += node.cpus.size();
+    }
+    return count;
+}
+
+/**
+ * CPU and node of each worker
+ */
+std::vector<CpuTopology::Placement> CpuTopology::placeWorkers(size_t numWorkers) const {
+    std::vector<Placement> placements;
+    std::vector<size_t> used(nodes_.size(), 0);
+    size_t cpuCount = getCpuCount();
+
+    for (size_t worker = 0; placements.size() < numWorkers; ++worker) {
+        const NumaNode& node = nodes_[worker % nodes_.size()];
+        size_t& next = used[worker % nodes_.size()];
+        if (placements.size() >= cpuCount) {
+            // More workers than CPUs: reuse CPUs in the same order
+            placements.push_back(placements[placements.size() - cpuCount]);
+            continue;
+        }
+        if (next < node.cpus.size()) {
+            placements.push_back(Placement{ node.cpus[next++], node.id });
+        }
+    }
+    return placements;
+}
+
+/**
+ * Pin the calling thread to one CPU
+ */
+bool CpuTopology::pinCurrentThread(int cpu) {
+    if (cpu < 0) {
+        return false;
+    }
+#if defined(_WIN32)
+    if (cpu >= static_cast<int>(sizeof(DWORD_PTR) * 8)) {
+        return false;   // Beyond the first processor group
+    }
+    return SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR{ 1 } << cpu) != 0;
+#elif defined(__linux__)
+    if (cpu >= CPU_SETSIZE) {
+        return false;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    return false;
+#endif
+}
@@ -0,0 +1,57 @@
+/**
+ * CpuTopology.hpp
+ * NUMA nodes and the CPUs this process may run on, for pinning workers
+ *
+ * On Linux the nodes come from /sys/devices/system/node, limited to the
+ * process affinity mask. Elsewhere (or without that directory) every
+ * available CPU is reported as node 0.
+ */
+
+#ifndef CPUTOPOLOGY_H
+#define CPUTOPOLOGY_H
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * One NUMA node
+ */
+struct NumaNode {
+    int id = 0;
+    std::vector<int> cpus;
+};
+
+/**
+ * CpuTopology class
+ */
+class CpuTopology {
+public:
+    /**
+     * Detect the topology of the running machine
+     */
+    static CpuTopology detect();
+
+    const std::vector<NumaNode>& getNodes() const { return nodes_; }
+    size_t getCpuCount() const;
+
+    /**
+     * CPU and node of each worker: workers alternate between nodes and fill
+     * each node's CPUs in order, so any thread count spreads across sockets
+     */
+    struct Placement {
+        int cpu = -1;
+        int node = 0;
+    };
+    std::vector<Placement> placeWorkers(size_t numWorkers) const;
+
+    /**
+     * Pin the calling thread to one CPU
+     * @return false if the platform refused (the thread keeps running unpinned)
+     */
+    static bool pinCurrentThread(int cpu);
+
+private:
+    std::vector<NumaNode> nodes_;
+};
+
+#endif // CPUTOPOLOGY_HPP
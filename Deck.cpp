@@ -9,46 +9,60 @@
 #include <chrono>
 
  /**
-  * Constructor - creates and initializes a standard 52-card deck
+  * Constructor - creates and initializes numDecks standard 52-card decks
   */
-Deck::Deck() {
-    // Seed the random number generator with current time
-    auto seed = std::chrono::steady_clock::now().time_since_epoch().count();
-    rng_.seed(static_cast<std::mt19937::result_type>(seed));
+Deck::Deck(int numDecks) : numDecks_(std::max(1, numDecks)) {
+    // Seed the first shuffle with the current time
+    seed_ = static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
 
     initializeDeck();
 }
 
 /**
- * Initialize deck with all 52 cards (13 ranks  4 suits)
+ * Initialize deck with all 52 cards (13 ranks  4 suits) per deck
  */
 void Deck::initializeDeck() {
-    cards_.clear();
-    cards_.reserve(52);
-
-    // Create all combinations of ranks and suits
-    const std::vector<Rank> ranks = {
+    // Static tables: resetting a deck reuses its storage and never allocates
+    static const Rank ranks[] = {
         Rank::Three, Rank::Four, Rank::Five, Rank::Six,
         Rank::Seven, Rank::Eight, Rank::Nine, Rank::Ten,
         Rank::Jack, Rank::Queen, Rank::King, Rank::Ace, Rank::Two
     };
 
-    const std::vector<Suit> suits = {
+    static const Suit suits[] = {
         Suit::Diamonds, Suit::Clubs, Suit::Hearts, Suit::Spades
     };
 
-    for (Rank rank : ranks) {
-        for (Suit suit : suits) {
-            cards_.emplace_back(rank, suit);
+    cards_.clear();
+    cards_.reserve(52 * static_cast<size_t>(numDecks_));
+
+    // Create all combinations of ranks and suits, once per deck
+    for (int deck = 0; deck < numDecks_; ++deck) {
+        for (Rank rank : ranks) {
+            for (Suit suit : suits) {
+                cards_.emplace_back(rank, suit);
+            }
         }
     }
 }
 
+/**
+ * Change the number of decks
+ */
+void Deck::setNumDecks(int numDecks) {
+    numDecks_ = std::max(1, numDecks);
+}
+
 /**
  * Shuffle the deck using Fisher-Yates algorithm
  */
 void Deck::shuffle() {
-    std::shuffle(cards_.begin(), cards_.end(), rng_);
+    std::seed_seq seq{ static_cast<std::uint32_t>(seed_), static_cast<std::uint32_t>(seed_ >> 32) };
+    std::mt19937 rng(seq);
+    shuffle(rng);
+
+    std::uint64_t high = rng();
+    seed_ = (high << 32) | rng();
 }
 
 /**
@@ -90,4 +104,11 @@ std::vector<Card> Deck::dealMultiple(size_t count) {
  */
 void Deck::reset() {
     initializeDeck();
-}
\ No newline at end of file
+}
+
+/**
+ * Replace the deck with a prearranged order
+ */
+void Deck::stack(std::span<const Card> cards) {
+    cards_.assign(cards.begin(), cards.end());
+}
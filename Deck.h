@@ -1,6 +1,7 @@
 /**
  * Deck.hpp
- * Manages a standard 52-card deck with shuffling and dealing capabilities
+ * Manages a shoe of one or more standard 52-card decks with shuffling and
+ * dealing capabilities
  */
 
 #ifndef DECK_H
@@ -9,19 +10,53 @@
 #include "Card.h"
 #include <vector>
 #include <random>
+#include <algorithm>
+#include <cstdint>
+#include <span>
 
 class Deck {
 public:
     /**
-     * Constructor - creates a standard 52-card deck
+     * Constructor - creates numDecks standard 52-card decks
      */
-    Deck();
+    explicit Deck(int numDecks = 1);
 
     /**
-     * Shuffle the deck using random number generator
+     * Change the number of decks (takes effect on the next reset)
+     */
+    void setNumDecks(int numDecks);
+
+    /**
+     * Get number of decks in a full shoe
+     */
+    int getNumDecks() const { return numDecks_; }
+
+    /**
+     * Shuffle the deck: an mt19937 seeded from the deck's seed shuffles it
+     * and draws the seed of the next shuffle, so the deck keeps 8 bytes of
+     * generator state instead of the engine's 5000
      */
     void shuffle();
 
+    /**
+     * Shuffle with a caller-supplied uniform random bit generator
+     * (lets statistical tests plug in any engine)
+     */
+    template <typename URBG>
+    void shuffle(URBG& rng) {
+        std::shuffle(cards_.begin(), cards_.end(), rng);
+    }
+
+    /**
+     * Set the seed of the next shuffle (for reproducible deals)
+     */
+    void seed(std::uint64_t seed) { seed_ = seed; }
+
+    /**
+     * Seed of the next shuffle; a deck seeded with it shuffles exactly like this one
+     */
+    std::uint64_t getSeed() const { return seed_; }
+
     /**
      * Deal a single card from the top of the deck
      * @return The dealt card
@@ -38,10 +73,15 @@ public:
     std::vector<Card> dealMultiple(size_t count);
 
     /**
-     * Reset the deck to full 52 cards (unshuffled)
+     * Reset the deck to numDecks x 52 cards (unshuffled)
      */
     void reset();
 
+    /**
+     * Replace the deck with a prearranged order (the last card is dealt first)
+     */
+    void stack(std::span<const Card> cards);
+
     /**
      * Get number of cards remaining in deck
      */
@@ -59,10 +99,11 @@ public:
 
 private:
     std::vector<Card> cards_;
-    std::mt19937 rng_;  // Random number generator
+    std::uint64_t seed_;    // Seeds the next shuffle's generator
+    int numDecks_;
 
     /**
-     * Initialize deck with all 52 cards
+     * Initialize deck with numDecks copies of all 52 cards
      */
     void initializeDeck();
 };
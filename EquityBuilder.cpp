@@ -0,0 +1,268 @@
+/**
+ * EquityBuilder.cpp
+ * Implementation of the equity table builder
+ */
+
+#include "EquityBuilder.h"
+#include "Simulator.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <filesystem>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+    constexpr int DECK_SIZE = 52;
+
+    /**
+     * One player count being built
+     */
+    struct SectionState {
+        EquitySection section{};
+        std::uint64_t limit = 0;            // Profiles to compute
+        std::vector<std::uint16_t> entries;
+    };
+
+    /**
+     * Whether every entry of a block is already known
+     */
+    bool isBlockDone(const SectionState& state, std::uint64_t first, std::uint64_t last) {
+        for (std::uint64_t i = first; i < last; ++i) {
+            if (state.entries[i] == EQUITY_UNKNOWN) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Copy known entries from a checkpoint with matching parameters
+     */
+    std::uint64_t resumeFrom(const std::string& path, std::vector<SectionState>& sections) {
+        if (path.empty() || !std::filesystem::exists(path)) {
+            return 0;
+        }
+
+        EquityTable checkpoint(path);
+        std::uint64_t resumed = 0;
+        for (size_t i = 0; i < checkpoint.getSections().size(); ++i) {
+            const EquitySection& saved = checkpoint.getSections()[i];
+            for (auto& state : sections) {
+                if (state.section.numPlayers != saved.numPlayers ||
+                    state.section.rolloutsPerHand != saved.rolloutsPerHand ||
+                    state.section.entryCount != saved.entryCount) {
+                    continue;
+                }
+                const std::uint16_t* entries = checkpoint.getEntries(i);
+                std::copy(entries, entries + saved.entryCount, state.entries.begin());
+                for (std::uint64_t p = 0; p < state.limit; ++p) {
+                    resumed += entries[p] != EQUITY_UNKNOWN;
+                }
+            }
+        }
+        return resumed;
+    }
+
+    void writeTable(const std::string& path, const std::vector<SectionState>& sections) {
+        std::vector<EquitySection> directory;
+        std::vector<const std::uint16_t*> entries;
+        for (const auto& state : sections) {
+            directory.push_back(state.section);
+            entries.push_back(state.entries.data());
+        }
+        EquityTable::write(path, directory, entries);
+    }
+
+} // namespace
+
+/**
+ * Constructor
+ */
+EquityTableBuilder::EquityTableBuilder(const EquityBuildConfig& config) : config_(config) {
+    if (config_.numThreads == 0) {
+        config_.numThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    config_.blockSize = std::max<std::uint64_t>(1, config_.blockSize);
+    config_.rolloutsPerHand = std::max<std::uint32_t>(1, config_.rolloutsPerHand);
+}
+
+/**
+ * Run all rollouts and write the table
+ */
+EquityBuildStats EquityTableBuilder::build(const ProgressCallback& progress) {
+    auto start = std::chrono::steady_clock::now();
+    EquityBuildStats stats;
+
+    std::vector<SectionState> sections;
+    for (int players : config_.playerCounts) {
+        if (players < 2 || players > 4) {
+            throw std::invalid_argument("Equity tables support 2 to 4 players");
+        }
+        SectionState state;
+        state.section.numPlayers = static_cast<std::uint8_t>(players);
+        state.section.handSize = static_cast<std::uint8_t>(DECK_SIZE / players);
+        state.section.rolloutsPerHand = config_.rolloutsPerHand;
+        state.section.entryCount = HandProfileIndex(state.section.handSize).size();
+        state.limit = config_.maxProfiles == 0 ? state.section.entryCount
+            : std::min(config_.maxProfiles, state.section.entryCount);
+        state.entries.assign(state.section.entryCount, EQUITY_UNKNOWN);
+        sections.push_back(std::move(state));
+    }
+
+    stats.profilesResumed = resumeFrom(config_.checkpointPath, sections);
+
+    // Work units still to do, in section order
+    struct Block {
+        size_t section;
+        std::uint64_t first;
+        std::uint64_t last;
+    };
+    std::vector<Block> blocks;
+    std::uint64_t total = 0;
+    for (size_t s = 0; s < sections.size(); ++s) {
+        total += sections[s].limit;
+        for (std::uint64_t first = 0; first < sections[s].limit; first += config_.blockSize) {
+            std::uint64_t last = std::min(first + config_.blockSize, sections[s].limit);
+            if (!isBlockDone(sections[s], first, last)) {
+                blocks.push_back({ s, first, last });
+            }
+        }
+    }
+
+    std::mutex mutex;
+    std::condition_variable finished;
+    std::atomic<size_t> nextBlock{ 0 };
+    std::atomic<std::uint64_t> rollouts{ 0 };
+    std::uint64_t computed = 0;
+    unsigned running = config_.numThreads;
+
+    auto worker = [&]() {
+        std::vector<std::uint16_t> results;
+        GameState state;
+        int statePlayers = 0;
+
+        while (true) {
+            size_t b = nextBlock.fetch_add(1, std::memory_order_relaxed);
+            if (b >= blocks.size()) {
+                break;
+            }
+            const Block& block = blocks[b];
+            SectionState& section = sections[block.section];
+            HandProfileIndex index(section.section.handSize);
+
+            if (statePlayers != section.section.numPlayers) {
+                statePlayers = section.section.numPlayers;
+                state.initializePlayers(statePlayers, 0);
+            }
+
+            std::seed_seq seq{ static_cast<std::uint32_t>(config_.seed), static_cast<std::uint32_t>(config_.seed >> 32),
+                static_cast<std::uint32_t>(statePlayers), static_cast<std::uint32_t>(block.first / config_.blockSize) };
+            std::mt19937_64 engine(seq);
+
+            results.clear();
+            for (std::uint64_t p = block.first; p < block.last; ++p) {
+                double winRate = rolloutProfile(state, index.unrank(p), config_.rolloutsPerHand,
+                    engine, config_.maxActionsPerGame);
+                results.push_back(static_cast<std::uint16_t>(std::lround(winRate * EQUITY_SCALE)));
+            }
+            rollouts.fetch_add(results.size() * config_.rolloutsPerHand, std::memory_order_relaxed);
+
+            std::lock_guard<std::mutex> lock(mutex);
+            std::copy(results.begin(), results.end(), section.entries.begin() + block.first);
+            computed += results.size();
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--running == 0) {
+            finished.notify_all();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned i = 0; i < config_.numThreads; ++i) {
+        threads.emplace_back(worker);
+    }
+
+    // Checkpoint periodically while the workers run
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        auto interval = std::chrono::duration<double>(config_.checkpointSeconds);
+        while (!finished.wait_for(lock, interval, [&] { return running == 0; })) {
+            if (!config_.checkpointPath.empty()) {
+                writeTable(config_.checkpointPath, sections);
+            }
+            if (progress) {
+                progress(stats.profilesResumed + computed, total);
+            }
+        }
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    writeTable(config_.outputPath, sections);
+    if (!config_.checkpointPath.empty()) {
+        std::filesystem::remove(config_.checkpointPath);
+    }
+    if (progress) {
+        progress(stats.profilesResumed + computed, total);
+    }
+
+    stats.profilesComputed = computed;
+    stats.rollouts = rollouts.load();
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return stats;
+}
+
+/**
+ * Win rate of seat 0 holding a random hand with the given profile
+ */
+double EquityTableBuilder::rolloutProfile(GameState& state, const RankProfile& profile, std::uint32_t rollouts,
+    std::mt19937_64& engine, size_t maxActions) {
+    const int numPlayers = static_cast<int>(state.getNumPlayers());
+    const int dealt = DECK_SIZE / numPlayers * numPlayers;
+
+    std::vector<Card> hand;
+    std::vector<Card> rest;
+    std::vector<Card> deck(DECK_SIZE, Card::fromIndex(0));
+    hand.reserve(DECK_SIZE);
+    rest.reserve(DECK_SIZE);
+
+    std::uint32_t wins = 0;
+    for (std::uint32_t r = 0; r < rollouts; ++r) {
+        // Random suits for each rank of the profile
+        hand.clear();
+        rest.clear();
+        for (int rank = 0; rank < 13; ++rank) {
+            int suits[4] = { 0, 1, 2, 3 };
+            for (int k = 0; k < profile[rank]; ++k) {
+                std::uniform_int_distribution<int> pick(k, 3);
+                std::swap(suits[k], suits[pick(engine)]);
+            }
+            for (int k = 0; k < 4; ++k) {
+                Card card = Card::fromIndex(rank * 4 + suits[k]);
+                (k < profile[rank] ? hand : rest).push_back(card);
+            }
+        }
+        std::shuffle(rest.begin(), rest.end(), engine);
+
+        // GameState::dealCards deals from the back, round-robin from seat 0
+        size_t nextHand = 0;
+        size_t nextRest = 0;
+        for (int i = 0; i < DECK_SIZE; ++i) {
+            bool toSeatZero = i < dealt && i % numPlayers == 0;
+            deck[DECK_SIZE - 1 - i] = toSeatZero ? hand[nextHand++] : rest[nextRest++];
+        }
+
+        state.startNewGame(deck);
+        GameRecord record = SimulationRunner::playDealtGame(state, 0, maxActions);
+        wins += record.winner == 0;
+    }
+
+    return static_cast<double>(wins) / rollouts;
+}
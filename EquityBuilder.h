@@ -0,0 +1,78 @@
+/**
+ * EquityBuilder.hpp
+ * Parallel rollout precomputation of the starting-hand equity table
+ *
+ * Each profile is evaluated by dealing seat 0 a random suit assignment of
+ * the profile, dealing the remaining cards at random through the normal
+ * GameState deal, and playing the game out with bots in every seat.
+ *
+ * Work is split into fixed blocks of profiles; every block draws from its
+ * own engine seeded by (seed, players, block), so results do not depend on
+ * the thread count or on resuming. Progress is checkpointed as a partial
+ * table file (uncomputed entries are EQUITY_UNKNOWN) and blocks that are
+ * complete in the checkpoint are skipped on restart.
+ */
+
+#ifndef EQUITYBUILDER_H
+#define EQUITYBUILDER_H
+
+#include "EquityTable.h"
+#include "GameState.h"
+#include <functional>
+#include <random>
+
+/**
+ * Build settings
+ */
+struct EquityBuildConfig {
+    std::vector<int> playerCounts = { 2, 3, 4 };
+    std::uint32_t rolloutsPerHand = 200;
+    unsigned numThreads = 0;                // 0 = hardware concurrency
+    std::uint64_t seed = 1;
+    std::uint64_t blockSize = 1024;         // Profiles per work unit
+    std::uint64_t maxProfiles = 0;          // Per player count, 0 = all
+    std::string outputPath;
+    std::string checkpointPath;             // Empty = no checkpoints
+    double checkpointSeconds = 60.0;
+    size_t maxActionsPerGame = 2000;
+};
+
+/**
+ * Build results
+ */
+struct EquityBuildStats {
+    std::uint64_t profilesComputed = 0;
+    std::uint64_t profilesResumed = 0;      // Taken from the checkpoint
+    std::uint64_t rollouts = 0;
+    double seconds = 0.0;
+};
+
+/**
+ * EquityTableBuilder class
+ */
+class EquityTableBuilder {
+public:
+    /**
+     * Called from the building thread after every checkpoint interval
+     */
+    using ProgressCallback = std::function<void(std::uint64_t done, std::uint64_t total)>;
+
+    explicit EquityTableBuilder(const EquityBuildConfig& config);
+
+    /**
+     * Run all rollouts and write the table
+     * @throws std::runtime_error on I/O failure
+     */
+    EquityBuildStats build(const ProgressCallback& progress = {});
+
+    /**
+     * Win rate of seat 0 holding a random hand with the given profile
+     */
+    static double rolloutProfile(GameState& state, const RankProfile& profile, std::uint32_t rollouts,
+        std::mt19937_64& engine, size_t maxActions = 2000);
+
+private:
+    EquityBuildConfig config_;
+};
+
+#endif // EQUITYBUILDER_HPP
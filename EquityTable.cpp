@@ -0,0 +1,210 @@
+/**
+ * EquityTable.cpp
+ * Implementation of the equity table file and profile index
+ */
+
+#include "EquityTable.h"
+#include <bit>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+static_assert(std::endian::native == std::endian::little,
+    "Equity tables are stored little-endian");
+
+namespace {
+
+    constexpr char EQUITY_MAGIC[8] = { 'T', 'H', 'E', 'Q', 'T', 'B', '0', '1' };
+    constexpr std::uint32_t EQUITY_VERSION = 1;
+    constexpr std::uint64_t ENTRY_ALIGNMENT = 64;
+
+    constexpr int NUM_RANKS = 13;
+    constexpr int CARDS_PER_RANK = 4;
+
+} // namespace
+
+/**
+ * Constructor - count completions of every suffix of the profile
+ */
+HandProfileIndex::HandProfileIndex(int handSize) : handSize_(handSize) {
+    if (handSize < 0 || handSize > 52) {
+        throw std::invalid_argument("Hand size must be between 0 and 52");
+    }
+
+    std::memset(ways_, 0, sizeof(ways_));
+    ways_[NUM_RANKS][0] = 1;
+    for (int r = NUM_RANKS - 1; r >= 0; --r) {
+        for (int s = 0; s <= 52; ++s) {
+            for (int k = 0; k <= CARDS_PER_RANK && k <= s; ++k) {
+                ways_[r][s] += ways_[r + 1][s - k];
+            }
+        }
+    }
+}
+
+/**
+ * Lexicographic rank of a profile
+ */
+std::uint64_t HandProfileIndex::rank(const RankProfile& profile) const {
+    std::uint64_t index = 0;
+    int remaining = handSize_;
+    for (int r = 0; r < NUM_RANKS; ++r) {
+        for (int k = 0; k < profile[r]; ++k) {
+            index += ways_[r + 1][remaining - k];
+        }
+        remaining -= profile[r];
+    }
+    return index;
+}
+
+/**
+ * Profile with a given rank
+ */
+RankProfile HandProfileIndex::unrank(std::uint64_t index) const {
+    RankProfile profile{};
+    int remaining = handSize_;
+    for (int r = 0; r < NUM_RANKS; ++r) {
+        int k = 0;
+        while (k < CARDS_PER_RANK && k < remaining && index >= ways_[r + 1][remaining - k]) {
+            index -= ways_[r + 1][remaining - k];
+            ++k;
+        }
+        profile[r] = static_cast<std::uint8_t>(k);
+        remaining -= k;
+    }
+    return profile;
+}
+
+/**
+ * Profile of a hand
+ */
+RankProfile HandProfileIndex::profileOf(std::span<const Card> hand) {
+    RankProfile profile{};
+    for (const auto& card : hand) {
+        ++profile[card.getIndex() / CARDS_PER_RANK];
+    }
+    return profile;
+}
+
+/**
+ * Map a table file and validate its directory
+ */
+EquityTable::EquityTable(const std::string& path) : file_(path) {
+    if (file_.size() < sizeof(EquityFileHeader)) {
+        throw std::runtime_error("Equity table too small: " + path);
+    }
+
+    EquityFileHeader header;
+    std::memcpy(&header, file_.data(), sizeof(header));
+    if (std::memcmp(header.magic, EQUITY_MAGIC, sizeof(EQUITY_MAGIC)) != 0 || header.version != EQUITY_VERSION) {
+        throw std::runtime_error("Not an equity table: " + path);
+    }
+
+    size_t directoryEnd = sizeof(header) + static_cast<size_t>(header.sectionCount) * sizeof(EquitySection);
+    if (file_.size() < directoryEnd) {
+        throw std::runtime_error("Truncated equity table: " + path);
+    }
+
+    sections_.resize(header.sectionCount);
+    if (header.sectionCount > 0) {
+        std::memcpy(sections_.data(), file_.data() + sizeof(header), header.sectionCount * sizeof(EquitySection));
+    }
+
+    for (const auto& section : sections_) {
+        auto index = std::make_unique<HandProfileIndex>(section.handSize);
+        if (section.entryCount != index->size() ||
+            section.offset % alignof(std::uint16_t) != 0 ||
+            section.offset + section.entryCount * sizeof(std::uint16_t) > file_.size()) {
+            throw std::runtime_error("Corrupt equity table section: " + path);
+        }
+        indexes_.push_back(std::move(index));
+    }
+}
+
+/**
+ * Win probability of a starting hand
+ */
+std::optional<double> EquityTable::lookup(std::span<const Card> hand, int numPlayers) const {
+    for (size_t i = 0; i < sections_.size(); ++i) {
+        if (sections_[i].numPlayers != numPlayers) {
+            continue;
+        }
+        if (static_cast<int>(hand.size()) != sections_[i].handSize) {
+            return std::nullopt;
+        }
+
+        std::uint16_t value = getEntries(i)[indexes_[i]->rank(HandProfileIndex::profileOf(hand))];
+        if (value == EQUITY_UNKNOWN) {
+            return std::nullopt;
+        }
+        return value / EQUITY_SCALE;
+    }
+    return std::nullopt;
+}
+
+/**
+ * Raw entries of a section
+ */
+const std::uint16_t* EquityTable::getEntries(size_t section) const {
+    return reinterpret_cast<const std::uint16_t*>(file_.data() + sections_.at(section).offset);
+}
+
+/**
+ * Write a table file
+ */
+void EquityTable::write(const std::string& path, const std::vector<EquitySection>& sections,
+    const std::vector<const std::uint16_t*>& entries) {
+    if (sections.size() != entries.size()) {
+        throw std::invalid_argument("Every equity section needs its entries");
+    }
+
+    EquityFileHeader header{};
+    std::memcpy(header.magic, EQUITY_MAGIC, sizeof(EQUITY_MAGIC));
+    header.version = EQUITY_VERSION;
+    header.sectionCount = static_cast<std::uint32_t>(sections.size());
+
+    // Lay out entry arrays after the directory
+    std::vector<EquitySection> directory = sections;
+    std::uint64_t position = sizeof(header) + directory.size() * sizeof(EquitySection);
+    for (auto& section : directory) {
+        position = (position + ENTRY_ALIGNMENT - 1) / ENTRY_ALIGNMENT * ENTRY_ALIGNMENT;
+        section.offset = position;
+        position += section.entryCount * sizeof(std::uint16_t);
+    }
+
+    // Write beside the target and rename, so readers never see a partial file
+    std::string temporary = path + ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            throw std::runtime_error("Cannot create equity table: " + temporary);
+        }
+
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(directory.data()),
+            static_cast<std::streamsize>(directory.size() * sizeof(EquitySection)));
+        std::uint64_t written = sizeof(header) + directory.size() * sizeof(EquitySection);
+
+        static const char padding[ENTRY_ALIGNMENT] = {};
+        for (size_t i = 0; i < directory.size(); ++i) {
+            out.write(padding, static_cast<std::streamsize>(directory[i].offset - written));
+            out.write(reinterpret_cast<const char*>(entries[i]),
+                static_cast<std::streamsize>(directory[i].entryCount * sizeof(std::uint16_t)));
+            written = directory[i].offset + directory[i].entryCount * sizeof(std::uint16_t);
+        }
+
+        out.flush();
+        if (!out) {
+            throw std::runtime_error("Write failed: " + temporary);
+        }
+    }
+
+#ifdef _WIN32
+    // rename does not replace an existing file on Windows
+    std::remove(path.c_str());
+#endif
+    if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+        throw std::runtime_error("Cannot replace equity table: " + path);
+    }
+}
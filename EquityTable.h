@@ -0,0 +1,128 @@
+/**
+ * EquityTable.hpp
+ * Precomputed starting-hand win probabilities
+ *
+ * Hands are canonicalized to their rank profile (how many cards of each of
+ * the 13 ranks). Suits break ties in this ruleset, so suit permutations are
+ * not true symmetries; the profile averages over them instead.
+ *
+ * File layout (little-endian):
+ *   [EquityFileHeader][EquitySection x sectionCount][entries...]
+ * Each section covers one player count and holds one u16 per profile,
+ * indexed by HandProfileIndex::rank: win rate scaled to 0..65534, or
+ * EQUITY_UNKNOWN if the profile has not been computed yet.
+ */
+
+#ifndef EQUITYTABLE_H
+#define EQUITYTABLE_H
+
+#include "Card.h"
+#include "MappedFile.h"
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+using RankProfile = std::array<std::uint8_t, 13>;
+
+constexpr std::uint16_t EQUITY_UNKNOWN = 0xFFFF;
+constexpr double EQUITY_SCALE = 65534.0;
+
+/**
+ * Perfect index of rank profiles with a fixed hand size
+ */
+class HandProfileIndex {
+public:
+    explicit HandProfileIndex(int handSize);
+
+    /**
+     * Number of distinct profiles
+     */
+    std::uint64_t size() const { return ways_[0][handSize_]; }
+
+    int getHandSize() const { return handSize_; }
+
+    /**
+     * Lexicographic rank of a profile (0 .. size()-1)
+     */
+    std::uint64_t rank(const RankProfile& profile) const;
+
+    /**
+     * Profile with a given rank
+     */
+    RankProfile unrank(std::uint64_t index) const;
+
+    /**
+     * Profile of a hand
+     */
+    static RankProfile profileOf(std::span<const Card> hand);
+
+private:
+    int handSize_;
+    std::uint64_t ways_[14][53];    // Ways to fill ranks r..12 with s cards
+};
+
+/**
+ * File header (16 bytes)
+ */
+struct EquityFileHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t sectionCount;
+};
+
+/**
+ * Section directory entry (24 bytes)
+ */
+struct EquitySection {
+    std::uint8_t numPlayers;
+    std::uint8_t handSize;
+    std::uint16_t reserved;
+    std::uint32_t rolloutsPerHand;
+    std::uint64_t entryCount;
+    std::uint64_t offset;
+};
+
+static_assert(sizeof(EquityFileHeader) == 16, "EquityFileHeader must be 16 bytes");
+static_assert(sizeof(EquitySection) == 24, "EquitySection must be 24 bytes");
+
+/**
+ * Memory-mapped, read-only equity table
+ */
+class EquityTable {
+public:
+    /**
+     * Map a table file
+     * @throws std::runtime_error on a missing or malformed file
+     */
+    explicit EquityTable(const std::string& path);
+
+    /**
+     * Win probability of a starting hand at a table of numPlayers
+     * @return nullopt if the table has no data for it
+     */
+    std::optional<double> lookup(std::span<const Card> hand, int numPlayers) const;
+
+    /**
+     * Raw entries of a section (for merging and checkpoints)
+     */
+    const std::vector<EquitySection>& getSections() const { return sections_; }
+    const std::uint16_t* getEntries(size_t section) const;
+
+    /**
+     * Write a table file (via a temporary file, renamed into place)
+     * @throws std::runtime_error on I/O failure
+     */
+    static void write(const std::string& path, const std::vector<EquitySection>& sections,
+        const std::vector<const std::uint16_t*>& entries);
+
+private:
+    MappedFile file_;
+    std::vector<EquitySection> sections_;
+    std::vector<std::unique_ptr<HandProfileIndex>> indexes_;
+};
+
+#endif // EQUITYTABLE_HPP
@@ -0,0 +1,122 @@
+/**
+ * GameClock.cpp
+ * Implementation of SystemClock and VirtualClock
+ */
+
+#include "GameClock.h"
+#include <stdexcept>
+#include <thread>
+
+/**
+ * The process-wide real clock
+ */
+GameClock& GameClock::system() {
+    static SystemClock clock;
+    return clock;
+}
+
+void SystemClock::sleepUntil(time_point when) {
+    std::this_thread::sleep_until(when);
+}
+
+/**
+ * Constructor
+ */
+VirtualClock::VirtualClock(time_point start) : now_(start.time_since_epoch().count()) {
+}
+
+/**
+ * Call back when the clock reaches when
+ */
+VirtualClock::TimerId VirtualClock::schedule(time_point when, Callback callback) {
+    if (!callback) {
+        throw std::invalid_argument("Cannot schedule an empty callback");
+    }
+    TimerId id = nextId_++;
+    callbacks_.emplace(id, std::move(callback));
+    timers_.push(Timer{ when, id });
+    return id;
+}
+
+/**
+ * Drop a timer that has not run
+ */
+bool VirtualClock::cancel(TimerId id) {
+    return callbacks_.erase(id) != 0;
+}
+
+/**
+ * Move the clock to the earliest timer and run it
+ */
+bool VirtualClock::runNext() {
+    Timer timer;
+    if (!popDue(time_point::max(), timer)) {
+        return false;
+    }
+    fire(timer);
+    return true;
+}
+
+/**
+ * Run the timers due by end in order, then move the clock to end
+ */
+size_t VirtualClock::runUntil(time_point end) {
+    size_t ran = 0;
+    Timer timer;
+    while (popDue(end, timer)) {
+        fire(timer);
+        ++ran;
+    }
+    moveTo(end);
+    return ran;
+}
+
+/**
+ * Move the clock without running anything
+ */
+void VirtualClock::advance(duration length) {
+    if (length < duration::zero()) {
+        throw std::invalid_argument("A virtual clock cannot move backwards");
+    }
+    moveTo(now() + length);
+}
+
+/**
+ * Earliest pending timer at or before end, skipping cancelled ones
+ */
+bool VirtualClock::popDue(time_point end, Timer& timer) {
+    while (!timers_.empty()) {
+        if (callbacks_.count(timers_.top().id) == 0) {
+            timers_.pop();      // Cancelled
+            continue;
+        }
+        if (timers_.top().when > end) {
+            return false;
+        }
+        timer = timers_.top();
+        timers_.pop();
+        return true;
+    }
+    return false;
+}
+
+/**
+ * Move the clock to a popped timer and run it
+ */
+void VirtualClock::fire(const Timer& timer) {
+    moveTo(timer.when);
+    auto it = callbacks_.find(timer.id);
+    Callback callback = std::move(it->second);
+    callbacks_.erase(it);
+    ++fired_;
+    callback();     // May schedule or cancel timers
+}
+
+/**
+ * Move forward to when; a timer scheduled in the past runs at the current time
+ */
+void VirtualClock::moveTo(time_point when) {
+    if (when > now()) {
+        now_.store(when.time_since_epoch().count(), std::memory_order_release);
+    }
+}
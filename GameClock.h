@@ -0,0 +1,151 @@
+/**
+ * GameClock.hpp
+ * The time game logic runs on: the real clock, or a virtual one
+ *
+ * Turn deadlines, bot pacing and idle timeouts read the time and wait
+ * through a GameClock instead of std::chrono and std::this_thread, so the
+ * same code runs in real time or in simulated time. Both clocks hand out
+ * steady_clock time points, so the time_point parameters already taken by
+ * TableStore, BotPool and the overload controller accept either.
+ *
+ * VirtualClock only moves when told to. It also keeps timers: callbacks
+ * run when the clock reaches their time, in time order (ties in the order
+ * they were scheduled). A whole server can then run as a discrete-event
+ * simulation on one thread, jumping from one event to the next, and the
+ * same seed gives the same run at whatever speed the machine allows.
+ * Measurements of real work (LatencyTracker, TraceRecorder, benchmark
+ * timings) stay on steady_clock.
+ */
+
+#ifndef GAMECLOCK_H
+#define GAMECLOCK_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * GameClock class - the interface
+ */
+class GameClock {
+public:
+    using duration = std::chrono::steady_clock::duration;
+    using time_point = std::chrono::steady_clock::time_point;
+
+    virtual ~GameClock() = default;
+
+    virtual time_point now() const = 0;
+
+    /**
+     * Return once the clock has reached when
+     */
+    virtual void sleepUntil(time_point when) = 0;
+
+    void sleepFor(duration length) { sleepUntil(now() + length); }
+
+    /**
+     * The process-wide real clock
+     */
+    static GameClock& system();
+};
+
+/**
+ * SystemClock class - steady_clock and a sleeping thread
+ */
+class SystemClock : public GameClock {
+public:
+    time_point now() const override { return std::chrono::steady_clock::now(); }
+    void sleepUntil(time_point when) override;
+};
+
+/**
+ * VirtualClock class - simulated time with timers
+ *
+ * now() may be read from any thread; everything else belongs to the thread
+ * driving the simulation.
+ */
+class VirtualClock : public GameClock {
+public:
+    using TimerId = std::uint64_t;
+    using Callback = std::function<void()>;
+
+    /**
+     * Constructor
+     * @param start Time the clock starts at
+     */
+    explicit VirtualClock(time_point start = time_point());
+
+    VirtualClock(const VirtualClock&) = delete;
+    VirtualClock& operator=(const VirtualClock&) = delete;
+
+    time_point now() const override { return time_point(duration(now_.load(std::memory_order_acquire))); }
+
+    /**
+     * Run the timers due by when, then move the clock there
+     */
+    void sleepUntil(time_point when) override { runUntil(when); }
+
+    /**
+     * Call back when the clock reaches when (at once on the next run if it
+     * already has)
+     * @return Id for cancel
+     */
+    TimerId schedule(time_point when, Callback callback);
+    TimerId scheduleAfter(duration delay, Callback callback) { return schedule(now() + delay, std::move(callback)); }
+
+    /**
+     * Drop a timer that has not run
+     * @return false if it already ran, was cancelled, or never existed
+     */
+    bool cancel(TimerId id);
+
+    /**
+     * Move the clock to the earliest timer and run it
+     * @return false if no timer is pending
+     */
+    bool runNext();
+
+    /**
+     * Run the timers due by end in order, then move the clock to end.
+     * Timers the callbacks schedule before end run too.
+     * @return Number of timers run
+     */
+    size_t runUntil(time_point end);
+
+    /**
+     * Move the clock without running anything; due timers run on the next run
+     */
+    void advance(duration length);
+
+    size_t getPendingCount() const { return callbacks_.size(); }
+    std::uint64_t getFiredCount() const { return fired_; }
+
+private:
+    struct Timer {
+        time_point when;
+        TimerId id;
+
+        bool operator>(const Timer& other) const {
+            return when != other.when ? when > other.when : id > other.id;
+        }
+    };
+
+    std::atomic<duration::rep> now_;
+    std::priority_queue<Timer, std::vector<Timer>, std::greater<Timer>> timers_;
+    std::unordered_map<TimerId, Callback> callbacks_;      // Pending timers; cancelled ones are left in the heap
+    TimerId nextId_ = 1;
+    std::uint64_t fired_ = 0;
+
+    /**
+     * Earliest pending timer at or before end, skipping cancelled ones
+     */
+    bool popDue(time_point end, Timer& timer);
+    void fire(const Timer& timer);
+    void moveTo(time_point when);
+};
+
+#endif // GAMECLOCK_HPP
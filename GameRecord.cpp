@@ -0,0 +1,75 @@
+/**
+ * GameRecord.cpp
+ * Implementation of GameRecorder
+ */
+
+#include "GameRecord.h"
+#include "GameState.h"
+#include "GameRules.h"
+#include "PositionHash.h"
+#include <utility>
+
+ /**
+  * Start recording a freshly dealt game
+  */
+void GameRecorder::begin(std::uint64_t gameId, const GameState& state) {
+    record_ = GameRecord();
+    record_.gameId = gameId;
+
+    const SeatTable& seats = state.getSeats();
+    for (size_t seat = 0; seat < seats.size(); ++seat) {
+        record_.playerNames.push_back(seats.getName(seat));
+        record_.playerTypes.push_back(seats.getType(seat));
+        CardSet dealt = seats.getHand(seat);
+        record_.dealtHands.push_back(dealt.plane(0));
+        record_.dealtCopies.push_back(dealt.plane(1));
+    }
+}
+
+/**
+ * Note the position the next action is taken in
+ */
+void GameRecorder::recordPosition(const GameState& state) {
+    position_ = PositionHash::hash(state);
+}
+
+/**
+ * Record a play by a seat
+ */
+void GameRecorder::recordPlay(size_t seat, std::span<const Card> cards, size_t cardsRemaining) {
+    ActionRecord action;
+    action.seat = static_cast<std::uint8_t>(seat);
+    action.type = ActionType::Play;
+    action.playKey = GameRules::getPlayKey(cards);
+    CardSet played(cards);
+    action.cards = played.plane(0);
+    action.cardsCopies = played.plane(1);
+    action.cardsRemaining = static_cast<std::uint8_t>(cardsRemaining);
+    action.position = position_;
+    record_.actions.push_back(action);
+}
+
+/**
+ * Record a pass by a seat
+ */
+void GameRecorder::recordPass(size_t seat, size_t cardsRemaining) {
+    ActionRecord action;
+    action.seat = static_cast<std::uint8_t>(seat);
+    action.type = ActionType::Pass;
+    action.cardsRemaining = static_cast<std::uint8_t>(cardsRemaining);
+    action.position = position_;
+    record_.actions.push_back(action);
+}
+
+/**
+ * Finish the game and hand over the record
+ */
+GameRecord GameRecorder::finish(const GameState& state, int winner) {
+    record_.winner = winner;
+    record_.cardsLeft.clear();
+    const SeatTable& seats = state.getSeats();
+    for (size_t seat = 0; seat < seats.size(); ++seat) {
+        record_.cardsLeft.push_back(static_cast<std::uint8_t>(seats.getCardCount(seat)));
+    }
+    return std::move(record_);
+}
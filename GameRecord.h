@@ -0,0 +1,93 @@
+/**
+ * GameRecord.hpp
+ * Compact history of a single game (deal, actions, winner)
+ */
+
+#ifndef GAMERECORD_H
+#define GAMERECORD_H
+
+#include "CardSet.h"
+#include "Player.h"
+#include <span>
+#include <vector>
+#include <string>
+#include <cstdint>
+
+class GameState;
+
+/**
+ * Action type
+ */
+enum class ActionType : std::uint8_t {
+    Play = 0,
+    Pass = 1
+};
+
+/**
+ * One recorded action
+ */
+struct ActionRecord {
+    std::uint8_t seat = 0;
+    ActionType type = ActionType::Pass;
+    std::uint16_t playKey = 0;          // GameRules::getPlayKey, 0 for passes
+    CardMask cards = 0;                 // Cards played
+    CardMask cardsCopies = 0;           // Cards played twice (two-deck tables)
+    std::uint8_t cardsRemaining = 0;    // Cards left in the seat's hand after the action
+    std::uint64_t position = 0;         // PositionHash of the position the action was taken in
+};
+
+/**
+ * One recorded game
+ */
+struct GameRecord {
+    std::uint64_t gameId = 0;
+    std::vector<std::string> playerNames;
+    std::vector<PlayerType> playerTypes;
+    std::vector<CardMask> dealtHands;   // Hand of each seat right after the deal
+    std::vector<CardMask> dealtCopies;  // Cards dealt twice to a seat (two-deck tables)
+    std::vector<std::uint8_t> cardsLeft; // Cards of each seat when the game ended
+    std::vector<ActionRecord> actions;
+    int winner = -1;                    // Seat index, -1 if unfinished
+};
+
+/**
+ * Builds a GameRecord while a game is being played
+ */
+class GameRecorder {
+public:
+    /**
+     * Start recording a freshly dealt game
+     */
+    void begin(std::uint64_t gameId, const GameState& state);
+
+    /**
+     * Note the position the next action is taken in
+     */
+    void recordPosition(const GameState& state);
+
+    /**
+     * Record a play by a seat
+     */
+    void recordPlay(size_t seat, std::span<const Card> cards, size_t cardsRemaining);
+
+    /**
+     * Record a pass by a seat
+     */
+    void recordPass(size_t seat, size_t cardsRemaining);
+
+    /**
+     * Finish the game and hand over the record
+     */
+    GameRecord finish(const GameState& state, int winner);
+
+    /**
+     * Access the record in progress
+     */
+    const GameRecord& current() const { return record_; }
+
+private:
+    GameRecord record_;
+    std::uint64_t position_ = 0;
+};
+
+#endif // GAMERECORD_HPP
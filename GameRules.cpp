@@ -5,14 +5,65 @@
 
 #include "GameRules.h"
 #include <algorithm>
+#include <array>
+#include <bit>
 #include <set>
 
+namespace {
+
+    /**
+     * Dense card index (Card::getIndex, inlined for the classifiers)
+     */
+    inline int denseIndex(const Card& card) {
+        return (static_cast<int>(card.getRank()) - static_cast<int>(Rank::Three)) * 4
+            + static_cast<int>(card.getSuit());
+    }
+
+    /**
+     * Play key fields, or 0 when valid is false
+     */
+    inline std::uint16_t makeKey(bool valid, PlayType type, int fiveRank, int highIndex) {
+        return static_cast<std::uint16_t>(static_cast<int>(valid)
+            * ((static_cast<int>(type) << 9) | (fiveRank << 6) | highIndex));
+    }
+
+    /**
+     * Five-card rank (getFiveCardRank) by shape bits:
+     * straight (1), flush (2), four of a kind (4), full house (8).
+     * Strongest shape wins, like determineFiveCardType's check order.
+     */
+    constexpr std::array<std::uint8_t, 16> FIVE_CARD_RANKS = [] {
+        std::array<std::uint8_t, 16> ranks{};
+        for (unsigned shape = 0; shape < ranks.size(); ++shape) {
+            bool straight = shape & 1u;
+            bool flush = shape & 2u;
+            ranks[shape] = straight && flush ? 5
+                : (shape & 4u) ? 4
+                : (shape & 8u) ? 3
+                : flush ? 2
+                : straight ? 1
+                : 0;
+        }
+        return ranks;
+    }();
+
+    /**
+     * Five-card type by five-card rank (3-bit key field)
+     */
+    constexpr std::array<FiveCardType, 8> FIVE_CARD_TYPES = {
+        FiveCardType::None, FiveCardType::Straight, FiveCardType::Flush,
+        FiveCardType::FullHouse, FiveCardType::FourOfAKind, FiveCardType::StraightFlush,
+        FiveCardType::None, FiveCardType::None
+    };
+
+} // namespace
+
  /**
   * Validate if a play is legal
   */
 PlayValidation GameRules::validatePlay(
-    const std::vector<Card>& cards,
-    const std::vector<Card>& lastPlay,
+    std::span<const Card> cards,
+    std::span<const Card> lastPlay,
     bool isFirstPlay,
     bool mustIncludeThreeOfDiamonds
 ) {
@@ -30,22 +81,14 @@ PlayValidation GameRules::validatePlay(
         return result;
     }
 
-    // Determine play type
-    result.playType = determinePlayType(cards);
-
-    if (result.playType == PlayType::Invalid) {
+    // Classify once; the key carries the play type, five-card type and highest card
+    std::uint16_t key = getPlayKey(cards);
+    if (key == 0) {
         result.errorMessage = "Invalid card combination";
         return result;
     }
-
-    // If it's a five-card play, determine the specific type
-    if (result.playType == PlayType::FiveCard) {
-        result.fiveCardType = determineFiveCardType(cards);
-        if (result.fiveCardType == FiveCardType::None) {
-            result.errorMessage = "Invalid five-card combination";
-            return result;
-        }
-    }
+    result.playType = getPlayTypeFromKey(key);
+    result.fiveCardType = getFiveCardTypeFromKey(key);
 
     // If this is the first play or last play was cleared, any valid play is allowed
     if (isFirstPlay || lastPlay.empty()) {
@@ -60,7 +103,7 @@ PlayValidation GameRules::validatePlay(
     }
 
     // Check if this play beats the last play
-    if (!doesPlayBeat(cards, lastPlay)) {
+    if (!playKeyBeats(key, getPlayKey(lastPlay))) {
         result.errorMessage = "Play does not beat the previous play";
         return result;
     }
@@ -73,8 +116,8 @@ PlayValidation GameRules::validatePlay(
  * Check if a play beats the previous play
  */
 bool GameRules::doesPlayBeat(
-    const std::vector<Card>& newPlay,
-    const std::vector<Card>& lastPlay
+    std::span<const Card> newPlay,
+    std::span<const Card> lastPlay
 ) {
     if (lastPlay.empty()) {
         return true;  // Any play beats an empty play
@@ -84,30 +127,15 @@ bool GameRules::doesPlayBeat(
         return false;  // Must be same size
     }
 
-    PlayType playType = determinePlayType(newPlay);
-
-    switch (playType) {
-    case PlayType::Single:
-        return singleBeats(newPlay[0], lastPlay[0]);
-
-    case PlayType::Pair:
-        return pairBeats(newPlay, lastPlay);
-
-    case PlayType::Triple:
-        return tripleBeats(newPlay, lastPlay);
-
-    case PlayType::FiveCard:
-        return fiveCardBeats(newPlay, lastPlay);
-
-    default:
-        return false;
-    }
+    // Same size, so both keys (when valid) have the same play type
+    std::uint16_t newKey = getPlayKey(newPlay);
+    return newKey != 0 && playKeyBeats(newKey, getPlayKey(lastPlay));
 }
 
 /**
  * Determine play type
  */
-PlayType GameRules::determinePlayType(const std::vector<Card>& cards) {
+PlayType GameRules::determinePlayType(std::span<const Card> cards) {
     size_t size = cards.size();
 
     if (size == 1) {
@@ -132,7 +160,7 @@ PlayType GameRules::determinePlayType(const std::vector<Card>& cards) {
 /**
  * Determine five-card combination type
  */
-FiveCardType GameRules::determineFiveCardType(const std::vector<Card>& cards) {
+FiveCardType GameRules::determineFiveCardType(std::span<const Card> cards) {
     if (cards.size() != 5) {
         return FiveCardType::None;
     }
@@ -150,21 +178,21 @@ FiveCardType GameRules::determineFiveCardType(const std::vector<Card>& cards) {
 /**
  * Check if cards form a valid single
  */
-bool GameRules::isSingle(const std::vector<Card>& cards) {
+bool GameRules::isSingle(std::span<const Card> cards) {
     return cards.size() == 1;
 }
 
 /**
  * Check if cards form a valid pair
  */
-bool GameRules::isPair(const std::vector<Card>& cards) {
+bool GameRules::isPair(std::span<const Card> cards) {
     return cards.size() == 2 && cards[0].getRank() == cards[1].getRank();
 }
 
 /**
  * Check if cards form a valid triple
  */
-bool GameRules::isTriple(const std::vector<Card>& cards) {
+bool GameRules::isTriple(std::span<const Card> cards) {
     return cards.size() == 3 &&
         cards[0].getRank() == cards[1].getRank() &&
         cards[1].getRank() == cards[2].getRank();
@@ -173,7 +201,7 @@ bool GameRules::isTriple(const std::vector<Card>& cards) {
 /**
  * Check if cards form a valid straight
  */
-bool GameRules::isStraight(const std::vector<Card>& cards) {
+bool GameRules::isStraight(std::span<const Card> cards) {
     if (cards.size() != 5) return false;
 
     auto sorted = sortByRank(cards);
@@ -194,7 +222,7 @@ bool GameRules::isStraight(const std::vector<Card>& cards) {
 /**
  * Check if cards form a valid flush
  */
-bool GameRules::isFlush(const std::vector<Card>& cards) {
+bool GameRules::isFlush(std::span<const Card> cards) {
     if (cards.size() != 5) return false;
 
     Suit suit = cards[0].getSuit();
@@ -210,17 +238,19 @@ bool GameRules::isFlush(const std::vector<Card>& cards) {
 /**
  * Check if cards form a valid full house
  */
-bool GameRules::isFullHouse(const std::vector<Card>& cards) {
+bool GameRules::isFullHouse(std::span<const Card> cards) {
     if (cards.size() != 5) return false;
 
     auto sorted = sortByRank(cards);
 
-    // Pattern: AAA BB or AA BBB
+    // Pattern: AAA BB or AA BBB (A != B; five of one rank needs two decks and is not a hand)
     bool pattern1 = (sorted[0].getRank() == sorted[1].getRank() &&
         sorted[1].getRank() == sorted[2].getRank() &&
+        sorted[2].getRank() != sorted[3].getRank() &&
         sorted[3].getRank() == sorted[4].getRank());
 
     bool pattern2 = (sorted[0].getRank() == sorted[1].getRank() &&
+        sorted[1].getRank() != sorted[2].getRank() &&
         sorted[2].getRank() == sorted[3].getRank() &&
         sorted[3].getRank() == sorted[4].getRank());
 
@@ -230,17 +260,19 @@ bool GameRules::isFullHouse(const std::vector<Card>& cards) {
 /**
  * Check if cards form four of a kind
  */
-bool GameRules::isFourOfAKind(const std::vector<Card>& cards) {
+bool GameRules::isFourOfAKind(std::span<const Card> cards) {
     if (cards.size() != 5) return false;
 
     auto sorted = sortByRank(cards);
 
-    // Pattern: AAAA B or A BBBB
+    // Pattern: AAAA B or A BBBB (A != B)
     bool pattern1 = (sorted[0].getRank() == sorted[1].getRank() &&
         sorted[1].getRank() == sorted[2].getRank() &&
-        sorted[2].getRank() == sorted[3].getRank());
+        sorted[2].getRank() == sorted[3].getRank() &&
+        sorted[3].getRank() != sorted[4].getRank());
 
-    bool pattern2 = (sorted[1].getRank() == sorted[2].getRank() &&
+    bool pattern2 = (sorted[0].getRank() != sorted[1].getRank() &&
+        sorted[1].getRank() == sorted[2].getRank() &&
         sorted[2].getRank() == sorted[3].getRank() &&
         sorted[3].getRank() == sorted[4].getRank());
 
@@ -250,7 +282,7 @@ bool GameRules::isFourOfAKind(const std::vector<Card>& cards) {
 /**
  * Check if cards form a straight flush
  */
-bool GameRules::isStraightFlush(const std::vector<Card>& cards) {
+bool GameRules::isStraightFlush(std::span<const Card> cards) {
     return isStraight(cards) && isFlush(cards);
 }
 
@@ -264,7 +296,7 @@ bool GameRules::singleBeats(const Card& newCard, const Card& lastCard) {
 /**
  * Compare two pairs
  */
-bool GameRules::pairBeats(const std::vector<Card>& newPair, const std::vector<Card>& lastPair) {
+bool GameRules::pairBeats(std::span<const Card> newPair, std::span<const Card> lastPair) {
     if (newPair.size() != 2 || lastPair.size() != 2) return false;
 
     Card newHigh = getHighestCard(newPair);
@@ -276,7 +308,7 @@ bool GameRules::pairBeats(const std::vector<Card>& newPair, const std::vector<Ca
 /**
  * Compare two triples
  */
-bool GameRules::tripleBeats(const std::vector<Card>& newTriple, const std::vector<Card>& lastTriple) {
+bool GameRules::tripleBeats(std::span<const Card> newTriple, std::span<const Card> lastTriple) {
     if (newTriple.size() != 3 || lastTriple.size() != 3) return false;
 
     Card newHigh = getHighestCard(newTriple);
@@ -288,7 +320,7 @@ bool GameRules::tripleBeats(const std::vector<Card>& newTriple, const std::vecto
 /**
  * Compare two five-card combinations
  */
-bool GameRules::fiveCardBeats(const std::vector<Card>& newCards, const std::vector<Card>& lastCards) {
+bool GameRules::fiveCardBeats(std::span<const Card> newCards, std::span<const Card> lastCards) {
     FiveCardType newType = determineFiveCardType(newCards);
     FiveCardType lastType = determineFiveCardType(lastCards);
 
@@ -313,7 +345,7 @@ bool GameRules::fiveCardBeats(const std::vector<Card>& newCards, const std::vect
 /**
  * Get the highest card in a set
  */
-Card GameRules::getHighestCard(const std::vector<Card>& cards) {
+Card GameRules::getHighestCard(std::span<const Card> cards) {
     if (cards.empty()) {
         throw std::runtime_error("Cannot get highest card from empty set");
     }
@@ -345,7 +377,7 @@ int GameRules::getFiveCardRank(FiveCardType type) {
 /**
  * Check if play contains 3 of Diamonds
  */
-bool GameRules::containsThreeOfDiamonds(const std::vector<Card>& cards) {
+bool GameRules::containsThreeOfDiamonds(std::span<const Card> cards) {
     Card threeOfDiamonds(Rank::Three, Suit::Diamonds);
     return std::find(cards.begin(), cards.end(), threeOfDiamonds) != cards.end();
 }
@@ -353,11 +385,12 @@ bool GameRules::containsThreeOfDiamonds(const std::vector<Card>& cards) {
 /**
  * Sort cards by rank
  */
-std::vector<Card> GameRules::sortByRank(std::vector<Card> cards) {
-    std::sort(cards.begin(), cards.end(), [](const Card& a, const Card& b) {
+PlayCards GameRules::sortByRank(std::span<const Card> cards) {
+    PlayCards sorted(cards);
+    std::sort(sorted.begin(), sorted.end(), [](const Card& a, const Card& b) {
         return a.getRank() < b.getRank();
         });
-    return cards;
+    return sorted;
 }
 
 /**
@@ -383,4 +416,109 @@ std::string GameRules::getPlayTypeName(PlayType type, FiveCardType fiveCardType)
     default:
         return "Invalid";
     }
-}
\ No newline at end of file
+}
+
+/**
+ * Compact play key (dispatches once on size)
+ */
+std::uint16_t GameRules::getPlayKey(std::span<const Card> cards) {
+    switch (cards.size()) {
+    case 1: return classify<1>(cards.first<1>());
+    case 2: return classify<2>(cards.first<2>());
+    case 3: return classify<3>(cards.first<3>());
+    case 5: return classify<5>(cards.first<5>());
+    default: return 0;
+    }
+}
+
+/**
+ * Single: always valid
+ */
+template <>
+std::uint16_t GameRules::classify<1>(std::span<const Card, 1> cards) {
+    return makeKey(true, PlayType::Single, 0, denseIndex(cards[0]));
+}
+
+/**
+ * Pair: both cards share a rank
+ */
+template <>
+std::uint16_t GameRules::classify<2>(std::span<const Card, 2> cards) {
+    int a = denseIndex(cards[0]);
+    int b = denseIndex(cards[1]);
+    bool valid = (a >> 2) == (b >> 2);
+    return makeKey(valid, PlayType::Pair, 0, std::max(a, b));
+}
+
+/**
+ * Triple: all three cards share a rank
+ */
+template <>
+std::uint16_t GameRules::classify<3>(std::span<const Card, 3> cards) {
+    int a = denseIndex(cards[0]);
+    int b = denseIndex(cards[1]);
+    int c = denseIndex(cards[2]);
+    bool valid = ((a >> 2) == (b >> 2)) & ((b >> 2) == (c >> 2));
+    return makeKey(valid, PlayType::Triple, 0, std::max({ a, b, c }));
+}
+
+/**
+ * Five cards: shape from the rank mask, the suits and the first rank's count
+ */
+template <>
+std::uint16_t GameRules::classify<5>(std::span<const Card, 5> cards) {
+    int index[5];
+    for (size_t i = 0; i < 5; ++i) {
+        index[i] = denseIndex(cards[i]);
+    }
+
+    unsigned rankMask = 0;
+    int firstRankCount = 0;
+    bool sameSuit = true;
+    int highIndex = 0;
+    for (size_t i = 0; i < 5; ++i) {
+        rankMask |= 1u << (index[i] >> 2);
+        firstRankCount += (index[i] >> 2) == (index[0] >> 2);
+        sameSuit &= (index[i] & 3) == (index[0] & 3);
+        highIndex = std::max(highIndex, index[i]);
+    }
+
+    // Two ranks split 4+1 or 3+2; a straight is five adjacent rank bits
+    int ranks = std::popcount(rankMask);
+    bool straight = (ranks == 5) & ((rankMask >> std::countr_zero(rankMask)) == 0x1Fu);
+    bool twoRanks = ranks == 2;
+    bool fourOfAKind = twoRanks & ((firstRankCount == 1) | (firstRankCount == 4));
+    bool fullHouse = twoRanks & ((firstRankCount == 2) | (firstRankCount == 3));
+
+    unsigned shape = static_cast<unsigned>(straight) | (static_cast<unsigned>(sameSuit) << 1)
+        | (static_cast<unsigned>(fourOfAKind) << 2) | (static_cast<unsigned>(fullHouse) << 3);
+    int fiveRank = FIVE_CARD_RANKS[shape];
+    return makeKey(fiveRank != 0, PlayType::FiveCard, fiveRank, highIndex);
+}
+
+/**
+ * Decode the play type from a play key
+ */
+PlayType GameRules::getPlayTypeFromKey(std::uint16_t key) {
+    return static_cast<PlayType>(key >> 9);
+}
+
+/**
+ * Decode the five-card type from a play key
+ */
+FiveCardType GameRules::getFiveCardTypeFromKey(std::uint16_t key) {
+    return FIVE_CARD_TYPES[(key >> 6) & 7];
+}
+
+/**
+ * Check if a play key beats another
+ */
+bool GameRules::playKeyBeats(std::uint16_t newKey, std::uint16_t lastKey) {
+    if (newKey == 0) {
+        return false;
+    }
+    if (lastKey == 0) {
+        return true;
+    }
+    return getPlayTypeFromKey(newKey) == getPlayTypeFromKey(lastKey) && newKey > lastKey;
+}
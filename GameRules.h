@@ -7,9 +7,13 @@
 #define GAMERULES_H
 
 #include "Card.h"
-#include "GameState.h"
+#include "Hand.h"
+#include <cstddef>
+#include <span>
+#include <string_view>
 #include <vector>
 #include <string>
+#include <cstdint>
 
  /**
   * Play type enumeration
@@ -41,7 +45,7 @@ struct PlayValidation {
     bool isValid;
     PlayType playType;
     FiveCardType fiveCardType;
-    std::string errorMessage;
+    std::string_view errorMessage;     // Static text
 
     PlayValidation()
         : isValid(false),
@@ -57,72 +61,73 @@ struct PlayValidation {
 class GameRules {
 public:
     /**
-     * Validate if a play is legal
+     * Validate if a play is legal (classifies each play once, through getPlayKey)
      */
     static PlayValidation validatePlay(
-        const std::vector<Card>& cards,
-        const std::vector<Card>& lastPlay,
+        std::span<const Card> cards,
+        std::span<const Card> lastPlay,
         bool isFirstPlay,
         bool mustIncludeThreeOfDiamonds
     );
 
     /**
      * Check if a play beats the previous play
+     * (with several decks, a play topped by an identical card ties and does not beat)
      */
     static bool doesPlayBeat(
-        const std::vector<Card>& newPlay,
-        const std::vector<Card>& lastPlay
+        std::span<const Card> newPlay,
+        std::span<const Card> lastPlay
     );
 
     /**
-     * Determine play type
+     * Determine play type (generic path over any number of cards)
      */
-    static PlayType determinePlayType(const std::vector<Card>& cards);
+    static PlayType determinePlayType(std::span<const Card> cards);
 
     /**
      * Determine five-card combination type
      */
-    static FiveCardType determineFiveCardType(const std::vector<Card>& cards);
+    static FiveCardType determineFiveCardType(std::span<const Card> cards);
 
     /**
      * Check if cards form a valid single
      */
-    static bool isSingle(const std::vector<Card>& cards);
+    static bool isSingle(std::span<const Card> cards);
 
     /**
      * Check if cards form a valid pair
      */
-    static bool isPair(const std::vector<Card>& cards);
+    static bool isPair(std::span<const Card> cards);
 
     /**
      * Check if cards form a valid triple
      */
-    static bool isTriple(const std::vector<Card>& cards);
+    static bool isTriple(std::span<const Card> cards);
 
     /**
      * Check if cards form a valid straight
      */
-    static bool isStraight(const std::vector<Card>& cards);
+    static bool isStraight(std::span<const Card> cards);
 
     /**
      * Check if cards form a valid flush
      */
-    static bool isFlush(const std::vector<Card>& cards);
+    static bool isFlush(std::span<const Card> cards);
 
     /**
      * Check if cards form a valid full house
      */
-    static bool isFullHouse(const std::vector<Card>& cards);
+    static bool isFullHouse(std::span<const Card> cards);
 
     /**
      * Check if cards form four of a kind
      */
-    static bool isFourOfAKind(const std::vector<Card>& cards);
+    static bool isFourOfAKind(std::span<const Card> cards);
 
     /**
      * Check if cards form a straight flush
      */
-    static bool isStraightFlush(const std::vector<Card>& cards);
+    static bool isStraightFlush(std::span<const Card> cards);
 
     /**
      * Compare two singles
@@ -132,22 +137,22 @@ public:
     /**
      * Compare two pairs
      */
-    static bool pairBeats(const std::vector<Card>& newPair, const std::vector<Card>& lastPair);
+    static bool pairBeats(std::span<const Card> newPair, std::span<const Card> lastPair);
 
     /**
      * Compare two triples
      */
-    static bool tripleBeats(const std::vector<Card>& newTriple, const std::vector<Card>& lastTriple);
+    static bool tripleBeats(std::span<const Card> newTriple, std::span<const Card> lastTriple);
 
     /**
      * Compare two five-card combinations
      */
-    static bool fiveCardBeats(const std::vector<Card>& newCards, const std::vector<Card>& lastCards);
+    static bool fiveCardBeats(std::span<const Card> newCards, std::span<const Card> lastCards);
 
     /**
      * Get the highest card in a set
      */
-    static Card getHighestCard(const std::vector<Card>& cards);
+    static Card getHighestCard(std::span<const Card> cards);
 
     /**
      * Get rank value for comparison (in a five-card combo)
@@ -157,17 +162,51 @@ public:
     /**
      * Check if play must include 3 of Diamonds (first play of game)
      */
-    static bool containsThreeOfDiamonds(const std::vector<Card>& cards);
+    static bool containsThreeOfDiamonds(std::span<const Card> cards);
 
     /**
-     * Sort cards by rank
+     * Sort a play (at most five cards) by rank
      */
-    static std::vector<Card> sortByRank(std::vector<Card> cards);
+    static PlayCards sortByRank(std::span<const Card> cards);
 
     /**
      * Get play type name
      */
     static std::string getPlayTypeName(PlayType type, FiveCardType fiveCardType = FiveCardType::None);
+
+    /**
+     * Compact play key: play type (bits 9-11), five-card rank (bits 6-8),
+     * highest card index (bits 0-5). 0 means invalid.
+     * Keys of the same play type order exactly like doesPlayBeat.
+     */
+    static std::uint16_t getPlayKey(std::span<const Card> cards);
+
+    /**
+     * Play key of exactly N cards, specialized for N = 1, 2, 3 and 5:
+     * unrolled and branch-free, equal to getPlayKey for that size
+     */
+    template <std::size_t N>
+    static std::uint16_t classify(std::span<const Card, N> cards);
+
+    /**
+     * Decode the five-card type from a play key (None for other play types)
+     */
+    static FiveCardType getFiveCardTypeFromKey(std::uint16_t key);
+
+    /**
+     * Decode the play type from a play key
+     */
+    static PlayType getPlayTypeFromKey(std::uint16_t key);
+
+    /**
+     * Check if a play key beats another (0 = nothing to beat)
+     */
+    static bool playKeyBeats(std::uint16_t newKey, std::uint16_t lastKey);
 };
 
+template <> std::uint16_t GameRules::classify<1>(std::span<const Card, 1> cards);
+template <> std::uint16_t GameRules::classify<2>(std::span<const Card, 2> cards);
+template <> std::uint16_t GameRules::classify<3>(std::span<const Card, 3> cards);
+template <> std::uint16_t GameRules::classify<5>(std::span<const Card, 5> cards);
+
 #endif // GAMERULES_HPP
@@ -4,8 +4,10 @@
  */
 
 #include "GameState.h"
-#include <sstream>
 #include <algorithm>
+#include <bit>
+#include <stdexcept>
+#include <string>
 
  /**
   * Constructor
@@ -15,6 +17,7 @@ GameState::GameState()
     lastPlayingPlayerIndex_(0),
     phase_(GamePhase::NotStarted),
     consecutivePasses_(0),
+    passedSeats_(0),
     firstPlayOfGame_(true) {
 }
 
@@ -22,20 +25,22 @@ GameState::GameState()
  * Initialize game with players
  */
 void GameState::initializePlayers(int numPlayers, int numHumans) {
-    players_.clear();
+    seats_.clear();
+    ++version_;
 
-    // Clamp values to reasonable range (2-4 players typical for Big Two)
-    numPlayers = std::max(2, std::min(4, numPlayers));
+    // Clamp values to reasonable range (2-4 players typical for Big Two, up to 8 with two decks)
+    numPlayers = std::max(2, std::min(MAX_PLAYERS, numPlayers));
     numHumans = std::max(0, std::min(numHumans, numPlayers));
+    deck_.setNumDecks((numPlayers + PLAYERS_PER_DECK - 1) / PLAYERS_PER_DECK);
 
     // Create human players first
     for (int i = 0; i < numHumans; ++i) {
-        players_.emplace_back(generatePlayerName(i, PlayerType::Human), PlayerType::Human);
+        seats_.addSeat(generatePlayerName(i, PlayerType::Human), PlayerType::Human);
     }
 
     // Create AI players
     for (int i = numHumans; i < numPlayers; ++i) {
-        players_.emplace_back(generatePlayerName(i, PlayerType::AI), PlayerType::AI);
+        seats_.addSeat(generatePlayerName(i, PlayerType::AI), PlayerType::AI);
     }
 }
 
@@ -47,13 +52,37 @@ void GameState::startNewGame() {
     deck_.reset();
     deck_.shuffle();
 
-    // Clear all player hands
-    for (auto& player : players_) {
-        player.clearHand();
-        player.resetPass();
+    dealAndBegin();
+}
+
+/**
+ * Start a new game from a prearranged deck
+ */
+void GameState::startNewGame(const std::vector<Card>& stackedDeck) {
+    deck_.stack(stackedDeck);
+    dealAndBegin();
+}
+
+/**
+ * Start a new game from a constrained deal
+ */
+void GameState::startNewGame(ConstrainedDealer& dealer, std::mt19937& rng) {
+    if (static_cast<size_t>(dealer.getNumPlayers()) != seats_.size()) {
+        throw std::invalid_argument("Constrained dealer is set up for " + std::to_string(dealer.getNumPlayers())
+            + " players, table has " + std::to_string(seats_.size()));
     }
+    startNewGame(dealer.dealDeck(rng));
+}
+
+/**
+ * Deal from the current deck and reset turn state
+ */
+void GameState::dealAndBegin() {
+    // Clear all player hands
+    seats_.clearHands();
 
-    // Deal cards
+    // Deal cards; the history is sized for the whole game here, so turns never allocate
+    history_.reserve(deck_.size(), seats_.size());
     dealCards();
 
     // Find starting player (player with 3 of Diamonds)
@@ -63,31 +92,29 @@ void GameState::startNewGame() {
     lastPlay_.clear();
     lastPlayingPlayerIndex_ = currentPlayerIndex_;
     consecutivePasses_ = 0;
+    passedSeats_ = 0;
     firstPlayOfGame_ = true;  // Reset the first play flag
     phase_ = GamePhase::InProgress;
+    history_.clear();
+    ++version_;
 }
 
 /**
  * Deal cards to all players
  */
 void GameState::dealCards() {
-    if (players_.empty()) {
+    if (seats_.size() == 0) {
         return;
     }
 
-    size_t numPlayers = players_.size();
-    size_t cardsPerPlayer = 52 / numPlayers;
+    size_t numPlayers = seats_.size();
+    size_t cardsPerPlayer = deck_.size() / numPlayers;
 
     // Deal cards in round-robin fashion
     for (size_t i = 0; i < cardsPerPlayer * numPlayers; ++i) {
         size_t playerIndex = i % numPlayers;
         Card card = deck_.deal();
-        players_[playerIndex].getHand().addCard(card);
-    }
-
-    // Sort each player's hand
-    for (auto& player : players_) {
-        player.getHand().sort(SortOrder::ByRank);
+        seats_.addCard(playerIndex, card);
     }
 }
 
@@ -95,123 +122,252 @@ void GameState::dealCards() {
  * Get current player
  */
 Player* GameState::getCurrentPlayer() {
-    if (currentPlayerIndex_ >= players_.size()) {
+    if (currentPlayerIndex_ >= seats_.size()) {
         return nullptr;
     }
-    return &players_[currentPlayerIndex_];
+    return &seats_.players()[currentPlayerIndex_];
 }
 
 const Player* GameState::getCurrentPlayer() const {
-    if (currentPlayerIndex_ >= players_.size()) {
+    if (currentPlayerIndex_ >= seats_.size()) {
         return nullptr;
     }
-    return &players_[currentPlayerIndex_];
+    return &seats_.players()[currentPlayerIndex_];
 }
 
 /**
  * Get player by index
  */
 Player* GameState::getPlayer(size_t index) {
-    if (index >= players_.size()) {
+    if (index >= seats_.size()) {
         return nullptr;
     }
-    return &players_[index];
+    return &seats_.players()[index];
 }
 
 const Player* GameState::getPlayer(size_t index) const {
-    if (index >= players_.size()) {
+    if (index >= seats_.size()) {
         return nullptr;
     }
-    return &players_[index];
+    return &seats_.players()[index];
 }
 
 /**
  * Get last playing player
  */
 const Player* GameState::getLastPlayingPlayer() const {
-    if (lastPlayingPlayerIndex_ >= players_.size()) {
+    if (lastPlayingPlayerIndex_ >= seats_.size()) {
         return nullptr;
     }
-    return &players_[lastPlayingPlayerIndex_];
+    return &seats_.players()[lastPlayingPlayerIndex_];
 }
 
 /**
- * Set last played cards
+ * Apply one turn transition for the current seat and record it
  */
-void GameState::setLastPlay(const std::vector<Card>& cards, size_t playerIndex) {
-    lastPlay_ = cards;
-    lastPlayingPlayerIndex_ = playerIndex;
-    resetPasses();
+TurnResult GameState::applyTurn(TurnAction action, std::span<const Card> cards) {
+    size_t seat = currentPlayerIndex_;
+    size_t lastSeat = lastPlayingPlayerIndex_;
+    std::uint32_t passedSeats = passedSeats_;
+    int passes = consecutivePasses_;
+    PlayType facing = opponentModel_ && !lastPlay_.empty()
+        ? GameRules::determinePlayType(lastPlay_) : PlayType::Invalid;
+
+    TurnResult result = performTurn(action, cards);
+    if (result == TurnResult::Rejected) {
+        return result;
+    }
+    ++version_;
+
+    TurnDiffKind kind = action == TurnAction::Play ? TurnDiffKind::Play
+        : action == TurnAction::ResetTrick ? TurnDiffKind::Reset
+        : result == TurnResult::TrickWon ? TurnDiffKind::TrickEnd
+        : TurnDiffKind::Pass;
+    observeTurn(seat, kind, facing, cards, false);
+    if (!history_.record(kind, action == TurnAction::Play ? cards : std::span<const Card>(),
+        seat, lastSeat, passedSeats, passes)) {
+        history_.clear();   // Oversized play; earlier turns can no longer be undone
+    }
+    return result;
 }
 
 /**
- * Clear last play
+ * Revert the most recent recorded turn
  */
-void GameState::clearLastPlay() {
-    lastPlay_.clear();
-    resetAllPasses();
-    resetPasses();
+bool GameState::undoTurn() {
+    if (!history_.canUndo()) {
+        return false;
+    }
+
+    const TurnDiff& diff = history_.stepBack();
+    if (opponentModel_) {
+        // Take the turn back out of the model while the hand is as the turn left it
+        PlayCards faced = history_.getLastPlayAtCursor();
+        observeTurn(diff.seat, diff.kind(), faced.empty() ? PlayType::Invalid : GameRules::determinePlayType(faced),
+            diff.getCards(), true);
+    }
+    if (diff.kind() == TurnDiffKind::Play) {
+        for (const auto& card : diff.getCards()) {
+            seats_.addCard(diff.seat, card);
+        }
+    }
+    if (diff.kind() != TurnDiffKind::Pass) {
+        lastPlay_ = history_.getLastPlayAtCursor();
+    }
+
+    currentPlayerIndex_ = diff.seat;
+    lastPlayingPlayerIndex_ = diff.lastSeat;
+    passedSeats_ = diff.passedSeats;
+    consecutivePasses_ = diff.passes;
+    firstPlayOfGame_ = !history_.hasPlayBeforeCursor();
+    phase_ = GamePhase::InProgress;
+    ++version_;
+    return true;
 }
 
 /**
- * Move to next player's turn
+ * Re-apply the most recently undone turn
  */
-void GameState::nextTurn() {
-    currentPlayerIndex_ = (currentPlayerIndex_ + 1) % players_.size();
+bool GameState::redoTurn() {
+    if (!history_.canRedo()) {
+        return false;
+    }
+
+    const TurnDiff& diff = history_.stepForward();
+    TurnAction action = diff.kind() == TurnDiffKind::Play ? TurnAction::Play
+        : diff.kind() == TurnDiffKind::Reset ? TurnAction::ResetTrick
+        : TurnAction::Pass;
+    size_t seat = currentPlayerIndex_;
+    PlayType facing = opponentModel_ && !lastPlay_.empty()
+        ? GameRules::determinePlayType(lastPlay_) : PlayType::Invalid;
+    PlayCards cards = diff.getCards();
+    if (performTurn(action, cards) == TurnResult::Rejected) {
+        return false;
+    }
+    ++version_;
+    observeTurn(seat, diff.kind(), facing, cards, false);
+    return true;
+}
+
+/**
+ * Feed a turn to the opponent model, or take it back out on undo
+ */
+void GameState::observeTurn(size_t seat, TurnDiffKind kind, PlayType facing, std::span<const Card> cards, bool takeBack) {
+    if (!opponentModel_) {
+        return;
+    }
+    PlayerId player = playerIds_[seat];
+    if (kind == TurnDiffKind::Play) {
+        size_t dealtCards = static_cast<size_t>(deck_.getNumDecks()) * 52 / seats_.size();
+        CardSet handAfter = seats_.getHand(seat);
+        if (takeBack) {
+            opponentModel_->forgetPlay(player, facing, cards, handAfter, dealtCards);
+        }
+        else {
+            opponentModel_->recordPlay(player, facing, cards, handAfter, dealtCards);
+        }
+    }
+    else if (kind == TurnDiffKind::Pass || kind == TurnDiffKind::TrickEnd) {
+        if (takeBack) {
+            opponentModel_->forgetPass(player, facing);
+        }
+        else {
+            opponentModel_->recordPass(player, facing);
+        }
+    }
 }
 
 /**
- * Check if all other players have passed
+ * Apply a turn transition without recording it
  */
-bool GameState::allOthersHavePassed() const {
-    if (players_.size() <= 1) {
-        return true;
+TurnResult GameState::performTurn(TurnAction action, std::span<const Card> cards) {
+    if (phase_ != GamePhase::InProgress || currentPlayerIndex_ >= seats_.size()) {
+        return TurnResult::Rejected;
+    }
+
+    switch (action) {
+    case TurnAction::Play: {
+        if (cards.empty() || cards.size() > PlayCards::capacity()
+            || !seats_.removeCards(currentPlayerIndex_, cards)) {
+            return TurnResult::Rejected;
+        }
+
+        lastPlay_.assign(cards);
+        lastPlayingPlayerIndex_ = currentPlayerIndex_;
+        consecutivePasses_ = 0;
+        firstPlayOfGame_ = false;
+
+        if (seats_.getCardCount(currentPlayerIndex_) == 0) {
+            phase_ = GamePhase::Finished;
+            return TurnResult::GameWon;
+        }
+        nextTurn();
+        return TurnResult::Played;
     }
 
-    // Check if all players except the last playing player have passed
-    int passCount = 0;
-    for (size_t i = 0; i < players_.size(); ++i) {
-        if (i != lastPlayingPlayerIndex_ && players_[i].hasPassed()) {
-            passCount++;
+    case TurnAction::Pass:
+        // The seat leading a trick must play
+        if (lastPlay_.empty()) {
+            return TurnResult::Rejected;
         }
+
+        passedSeats_ |= 1u << currentPlayerIndex_;
+        consecutivePasses_++;
+
+        // The last playing seat never passes within its own trick
+        if (std::popcount(passedSeats_) >= static_cast<int>(seats_.size()) - 1) {
+            resetTrick();
+            return TurnResult::TrickWon;
+        }
+        nextTurn();
+        return TurnResult::Passed;
+
+    case TurnAction::ResetTrick:
+        resetTrick();
+        return TurnResult::TrickWon;
     }
 
-    return passCount >= static_cast<int>(players_.size()) - 1;
+    return TurnResult::Rejected;
 }
 
 /**
- * Reset all player pass flags
+ * Advance to the next seat still in the trick
  */
-void GameState::resetAllPasses() {
-    for (auto& player : players_) {
-        player.resetPass();
+void GameState::nextTurn() {
+    const size_t numPlayers = seats_.size();
+    for (size_t step = 1; step <= numPlayers; ++step) {
+        size_t seat = (currentPlayerIndex_ + step) % numPlayers;
+        if (!hasPassed(seat)) {
+            currentPlayerIndex_ = seat;
+            return;
+        }
     }
 }
 
+/**
+ * Clear the trick and give the lead to the last playing seat
+ */
+void GameState::resetTrick() {
+    lastPlay_.clear();
+    passedSeats_ = 0;
+    consecutivePasses_ = 0;
+    currentPlayerIndex_ = lastPlayingPlayerIndex_;
+}
+
 /**
  * Find winner
  */
 Player* GameState::findWinner() {
-    for (auto& player : players_) {
-        if (player.hasWon()) {
-            return &player;
-        }
-    }
-    return nullptr;
+    std::optional<size_t> seat = seats_.findEmptyHand();
+    return seat ? &seats_.players()[*seat] : nullptr;
 }
 
 /**
  * Find starting player (player with 3 of Diamonds)
  */
 size_t GameState::findStartingPlayer() const {
-    for (size_t i = 0; i < players_.size(); ++i) {
-        if (players_[i].getHand().hasThreeOfDiamonds()) {
-            return i;
-        }
-    }
-
     // Fallback to first player if 3 of Diamonds not found
-    return 0;
+    return seats_.findHolder(Card(Rank::Three, Suit::Diamonds)).value_or(0);
 }
 
 /**
@@ -226,7 +382,8 @@ std::string GameState::generatePlayerName(size_t index, PlayerType type) const {
     }
     else {
         const std::vector<std::string> aiNames = {
-            "CPU Alice", "CPU Bob", "CPU Charlie", "CPU Dana"
+            "CPU Alice", "CPU Bob", "CPU Charlie", "CPU Dana",
+            "CPU Erin", "CPU Frank", "CPU Grace", "CPU Heidi"
         };
         if (index < aiNames.size()) {
             return aiNames[index];
@@ -239,43 +396,160 @@ std::string GameState::generatePlayerName(size_t index, PlayerType type) const {
  * Get status message
  */
 std::string GameState::getStatusMessage() const {
-    std::ostringstream oss;
+    TextBuffer text;
+    formatStatusMessage(text);
+    return text.str();
+}
+
+/**
+ * Write the game status message without allocating
+ */
+void GameState::formatStatusMessage(TextBuffer& out) const {
+    out.clear();
 
     switch (phase_) {
     case GamePhase::NotStarted:
-        oss << "Game not started. Waiting to begin...";
+        out.append("Game not started. Waiting to begin...");
         break;
 
     case GamePhase::InProgress:
         if (const Player* current = getCurrentPlayer()) {
-            oss << current->getName() << "'s turn";
+            out.append(current->getName()).append("'s turn");
 
             if (!lastPlay_.empty()) {
-                oss << " - Last play: ";
-                for (size_t i = 0; i < lastPlay_.size(); ++i) {
-                    if (i > 0) oss << " ";
-                    oss << lastPlay_[i].toString();
-                }
+                out.append(" - Last play: ").appendCards(getLastPlay());
 
                 if (const Player* lastPlayer = getLastPlayingPlayer()) {
-                    oss << " by " << lastPlayer->getName();
+                    out.append(" by ").append(lastPlayer->getName());
                 }
             }
             else {
-                oss << " - No cards played yet";
+                out.append(" - No cards played yet");
             }
         }
         break;
 
     case GamePhase::Finished:
         if (Player* winner = const_cast<GameState*>(this)->findWinner()) {
-            oss << winner->getName() << " wins!";
+            out.append(winner->getName()).append(" wins!");
         }
         else {
-            oss << "Game finished";
+            out.append("Game finished");
         }
         break;
     }
+}
+
+/**
+ * Attach an opponent model
+ */
+void GameState::setOpponentModel(OpponentModel* model, std::span<const PlayerId> playerIds) {
+    if (model && playerIds.size() < seats_.size()) {
+        throw std::invalid_argument("Opponent model needs a player id for every seat");
+    }
+    opponentModel_ = model;
+    playerIds_ = {};
+    if (model) {
+        std::copy_n(playerIds.begin(), seats_.size(), playerIds_.begin());
+    }
+}
 
-    return oss.str();
-}
\ No newline at end of file
+/**
+ * Profiles of the other seats still in the trick
+ */
+StaticVector<OpponentProfile, SeatTable::MAX_SEATS> GameState::getOpponentProfiles(size_t seat) const {
+    StaticVector<OpponentProfile, SeatTable::MAX_SEATS> profiles;
+    if (!opponentModel_) {
+        return profiles;
+    }
+    for (size_t other = 0; other < seats_.size(); ++other) {
+        if (other != seat && !hasPassed(other) && seats_.getCardCount(other) > 0) {
+            profiles.push_back(opponentModel_->getProfile(playerIds_[other]));
+        }
+    }
+    return profiles;
+}
+
+/**
+ * Compact copy of the table for hibernation
+ */
+PackedGameState GameState::pack() const {
+    PackedGameState packed;
+    packed.seats = seats_.pack();
+    packed.opponentModel = opponentModel_;
+    packed.playerIds = playerIds_;
+    packed.version = version_;
+    packed.deckSeed = deck_.getSeed();
+
+    packed.lastPlay = 0;
+    for (size_t i = 0; i < TurnDiff::MAX_CARDS; ++i) {
+        std::uint32_t index = i < lastPlay_.size() ? static_cast<std::uint32_t>(lastPlay_[i].getIndex()) : TurnDiff::NO_CARD;
+        packed.lastPlay |= index << (6 * i);
+    }
+
+    const std::vector<Card>& undealt = deck_.getCards();
+    if (undealt.size() <= PackedGameState::MAX_UNDEALT) {
+        for (size_t i = 0; i < undealt.size(); ++i) {
+            packed.undealt[i] = static_cast<std::uint8_t>(undealt[i].getIndex());
+        }
+        packed.undealtCount = static_cast<std::uint8_t>(undealt.size());
+    }
+    else {
+        packed.undealtCount = PackedGameState::FRESH_SHOE;
+    }
+    packed.numDecks = static_cast<std::uint8_t>(deck_.getNumDecks());
+
+    packed.currentSeat = static_cast<std::uint8_t>(currentPlayerIndex_);
+    packed.lastSeat = static_cast<std::uint8_t>(lastPlayingPlayerIndex_);
+    packed.passedSeats = static_cast<std::uint8_t>(passedSeats_);
+    packed.passes = static_cast<std::uint8_t>(consecutivePasses_);
+    packed.phase = phase_;
+    packed.firstPlayOfGame = firstPlayOfGame_;
+    return packed;
+}
+
+/**
+ * Restore a packed table
+ */
+void GameState::unpack(const PackedGameState& packed) {
+    seats_.unpack(packed.seats);
+    opponentModel_ = packed.opponentModel;
+    playerIds_ = packed.playerIds;
+    version_ = packed.version;
+
+    lastPlay_.clear();
+    for (size_t i = 0; i < TurnDiff::MAX_CARDS; ++i) {
+        std::uint32_t index = (packed.lastPlay >> (6 * i)) & 63u;
+        if (index == TurnDiff::NO_CARD) {
+            break;
+        }
+        lastPlay_.push_back(Card::fromIndex(static_cast<int>(index)));
+    }
+
+    deck_.setNumDecks(packed.numDecks);
+    deck_.seed(packed.deckSeed);
+    if (packed.undealtCount == PackedGameState::FRESH_SHOE) {
+        deck_.reset();
+    }
+    else {
+        StaticVector<Card, PackedGameState::MAX_UNDEALT> undealt;
+        for (size_t i = 0; i < packed.undealtCount; ++i) {
+            undealt.push_back(Card::fromIndex(packed.undealt[i]));
+        }
+        deck_.stack(undealt);
+    }
+
+    currentPlayerIndex_ = packed.currentSeat;
+    lastPlayingPlayerIndex_ = packed.lastSeat;
+    passedSeats_ = packed.passedSeats;
+    consecutivePasses_ = packed.passes;
+    phase_ = packed.phase;
+    firstPlayOfGame_ = packed.firstPlayOfGame;
+    history_.clear(lastPlay_);
+
+    size_t cardsLeft = 0;
+    for (size_t seat = 0; seat < seats_.size(); ++seat) {
+        cardsLeft += seats_.getCardCount(seat);
+    }
+    history_.reserve(cardsLeft, seats_.size());
+}
@@ -6,34 +6,97 @@
 #ifndef GAMESTATE_H
 #define GAMESTATE_H
 
-#include "Player.h"
+#include "SeatTable.h"
+#include "TurnHistory.h"
+#include "TextBuffer.h"
 #include "Deck.h"
+#include "ConstrainedDealer.h"
+#include "OpponentModel.h"
 #include "Card.h"
 #include <vector>
 #include <memory>
 #include <optional>
+#include <cstdint>
+#include <span>
 
  /**
   * Game phase
   */
-enum class GamePhase {
+enum class GamePhase : std::uint8_t {
     NotStarted,     // Game hasn't started yet
     InProgress,     // Game is being played
     Finished        // Game has ended
 };
 
+/**
+ * Turn transition requested by the seat to move
+ */
+enum class TurnAction {
+    Play,
+    Pass,
+    ResetTrick
+};
+
+/**
+ * Outcome of a turn transition
+ */
+enum class TurnResult {
+    Rejected,       // Not in progress, cards not in hand, or passing on the lead
+    Played,         // Cards played, next seat to move
+    Passed,         // Seat passed, trick continues
+    TrickWon,       // Every other seat passed; last playing seat leads a new trick
+    GameWon         // Cards played and the hand is empty
+};
+
+/**
+ * A table packed for hibernation: hands as masks, the trick state as small
+ * fields, the play to beat as card indices, and the deck as a generator
+ * seed plus the few cards a deal leaves over. Undo history is not kept.
+ */
+struct PackedGameState {
+    static constexpr size_t MAX_UNDEALT = SeatTable::MAX_SEATS;     // A deal leaves fewer cards than seats
+    static constexpr std::uint8_t FRESH_SHOE = 0xFF;                // Deck not dealt from yet
+
+    SeatTable::Packed seats;
+    OpponentModel* opponentModel = nullptr;
+    std::array<PlayerId, SeatTable::MAX_SEATS> playerIds{};
+    std::uint64_t version = 0;
+    std::uint64_t deckSeed = 0;
+    std::uint32_t lastPlay = 0;                         // Five 6-bit card indices, TurnDiff::NO_CARD padded
+    std::array<std::uint8_t, MAX_UNDEALT> undealt{};    // Card indices in deck order
+    std::uint8_t undealtCount = 0;                      // Or FRESH_SHOE
+    std::uint8_t numDecks = 1;
+    std::uint8_t currentSeat = 0;
+    std::uint8_t lastSeat = 0;
+    std::uint8_t passedSeats = 0;
+    std::uint8_t passes = 0;
+    GamePhase phase = GamePhase::NotStarted;
+    bool firstPlayOfGame = true;
+};
+
 /**
  * GameState class
+ *
+ * About 550 bytes inline, 336 of them the seat table; the deck keeps a
+ * seed rather than its generator. The cards a deal leaves over and the
+ * turn history are heap storage copied with the state, so code copying
+ * positions in a loop should work on pack() instead.
  */
 class GameState {
 public:
+    static constexpr int MAX_PLAYERS = static_cast<int>(SeatTable::MAX_SEATS);
+    static constexpr int PLAYERS_PER_DECK = 4;  // A second deck joins from 5 players
+
+    static_assert((MAX_PLAYERS + PLAYERS_PER_DECK - 1) / PLAYERS_PER_DECK <= static_cast<int>(CardSet::MAX_COPIES),
+        "A full table deals more decks than a hand can hold copies of a card");
+
     /**
      * Constructor
      */
     GameState();
 
     /**
-     * Initialize game with players
+     * Initialize game with players (2-8; tables over 4 players use two decks)
      */
     void initializePlayers(int numPlayers, int numHumans = 1);
 
@@ -42,6 +105,18 @@ public:
      */
     void startNewGame();
 
+    /**
+     * Start a new game from a prearranged deck instead of a shuffle
+     * (dealt exactly like dealCards: from the back, round-robin)
+     */
+    void startNewGame(const std::vector<Card>& stackedDeck);
+
+    /**
+     * Start a new game from a deal sampled under constraints
+     * @throws std::invalid_argument if the dealer is set up for another table size
+     */
+    void startNewGame(ConstrainedDealer& dealer, std::mt19937& rng);
+
     /**
      * Deal cards to all players
      */
@@ -62,13 +137,18 @@ public:
     /**
      * Get all players
      */
-    std::vector<Player>& getPlayers() { return players_; }
-    const std::vector<Player>& getPlayers() const { return players_; }
+    std::span<Player> getPlayers() { return seats_.players(); }
+    std::span<const Player> getPlayers() const { return seats_.players(); }
+
+    /**
+     * Per-seat hands, counts and flags
+     */
+    const SeatTable& getSeats() const { return seats_; }
 
     /**
      * Get number of players
      */
-    size_t getNumPlayers() const { return players_.size(); }
+    size_t getNumPlayers() const { return seats_.size(); }
 
     /**
      * Get current player index
@@ -78,7 +158,7 @@ public:
     /**
      * Get last played cards
      */
-    const std::vector<Card>& getLastPlay() const { return lastPlay_; }
+    std::span<const Card> getLastPlay() const { return lastPlay_; }
 
     /**
      * Get last player who played (not passed)
@@ -86,54 +166,66 @@ public:
     const Player* getLastPlayingPlayer() const;
 
     /**
-     * Set last played cards
+     * Apply one turn transition for the current seat:
+     *   Play       - remove cards from the hand and make them the play to beat
+     *   Pass       - drop out of the trick; when every other seat has passed,
+     *                the trick resets and the last playing seat leads
+     *   ResetTrick - clear the trick and give the lead to the last playing seat
+     * Play legality (GameRules::validatePlay) is the caller's responsibility.
+     * Accepted turns are recorded for undoTurn; a new turn drops the redo tail.
+     * The history is reserved for the whole game at the deal, so a turn
+     * allocates nothing.
      */
-    void setLastPlay(const std::vector<Card>& cards, size_t playerIndex);
+    TurnResult applyTurn(TurnAction action, std::span<const Card> cards = {});
 
     /**
-     * Clear last play (when all players pass)
+     * Revert the most recent recorded turn, taking it back out of the
+     * opponent model (redoTurn feeds it in again)
+     * @return false if there is nothing to undo
      */
-    void clearLastPlay();
+    bool undoTurn();
 
     /**
-     * Move to next player's turn
+     * Re-apply the most recently undone turn
+     * @return false if there is nothing to redo
      */
-    void nextTurn();
+    bool redoTurn();
 
-    /**
-     * Get game phase
-     */
-    GamePhase getPhase() const { return phase_; }
+    bool canUndo() const { return history_.canUndo(); }
+    bool canRedo() const { return history_.canRedo(); }
 
     /**
-     * Set game phase
+     * Turns of the current game
      */
-    void setPhase(GamePhase phase) { phase_ = phase; }
+    const TurnHistory& getHistory() const { return history_; }
 
     /**
-     * Get number of consecutive passes
+     * Check if a seat has passed in the current trick
      */
-    int getConsecutivePasses() const { return consecutivePasses_; }
+    bool hasPassed(size_t seat) const { return (passedSeats_ >> seat) & 1u; }
 
     /**
-     * Increment consecutive passes
+     * Seats that have passed in the current trick (bit i = seat i)
      */
-    void incrementPasses() { consecutivePasses_++; }
+    std::uint32_t getPassedSeats() const { return passedSeats_; }
 
     /**
-     * Reset consecutive passes
+     * Get game phase
      */
-    void resetPasses() { consecutivePasses_ = 0; }
+    GamePhase getPhase() const { return phase_; }
 
     /**
-     * Check if all other players have passed
+     * Set game phase
      */
-    bool allOthersHavePassed() const;
+    void setPhase(GamePhase phase) {
+        phase_ = phase;
+        ++version_;
+    }
 
     /**
-     * Reset all player pass flags
+     * Get number of consecutive passes
      */
-    void resetAllPasses();
+    int getConsecutivePasses() const { return consecutivePasses_; }
 
     /**
      * Find winner (player with no cards)
@@ -155,24 +247,88 @@ public:
      */
     std::string getStatusMessage() const;
 
+    /**
+     * Write the game status message without allocating
+     */
+    void formatStatusMessage(TextBuffer& out) const;
+
+    /**
+     * Counter bumped by every change made through GameState (players, deals,
+     * turns, undo/redo, phase); derived UI text is stale when it moves
+     */
+    std::uint64_t getVersion() const { return version_; }
+
     /**
      * Check if this is the very first play of the game
      */
     bool isFirstPlayOfGame() const { return firstPlayOfGame_; }
 
     /**
-     * Mark that the first play has been made
+     * Feed accepted plays and passes to an opponent model (nullptr to stop);
+     * playerIds maps seats to the model's player ids. Undo takes turns back
+     * out of the model attached at the time, so attach it before the deal.
+     */
+    void setOpponentModel(OpponentModel* model, std::span<const PlayerId> playerIds);
+
+    const OpponentModel* getOpponentModel() const { return opponentModel_; }
+    PlayerId getPlayerId(size_t seat) const { return playerIds_[seat]; }
+
+    /**
+     * Profiles of the other seats still in the trick with cards left
+     * (empty without an opponent model)
+     */
+    StaticVector<OpponentProfile, SeatTable::MAX_SEATS> getOpponentProfiles(size_t seat) const;
+
+    /**
+     * Compact copy of the table for hibernation; this table and every
+     * table unpacked from the result shuffle alike from here on
+     */
+    PackedGameState pack() const;
+
+    /**
+     * Restore a packed table; the undo history starts empty
      */
-    void setFirstPlayMade() { firstPlayOfGame_ = false; }
+    void unpack(const PackedGameState& packed);
 
 private:
-    std::vector<Player> players_;
-    Deck deck_;
+    SeatTable seats_;
+    Deck deck_;                     // Cards left after the deal, and the next shuffle's seed
     size_t currentPlayerIndex_;
-    std::vector<Card> lastPlay_;
+    PlayCards lastPlay_;
     size_t lastPlayingPlayerIndex_;
     GamePhase phase_;
     int consecutivePasses_;
+    std::uint32_t passedSeats_;     // Seats out of the current trick
+    TurnHistory history_;
+    std::uint64_t version_ = 0;
+    OpponentModel* opponentModel_ = nullptr;
+    std::array<PlayerId, SeatTable::MAX_SEATS> playerIds_{};
+
+    /**
+     * Apply a turn transition without recording it
+     */
+    TurnResult performTurn(TurnAction action, std::span<const Card> cards);
+
+    /**
+     * Feed an accepted turn to the opponent model, or take it back out
+     * (handAfter is read from the seat, so call while its hand is as the turn left it)
+     */
+    void observeTurn(size_t seat, TurnDiffKind kind, PlayType facing, std::span<const Card> cards, bool takeBack);
+
+    /**
+     * Advance to the next seat still in the trick
+     */
+    void nextTurn();
+
+    /**
+     * Clear the trick and give the lead to the last playing seat
+     */
+    void resetTrick();
+
+    /**
+     * Deal from the current deck and reset turn state
+     */
+    void dealAndBegin();
 
     /**
      * Create default player names
@@ -4,8 +4,9 @@
  */
 
 #include "Hand.h"
+#include "CardSet.h"
+#include "TextBuffer.h"
 #include <algorithm>
-#include <sstream>
 #include <stdexcept>
 
  /**
@@ -18,8 +19,8 @@ void Hand::addCard(const Card& card) {
 /**
  * Add multiple cards to the hand
  */
-void Hand::addCards(const std::vector<Card>& cards) {
-    cards_.insert(cards_.end(), cards.begin(), cards.end());
+void Hand::addCards(std::span<const Card> cards) {
+    cards_.append(cards);
 }
 
 /**
@@ -37,12 +38,10 @@ bool Hand::removeCard(const Card& card) {
 /**
  * Remove multiple cards from the hand
  */
-bool Hand::removeCards(const std::vector<Card>& cards) {
-    // First check if all cards exist
-    for (const auto& card : cards) {
-        if (!hasCard(card)) {
-            return false;
-        }
+bool Hand::removeCards(std::span<const Card> cards) {
+    // First check if all cards exist (duplicates must be held as often as listed)
+    if (!hasCards(cards)) {
+        return false;
     }
 
     // If all exist, remove them
@@ -63,13 +62,8 @@ bool Hand::hasCard(const Card& card) const {
 /**
  * Check if hand contains all specified cards
  */
-bool Hand::hasCards(const std::vector<Card>& cards) const {
-    for (const auto& card : cards) {
-        if (!hasCard(card)) {
-            return false;
-        }
-    }
-    return true;
+bool Hand::hasCards(std::span<const Card> cards) const {
+    return CardSet(cards_).contains(CardSet(cards));
 }
 
 /**
@@ -91,10 +85,12 @@ std::vector<Card> Hand::findCards(const std::vector<std::string>& cardStrings) c
     std::vector<Card> found;
     found.reserve(cardStrings.size());
 
+    // Each copy in the hand can be matched once
+    CardSet available(cards_);
     for (const auto& cardStr : cardStrings) {
         try {
             Card searchCard(cardStr);
-            if (hasCard(searchCard)) {
+            if (available.remove(searchCard)) {
                 found.push_back(searchCard);
             }
         }
@@ -140,14 +136,9 @@ std::string Hand::toString() const {
         return "Empty hand";
     }
 
-    std::ostringstream oss;
-    for (size_t i = 0; i < cards_.size(); ++i) {
-        if (i > 0) {
-            oss << " ";
-        }
-        oss << cards_[i].toString();
-    }
-    return oss.str();
+    TextBuffer text;
+    text.appendCards(cards_, false);
+    return text.str();
 }
 
 /**
@@ -158,14 +149,9 @@ std::string Hand::toDisplayString() const {
         return "Empty hand";
     }
 
-    std::ostringstream oss;
-    for (size_t i = 0; i < cards_.size(); ++i) {
-        if (i > 0) {
-            oss << " ";
-        }
-        oss << cards_[i].toDisplayString();
-    }
-    return oss.str();
+    TextBuffer text;
+    text.appendCards(cards_, true);
+    return text.str();
 }
 
 /**
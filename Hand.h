@@ -7,10 +7,18 @@
 #define HAND_H
 
 #include "Card.h"
+#include "StaticVector.h"
+#include <span>
 #include <vector>
 #include <string>
 #include <optional>
 
+/**
+ * Inline card storage: the largest deal (26 cards, two players) and the largest play
+ */
+using HandCards = StaticVector<Card, 26>;
+using PlayCards = StaticVector<Card, 5>;
+
 enum class SortOrder {
     ByRank,     // Sort by rank first, then suit
     BySuit      // Sort by suit first, then rank
@@ -25,13 +33,14 @@ public:
 
     /**
      * Add a card to the hand
+     * @throws std::length_error if the hand is full
      */
     void addCard(const Card& card);
 
     /**
      * Add multiple cards to the hand
      */
-    void addCards(const std::vector<Card>& cards);
+    void addCards(std::span<const Card> cards);
 
     /**
      * Remove a card from the hand
@@ -43,7 +52,7 @@ public:
      * Remove multiple cards from the hand
      * @return true if all cards were found and removed, false otherwise
      */
-    bool removeCards(const std::vector<Card>& cards);
+    bool removeCards(std::span<const Card> cards);
 
     /**
      * Check if hand contains a specific card
@@ -53,12 +62,12 @@ public:
     /**
      * Check if hand contains all specified cards
      */
-    bool hasCards(const std::vector<Card>& cards) const;
+    bool hasCards(std::span<const Card> cards) const;
 
     /**
      * Get all cards in the hand
      */
-    const std::vector<Card>& getCards() const { return cards_; }
+    std::span<const Card> getCards() const { return cards_; }
 
     /**
      * Get number of cards in hand
@@ -105,7 +114,7 @@ public:
     std::string toDisplayString() const;  // With unicode suit symbols
 
 private:
-    std::vector<Card> cards_;
+    HandCards cards_;
 
     /**
      * Comparator for sorting by rank
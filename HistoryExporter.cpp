@@ -0,0 +1,214 @@
+/**
+ * HistoryExporter.cpp
+ * Implementation of the columnar history exporter
+ */
+
+#include "HistoryExporter.h"
+#include <filesystem>
+#include <future>
+
+ /**
+  * Create the export directory and column files, start the writer thread
+  */
+HistoryExporter::HistoryExporter(const HistoryExportOptions& options) : options_(options) {
+    if (options_.rowGroupSize == 0) {
+        options_.rowGroupSize = 65536;
+    }
+    if (options_.queueCapacity == 0) {
+        options_.queueCapacity = 1;
+    }
+
+    std::filesystem::create_directories(options_.directory);
+
+    openTable(games_, HistoryTable::Games);
+    openTable(seats_, HistoryTable::Seats);
+    openTable(actions_, HistoryTable::Actions);
+
+    writer_ = std::thread(&HistoryExporter::writerLoop, this);
+}
+
+HistoryExporter::~HistoryExporter() {
+    try {
+        close();
+    }
+    catch (const std::exception&) {
+        // Destructors must not throw
+    }
+}
+
+/**
+ * Open the column files of a table
+ */
+void HistoryExporter::openTable(TableBuffer& buffer, HistoryTable table) {
+    buffer.table = table;
+    size_t count = HistorySchema::columnCount(table);
+    const HistoryColumnSpec* specs = HistorySchema::columns(table);
+
+    buffer.columns.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        buffer.columns[i].reserve(options_.rowGroupSize);
+        buffer.writers.push_back(std::make_unique<ColumnWriter>(
+            HistorySchema::columnPath(options_.directory, table, i), specs[i].width));
+    }
+}
+
+/**
+ * Queue a finished game
+ */
+void HistoryExporter::submit(GameRecord record) {
+    std::unique_lock<std::mutex> lock(queueMutex_);
+    queueNotFull_.wait(lock, [this] { return queue_.size() < options_.queueCapacity || stopping_; });
+    if (stopping_) {
+        throw std::runtime_error("HistoryExporter is closed");
+    }
+
+    queue_.push_back(std::move(record));
+    queueNotEmpty_.notify_one();
+}
+
+/**
+ * Flush remaining rows and finish all files
+ */
+void HistoryExporter::close() {
+    if (closed_) {
+        return;
+    }
+    closed_ = true;
+
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        stopping_ = true;
+    }
+    queueNotEmpty_.notify_all();
+    queueNotFull_.notify_all();
+
+    if (writer_.joinable()) {
+        writer_.join();
+    }
+    if (writerError_) {
+        std::rethrow_exception(writerError_);
+    }
+
+    for (TableBuffer* buffer : { &games_, &seats_, &actions_ }) {
+        flushTable(*buffer);
+        for (auto& writer : buffer->writers) {
+            writer->close();
+        }
+    }
+
+    players_.save(HistorySchema::dictionaryPath(options_.directory));
+}
+
+/**
+ * Writer thread body
+ */
+void HistoryExporter::writerLoop() {
+    std::vector<GameRecord> batch;
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(queueMutex_);
+            queueNotEmpty_.wait(lock, [this] { return !queue_.empty() || stopping_; });
+            if (queue_.empty() && stopping_) {
+                break;
+            }
+
+            // Take everything queued so producers are released at once
+            while (!queue_.empty()) {
+                batch.push_back(std::move(queue_.front()));
+                queue_.pop_front();
+            }
+        }
+        queueNotFull_.notify_all();
+
+        try {
+            for (const auto& record : batch) {
+                appendGame(record);
+                gamesWritten_.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        catch (...) {
+            // Stop accepting games; close() reports the failure
+            std::lock_guard<std::mutex> lock(queueMutex_);
+            writerError_ = std::current_exception();
+            stopping_ = true;
+            queue_.clear();
+            queueNotFull_.notify_all();
+            break;
+        }
+        batch.clear();
+    }
+}
+
+/**
+ * Append one game's rows to the table buffers
+ */
+void HistoryExporter::appendGame(const GameRecord& record) {
+    const std::uint64_t winner = record.winner < 0 ? HistorySchema::NO_WINNER : record.winner;
+
+    auto& g = games_.columns;
+    g[GameColGameId].push_back(record.gameId);
+    g[GameColNumPlayers].push_back(record.playerNames.size());
+    g[GameColWinner].push_back(winner);
+    g[GameColActionCount].push_back(record.actions.size());
+    g[GameColFirstAction].push_back(actionRows_);
+    if (games_.rows() >= options_.rowGroupSize) {
+        flushTable(games_);
+    }
+
+    for (size_t seat = 0; seat < record.playerNames.size(); ++seat) {
+        auto& s = seats_.columns;
+        s[SeatColGameId].push_back(record.gameId);
+        s[SeatColSeat].push_back(seat);
+        s[SeatColPlayer].push_back(players_.intern(record.playerNames[seat]));
+        s[SeatColPlayerType].push_back(static_cast<std::uint64_t>(record.playerTypes[seat]));
+        s[SeatColDealtMask].push_back(record.dealtHands[seat]);
+        s[SeatColCardsLeft].push_back(seat < record.cardsLeft.size() ? record.cardsLeft[seat] : 0);
+        s[SeatColWon].push_back(static_cast<std::uint64_t>(seat) == winner ? 1 : 0);
+        s[SeatColDealtCopies].push_back(seat < record.dealtCopies.size() ? record.dealtCopies[seat] : 0);
+        if (seats_.rows() >= options_.rowGroupSize) {
+            flushTable(seats_);
+        }
+    }
+
+    for (size_t i = 0; i < record.actions.size(); ++i) {
+        const ActionRecord& action = record.actions[i];
+        auto& a = actions_.columns;
+        a[ActionColGameId].push_back(record.gameId);
+        a[ActionColIndex].push_back(i);
+        a[ActionColSeat].push_back(action.seat);
+        a[ActionColType].push_back(static_cast<std::uint64_t>(action.type));
+        a[ActionColPlayKey].push_back(action.playKey);
+        a[ActionColCardsMask].push_back(action.cards);
+        a[ActionColRemaining].push_back(action.cardsRemaining);
+        a[ActionColWinner].push_back(winner);
+        a[ActionColCardsCopies].push_back(action.cardsCopies);
+        if (actions_.rows() >= options_.rowGroupSize) {
+            flushTable(actions_);
+        }
+    }
+    actionRows_ += record.actions.size();
+}
+
+/**
+ * Encode and write a table's buffered rows as one row group
+ */
+void HistoryExporter::flushTable(TableBuffer& buffer) {
+    if (buffer.rows() == 0) {
+        return;
+    }
+
+    // Columns are independent: encode them concurrently
+    std::vector<std::future<EncodedChunk>> encoded;
+    encoded.reserve(buffer.columns.size());
+    for (size_t i = 0; i < buffer.columns.size(); ++i) {
+        encoded.push_back(std::async(std::launch::async, [&buffer, i] {
+            return ColumnCodec::encode(buffer.columns[i], buffer.writers[i]->getValueWidth());
+            }));
+    }
+
+    for (size_t i = 0; i < buffer.columns.size(); ++i) {
+        buffer.writers[i]->writeChunk(encoded[i].get());
+        buffer.columns[i].clear();
+    }
+}
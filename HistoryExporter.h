@@ -0,0 +1,117 @@
+/**
+ * HistoryExporter.hpp
+ * Writes game records into columnar tables (see HistorySchema.h)
+ *
+ * Producers call submit() from any thread; a writer thread appends rows to
+ * per-table row groups and, when a row group fills, encodes its columns in
+ * parallel before writing them out.
+ */
+
+#ifndef HISTORYEXPORTER_H
+#define HISTORYEXPORTER_H
+
+#include "ColumnStore.h"
+#include "GameRecord.h"
+#include "HistorySchema.h"
+#include "StringDictionary.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Export settings
+ */
+struct HistoryExportOptions {
+    std::string directory;              // Created if missing
+    std::uint32_t rowGroupSize = 65536; // Rows per chunk
+    size_t queueCapacity = 4096;        // Games buffered before submit() blocks
+};
+
+/**
+ * HistoryExporter class
+ */
+class HistoryExporter {
+public:
+    /**
+     * Create the export directory and column files, start the writer thread
+     * @throws std::runtime_error if files cannot be created
+     */
+    explicit HistoryExporter(const HistoryExportOptions& options);
+    ~HistoryExporter();
+
+    HistoryExporter(const HistoryExporter&) = delete;
+    HistoryExporter& operator=(const HistoryExporter&) = delete;
+
+    /**
+     * Queue a finished game (thread-safe, blocks while the queue is full)
+     */
+    void submit(GameRecord record);
+
+    /**
+     * Flush remaining rows, write directories and the dictionary
+     * @throws std::runtime_error if the writer thread failed
+     */
+    void close();
+
+    /**
+     * Number of games written so far
+     */
+    std::uint64_t getGamesWritten() const { return gamesWritten_.load(); }
+
+private:
+    /**
+     * Row buffer and column writers of one table
+     */
+    struct TableBuffer {
+        HistoryTable table = HistoryTable::Games;
+        std::vector<std::vector<std::uint64_t>> columns;
+        std::vector<std::unique_ptr<ColumnWriter>> writers;
+
+        size_t rows() const { return columns.empty() ? 0 : columns[0].size(); }
+    };
+
+    HistoryExportOptions options_;
+    TableBuffer games_;
+    TableBuffer seats_;
+    TableBuffer actions_;
+    StringDictionary players_;
+    std::uint64_t actionRows_ = 0;
+
+    std::deque<GameRecord> queue_;
+    std::mutex queueMutex_;
+    std::condition_variable queueNotEmpty_;
+    std::condition_variable queueNotFull_;
+    bool stopping_ = false;
+    bool closed_ = false;
+    std::atomic<std::uint64_t> gamesWritten_{ 0 };
+    std::exception_ptr writerError_;
+    std::thread writer_;
+
+    /**
+     * Open the column files of a table
+     */
+    void openTable(TableBuffer& buffer, HistoryTable table);
+
+    /**
+     * Writer thread body
+     */
+    void writerLoop();
+
+    /**
+     * Append one game's rows to the table buffers
+     */
+    void appendGame(const GameRecord& record);
+
+    /**
+     * Encode and write a table's buffered rows as one row group
+     */
+    void flushTable(TableBuffer& buffer);
+};
+
+#endif // HISTORYEXPORTER_HPP
@@ -0,0 +1,441 @@
+/**
+ * HistoryQuery.cpp
+ * Implementation of the morsel-parallel history query engine
+ */
+
+#include "HistoryQuery.h"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+/**
+ * Per-worker decode buffers for action columns
+ */
+struct HistoryQuery::ActionScratch {
+    std::vector<std::uint8_t> type;
+    std::vector<std::uint8_t> seat;
+    std::vector<std::uint8_t> winner;
+    std::vector<std::uint16_t> index;
+    std::vector<std::uint16_t> key;
+    std::vector<std::uint64_t> cards;
+};
+
+namespace {
+
+    /**
+     * Zone-map check: can value occur in the chunk?
+     */
+    bool chunkMayContain(const ColumnChunkInfo& info, std::uint64_t value) {
+        return info.rowCount > 0 && value >= info.minValue && value <= info.maxValue;
+    }
+
+    /**
+     * selection[i] &= (column[i] == value)
+     */
+    template <typename T>
+    void filterEquals(std::span<const T> column, T value, std::vector<std::uint8_t>& selection) {
+        std::uint8_t* sel = selection.data();
+        const T* values = column.data();
+        const size_t n = column.size();
+        for (size_t i = 0; i < n; ++i) {
+            sel[i] &= static_cast<std::uint8_t>(values[i] == value);
+        }
+    }
+
+    /**
+     * Any row still selected?
+     */
+    bool anySelected(const std::vector<std::uint8_t>& selection) {
+        return std::find(selection.begin(), selection.end(), std::uint8_t{ 1 }) != selection.end();
+    }
+
+} // namespace
+
+/**
+ * Open an export directory
+ */
+HistoryQuery::HistoryQuery(const std::string& directory, unsigned numThreads)
+    : games_(openTable(directory, HistoryTable::Games)),
+    seats_(openTable(directory, HistoryTable::Seats)),
+    actions_(openTable(directory, HistoryTable::Actions)),
+    players_(StringDictionary::load(HistorySchema::dictionaryPath(directory))),
+    numThreads_(numThreads) {
+    if (numThreads_ == 0) {
+        numThreads_ = std::max(1u, std::thread::hardware_concurrency());
+    }
+}
+
+/**
+ * Open all column files of a table
+ */
+std::vector<std::unique_ptr<ColumnReader>> HistoryQuery::openTable(const std::string& directory,
+    HistoryTable table) {
+    std::vector<std::unique_ptr<ColumnReader>> columns;
+    const HistoryColumnSpec* specs = HistorySchema::columns(table);
+
+    for (size_t i = 0; i < HistorySchema::columnCount(table); ++i) {
+        auto reader = std::make_unique<ColumnReader>(HistorySchema::columnPath(directory, table, i));
+        if (reader->getValueWidth() != specs[i].width) {
+            throw std::runtime_error(std::string("Unexpected width for column ") + specs[i].name);
+        }
+        if (!columns.empty() && reader->getChunkCount() != columns[0]->getChunkCount()) {
+            throw std::runtime_error(std::string("Row groups out of step in column ") + specs[i].name);
+        }
+        columns.push_back(std::move(reader));
+    }
+    return columns;
+}
+
+/**
+ * Run fn(worker, chunk) over all chunks, morsel-wise across workers
+ */
+template <typename Fn>
+void HistoryQuery::forEachChunk(size_t chunkCount, Fn&& fn) const {
+    unsigned workers = static_cast<unsigned>(std::min<size_t>(numThreads_, std::max<size_t>(chunkCount, 1)));
+
+    std::atomic<size_t> nextChunk{ 0 };
+    std::exception_ptr error;
+    std::mutex errorMutex;
+
+    auto body = [&](unsigned worker) {
+        try {
+            while (true) {
+                size_t chunk = nextChunk.fetch_add(1, std::memory_order_relaxed);
+                if (chunk >= chunkCount) {
+                    break;
+                }
+                fn(worker, chunk);
+            }
+        }
+        catch (...) {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if (!error) {
+                error = std::current_exception();
+            }
+            nextChunk.store(chunkCount);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned w = 1; w < workers; ++w) {
+        threads.emplace_back(body, w);
+    }
+    body(0);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+/**
+ * Win rate / cards left aggregates over seats
+ */
+std::vector<SeatGroupResult> HistoryQuery::seatStats(const SeatFilter& filter, SeatGroupBy groupBy) const {
+    size_t keySpace = 1;
+    switch (groupBy) {
+    case SeatGroupBy::None:       keySpace = 1; break;
+    case SeatGroupBy::Seat:       keySpace = 256; break;
+    case SeatGroupBy::PlayerType: keySpace = 256; break;
+    case SeatGroupBy::Player:     keySpace = std::max<size_t>(players_.size(), 1); break;
+    }
+
+    struct WorkerState {
+        std::vector<SeatGroupResult> groups;
+        std::vector<std::uint8_t> selection;
+        std::vector<std::uint8_t> seat, type, left, won;
+        std::vector<std::uint32_t> player;
+        std::vector<std::uint64_t> dealt;
+    };
+    std::vector<WorkerState> states(numThreads_);
+    for (auto& state : states) {
+        state.groups.resize(keySpace);
+    }
+
+    forEachChunk(seats_[0]->getChunkCount(), [&](unsigned worker, size_t chunk) {
+        WorkerState& st = states[worker];
+        const size_t n = seats_[0]->getChunkInfo(chunk).rowCount;
+
+        if (filter.seat && !chunkMayContain(seats_[SeatColSeat]->getChunkInfo(chunk), *filter.seat)) {
+            return;
+        }
+        if (filter.player && !chunkMayContain(seats_[SeatColPlayer]->getChunkInfo(chunk), *filter.player)) {
+            return;
+        }
+
+        st.selection.assign(n, 1);
+        std::uint8_t* sel = st.selection.data();
+
+        if (filter.dealtAll != 0 || filter.dealtNone != 0) {
+            auto dealt = seats_[SeatColDealtMask]->chunk<std::uint64_t>(chunk, st.dealt);
+            const CardMask all = filter.dealtAll;
+            const CardMask none = filter.dealtNone;
+            for (size_t i = 0; i < n; ++i) {
+                sel[i] &= static_cast<std::uint8_t>(((dealt[i] & all) == all) & ((dealt[i] & none) == 0));
+            }
+        }
+
+        std::span<const std::uint8_t> seats;
+        std::span<const std::uint8_t> types;
+        std::span<const std::uint32_t> players;
+        if (filter.seat || groupBy == SeatGroupBy::Seat) {
+            seats = seats_[SeatColSeat]->chunk<std::uint8_t>(chunk, st.seat);
+        }
+        if (filter.playerType || groupBy == SeatGroupBy::PlayerType) {
+            types = seats_[SeatColPlayerType]->chunk<std::uint8_t>(chunk, st.type);
+        }
+        if (filter.player || groupBy == SeatGroupBy::Player) {
+            players = seats_[SeatColPlayer]->chunk<std::uint32_t>(chunk, st.player);
+        }
+
+        if (filter.seat) {
+            filterEquals(seats, *filter.seat, st.selection);
+        }
+        if (filter.playerType) {
+            filterEquals(types, static_cast<std::uint8_t>(*filter.playerType), st.selection);
+        }
+        if (filter.player) {
+            filterEquals(players, *filter.player, st.selection);
+        }
+
+        auto won = seats_[SeatColWon]->chunk<std::uint8_t>(chunk, st.won);
+        auto left = seats_[SeatColCardsLeft]->chunk<std::uint8_t>(chunk, st.left);
+
+        if (groupBy == SeatGroupBy::None) {
+            // Branch-free sums over the whole morsel
+            std::uint64_t rows = 0;
+            std::uint64_t wins = 0;
+            std::uint64_t cardsLeft = 0;
+            for (size_t i = 0; i < n; ++i) {
+                rows += sel[i];
+                wins += sel[i] & won[i];
+                cardsLeft += static_cast<std::uint64_t>(sel[i]) * left[i];
+            }
+            st.groups[0].rows += rows;
+            st.groups[0].wins += wins;
+            st.groups[0].cardsLeftSum += cardsLeft;
+            return;
+        }
+
+        for (size_t i = 0; i < n; ++i) {
+            size_t key = 0;
+            switch (groupBy) {
+            case SeatGroupBy::Seat:       key = seats[i]; break;
+            case SeatGroupBy::PlayerType: key = types[i]; break;
+            case SeatGroupBy::Player:     key = std::min<size_t>(players[i], keySpace - 1); break;
+            default:                      break;
+            }
+            SeatGroupResult& group = st.groups[key];
+            group.rows += sel[i];
+            group.wins += sel[i] & won[i];
+            group.cardsLeftSum += static_cast<std::uint64_t>(sel[i]) * left[i];
+        }
+        });
+
+    // Merge per-worker partials
+    std::vector<SeatGroupResult> results;
+    for (size_t key = 0; key < keySpace; ++key) {
+        SeatGroupResult merged;
+        merged.key = key;
+        for (const auto& state : states) {
+            merged.rows += state.groups[key].rows;
+            merged.wins += state.groups[key].wins;
+            merged.cardsLeftSum += state.groups[key].cardsLeftSum;
+        }
+        if (merged.rows > 0 || groupBy == SeatGroupBy::None) {
+            results.push_back(merged);
+        }
+    }
+    return results;
+}
+
+/**
+ * Build the selection vector of an action chunk
+ */
+bool HistoryQuery::selectActions(const ActionFilter& filter, size_t chunk,
+    std::vector<std::uint8_t>& selection, ActionScratch& scratch) const {
+    const size_t n = actions_[0]->getChunkInfo(chunk).rowCount;
+
+    // Zone maps
+    if (filter.openingOnly && !chunkMayContain(actions_[ActionColIndex]->getChunkInfo(chunk), 0)) {
+        return false;
+    }
+    if (filter.type &&
+        !chunkMayContain(actions_[ActionColType]->getChunkInfo(chunk), static_cast<std::uint64_t>(*filter.type))) {
+        return false;
+    }
+    if (filter.seat && !chunkMayContain(actions_[ActionColSeat]->getChunkInfo(chunk), *filter.seat)) {
+        return false;
+    }
+
+    selection.assign(n, 1);
+    std::uint8_t* sel = selection.data();
+
+    if (filter.openingOnly) {
+        filterEquals(actions_[ActionColIndex]->chunk<std::uint16_t>(chunk, scratch.index),
+            std::uint16_t{ 0 }, selection);
+    }
+    if (filter.type) {
+        filterEquals(actions_[ActionColType]->chunk<std::uint8_t>(chunk, scratch.type),
+            static_cast<std::uint8_t>(*filter.type), selection);
+    }
+
+    if (filter.seat || filter.winnerOnly) {
+        auto seats = actions_[ActionColSeat]->chunk<std::uint8_t>(chunk, scratch.seat);
+        if (filter.seat) {
+            filterEquals(seats, *filter.seat, selection);
+        }
+        if (filter.winnerOnly) {
+            auto winners = actions_[ActionColWinner]->chunk<std::uint8_t>(chunk, scratch.winner);
+            for (size_t i = 0; i < n; ++i) {
+                sel[i] &= static_cast<std::uint8_t>(seats[i] == winners[i]);
+            }
+        }
+    }
+
+    if (filter.playType || filter.fiveCardType) {
+        auto keys = actions_[ActionColPlayKey]->chunk<std::uint16_t>(chunk, scratch.key);
+        if (filter.playType) {
+            const unsigned type = static_cast<unsigned>(*filter.playType);
+            for (size_t i = 0; i < n; ++i) {
+                sel[i] &= static_cast<std::uint8_t>((keys[i] >> 9) == type);
+            }
+        }
+        if (filter.fiveCardType) {
+            const unsigned type = static_cast<unsigned>(PlayType::FiveCard);
+            const unsigned rank = static_cast<unsigned>(GameRules::getFiveCardRank(*filter.fiveCardType));
+            for (size_t i = 0; i < n; ++i) {
+                sel[i] &= static_cast<std::uint8_t>(((keys[i] >> 9) == type) & (((keys[i] >> 6) & 7u) == rank));
+            }
+        }
+    }
+
+    if (filter.cardsAll != 0 || filter.cardsAny != 0) {
+        auto cards = actions_[ActionColCardsMask]->chunk<std::uint64_t>(chunk, scratch.cards);
+        const CardMask all = filter.cardsAll;
+        const CardMask any = filter.cardsAny;
+        for (size_t i = 0; i < n; ++i) {
+            sel[i] &= static_cast<std::uint8_t>(((cards[i] & all) == all) & ((any == 0) | ((cards[i] & any) != 0)));
+        }
+    }
+
+    return anySelected(selection);
+}
+
+/**
+ * Most common plays matching a filter
+ */
+std::vector<PlayCountResult> HistoryQuery::topPlays(const ActionFilter& filter, PlayGroupBy groupBy,
+    size_t limit) const {
+    struct WorkerState {
+        std::unordered_map<std::uint64_t, std::uint64_t> counts;
+        std::vector<std::uint64_t> keyCounts;
+        std::vector<std::uint8_t> selection;
+        ActionScratch scratch;
+    };
+    std::vector<WorkerState> states(numThreads_);
+    for (auto& state : states) {
+        if (groupBy == PlayGroupBy::PlayKey) {
+            state.keyCounts.assign(1 << 12, 0);
+        }
+    }
+
+    // Passes have no cards; counting them as plays is never useful
+    ActionFilter playFilter = filter;
+    playFilter.type = ActionType::Play;
+
+    forEachChunk(actions_[0]->getChunkCount(), [&](unsigned worker, size_t chunk) {
+        WorkerState& st = states[worker];
+        if (!selectActions(playFilter, chunk, st.selection, st.scratch)) {
+            return;
+        }
+
+        const size_t n = st.selection.size();
+        if (groupBy == PlayGroupBy::PlayKey) {
+            auto keys = actions_[ActionColPlayKey]->chunk<std::uint16_t>(chunk, st.scratch.key);
+            for (size_t i = 0; i < n; ++i) {
+                st.keyCounts[keys[i] & 0xFFF] += st.selection[i];
+            }
+        }
+        else {
+            auto cards = actions_[ActionColCardsMask]->chunk<std::uint64_t>(chunk, st.scratch.cards);
+            for (size_t i = 0; i < n; ++i) {
+                if (st.selection[i]) {
+                    ++st.counts[cards[i]];
+                }
+            }
+        }
+        });
+
+    std::unordered_map<std::uint64_t, std::uint64_t> merged;
+    for (const auto& state : states) {
+        for (const auto& [key, count] : state.counts) {
+            merged[key] += count;
+        }
+        for (size_t key = 0; key < state.keyCounts.size(); ++key) {
+            if (state.keyCounts[key] > 0) {
+                merged[key] += state.keyCounts[key];
+            }
+        }
+    }
+
+    std::vector<PlayCountResult> results;
+    results.reserve(merged.size());
+    for (const auto& [key, count] : merged) {
+        results.push_back({ key, count });
+    }
+
+    limit = std::min(limit, results.size());
+    std::partial_sort(results.begin(), results.begin() + limit, results.end(),
+        [](const PlayCountResult& a, const PlayCountResult& b) {
+            return a.count != b.count ? a.count > b.count : a.key < b.key;
+        });
+    results.resize(limit);
+    return results;
+}
+
+/**
+ * Number of matching actions
+ */
+std::uint64_t HistoryQuery::countActions(const ActionFilter& filter) const {
+    struct alignas(64) WorkerState {
+        std::uint64_t count = 0;
+        std::vector<std::uint8_t> selection;
+        ActionScratch scratch;
+    };
+    std::vector<WorkerState> states(numThreads_);
+
+    forEachChunk(actions_[0]->getChunkCount(), [&](unsigned worker, size_t chunk) {
+        WorkerState& st = states[worker];
+        if (!selectActions(filter, chunk, st.selection, st.scratch)) {
+            return;
+        }
+        std::uint64_t count = 0;
+        for (std::uint8_t s : st.selection) {
+            count += s;
+        }
+        st.count += count;
+        });
+
+    std::uint64_t total = 0;
+    for (const auto& state : states) {
+        total += state.count;
+    }
+    return total;
+}
+
+/**
+ * Row counts
+ */
+std::uint64_t HistoryQuery::getGameCount() const {
+    return games_[0]->getRowCount();
+}
+
+std::uint64_t HistoryQuery::getActionCount() const {
+    return actions_[0]->getRowCount();
+}
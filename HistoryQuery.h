@@ -0,0 +1,162 @@
+/**
+ * HistoryQuery.hpp
+ * Embedded query engine over exported game histories
+ *
+ * Column files are memory-mapped; each row-group chunk is a morsel that
+ * worker threads claim from a shared counter. Within a morsel, predicates
+ * are evaluated column-at-a-time into a selection vector, then aggregated
+ * into per-thread partial results that are merged at the end. Chunks whose
+ * zone maps cannot match a predicate are skipped without decoding.
+ */
+
+#ifndef HISTORYQUERY_H
+#define HISTORYQUERY_H
+
+#include "CardMask.h"
+#include "ColumnStore.h"
+#include "GameRecord.h"
+#include "GameRules.h"
+#include "HistorySchema.h"
+#include "Player.h"
+#include "StringDictionary.h"
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+/**
+ * Predicate on the seats table (one row per seat per game)
+ */
+struct SeatFilter {
+    CardMask dealtAll = 0;                  // Seat was dealt all of these cards
+    CardMask dealtNone = 0;                 // Seat was dealt none of these cards
+    std::optional<std::uint8_t> seat;
+    std::optional<PlayerType> playerType;
+    std::optional<std::uint32_t> player;    // Id in the player dictionary
+};
+
+/**
+ * Predicate on the actions table
+ */
+struct ActionFilter {
+    std::optional<ActionType> type;
+    std::optional<PlayType> playType;
+    std::optional<FiveCardType> fiveCardType;
+    CardMask cardsAll = 0;                  // Play contains all of these cards
+    CardMask cardsAny = 0;                  // Play contains at least one of these cards
+    std::optional<std::uint8_t> seat;
+    bool openingOnly = false;               // First action of the game
+    bool winnerOnly = false;                // Acting seat went on to win
+};
+
+/**
+ * Grouping for seat aggregates
+ */
+enum class SeatGroupBy {
+    None,
+    Seat,
+    PlayerType,
+    Player
+};
+
+/**
+ * Grouping for play counts
+ */
+enum class PlayGroupBy {
+    Cards,      // Exact cards (CardMask)
+    PlayKey     // Play type and strength (GameRules::getPlayKey)
+};
+
+/**
+ * Aggregate over matching seat rows
+ */
+struct SeatGroupResult {
+    std::uint64_t key = 0;          // Seat, PlayerType or player id
+    std::uint64_t rows = 0;
+    std::uint64_t wins = 0;
+    std::uint64_t cardsLeftSum = 0;
+
+    double winRate() const { return rows ? static_cast<double>(wins) / rows : 0.0; }
+    double averageCardsLeft() const { return rows ? static_cast<double>(cardsLeftSum) / rows : 0.0; }
+};
+
+/**
+ * Count of a distinct play
+ */
+struct PlayCountResult {
+    std::uint64_t key = 0;          // CardMask or play key
+    std::uint64_t count = 0;
+};
+
+/**
+ * HistoryQuery class
+ */
+class HistoryQuery {
+public:
+    /**
+     * Open an export directory
+     * @param numThreads Worker threads, 0 = hardware concurrency
+     * @throws std::runtime_error if column files are missing or malformed
+     */
+    explicit HistoryQuery(const std::string& directory, unsigned numThreads = 0);
+
+    /**
+     * Win rate / cards left aggregates over seats
+     * Results are sorted by key
+     */
+    std::vector<SeatGroupResult> seatStats(const SeatFilter& filter, SeatGroupBy groupBy) const;
+
+    /**
+     * Most common plays matching a filter, most frequent first
+     */
+    std::vector<PlayCountResult> topPlays(const ActionFilter& filter, PlayGroupBy groupBy,
+        size_t limit) const;
+
+    /**
+     * Number of matching actions
+     */
+    std::uint64_t countActions(const ActionFilter& filter) const;
+
+    /**
+     * Row counts
+     */
+    std::uint64_t getGameCount() const;
+    std::uint64_t getActionCount() const;
+
+    /**
+     * Player name dictionary
+     */
+    const StringDictionary& getPlayers() const { return players_; }
+
+    unsigned getNumThreads() const { return numThreads_; }
+
+private:
+    struct ActionScratch;
+
+    std::vector<std::unique_ptr<ColumnReader>> games_;
+    std::vector<std::unique_ptr<ColumnReader>> seats_;
+    std::vector<std::unique_ptr<ColumnReader>> actions_;
+    StringDictionary players_;
+    unsigned numThreads_;
+
+    /**
+     * Open all column files of a table; all columns must share row groups
+     */
+    static std::vector<std::unique_ptr<ColumnReader>> openTable(const std::string& directory,
+        HistoryTable table);
+
+    /**
+     * Run fn(worker, chunk) over all chunks, morsel-wise across workers
+     */
+    template <typename Fn>
+    void forEachChunk(size_t chunkCount, Fn&& fn) const;
+
+    /**
+     * Build the selection vector of an action chunk
+     * @return false if no row can match
+     */
+    bool selectActions(const ActionFilter& filter, size_t chunk,
+        std::vector<std::uint8_t>& selection, ActionScratch& scratch) const;
+};
+
+#endif // HISTORYQUERY_HPP
@@ -0,0 +1,88 @@
+/**
+ * HistorySchema.cpp
+ * Column specs of the exported history tables
+ */
+
+#include "HistorySchema.h"
+
+namespace {
+
+    const HistoryColumnSpec GAME_COLUMNS[GameColumnCount] = {
+        { "game_id", 8 },
+        { "num_players", 1 },
+        { "winner", 1 },
+        { "action_count", 4 },
+        { "first_action", 8 }
+    };
+
+    const HistoryColumnSpec SEAT_COLUMNS[SeatColumnCount] = {
+        { "game_id", 8 },
+        { "seat", 1 },
+        { "player", 4 },
+        { "player_type", 1 },
+        { "dealt_mask", 8 },
+        { "cards_left", 1 },
+        { "won", 1 },
+        { "dealt_copies", 8 }
+    };
+
+    const HistoryColumnSpec ACTION_COLUMNS[ActionColumnCount] = {
+        { "game_id", 8 },
+        { "action_index", 2 },
+        { "seat", 1 },
+        { "action_type", 1 },
+        { "play_key", 2 },
+        { "cards_mask", 8 },
+        { "cards_remaining", 1 },
+        { "winner", 1 },
+        { "cards_copies", 8 }
+    };
+
+} // namespace
+
+/**
+ * Table name used in file names
+ */
+const char* HistorySchema::tableName(HistoryTable table) {
+    switch (table) {
+    case HistoryTable::Games:   return "games";
+    case HistoryTable::Seats:   return "seats";
+    case HistoryTable::Actions: return "actions";
+    default:                    return "unknown";
+    }
+}
+
+/**
+ * Column specs of a table
+ */
+const HistoryColumnSpec* HistorySchema::columns(HistoryTable table) {
+    switch (table) {
+    case HistoryTable::Games:   return GAME_COLUMNS;
+    case HistoryTable::Seats:   return SEAT_COLUMNS;
+    case HistoryTable::Actions: return ACTION_COLUMNS;
+    default:                    return nullptr;
+    }
+}
+
+size_t HistorySchema::columnCount(HistoryTable table) {
+    switch (table) {
+    case HistoryTable::Games:   return GameColumnCount;
+    case HistoryTable::Seats:   return SeatColumnCount;
+    case HistoryTable::Actions: return ActionColumnCount;
+    default:                    return 0;
+    }
+}
+
+/**
+ * Path of a column file inside an export directory
+ */
+std::string HistorySchema::columnPath(const std::string& directory, HistoryTable table, size_t column) {
+    return directory + "/" + tableName(table) + "." + columns(table)[column].name + ".col";
+}
+
+/**
+ * Path of the player name dictionary
+ */
+std::string HistorySchema::dictionaryPath(const std::string& directory) {
+    return directory + "/players.dict";
+}
@@ -0,0 +1,107 @@
+/**
+ * HistorySchema.hpp
+ * Table and column layout of exported game histories
+ *
+ * An export directory holds three tables, one column file per column:
+ *   games.<column>.col    one row per game
+ *   seats.<column>.col    one row per (game, seat)
+ *   actions.<column>.col  one row per play or pass, in game order
+ * plus players.dict, the dictionary for seats.player.
+ */
+
+#ifndef HISTORYSCHEMA_H
+#define HISTORYSCHEMA_H
+
+#include <cstdint>
+#include <string>
+
+/**
+ * Column name and value width in bytes
+ */
+struct HistoryColumnSpec {
+    const char* name;
+    std::uint32_t width;
+};
+
+/**
+ * History tables
+ */
+enum class HistoryTable {
+    Games,
+    Seats,
+    Actions
+};
+
+/**
+ * Column indices of the games table
+ */
+enum GameColumn {
+    GameColGameId,          // u64
+    GameColNumPlayers,      // u8
+    GameColWinner,          // u8, 255 if unfinished
+    GameColActionCount,     // u32
+    GameColFirstAction,     // u64, row of the first action in the actions table
+    GameColumnCount
+};
+
+/**
+ * Column indices of the seats table
+ */
+enum SeatColumn {
+    SeatColGameId,          // u64
+    SeatColSeat,            // u8
+    SeatColPlayer,          // u32, id in players.dict
+    SeatColPlayerType,      // u8, PlayerType
+    SeatColDealtMask,       // u64, CardMask at deal
+    SeatColCardsLeft,       // u8, cards in hand at game end
+    SeatColWon,             // u8, 1 if this seat won
+    SeatColDealtCopies,     // u64, cards dealt twice (two-deck tables)
+    SeatColumnCount
+};
+
+/**
+ * Column indices of the actions table
+ */
+enum ActionColumn {
+    ActionColGameId,        // u64
+    ActionColIndex,         // u16, action number within the game
+    ActionColSeat,          // u8
+    ActionColType,          // u8, ActionType
+    ActionColPlayKey,       // u16, GameRules::getPlayKey
+    ActionColCardsMask,     // u64, CardMask of the cards played
+    ActionColRemaining,     // u8, cards left after the action
+    ActionColWinner,        // u8, winning seat of the game (denormalized for scans)
+    ActionColCardsCopies,   // u64, cards played twice (two-deck tables)
+    ActionColumnCount
+};
+
+/**
+ * Schema helpers
+ */
+class HistorySchema {
+public:
+    static constexpr std::uint8_t NO_WINNER = 255;
+
+    /**
+     * Table name used in file names
+     */
+    static const char* tableName(HistoryTable table);
+
+    /**
+     * Column specs of a table
+     */
+    static const HistoryColumnSpec* columns(HistoryTable table);
+    static size_t columnCount(HistoryTable table);
+
+    /**
+     * Path of a column file inside an export directory
+     */
+    static std::string columnPath(const std::string& directory, HistoryTable table, size_t column);
+
+    /**
+     * Path of the player name dictionary
+     */
+    static std::string dictionaryPath(const std::string& directory);
+};
+
+#endif // HISTORYSCHEMA_HPP
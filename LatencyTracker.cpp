@@ -0,0 +1,214 @@
+/**
+ * LatencyTracker.cpp
+ * Implementation of LatencyTracker
+ */
+
+#include "LatencyTracker.h"
+#include <algorithm>
+#include <bit>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+/**
+ * Bucket of a latency: exact below 8 ns, then 8 buckets per power of two
+ */
+size_t LatencyHistogram::bucketOf(std::uint64_t nanos) {
+    constexpr std::uint64_t subBuckets = std::uint64_t{ 1 } << SUB_BUCKET_BITS;
+    if (nanos < subBuckets) {
+        return static_cast<size_t>(nanos);
+    }
+    int exponent = std::bit_width(nanos) - 1;
+    if (exponent > MAX_EXPONENT) {
+        return BUCKET_COUNT - 1;
+    }
+    std::uint64_t sub = (nanos >> (exponent - SUB_BUCKET_BITS)) & (subBuckets - 1);
+    return (static_cast<size_t>(exponent - SUB_BUCKET_BITS + 1) << SUB_BUCKET_BITS) + static_cast<size_t>(sub);
+}
+
+/**
+ * Largest latency counted in a bucket
+ */
+std::uint64_t LatencyHistogram::bucketUpperBound(size_t bucket) {
+    constexpr size_t subBuckets = size_t{ 1 } << SUB_BUCKET_BITS;
+    if (bucket < subBuckets) {
+        return bucket;
+    }
+    if (bucket == BUCKET_COUNT - 1) {
+        return std::numeric_limits<std::uint64_t>::max();
+    }
+    int shift = static_cast<int>(bucket >> SUB_BUCKET_BITS) - 1;
+    std::uint64_t lower = static_cast<std::uint64_t>(subBuckets + (bucket & (subBuckets - 1))) << shift;
+    return lower + (std::uint64_t{ 1 } << shift) - 1;
+}
+
+/**
+ * Latency below which a fraction of the recorded ones fall
+ */
+std::uint64_t LatencyHistogram::percentile(double fraction) const {
+    std::array<std::uint64_t, BUCKET_COUNT> counts;
+    std::uint64_t total = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+        counts[i] = counts_[i].load(std::memory_order_relaxed);
+        total += counts[i];
+    }
+    if (total == 0) {
+        return 0;
+    }
+
+    fraction = std::clamp(fraction, 0.0, 1.0);
+    std::uint64_t rank = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(fraction * static_cast<double>(total) + 0.5));
+    std::uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+        seen += counts[i];
+        if (seen >= rank) {
+            return bucketUpperBound(i);
+        }
+    }
+    return bucketUpperBound(BUCKET_COUNT - 1);
+}
+
+std::uint64_t LatencyHistogram::getCount() const {
+    std::uint64_t total = 0;
+    for (const auto& count : counts_) {
+        total += count.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+void LatencyHistogram::clear() {
+    for (auto& count : counts_) {
+        count.store(0, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * Constructor
+ */
+LatencyTracker::LatencyTracker() : samples_(std::make_unique<ActionSpan[]>(MAX_SAMPLES)) {
+}
+
+/**
+ * Clear histograms and samples and start tracing
+ */
+void LatencyTracker::start(std::uint32_t sampleEvery) {
+    for (auto& histogram : histograms_) {
+        histogram.clear();
+    }
+    sampleCount_.store(0, std::memory_order_relaxed);
+    dropped_.store(0, std::memory_order_relaxed);
+    sampleEvery_.store(std::max(1u, sampleEvery), std::memory_order_relaxed);
+    enabled_.store(true, std::memory_order_release);
+}
+
+/**
+ * Stop tracing
+ */
+void LatencyTracker::stop() {
+    enabled_.store(false, std::memory_order_release);
+}
+
+/**
+ * Open a span at the start of the Receive stage
+ */
+ActionSpan LatencyTracker::begin() {
+    ActionSpan span;
+    if (isEnabled()) {
+        span.spanId = nextSpanId_.fetch_add(1, std::memory_order_relaxed);
+        span.startNs = nowNs();
+        span.markNs = span.startNs;
+    }
+    return span;
+}
+
+/**
+ * Close a stage of a span at the current time
+ */
+void LatencyTracker::mark(ActionSpan& span, LatencyStage stage) {
+    if (!span) {
+        return;
+    }
+    std::int64_t now = nowNs();
+    std::uint64_t elapsed = static_cast<std::uint64_t>(std::max<std::int64_t>(0, now - span.markNs));
+    span.markNs = now;
+
+    size_t index = static_cast<size_t>(stage);
+    std::uint64_t total = span.stageNs[index] + elapsed;
+    span.stageNs[index] = static_cast<std::uint32_t>(std::min<std::uint64_t>(total, std::numeric_limits<std::uint32_t>::max()));
+    span.stages |= 1u << index;
+    histograms_[index].record(elapsed);
+}
+
+/**
+ * Record the span's total, and keep it if sampled
+ */
+void LatencyTracker::finish(ActionSpan& span) {
+    if (!span) {
+        return;
+    }
+    std::uint64_t total = static_cast<std::uint64_t>(std::max<std::int64_t>(0, span.markNs - span.startNs));
+    size_t index = static_cast<size_t>(LatencyStage::Total);
+    span.stageNs[index] = static_cast<std::uint32_t>(std::min<std::uint64_t>(total, std::numeric_limits<std::uint32_t>::max()));
+    span.stages |= 1u << index;
+    histograms_[index].record(total);
+
+    if (span.spanId % sampleEvery_.load(std::memory_order_relaxed) == 0) {
+        size_t slot = sampleCount_.fetch_add(1, std::memory_order_relaxed);
+        if (slot < MAX_SAMPLES) {
+            samples_[slot] = span;
+        }
+        else {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    span = ActionSpan();
+}
+
+size_t LatencyTracker::getSampleCount() const {
+    return std::min(sampleCount_.load(std::memory_order_relaxed), MAX_SAMPLES);
+}
+
+/**
+ * Write the sampled spans as JSON lines
+ */
+size_t LatencyTracker::exportSamples(const std::string& path) const {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("Cannot write latency samples: " + path);
+    }
+
+    size_t count = getSampleCount();
+    for (size_t i = 0; i < count; ++i) {
+        const ActionSpan& span = samples_[i];
+        out << "{\"span\":" << span.spanId << ",\"action\":\"" << span.action << '"';
+        for (size_t stage = 0; stage < LATENCY_STAGE_COUNT; ++stage) {
+            if (!((span.stages >> stage) & 1u)) {
+                continue;
+            }
+            char micros[32];
+            std::snprintf(micros, sizeof(micros), "%.3f", static_cast<double>(span.stageNs[stage]) / 1000.0);
+            out << ",\"" << getStageName(static_cast<LatencyStage>(stage)) << "_us\":" << micros;
+        }
+        out << "}\n";
+    }
+
+    if (!out) {
+        throw std::runtime_error("Failed writing latency samples: " + path);
+    }
+    return count;
+}
+
+const char* LatencyTracker::getStageName(LatencyStage stage) {
+    switch (stage) {
+    case LatencyStage::Receive: return "receive";
+    case LatencyStage::QueueWait: return "queue";
+    case LatencyStage::Parse: return "parse";
+    case LatencyStage::Validate: return "validate";
+    case LatencyStage::Mutate: return "mutate";
+    case LatencyStage::Bots: return "bots";
+    case LatencyStage::Broadcast: return "broadcast";
+    case LatencyStage::Total: return "total";
+    }
+    return "unknown";
+}
@@ -0,0 +1,155 @@
+/**
+ * LatencyTracker.hpp
+ * Per-action latency by stage, from receiving a command to showing its result
+ *
+ * An ActionSpan follows one command through its stages; it is created when
+ * the command is received and travels with it through the command queue.
+ * mark() closes a stage at the current time, so the stages of a span add
+ * up to its total. Every closed stage goes into a histogram of its own:
+ * log-linear buckets (8 per power of two, at most 12.5% wide) counted with
+ * relaxed atomic adds, so recording never locks and percentiles can be read
+ * while actions are running. One span in sampleEvery is also kept in full
+ * and can be exported as JSON lines.
+ */
+
+#ifndef LATENCYTRACKER_H
+#define LATENCYTRACKER_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/**
+ * Stages of an action, in the order they run
+ */
+enum class LatencyStage : std::uint8_t {
+    Receive,        // Command read and queued
+    QueueWait,      // Waiting for the game loop
+    Parse,          // Command and cards parsed
+    Validate,       // Play checked against the trick (GameRules)
+    Mutate,         // GameState::applyTurn
+    Bots,           // Bot seats moving until the next human turn
+    Broadcast,      // Result shown (frame rendered)
+    Total           // Receive to broadcast
+};
+
+constexpr size_t LATENCY_STAGE_COUNT = 8;
+
+/**
+ * Lock-free latency histogram in nanoseconds
+ */
+class LatencyHistogram {
+public:
+    static constexpr int SUB_BUCKET_BITS = 3;
+    static constexpr int MAX_EXPONENT = 47;     // Longer latencies (~39 hours) share the last bucket
+    static constexpr size_t BUCKET_COUNT = static_cast<size_t>(MAX_EXPONENT - SUB_BUCKET_BITS + 2) << SUB_BUCKET_BITS;
+
+    /**
+     * Count one latency (thread-safe, lock-free)
+     */
+    void record(std::uint64_t nanos) {
+        counts_[bucketOf(nanos)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * Latency below which a fraction of the recorded ones fall
+     * (upper edge of its bucket; 0 if nothing is recorded)
+     */
+    std::uint64_t percentile(double fraction) const;
+
+    std::uint64_t getCount() const;
+    void clear();
+
+    static size_t bucketOf(std::uint64_t nanos);
+    static std::uint64_t bucketUpperBound(size_t bucket);
+
+private:
+    std::array<std::atomic<std::uint64_t>, BUCKET_COUNT> counts_{};
+};
+
+/**
+ * One action on its way through the stages
+ */
+struct ActionSpan {
+    std::uint64_t spanId = 0;                       // 0 = not traced
+    const char* action = "";                        // String literal, set once the command is parsed
+    std::int64_t startNs = 0;
+    std::int64_t markNs = 0;                        // End of the last closed stage
+    std::array<std::uint32_t, LATENCY_STAGE_COUNT> stageNs{};
+    std::uint32_t stages = 0;                       // Bit per closed stage
+
+    explicit operator bool() const { return spanId != 0; }
+};
+
+/**
+ * LatencyTracker class
+ */
+class LatencyTracker {
+public:
+    static constexpr size_t MAX_SAMPLES = 1 << 14;
+
+    LatencyTracker();
+
+    /**
+     * Clear histograms and samples and start tracing; keep one span in sampleEvery
+     */
+    void start(std::uint32_t sampleEvery = 100);
+
+    /**
+     * Stop tracing (histograms and samples are kept)
+     */
+    void stop();
+
+    bool isEnabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+    /**
+     * Open a span at the start of the Receive stage (an untraced span while stopped)
+     */
+    ActionSpan begin();
+
+    /**
+     * Close a stage of a span at the current time
+     */
+    void mark(ActionSpan& span, LatencyStage stage);
+
+    /**
+     * Record the span's total, and keep it if sampled
+     */
+    void finish(ActionSpan& span);
+
+    const LatencyHistogram& getHistogram(LatencyStage stage) const {
+        return histograms_[static_cast<size_t>(stage)];
+    }
+
+    /**
+     * Write the sampled spans as JSON lines (times in microseconds); call after stop()
+     * @return number of spans written
+     * @throws std::runtime_error if the file cannot be written
+     */
+    size_t exportSamples(const std::string& path) const;
+
+    size_t getSampleCount() const;
+    size_t getDroppedCount() const { return dropped_.load(std::memory_order_relaxed); }
+
+    static const char* getStageName(LatencyStage stage);
+
+    static std::int64_t nowNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+private:
+    std::atomic<bool> enabled_{ false };
+    std::atomic<std::uint32_t> sampleEvery_{ 100 };
+    std::atomic<std::uint64_t> nextSpanId_{ 1 };
+    std::array<LatencyHistogram, LATENCY_STAGE_COUNT> histograms_;
+
+    std::unique_ptr<ActionSpan[]> samples_;
+    std::atomic<size_t> sampleCount_{ 0 };
+    std::atomic<size_t> dropped_{ 0 };
+};
+
+#endif // LATENCYTRACKER_HPP
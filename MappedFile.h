@@ -0,0 +1,52 @@
+/**
+ * MappedFile.hpp
+ * Read-only memory-mapped file (POSIX mmap / Win32 file mapping)
+ */
+
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * MappedFile class
+ */
+class MappedFile {
+public:
+    /**
+     * Map a whole file read-only
+     * @throws std::runtime_error if the file cannot be opened or mapped
+     */
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    /**
+     * Mapped bytes
+     */
+    const std::uint8_t* data() const { return data_; }
+    size_t size() const { return size_; }
+    const std::string& path() const { return path_; }
+
+private:
+    std::string path_;
+    const std::uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+#ifdef _WIN32
+    void* fileHandle_ = nullptr;
+    void* mappingHandle_ = nullptr;
+#endif
+
+    /**
+     * Unmap and close handles
+     */
+    void release();
+};
+
+#endif // MAPPEDFILE_HPP
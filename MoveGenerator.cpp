@@ -0,0 +1,247 @@
+/**
+ * MoveGenerator.cpp
+ * Implementation of legal play enumeration
+ */
+
+#include "MoveGenerator.h"
+#include "CardSet.h"
+#include "GameRules.h"
+#include <algorithm>
+#include <unordered_set>
+#include <utility>
+
+namespace {
+
+    void addSubsetsFrom(const std::vector<Card>& pool, size_t first, size_t k,
+        std::vector<Card>& combo, std::vector<std::vector<Card>>& out) {
+        if (combo.size() == k) {
+            out.push_back(combo);
+            return;
+        }
+        for (size_t i = first; i + (k - combo.size()) <= pool.size(); ++i) {
+            // Identical copies (multi-deck) would repeat the same subset
+            if (i > first && pool[i] == pool[i - 1]) {
+                continue;
+            }
+            combo.push_back(pool[i]);
+            addSubsetsFrom(pool, i + 1, k, combo, out);
+            combo.pop_back();
+        }
+    }
+
+    /**
+     * Append every distinct k-card subset of a sorted pool to out
+     */
+    void addSubsets(const std::vector<Card>& pool, size_t k, std::vector<std::vector<Card>>& out) {
+        if (pool.size() < k) {
+            return;
+        }
+        std::vector<Card> combo;
+        combo.reserve(k);
+        addSubsetsFrom(pool, 0, k, combo, out);
+    }
+
+    /**
+     * One copy of each card of a sorted pool
+     */
+    std::vector<Card> distinctCards(std::vector<Card> pool) {
+        pool.erase(std::unique(pool.begin(), pool.end()), pool.end());
+        return pool;
+    }
+
+} // namespace
+
+/**
+ * Generate every legal play against the last play
+ */
+std::vector<std::vector<Card>> MoveGenerator::generatePlays(
+    std::span<const Card> hand,
+    std::span<const Card> lastPlay,
+    bool mustIncludeThreeOfDiamonds
+) {
+    std::vector<size_t> sizes;
+    if (lastPlay.empty()) {
+        sizes = { 1, 2, 3, 5 };
+    }
+    else {
+        sizes = { lastPlay.size() };
+    }
+
+    std::uint16_t lastKey = lastPlay.empty() ? 0 : GameRules::getPlayKey(lastPlay);
+
+    std::vector<std::pair<std::uint16_t, std::vector<Card>>> keyed;
+    for (size_t size : sizes) {
+        for (auto& play : generateCombinations(hand, size)) {
+            if (mustIncludeThreeOfDiamonds && !GameRules::containsThreeOfDiamonds(play)) {
+                continue;
+            }
+
+            std::uint16_t key = GameRules::getPlayKey(play);
+            if (!GameRules::playKeyBeats(key, lastKey)) {
+                continue;
+            }
+            keyed.emplace_back(key, std::move(play));
+        }
+    }
+
+    std::stable_sort(keyed.begin(), keyed.end(), [](const auto& a, const auto& b) {
+        return a.first < b.first;
+        });
+
+    std::vector<std::vector<Card>> plays;
+    plays.reserve(keyed.size());
+    for (auto& entry : keyed) {
+        plays.push_back(std::move(entry.second));
+    }
+    return plays;
+}
+
+/**
+ * Generate all valid combinations of a given size
+ */
+std::vector<std::vector<Card>> MoveGenerator::generateCombinations(
+    std::span<const Card> hand,
+    size_t size
+) {
+    std::vector<std::vector<Card>> byRank(13);
+    for (const auto& card : hand) {
+        byRank[static_cast<int>(card.getRank()) - static_cast<int>(Rank::Three)].push_back(card);
+    }
+    for (auto& group : byRank) {
+        std::sort(group.begin(), group.end());
+    }
+
+    std::vector<std::vector<Card>> out;
+
+    switch (size) {
+    case 1:
+    case 2:
+    case 3:
+        for (const auto& group : byRank) {
+            addSubsets(group, size, out);
+        }
+        break;
+
+    case 5:
+        addFiveCardCombinations(byRank, hand, out);
+        break;
+
+    default:
+        break;
+    }
+
+    return out;
+}
+
+/**
+ * Five-card combinations
+ */
+void MoveGenerator::addFiveCardCombinations(
+    const std::vector<std::vector<Card>>& byRank,
+    std::span<const Card> hand,
+    std::vector<std::vector<Card>>& out
+) {
+    std::vector<std::vector<Card>> candidates;
+
+    // Identical copies of a card make identical straights and kickers
+    std::vector<std::vector<Card>> distinctByRank;
+    std::vector<Card> distinctHand;
+    for (const auto& group : byRank) {
+        distinctByRank.push_back(distinctCards(group));
+        distinctHand.insert(distinctHand.end(), distinctByRank.back().begin(), distinctByRank.back().end());
+    }
+
+    // Straights: one card from each of five consecutive ranks
+    for (size_t start = 0; start + 5 <= distinctByRank.size(); ++start) {
+        bool available = true;
+        for (size_t r = start; r < start + 5; ++r) {
+            if (distinctByRank[r].empty()) {
+                available = false;
+                break;
+            }
+        }
+        if (!available) {
+            continue;
+        }
+
+        std::vector<size_t> pick(5, 0);
+        while (true) {
+            std::vector<Card> combo;
+            combo.reserve(5);
+            for (size_t i = 0; i < 5; ++i) {
+                combo.push_back(distinctByRank[start + i][pick[i]]);
+            }
+            candidates.push_back(std::move(combo));
+
+            // Advance the odometer over the five rank groups
+            size_t i = 5;
+            while (i > 0 && ++pick[i - 1] == distinctByRank[start + i - 1].size()) {
+                pick[i - 1] = 0;
+                --i;
+            }
+            if (i == 0) {
+                break;
+            }
+        }
+    }
+
+    // Flushes: any five cards of one suit
+    std::vector<std::vector<Card>> bySuit(4);
+    for (const auto& card : hand) {
+        bySuit[static_cast<int>(card.getSuit())].push_back(card);
+    }
+    for (auto& group : bySuit) {
+        std::sort(group.begin(), group.end());
+        addSubsets(group, 5, candidates);
+    }
+
+    // Full houses and four of a kind
+    std::vector<std::vector<std::vector<Card>>> pairsByRank(byRank.size());
+    for (size_t b = 0; b < byRank.size(); ++b) {
+        addSubsets(byRank[b], 2, pairsByRank[b]);
+    }
+
+    for (size_t a = 0; a < byRank.size(); ++a) {
+        std::vector<std::vector<Card>> triples;
+        addSubsets(byRank[a], 3, triples);
+
+        for (size_t b = 0; b < byRank.size(); ++b) {
+            if (a == b) {
+                continue;
+            }
+            for (const auto& triple : triples) {
+                for (const auto& pair : pairsByRank[b]) {
+                    std::vector<Card> combo = triple;
+                    combo.insert(combo.end(), pair.begin(), pair.end());
+                    candidates.push_back(std::move(combo));
+                }
+            }
+        }
+
+        // More than four of a rank needs several decks
+        std::vector<std::vector<Card>> quads;
+        addSubsets(byRank[a], 4, quads);
+        for (const auto& quad : quads) {
+            for (const auto& card : distinctHand) {
+                if (card.getRank() != quad[0].getRank()) {
+                    std::vector<Card> combo = quad;
+                    combo.push_back(card);
+                    candidates.push_back(std::move(combo));
+                }
+            }
+        }
+    }
+
+    // Deduplicate (straight flushes appear as both straights and flushes)
+    std::unordered_set<CardSet, CardSet::Hash> seen;
+    for (auto& combo : candidates) {
+        if (!seen.insert(CardSet(combo)).second) {
+            continue;
+        }
+        if (GameRules::classify<5>(std::span<const Card, 5>(combo.data(), 5)) == 0) {
+            continue;
+        }
+        std::sort(combo.begin(), combo.end());
+        out.push_back(std::move(combo));
+    }
+}
@@ -0,0 +1,49 @@
+/**
+ * MoveGenerator.hpp
+ * Enumerates the legal plays available to a hand
+ */
+
+#ifndef MOVEGENERATOR_H
+#define MOVEGENERATOR_H
+
+#include "Card.h"
+#include <span>
+#include <vector>
+
+/**
+ * MoveGenerator class
+ */
+class MoveGenerator {
+public:
+    /**
+     * Generate every legal play for a hand against the last play.
+     * Each play is sorted by rank; plays are ordered by play key (weakest first).
+     * Passing is not included.
+     */
+    static std::vector<std::vector<Card>> generatePlays(
+        std::span<const Card> hand,
+        std::span<const Card> lastPlay,
+        bool mustIncludeThreeOfDiamonds
+    );
+
+    /**
+     * Generate all valid combinations of a given size (1, 2, 3 or 5),
+     * ignoring the last play
+     */
+    static std::vector<std::vector<Card>> generateCombinations(
+        std::span<const Card> hand,
+        size_t size
+    );
+
+private:
+    /**
+     * Five-card combinations: straights, flushes, full houses, four of a kind
+     */
+    static void addFiveCardCombinations(
+        const std::vector<std::vector<Card>>& byRank,
+        std::span<const Card> hand,
+        std::vector<std::vector<Card>>& out
+    );
+};
+
+#endif // MOVEGENERATOR_HPP
@@ -0,0 +1,116 @@
+/**
+ * MpmcQueue.hpp
+ * Bounded lock-free multi-producer multi-consumer queue
+ *
+ * Dmitry Vyukov's bounded MPMC design: a power-of-two ring of cells, each
+ * with a sequence number that tells producers and consumers whose turn the
+ * cell is. tryPush and tryPop never block and never allocate. close() marks
+ * the end of the stream once every push has returned; a consumer whose
+ * tryPop fails after it has seen isClosed() tries once more, and if that
+ * fails too the stream is over. Blocking with backoff is left to the
+ * caller (see SimulationPipeline), so waits can be measured.
+ */
+
+#ifndef MPMCQUEUE_H
+#define MPMCQUEUE_H
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+/**
+ * MpmcQueue class
+ */
+template <typename T>
+class MpmcQueue {
+public:
+    /**
+     * Constructor - capacity is rounded up to a power of two (at least 2)
+     */
+    explicit MpmcQueue(size_t capacity) {
+        size_t size = std::bit_ceil(capacity < 2 ? size_t{ 2 } : capacity);
+        cells_ = std::make_unique<Cell[]>(size);
+        for (size_t i = 0; i < size; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        mask_ = size - 1;
+    }
+
+    MpmcQueue(const MpmcQueue&) = delete;
+    MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+    /**
+     * Append an item unless the queue is full
+     */
+    bool tryPush(T&& item) {
+        size_t position = enqueuePos_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[position & mask_];
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+            if (diff == 0) {
+                if (enqueuePos_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    cell.value = std::move(item);
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0) {
+                return false;   // Full
+            }
+            else {
+                position = enqueuePos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * Take the oldest item unless the queue is empty
+     */
+    bool tryPop(T& item) {
+        size_t position = dequeuePos_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[position & mask_];
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position + 1);
+            if (diff == 0) {
+                if (dequeuePos_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    item = std::move(cell.value);
+                    cell.value = T();
+                    cell.sequence.store(position + mask_ + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0) {
+                return false;   // Empty
+            }
+            else {
+                position = dequeuePos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * No more items will be pushed
+     */
+    void close() { closed_.store(true, std::memory_order_release); }
+    bool isClosed() const { return closed_.load(std::memory_order_acquire); }
+
+    size_t getCapacity() const { return mask_ + 1; }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence{ 0 };
+        T value{};
+    };
+
+    std::unique_ptr<Cell[]> cells_;
+    size_t mask_ = 0;
+    alignas(64) std::atomic<size_t> enqueuePos_{ 0 };
+    alignas(64) std::atomic<size_t> dequeuePos_{ 0 };
+    alignas(64) std::atomic<bool> closed_{ false };
+};
+
+#endif // MPMCQUEUE_HPP
@@ -0,0 +1,204 @@
+/**
+ * OpponentModel.cpp
+ * Implementation of OpponentModel
+ */
+
+#include "OpponentModel.h"
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+
+namespace {
+
+    /**
+     * Counter index of a play type (-1 when leading)
+     */
+    int typeIndex(PlayType type) {
+        return type == PlayType::Invalid ? -1 : static_cast<int>(type) - 1;
+    }
+
+    void increment(std::atomic<std::uint32_t>& counter, int step, std::uint32_t amount = 1) {
+        if (step > 0) {
+            counter.fetch_add(amount, std::memory_order_relaxed);
+        }
+        else {
+            counter.fetch_sub(amount, std::memory_order_relaxed);
+        }
+    }
+
+    std::uint32_t read(const std::atomic<std::uint32_t>& counter) {
+        return counter.load(std::memory_order_relaxed);
+    }
+
+    float smoothed(std::uint32_t hits, std::uint32_t total, float prior) {
+        return (static_cast<float>(hits) + prior * OpponentModel::PRIOR_WEIGHT)
+            / (static_cast<float>(total) + OpponentModel::PRIOR_WEIGHT);
+    }
+
+} // namespace
+
+/**
+ * Constructor
+ */
+OpponentModel::OpponentModel(size_t capacity) {
+    size_t size = std::bit_ceil(std::max<size_t>(capacity, 1));
+    slots_ = std::make_unique<Slot[]>(size);
+    mask_ = size - 1;
+}
+
+/**
+ * Record a pass
+ */
+void OpponentModel::recordPass(PlayerId player, PlayType facing) {
+    countPass(player, facing, 1);
+}
+
+/**
+ * Record a play
+ */
+void OpponentModel::recordPlay(PlayerId player, PlayType facing, std::span<const Card> cards,
+    const CardSet& handAfter, size_t dealtCards) {
+    countPlay(player, facing, cards, handAfter, dealtCards, 1);
+}
+
+/**
+ * Take back a recorded pass
+ */
+void OpponentModel::forgetPass(PlayerId player, PlayType facing) {
+    countPass(player, facing, -1);
+}
+
+/**
+ * Take back a recorded play
+ */
+void OpponentModel::forgetPlay(PlayerId player, PlayType facing, std::span<const Card> cards,
+    const CardSet& handAfter, size_t dealtCards) {
+    countPlay(player, facing, cards, handAfter, dealtCards, -1);
+}
+
+/**
+ * Add or take back the counts of a pass
+ */
+void OpponentModel::countPass(PlayerId player, PlayType facing, int step) {
+    int index = typeIndex(facing);
+    if (index < 0) {
+        return;     // Passing on the lead is never accepted
+    }
+    Slot& slot = findOrInsert(player);
+    increment(slot.faced[index], step);
+    increment(slot.passed[index], step);
+}
+
+/**
+ * Add or take back the counts of a play
+ */
+void OpponentModel::countPlay(PlayerId player, PlayType facing, std::span<const Card> cards,
+    const CardSet& handAfter, size_t dealtCards, int step) {
+    Slot& slot = findOrInsert(player);
+    int index = typeIndex(facing);
+    if (index >= 0) {
+        increment(slot.faced[index], step);
+    }
+
+    std::uint32_t twos = 0;
+    for (const auto& card : cards) {
+        twos += card.getRank() == Rank::Two;
+    }
+    if (twos > 0) {
+        increment(slot.twosPlayed, step, twos);
+        if ((handAfter.size() + cards.size()) * 2 > dealtCards) {
+            increment(slot.earlyTwosPlayed, step, twos);
+        }
+    }
+
+    // Singles, pairs and triples: was the rank held in a larger set?
+    if (!cards.empty() && cards.size() <= 3) {
+        Rank rank = cards[0].getRank();
+        int left = 0;
+        for (int suit = 0; suit < 4; ++suit) {
+            left += handAfter.count(Card(rank, static_cast<Suit>(suit)));
+        }
+        increment(slot.rankPlays, step);
+        if (left > 0) {
+            increment(slot.brokenRankPlays, step);
+        }
+    }
+}
+
+/**
+ * Current profile
+ */
+OpponentProfile OpponentModel::getProfile(PlayerId player) const {
+    const Slot* slot = find(player);
+    if (!slot) {
+        return defaultProfile();
+    }
+
+    OpponentProfile profile;
+    for (size_t i = 0; i < PLAY_TYPES; ++i) {
+        std::uint32_t faced = read(slot->faced[i]);
+        profile.passRate[i + 1] = smoothed(read(slot->passed[i]), faced, PRIOR_PASS_RATE);
+        profile.turns += faced;
+    }
+    profile.earlyTwoRate = smoothed(read(slot->earlyTwosPlayed), read(slot->twosPlayed), PRIOR_EARLY_TWO_RATE);
+    profile.comboBreakRate = smoothed(read(slot->brokenRankPlays), read(slot->rankPlays), PRIOR_COMBO_BREAK_RATE);
+    return profile;
+}
+
+/**
+ * Profile of an unseen player
+ */
+OpponentProfile OpponentModel::defaultProfile() {
+    OpponentProfile profile;
+    for (size_t i = 1; i < profile.passRate.size(); ++i) {
+        profile.passRate[i] = PRIOR_PASS_RATE;
+    }
+    profile.earlyTwoRate = PRIOR_EARLY_TWO_RATE;
+    profile.comboBreakRate = PRIOR_COMBO_BREAK_RATE;
+    return profile;
+}
+
+/**
+ * First probe position of a player (Fibonacci hashing)
+ */
+size_t OpponentModel::home(PlayerId player) const {
+    return static_cast<size_t>((static_cast<std::uint64_t>(player) * 0x9E3779B97F4A7C15ull) >> 32) & mask_;
+}
+
+/**
+ * Slot of a known player, or nullptr
+ */
+const OpponentModel::Slot* OpponentModel::find(PlayerId player) const {
+    std::uint64_t key = static_cast<std::uint64_t>(player) + 1;
+    for (size_t probe = 0, i = home(player); probe <= mask_; ++probe, i = (i + 1) & mask_) {
+        std::uint64_t current = slots_[i].key.load(std::memory_order_acquire);
+        if (current == key) {
+            return &slots_[i];
+        }
+        if (current == 0) {
+            return nullptr;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * Slot of a player, claiming a free one for a new player
+ */
+OpponentModel::Slot& OpponentModel::findOrInsert(PlayerId player) {
+    std::uint64_t key = static_cast<std::uint64_t>(player) + 1;
+    for (size_t probe = 0, i = home(player); probe <= mask_; ++probe, i = (i + 1) & mask_) {
+        std::uint64_t current = slots_[i].key.load(std::memory_order_acquire);
+        if (current == 0) {
+            if (slots_[i].key.compare_exchange_strong(current, key, std::memory_order_acq_rel)) {
+                players_.fetch_add(1, std::memory_order_relaxed);
+                return slots_[i];
+            }
+            // Another thread claimed the slot; current now holds its key
+        }
+        if (current == key) {
+            return slots_[i];
+        }
+    }
+    throw std::length_error("Opponent model is full");
+}
@@ -0,0 +1,126 @@
+/**
+ * OpponentModel.hpp
+ * Per-player tendencies learned online from turns
+ *
+ * Counters live in a fixed-capacity open-addressing table keyed by player
+ * id, one cache line per player. Every observed turn costs a handful of
+ * relaxed atomic increments and reads are plain atomic loads, so the same
+ * player can be updated and read from many tables at once without locks.
+ * A profile read while turns are being recorded may mix counts from
+ * neighbouring turns.
+ */
+
+#ifndef OPPONENTMODEL_H
+#define OPPONENTMODEL_H
+
+#include "CardSet.h"
+#include "GameRules.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <span>
+
+using PlayerId = std::uint32_t;
+
+/**
+ * Smoothed tendencies of one player (priors until turns are seen)
+ */
+struct OpponentProfile {
+    std::array<float, 5> passRate{};    // Passes per play faced, indexed by PlayType
+    float earlyTwoRate = 0.0f;          // Share of 2s spent with over half the dealt cards left
+    float comboBreakRate = 0.0f;        // Share of singles/pairs/triples split from a larger set
+    std::uint32_t turns = 0;
+
+    float getPassRate(PlayType type) const { return passRate[static_cast<size_t>(type)]; }
+};
+
+/**
+ * OpponentModel class
+ */
+class OpponentModel {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 4096;
+
+    // Priors, weighted as PRIOR_WEIGHT observations
+    static constexpr float PRIOR_WEIGHT = 4.0f;
+    static constexpr float PRIOR_PASS_RATE = 0.3f;
+    static constexpr float PRIOR_EARLY_TWO_RATE = 0.5f;
+    static constexpr float PRIOR_COMBO_BREAK_RATE = 0.2f;
+
+    /**
+     * Constructor - capacity is rounded up to a power of two
+     */
+    explicit OpponentModel(size_t capacity = DEFAULT_CAPACITY);
+
+    OpponentModel(const OpponentModel&) = delete;
+    OpponentModel& operator=(const OpponentModel&) = delete;
+
+    /**
+     * Record a pass against a play of the given type
+     * @throws std::length_error if a new player does not fit
+     */
+    void recordPass(PlayerId player, PlayType facing);
+
+    /**
+     * Record a play; handAfter is the hand once the cards have left it and
+     * dealtCards the size of the hand dealt
+     * @throws std::length_error if a new player does not fit
+     */
+    void recordPlay(PlayerId player, PlayType facing, std::span<const Card> cards,
+        const CardSet& handAfter, size_t dealtCards);
+
+    /**
+     * Take back a recorded pass or play (undo); the arguments must be the
+     * ones it was recorded with
+     */
+    void forgetPass(PlayerId player, PlayType facing);
+    void forgetPlay(PlayerId player, PlayType facing, std::span<const Card> cards,
+        const CardSet& handAfter, size_t dealtCards);
+
+    /**
+     * Current profile (lock-free; priors for unseen players)
+     */
+    OpponentProfile getProfile(PlayerId player) const;
+
+    /**
+     * Profile of a player who has not been seen
+     */
+    static OpponentProfile defaultProfile();
+
+    size_t getPlayerCount() const { return players_.load(std::memory_order_relaxed); }
+    size_t getCapacity() const { return mask_ + 1; }
+
+private:
+    static constexpr size_t PLAY_TYPES = 4;     // Single, Pair, Triple, FiveCard
+
+    /**
+     * Counters of one player (key 0 = free slot, otherwise id + 1)
+     */
+    struct alignas(64) Slot {
+        std::atomic<std::uint64_t> key{ 0 };
+        std::array<std::atomic<std::uint32_t>, PLAY_TYPES> faced{};
+        std::array<std::atomic<std::uint32_t>, PLAY_TYPES> passed{};
+        std::atomic<std::uint32_t> twosPlayed{ 0 };
+        std::atomic<std::uint32_t> earlyTwosPlayed{ 0 };
+        std::atomic<std::uint32_t> rankPlays{ 0 };
+        std::atomic<std::uint32_t> brokenRankPlays{ 0 };
+    };
+
+    std::unique_ptr<Slot[]> slots_;
+    size_t mask_ = 0;
+    std::atomic<size_t> players_{ 0 };
+
+    /**
+     * Add (step 1) or take back (step -1) the counts of a pass or play
+     */
+    void countPass(PlayerId player, PlayType facing, int step);
+    void countPlay(PlayerId player, PlayType facing, std::span<const Card> cards,
+        const CardSet& handAfter, size_t dealtCards, int step);
+
+    const Slot* find(PlayerId player) const;
+    Slot& findOrInsert(PlayerId player);
+    size_t home(PlayerId player) const;
+};
+
+#endif // OPPONENTMODEL_HPP
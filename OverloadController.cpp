@@ -0,0 +1,107 @@
+/**
+ * OverloadController.cpp
+ * Implementation of OverloadController
+ */
+
+#include "OverloadController.h"
+
+/**
+ * Constructor
+ */
+OverloadController::OverloadController(const OverloadPolicy& policy, const GameClock& clock)
+    : policy_(policy), clock_(clock), nextEvaluation_((clock.now() + policy.window).time_since_epoch().count()) {
+}
+
+/**
+ * Count an answered decision
+ */
+void OverloadController::recordDecision(std::uint64_t latencyNs, DegradationLevel level) {
+    windows_[activeWindow_.load(std::memory_order_relaxed)].record(latencyNs);
+    decisions_[static_cast<size_t>(level)].fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * Whether a new table may open
+ */
+bool OverloadController::admitTable() {
+    if (getLevel() == DegradationLevel::Shedding) {
+        rejectedTables_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Evaluate the window if it has ended
+ */
+bool OverloadController::update(size_t queueDepth, Clock::time_point now) {
+    Clock::rep due = nextEvaluation_.load(std::memory_order_acquire);
+    Clock::rep current = now.time_since_epoch().count();
+    if (current < due || !nextEvaluation_.compare_exchange_strong(due,
+        (now + policy_.window).time_since_epoch().count(), std::memory_order_acq_rel)) {
+        return false;
+    }
+
+    // Decisions recorded from here on go to the other window
+    unsigned active = activeWindow_.load(std::memory_order_relaxed);
+    windows_[active ^ 1u].clear();
+    activeWindow_.store(active ^ 1u, std::memory_order_relaxed);
+    const LatencyHistogram& window = windows_[active];
+    std::uint64_t decisions = window.getCount();
+    std::uint64_t p99 = window.percentile(0.99);
+    windowP99Ns_.store(p99, std::memory_order_relaxed);
+    windowDecisions_.store(decisions, std::memory_order_relaxed);
+    queueDepth_.store(queueDepth, std::memory_order_relaxed);
+
+    auto target = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(policy_.targetP99).count());
+    std::uint8_t level = level_.load(std::memory_order_relaxed);
+    std::uint8_t next = level;
+    if (p99 > target || queueDepth > policy_.maxQueueDepth) {
+        calmWindows_.store(0, std::memory_order_relaxed);
+        if (level + 1u < DEGRADATION_LEVEL_COUNT) {
+            next = static_cast<std::uint8_t>(level + 1);
+        }
+    }
+    else if (static_cast<double>(p99) < policy_.recoverShare * static_cast<double>(target)
+        && static_cast<double>(queueDepth) < policy_.recoverShare * static_cast<double>(policy_.maxQueueDepth)) {
+        if (calmWindows_.fetch_add(1, std::memory_order_relaxed) + 1 >= policy_.recoverWindows && level > 0) {
+            next = static_cast<std::uint8_t>(level - 1);
+            calmWindows_.store(0, std::memory_order_relaxed);
+        }
+    }
+    else {
+        calmWindows_.store(0, std::memory_order_relaxed);
+    }
+
+    if (next == level) {
+        return false;
+    }
+    level_.store(next, std::memory_order_relaxed);
+    levelChanges_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+OverloadMetrics OverloadController::getMetrics() const {
+    OverloadMetrics metrics;
+    metrics.level = getLevel();
+    metrics.windowP99Ns = windowP99Ns_.load(std::memory_order_relaxed);
+    metrics.windowDecisions = windowDecisions_.load(std::memory_order_relaxed);
+    metrics.queueDepth = queueDepth_.load(std::memory_order_relaxed);
+    metrics.levelChanges = levelChanges_.load(std::memory_order_relaxed);
+    metrics.rejectedTables = rejectedTables_.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < DEGRADATION_LEVEL_COUNT; ++i) {
+        metrics.decisions[i] = decisions_[i].load(std::memory_order_relaxed);
+    }
+    return metrics;
+}
+
+const char* OverloadController::getLevelName(DegradationLevel level) {
+    switch (level) {
+    case DegradationLevel::Full: return "full";
+    case DegradationLevel::Reduced: return "reduced";
+    case DegradationLevel::Minimal: return "minimal";
+    case DegradationLevel::Heuristic: return "heuristic";
+    case DegradationLevel::Shedding: return "shedding";
+    }
+    return "unknown";
+}
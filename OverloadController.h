@@ -0,0 +1,130 @@
+/**
+ * OverloadController.hpp
+ * Admission control and stepwise bot-strength degradation under load
+ *
+ * The controller watches two signals of the bot decision pool: how many
+ * decisions are queued, and the p99 of decision latency (submit to answer)
+ * over the last window. Decisions are counted into one of two histograms
+ * with relaxed atomic adds; at the end of each window one thread evaluates
+ * it, swaps in the other and clears it. When either signal is over its
+ * limit the level drops one step: full search, reduced search, minimal
+ * search, heuristic bot, and only then refusing new tables. It climbs back
+ * one step after a few windows in a row comfortably under both limits.
+ */
+
+#ifndef OVERLOADCONTROLLER_H
+#define OVERLOADCONTROLLER_H
+
+#include "GameClock.h"
+#include "LatencyTracker.h"
+#include "RolloutSearch.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+/**
+ * Strength the bots play at, from strongest
+ */
+enum class DegradationLevel : std::uint8_t {
+    Full,           // Full search budget
+    Reduced,        // Fewer samples
+    Minimal,        // A couple of samples over fewer candidates
+    Heuristic,      // Bot::choosePlay, no search
+    Shedding        // Heuristic, and new tables are refused
+};
+
+constexpr size_t DEGRADATION_LEVEL_COUNT = 5;
+
+/**
+ * Limits and budgets of the controller
+ */
+struct OverloadPolicy {
+    std::chrono::milliseconds window{ 250 };        // Evaluation period
+    std::chrono::milliseconds targetP99{ 100 };     // Decision latency to stay under
+    size_t maxQueueDepth = 64;                      // Queued decisions to stay under
+    double recoverShare = 0.5;                      // Step back up below this share of both limits...
+    unsigned recoverWindows = 8;                    // ...for this many windows in a row
+
+    // Search budget of each level (Heuristic and Shedding search nothing)
+    std::array<SearchBudget, DEGRADATION_LEVEL_COUNT> budgets{ {
+        { 32, 8 }, { 8, 8 }, { 2, 4 }, { 0, 0 }, { 0, 0 } } };
+};
+
+/**
+ * What the controller has seen and done
+ */
+struct OverloadMetrics {
+    DegradationLevel level = DegradationLevel::Full;
+    std::uint64_t windowP99Ns = 0;                  // p99 of the last evaluated window
+    std::uint64_t windowDecisions = 0;
+    size_t queueDepth = 0;                          // Depth at the last evaluation
+    std::uint64_t levelChanges = 0;
+    std::uint64_t rejectedTables = 0;
+    std::array<std::uint64_t, DEGRADATION_LEVEL_COUNT> decisions{};     // Decisions answered at each level
+};
+
+/**
+ * OverloadController class
+ */
+class OverloadController {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * Constructor
+     * @param clock Times the windows; must outlive the controller
+     */
+    explicit OverloadController(const OverloadPolicy& policy = OverloadPolicy(),
+        const GameClock& clock = GameClock::system());
+
+    DegradationLevel getLevel() const { return static_cast<DegradationLevel>(level_.load(std::memory_order_relaxed)); }
+
+    /**
+     * Search budget of a level
+     */
+    const SearchBudget& getBudget(DegradationLevel level) const {
+        return policy_.budgets[static_cast<size_t>(level)];
+    }
+
+    /**
+     * Count an answered decision (thread-safe, lock-free)
+     */
+    void recordDecision(std::uint64_t latencyNs, DegradationLevel level);
+
+    /**
+     * Whether a new table may open; counts refusals (thread-safe)
+     */
+    bool admitTable();
+
+    /**
+     * Evaluate the window if it has ended (thread-safe; one caller evaluates)
+     * @return true if the level changed
+     */
+    bool update(size_t queueDepth, Clock::time_point now);
+
+    OverloadMetrics getMetrics() const;
+    const OverloadPolicy& getPolicy() const { return policy_; }
+    const GameClock& getClock() const { return clock_; }
+
+    static const char* getLevelName(DegradationLevel level);
+
+private:
+    OverloadPolicy policy_;
+    const GameClock& clock_;
+
+    std::array<LatencyHistogram, 2> windows_;
+    std::atomic<unsigned> activeWindow_{ 0 };
+    std::atomic<Clock::rep> nextEvaluation_;
+    std::atomic<std::uint8_t> level_{ 0 };
+    std::atomic<unsigned> calmWindows_{ 0 };        // Evaluations can overlap if one runs past a window
+
+    std::atomic<std::uint64_t> windowP99Ns_{ 0 };
+    std::atomic<std::uint64_t> windowDecisions_{ 0 };
+    std::atomic<size_t> queueDepth_{ 0 };
+    std::atomic<std::uint64_t> levelChanges_{ 0 };
+    std::atomic<std::uint64_t> rejectedTables_{ 0 };
+    std::array<std::atomic<std::uint64_t>, DEGRADATION_LEVEL_COUNT> decisions_{};
+};
+
+#endif // OVERLOADCONTROLLER_HPP
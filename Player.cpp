@@ -4,32 +4,58 @@
  */
 
 #include "Player.h"
-#include <sstream>
+#include "SeatTable.h"
+#include "TextBuffer.h"
 
- /**
-  * Constructor
-  */
-Player::Player(const std::string& name, PlayerType type)
-    : name_(name), type_(type), score_(0), hasPassed_(false) {
+/**
+ * Getters
+ */
+const std::string& Player::getName() const {
+    return table_->getName(seat_);
+}
+
+PlayerType Player::getType() const {
+    return table_->getType(seat_);
+}
+
+int Player::getScore() const {
+    return table_->getScore(seat_);
+}
+
+size_t Player::getCardCount() const {
+    return table_->getCardCount(seat_);
 }
 
 /**
- * Deal cards to this player
+ * Copy of the hand, in the seat's sort order
  */
-void Player::dealCards(const std::vector<Card>& cards) {
-    hand_.addCards(cards);
+Hand Player::getHand() const {
+    Hand hand;
+    hand.addCards(table_->getCards(seat_));
+    return hand;
+}
+
+/**
+ * Setters
+ */
+void Player::setScore(int score) {
+    table_->setScore(seat_, score);
+}
+
+/**
+ * Change the order getHand returns cards in
+ */
+void Player::sortHand(SortOrder order) {
+    table_->setSortOrder(seat_, order);
 }
 
 /**
  * String representation
  */
 std::string Player::toString() const {
-    std::ostringstream oss;
-    oss << name_ << " (" << (type_ == PlayerType::Human ? "Human" : "AI") << ")";
-    oss << " - Cards: " << hand_.size();
-    oss << ", Score: " << score_;
-    if (hasPassed_) {
-        oss << " [PASSED]";
-    }
-    return oss.str();
-}
\ No newline at end of file
+    TextBuffer text;
+    text.append(getName()).append(" (").append(getType() == PlayerType::Human ? "Human" : "AI").append(")");
+    text.append(" - Cards: ").append(getCardCount());
+    text.append(", Score: ").append(getScore());
+    return text.str();
+}
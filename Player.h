@@ -1,6 +1,9 @@
 /**
  * Player.hpp
  * Represents a player in the game (human or AI)
+ *
+ * A Player is a view of one seat in a SeatTable; it holds no game data of
+ * its own and stays valid as long as the table does.
  */
 
 #ifndef PLAYER_H
@@ -10,6 +13,8 @@
 #include <string>
 #include <memory>
 
+class SeatTable;
+
  /**
   * Player type
   */
@@ -26,45 +31,46 @@ public:
     /**
      * Constructor
      */
-    Player(const std::string& name, PlayerType type = PlayerType::Human);
+    Player() = default;
+    Player(SeatTable& table, size_t seat) : table_(&table), seat_(seat) {}
 
     /**
      * Getters
      */
-    const std::string& getName() const { return name_; }
-    PlayerType getType() const { return type_; }
-    Hand& getHand() { return hand_; }
-    const Hand& getHand() const { return hand_; }
-    int getScore() const { return score_; }
-    bool hasPassed() const { return hasPassed_; }
+    const std::string& getName() const;
+    PlayerType getType() const;
+    size_t getSeat() const { return seat_; }
+    int getScore() const;
 
     /**
-     * Setters
+     * Copy of the hand, in the seat's sort order
      */
-    void setName(const std::string& name) { name_ = name; }
-    void setScore(int score) { score_ = score; }
-    void setHasPassed(bool passed) { hasPassed_ = passed; }
+    Hand getHand() const;
 
     /**
-     * Game actions
+     * Number of cards left
      */
-    void addScore(int points) { score_ += points; }
-    void resetPass() { hasPassed_ = false; }
+    size_t getCardCount() const;
 
     /**
-     * Check if player has won (no cards left)
+     * Setters
      */
-    bool hasWon() const { return hand_.isEmpty(); }
+    void setScore(int score);
 
     /**
-     * Deal cards to this player
+     * Game actions
      */
-    void dealCards(const std::vector<Card>& cards);
+    void addScore(int points) { setScore(getScore() + points); }
 
     /**
-     * Clear the player's hand
+     * Change the order getHand returns cards in
+     */
+    void sortHand(SortOrder order);
+
+    /**
+     * Check if player has won (no cards left)
      */
-    void clearHand() { hand_.clear(); }
+    bool hasWon() const { return getCardCount() == 0; }
 
     /**
      * String representation
@@ -72,11 +78,8 @@ public:
     std::string toString() const;
 
 private:
-    std::string name_;
-    PlayerType type_;
-    Hand hand_;
-    int score_;
-    bool hasPassed_;
+    SeatTable* table_ = nullptr;
+    size_t seat_ = 0;
 };
 
 #endif // PLAYER_HPP
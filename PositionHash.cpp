@@ -0,0 +1,116 @@
+/**
+ * PositionHash.cpp
+ * Implementation of PositionHash
+ */
+
+#include "PositionHash.h"
+#include "GameState.h"
+#include <array>
+#include <bit>
+
+namespace {
+
+    constexpr size_t DECK_SIZE = 52;
+    constexpr size_t LEGACY_SEATS = 4;      // Seats hashed before multi-deck support
+
+    /**
+     * Zobrist keys, laid out as [copy][seat][card], then last play as [copy][card], then turn
+     */
+    struct ZobristKeys {
+        std::array<std::array<std::uint64_t, PositionHash::MAX_SEATS * DECK_SIZE>, CardSet::MAX_COPIES> hands{};
+        std::array<std::array<std::uint64_t, DECK_SIZE>, CardSet::MAX_COPIES> lastPlay{};
+        std::array<std::uint64_t, PositionHash::MAX_SEATS> turn{};
+    };
+
+    /**
+     * SplitMix64 step
+     */
+    constexpr std::uint64_t splitMix64(std::uint64_t& state) {
+        std::uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    constexpr ZobristKeys makeKeys() {
+        ZobristKeys keys;
+        std::uint64_t state = 0x746869727465656Eull;    // "thirteen"
+
+        // Single-deck keys for the first four seats come first, in their original order
+        for (size_t i = 0; i < LEGACY_SEATS * DECK_SIZE; ++i) keys.hands[0][i] = splitMix64(state);
+        for (auto& key : keys.lastPlay[0]) key = splitMix64(state);
+        for (size_t i = 0; i < LEGACY_SEATS; ++i) keys.turn[i] = splitMix64(state);
+
+        for (size_t i = LEGACY_SEATS * DECK_SIZE; i < keys.hands[0].size(); ++i) keys.hands[0][i] = splitMix64(state);
+        for (size_t i = LEGACY_SEATS; i < keys.turn.size(); ++i) keys.turn[i] = splitMix64(state);
+        for (size_t copy = 1; copy < CardSet::MAX_COPIES; ++copy) {
+            for (auto& key : keys.hands[copy]) key = splitMix64(state);
+            for (auto& key : keys.lastPlay[copy]) key = splitMix64(state);
+        }
+        return keys;
+    }
+
+    constexpr ZobristKeys KEYS = makeKeys();
+
+} // namespace
+
+/**
+ * Hash of the position in a game state
+ */
+std::uint64_t PositionHash::hash(const GameState& state) {
+    std::uint64_t h = 0;
+    const SeatTable& seats = state.getSeats();
+    for (size_t seat = 0; seat < seats.size() && seat < MAX_SEATS; ++seat) {
+        h ^= hashSet(seat, seats.getHand(seat));
+    }
+    h ^= hashLastPlay(CardSet(state.getLastPlay()));
+    h ^= KEYS.turn[state.getCurrentPlayerIndex() % MAX_SEATS];
+    return h;
+}
+
+/**
+ * Hash of a position given as card sets
+ */
+std::uint64_t PositionHash::hash(const std::vector<CardSet>& hands, const CardSet& lastPlay, size_t currentPlayer) {
+    std::uint64_t h = 0;
+    for (size_t seat = 0; seat < hands.size() && seat < MAX_SEATS; ++seat) {
+        h ^= hashSet(seat, hands[seat]);
+    }
+    h ^= hashLastPlay(lastPlay);
+    h ^= KEYS.turn[currentPlayer % MAX_SEATS];
+    return h;
+}
+
+/**
+ * XOR of the keys of every card in a mask
+ */
+std::uint64_t PositionHash::hashCards(const std::uint64_t* keys, CardMask cards) {
+    std::uint64_t h = 0;
+    while (cards) {
+        h ^= keys[std::countr_zero(cards)];
+        cards &= cards - 1;
+    }
+    return h;
+}
+
+/**
+ * XOR of the keys of every copy of every card held by a seat
+ */
+std::uint64_t PositionHash::hashSet(size_t seat, const CardSet& cards) {
+    std::uint64_t h = 0;
+    for (size_t copy = 0; copy < CardSet::MAX_COPIES && cards.plane(copy); ++copy) {
+        h ^= hashCards(&KEYS.hands[copy][seat * DECK_SIZE], cards.plane(copy));
+    }
+    return h;
+}
+
+/**
+ * XOR of the keys of every copy of every card in the play to beat
+ */
+std::uint64_t PositionHash::hashLastPlay(const CardSet& cards) {
+    std::uint64_t h = 0;
+    for (size_t copy = 0; copy < CardSet::MAX_COPIES && cards.plane(copy); ++copy) {
+        h ^= hashCards(KEYS.lastPlay[copy].data(), cards.plane(copy));
+    }
+    return h;
+}
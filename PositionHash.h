@@ -0,0 +1,44 @@
+/**
+ * PositionHash.hpp
+ * Zobrist hashing of game positions
+ *
+ * A position is every seat's hand, the play to beat (GameState::getLastPlay)
+ * and the seat to move. Its hash is the XOR of one random key per
+ * (seat, card, copy) held, per (card, copy) in the play to beat, and for the
+ * seat to move. Keys are generated from a fixed seed so hashes are stable
+ * across runs; single-deck positions on up to 4 seats hash as before.
+ */
+
+#ifndef POSITIONHASH_H
+#define POSITIONHASH_H
+
+#include "CardSet.h"
+#include <cstdint>
+#include <vector>
+
+class GameState;
+
+/**
+ * PositionHash class
+ */
+class PositionHash {
+public:
+    static constexpr size_t MAX_SEATS = 8;
+
+    /**
+     * Hash of the position in a game state
+     */
+    static std::uint64_t hash(const GameState& state);
+
+    /**
+     * Hash of a position given as card sets
+     */
+    static std::uint64_t hash(const std::vector<CardSet>& hands, const CardSet& lastPlay, size_t currentPlayer);
+
+private:
+    static std::uint64_t hashCards(const std::uint64_t* keys, CardMask cards);
+    static std::uint64_t hashSet(size_t seat, const CardSet& cards);
+    static std::uint64_t hashLastPlay(const CardSet& cards);
+};
+
+#endif // POSITIONHASH_HPP
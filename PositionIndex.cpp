@@ -0,0 +1,514 @@
+/**
+ * PositionIndex.cpp
+ * Implementation of the position hash index
+ */
+
+#include "PositionIndex.h"
+#include <algorithm>
+#include <bit>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <queue>
+#include <sstream>
+#include <stdexcept>
+
+static_assert(std::endian::native == std::endian::little,
+    "Position index runs are stored little-endian");
+
+namespace {
+
+    constexpr char RUN_MAGIC[8] = { 'T', 'H', 'P', 'I', 'D', 'X', '0', '1' };
+    constexpr std::uint32_t RUN_VERSION = 1;
+    constexpr const char* MANIFEST_NAME = "MANIFEST";
+
+    constexpr std::uint64_t BLOOM_BITS_PER_ENTRY = 10;
+    constexpr std::uint32_t BLOOM_HASHES = 7;
+    constexpr size_t WRITE_BUFFER_ENTRIES = 1 << 14;
+
+    /**
+     * Bit probed by the i-th bloom hash (double hashing; position hashes are
+     * already uniformly distributed)
+     */
+    inline std::uint64_t bloomBit(std::uint64_t hash, std::uint32_t i, std::uint64_t bits) {
+        std::uint64_t step = std::rotl(hash, 32) | 1;
+        return (hash + i * step) % bits;
+    }
+
+    /**
+     * Streams sorted entries into a run file
+     */
+    class RunBuilder {
+    public:
+        RunBuilder(const std::string& path, std::uint32_t level, std::uint64_t expectedEntries)
+            : path_(path),
+            temporary_(path + ".tmp"),
+            out_(temporary_, std::ios::binary | std::ios::trunc) {
+            if (!out_) {
+                throw std::runtime_error("Cannot create index run: " + temporary_);
+            }
+
+            std::memcpy(header_.magic, RUN_MAGIC, sizeof(RUN_MAGIC));
+            header_.version = RUN_VERSION;
+            header_.level = level;
+            header_.bloomHashes = BLOOM_HASHES;
+            header_.bloomWords = (std::max<std::uint64_t>(1, expectedEntries) * BLOOM_BITS_PER_ENTRY + 63) / 64;
+            bloom_.assign(header_.bloomWords, 0);
+
+            // Placeholder header, rewritten by finish()
+            out_.write(reinterpret_cast<const char*>(&header_), sizeof(header_));
+            buffer_.reserve(WRITE_BUFFER_ENTRIES);
+        }
+
+        void append(const PositionEntry& entry) {
+            if (header_.entryCount % PositionRun::FENCE_INTERVAL == 0) {
+                fences_.push_back(entry.hash);
+            }
+            const std::uint64_t bits = header_.bloomWords * 64;
+            for (std::uint32_t i = 0; i < BLOOM_HASHES; ++i) {
+                std::uint64_t bit = bloomBit(entry.hash, i, bits);
+                bloom_[bit / 64] |= std::uint64_t{ 1 } << (bit % 64);
+            }
+
+            buffer_.push_back(entry);
+            ++header_.entryCount;
+            if (buffer_.size() == WRITE_BUFFER_ENTRIES) {
+                writeBuffer();
+            }
+        }
+
+        void finish() {
+            writeBuffer();
+
+            header_.fenceOffset = sizeof(header_) + header_.entryCount * sizeof(PositionEntry);
+            header_.fenceCount = fences_.size();
+            header_.bloomOffset = header_.fenceOffset + fences_.size() * sizeof(std::uint64_t);
+
+            out_.write(reinterpret_cast<const char*>(fences_.data()),
+                static_cast<std::streamsize>(fences_.size() * sizeof(std::uint64_t)));
+            out_.write(reinterpret_cast<const char*>(bloom_.data()),
+                static_cast<std::streamsize>(bloom_.size() * sizeof(std::uint64_t)));
+            out_.seekp(0);
+            out_.write(reinterpret_cast<const char*>(&header_), sizeof(header_));
+            out_.close();
+            if (!out_) {
+                throw std::runtime_error("Write failed: " + temporary_);
+            }
+
+            if (std::rename(temporary_.c_str(), path_.c_str()) != 0) {
+                throw std::runtime_error("Cannot rename index run: " + path_);
+            }
+        }
+
+    private:
+        std::string path_;
+        std::string temporary_;
+        std::ofstream out_;
+        PositionRunHeader header_{};
+        std::vector<PositionEntry> buffer_;
+        std::vector<std::uint64_t> fences_;
+        std::vector<std::uint64_t> bloom_;
+
+        void writeBuffer() {
+            out_.write(reinterpret_cast<const char*>(buffer_.data()),
+                static_cast<std::streamsize>(buffer_.size() * sizeof(PositionEntry)));
+            buffer_.clear();
+        }
+    };
+
+    PositionHit toHit(const PositionEntry& entry) {
+        PositionHit hit;
+        hit.gameId = entry.location >> 16;
+        hit.actionIndex = static_cast<std::uint32_t>(entry.location & 0xFFFF);
+        return hit;
+    }
+
+} // namespace
+
+/**
+ * Map a run file and validate its layout
+ */
+PositionRun::PositionRun(const std::string& path) : file_(path) {
+    if (file_.size() < sizeof(PositionRunHeader)) {
+        throw std::runtime_error("Index run too small: " + path);
+    }
+    std::memcpy(&header_, file_.data(), sizeof(header_));
+    if (std::memcmp(header_.magic, RUN_MAGIC, sizeof(RUN_MAGIC)) != 0 || header_.version != RUN_VERSION) {
+        throw std::runtime_error("Not an index run: " + path);
+    }
+    if (header_.fenceOffset != sizeof(header_) + header_.entryCount * sizeof(PositionEntry) ||
+        header_.bloomOffset != header_.fenceOffset + header_.fenceCount * sizeof(std::uint64_t) ||
+        header_.bloomOffset + header_.bloomWords * sizeof(std::uint64_t) > file_.size() ||
+        header_.bloomWords == 0) {
+        throw std::runtime_error("Truncated index run: " + path);
+    }
+
+    entries_ = reinterpret_cast<const PositionEntry*>(file_.data() + sizeof(header_));
+    fences_ = reinterpret_cast<const std::uint64_t*>(file_.data() + header_.fenceOffset);
+    bloom_ = reinterpret_cast<const std::uint64_t*>(file_.data() + header_.bloomOffset);
+}
+
+/**
+ * Bloom filter test
+ */
+bool PositionRun::mayContain(std::uint64_t hash) const {
+    const std::uint64_t bits = header_.bloomWords * 64;
+    for (std::uint32_t i = 0; i < header_.bloomHashes; ++i) {
+        std::uint64_t bit = bloomBit(hash, i, bits);
+        if (!(bloom_[bit / 64] & (std::uint64_t{ 1 } << (bit % 64)))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Index of the first entry with this hash or greater
+ */
+std::uint64_t PositionRun::lowerBound(std::uint64_t hash) const {
+    // The first fence >= hash bounds the search to the block before it
+    const std::uint64_t* fence = std::lower_bound(fences_, fences_ + header_.fenceCount, hash);
+    std::uint64_t f = static_cast<std::uint64_t>(fence - fences_);
+    std::uint64_t begin = f > 0 ? (f - 1) * FENCE_INTERVAL : 0;
+    std::uint64_t end = f < header_.fenceCount ? f * FENCE_INTERVAL : header_.entryCount;
+
+    const PositionEntry* first = std::lower_bound(entries_ + begin, entries_ + end, hash,
+        [](const PositionEntry& entry, std::uint64_t value) { return entry.hash < value; });
+    return static_cast<std::uint64_t>(first - entries_);
+}
+
+/**
+ * Append the hits for a hash
+ */
+void PositionRun::find(std::uint64_t hash, std::vector<PositionHit>& hits, size_t limit) const {
+    if (!mayContain(hash)) {
+        return;
+    }
+    for (std::uint64_t i = lowerBound(hash); i < header_.entryCount && entries_[i].hash == hash; ++i) {
+        if (hits.size() >= limit) {
+            return;
+        }
+        hits.push_back(toHit(entries_[i]));
+    }
+}
+
+/**
+ * Number of entries for a hash
+ */
+std::uint64_t PositionRun::count(std::uint64_t hash) const {
+    if (!mayContain(hash)) {
+        return 0;
+    }
+    std::uint64_t first = lowerBound(hash);
+    const PositionEntry* last = std::upper_bound(entries_ + first, entries_ + header_.entryCount, hash,
+        [](std::uint64_t value, const PositionEntry& entry) { return value < entry.hash; });
+    return static_cast<std::uint64_t>(last - entries_) - first;
+}
+
+/**
+ * Open (or create) an index directory
+ */
+PositionIndexWriter::PositionIndexWriter(const PositionIndexOptions& options) : options_(options) {
+    options_.memtableEntries = std::max<size_t>(1, options_.memtableEntries);
+    options_.mergeFanIn = std::max<size_t>(2, options_.mergeFanIn);
+    std::filesystem::create_directories(options_.directory);
+
+    std::ifstream manifest(runPath(MANIFEST_NAME));
+    std::string line;
+    while (std::getline(manifest, line)) {
+        std::istringstream iss(line);
+        RunInfo run;
+        if (iss >> run.name >> run.level >> run.entries) {
+            runs_.push_back(run);
+            nextRunId_ = std::max<std::uint64_t>(nextRunId_, std::strtoull(run.name.c_str() + 4, nullptr, 10) + 1);
+        }
+    }
+
+    memtable_.reserve(options_.memtableEntries);
+}
+
+PositionIndexWriter::~PositionIndexWriter() {
+    try {
+        close();
+    }
+    catch (const std::exception&) {
+        // Destructors must not throw
+    }
+}
+
+/**
+ * Add every action of a game
+ */
+void PositionIndexWriter::add(const GameRecord& record) {
+    std::vector<PositionEntry> full;
+    {
+        std::lock_guard<std::mutex> lock(memtableMutex_);
+        for (size_t i = 0; i < record.actions.size(); ++i) {
+            memtable_.push_back({ record.actions[i].position, record.gameId << 16 | (i & 0xFFFF) });
+        }
+        if (memtable_.size() >= options_.memtableEntries) {
+            full.swap(memtable_);
+            memtable_.reserve(options_.memtableEntries);
+        }
+    }
+    if (!full.empty()) {
+        writeRun(std::move(full));
+    }
+}
+
+/**
+ * Add one entry
+ */
+void PositionIndexWriter::add(std::uint64_t hash, std::uint64_t gameId, std::uint32_t actionIndex) {
+    std::vector<PositionEntry> full;
+    {
+        std::lock_guard<std::mutex> lock(memtableMutex_);
+        memtable_.push_back({ hash, gameId << 16 | (actionIndex & 0xFFFF) });
+        if (memtable_.size() >= options_.memtableEntries) {
+            full.swap(memtable_);
+            memtable_.reserve(options_.memtableEntries);
+        }
+    }
+    if (!full.empty()) {
+        writeRun(std::move(full));
+    }
+}
+
+/**
+ * Write the memtable out as a run
+ */
+void PositionIndexWriter::flush() {
+    std::vector<PositionEntry> entries;
+    {
+        std::lock_guard<std::mutex> lock(memtableMutex_);
+        entries.swap(memtable_);
+    }
+    if (!entries.empty()) {
+        writeRun(std::move(entries));
+    }
+}
+
+/**
+ * Flush and merge all runs into one
+ */
+void PositionIndexWriter::compact() {
+    flush();
+
+    std::lock_guard<std::mutex> lock(runsMutex_);
+    if (runs_.size() > 1) {
+        std::uint32_t level = 0;
+        for (const auto& run : runs_) {
+            level = std::max(level, run.level);
+        }
+        std::vector<RunInfo> inputs = runs_;
+        mergeRuns(inputs, level + 1);
+    }
+}
+
+/**
+ * Flush remaining entries
+ */
+void PositionIndexWriter::close() {
+    if (closed_) {
+        return;
+    }
+    closed_ = true;
+    flush();
+}
+
+/**
+ * Sort entries and write them as a level 0 run
+ */
+void PositionIndexWriter::writeRun(std::vector<PositionEntry>&& entries) {
+    std::sort(entries.begin(), entries.end());
+
+    std::lock_guard<std::mutex> lock(runsMutex_);
+    RunInfo run;
+    run.name = newRunName();
+    run.entries = entries.size();
+
+    RunBuilder builder(runPath(run.name), 0, entries.size());
+    for (const auto& entry : entries) {
+        builder.append(entry);
+    }
+    builder.finish();
+
+    runs_.push_back(run);
+    writeManifest();
+    mergeFullLevels();
+}
+
+/**
+ * Merge every level that has mergeFanIn runs
+ */
+void PositionIndexWriter::mergeFullLevels() {
+    for (std::uint32_t level = 0;; ++level) {
+        std::vector<RunInfo> inputs;
+        bool deeper = false;
+        for (const auto& run : runs_) {
+            if (run.level == level) {
+                inputs.push_back(run);
+            }
+            deeper |= run.level > level;
+        }
+        if (inputs.size() >= options_.mergeFanIn) {
+            mergeRuns(inputs, level + 1);
+        }
+        else if (!deeper) {
+            return;
+        }
+    }
+}
+
+/**
+ * Merge runs into one run of a given level
+ */
+void PositionIndexWriter::mergeRuns(const std::vector<RunInfo>& inputs, std::uint32_t level) {
+    std::vector<std::unique_ptr<PositionRun>> sources;
+    std::uint64_t total = 0;
+    for (const auto& input : inputs) {
+        sources.push_back(std::make_unique<PositionRun>(runPath(input.name)));
+        total += sources.back()->getEntryCount();
+    }
+
+    // K-way merge on (entry, source)
+    struct Cursor {
+        PositionEntry entry;
+        size_t source;
+        std::uint64_t next;
+
+        bool operator>(const Cursor& other) const { return other.entry < entry; }
+    };
+    std::priority_queue<Cursor, std::vector<Cursor>, std::greater<Cursor>> heap;
+    for (size_t s = 0; s < sources.size(); ++s) {
+        if (sources[s]->getEntryCount() > 0) {
+            heap.push({ sources[s]->entries()[0], s, 1 });
+        }
+    }
+
+    RunInfo merged;
+    merged.name = newRunName();
+    merged.level = level;
+    merged.entries = total;
+
+    RunBuilder builder(runPath(merged.name), level, total);
+    while (!heap.empty()) {
+        Cursor cursor = heap.top();
+        heap.pop();
+        builder.append(cursor.entry);
+
+        const PositionRun& source = *sources[cursor.source];
+        if (cursor.next < source.getEntryCount()) {
+            heap.push({ source.entries()[cursor.next], cursor.source, cursor.next + 1 });
+        }
+    }
+    builder.finish();
+    sources.clear();
+
+    // Publish the merged run before deleting its inputs
+    auto isInput = [&inputs](const RunInfo& run) {
+        return std::any_of(inputs.begin(), inputs.end(),
+            [&run](const RunInfo& input) { return input.name == run.name; });
+    };
+    runs_.erase(std::remove_if(runs_.begin(), runs_.end(), isInput), runs_.end());
+    runs_.push_back(merged);
+    writeManifest();
+
+    for (const auto& input : inputs) {
+        std::error_code ignored;
+        std::filesystem::remove(runPath(input.name), ignored);
+    }
+}
+
+/**
+ * Replace the manifest with the current run list
+ */
+void PositionIndexWriter::writeManifest() {
+    std::string path = runPath(MANIFEST_NAME);
+    std::string temporary = path + ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::trunc);
+        if (!out) {
+            throw std::runtime_error("Cannot create index manifest: " + temporary);
+        }
+        for (const auto& run : runs_) {
+            out << run.name << " " << run.level << " " << run.entries << "\n";
+        }
+        out.close();
+        if (!out) {
+            throw std::runtime_error("Write failed: " + temporary);
+        }
+    }
+
+#ifdef _WIN32
+    // rename does not replace an existing file on Windows
+    std::remove(path.c_str());
+#endif
+    if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+        throw std::runtime_error("Cannot replace index manifest: " + path);
+    }
+}
+
+std::string PositionIndexWriter::runPath(const std::string& name) const {
+    return (std::filesystem::path(options_.directory) / name).string();
+}
+
+std::string PositionIndexWriter::newRunName() {
+    char name[32];
+    std::snprintf(name, sizeof(name), "run-%08llu.idx", static_cast<unsigned long long>(nextRunId_++));
+    return name;
+}
+
+/**
+ * Map every run listed in the manifest
+ */
+PositionIndex::PositionIndex(const std::string& directory) {
+    std::filesystem::path root(directory);
+    std::ifstream manifest(root / MANIFEST_NAME);
+    if (!manifest) {
+        throw std::runtime_error("Cannot open index manifest in: " + directory);
+    }
+
+    std::string line;
+    while (std::getline(manifest, line)) {
+        std::istringstream iss(line);
+        std::string name;
+        if (iss >> name) {
+            runs_.push_back(std::make_unique<PositionRun>((root / name).string()));
+        }
+    }
+}
+
+/**
+ * Where a position occurred
+ */
+std::vector<PositionHit> PositionIndex::lookup(std::uint64_t hash, size_t limit) const {
+    std::vector<PositionHit> hits;
+    for (const auto& run : runs_) {
+        run->find(hash, hits, limit);
+    }
+    std::sort(hits.begin(), hits.end(), [](const PositionHit& a, const PositionHit& b) {
+        return a.gameId != b.gameId ? a.gameId < b.gameId : a.actionIndex < b.actionIndex;
+        });
+    return hits;
+}
+
+/**
+ * How often a position occurred
+ */
+std::uint64_t PositionIndex::count(std::uint64_t hash) const {
+    std::uint64_t total = 0;
+    for (const auto& run : runs_) {
+        total += run->count(hash);
+    }
+    return total;
+}
+
+std::uint64_t PositionIndex::getEntryCount() const {
+    std::uint64_t total = 0;
+    for (const auto& run : runs_) {
+        total += run->getEntryCount();
+    }
+    return total;
+}
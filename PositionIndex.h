@@ -0,0 +1,235 @@
+/**
+ * PositionIndex.hpp
+ * On-disk inverted index from position hashes to (game id, action index)
+ *
+ * LSM layout: entries are buffered in a memtable, written out as sorted
+ * immutable runs when it fills, and runs of the same level are merged into
+ * one run of the next level once mergeFanIn of them exist. The MANIFEST
+ * file lists the live runs and is replaced atomically after every change.
+ *
+ * Run file layout (little-endian):
+ *   [PositionRunHeader][PositionEntry x entryCount][fences][bloom words]
+ * Entries are sorted by (hash, location). Fences hold the hash of every
+ * FENCE_INTERVAL-th entry; the bloom filter covers all hashes in the run.
+ */
+
+#ifndef POSITIONINDEX_H
+#define POSITIONINDEX_H
+
+#include "GameRecord.h"
+#include "MappedFile.h"
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * One index entry (16 bytes)
+ */
+struct PositionEntry {
+    std::uint64_t hash;
+    std::uint64_t location;             // gameId << 16 | action index
+
+    bool operator<(const PositionEntry& other) const {
+        return hash != other.hash ? hash < other.hash : location < other.location;
+    }
+};
+
+/**
+ * Where a position occurred
+ */
+struct PositionHit {
+    std::uint64_t gameId = 0;
+    std::uint32_t actionIndex = 0;
+};
+
+/**
+ * Run file header (64 bytes)
+ */
+struct PositionRunHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t level;
+    std::uint64_t entryCount;
+    std::uint64_t fenceOffset;
+    std::uint64_t fenceCount;
+    std::uint64_t bloomOffset;
+    std::uint64_t bloomWords;
+    std::uint32_t bloomHashes;
+    std::uint32_t reserved;
+};
+
+static_assert(sizeof(PositionEntry) == 16, "PositionEntry must be 16 bytes");
+static_assert(sizeof(PositionRunHeader) == 64, "PositionRunHeader must be 64 bytes");
+
+/**
+ * One memory-mapped sorted run
+ */
+class PositionRun {
+public:
+    static constexpr std::uint64_t FENCE_INTERVAL = 256;
+
+    /**
+     * Map a run file
+     * @throws std::runtime_error on a missing or malformed file
+     */
+    explicit PositionRun(const std::string& path);
+
+    /**
+     * Bloom filter test (false means definitely absent)
+     */
+    bool mayContain(std::uint64_t hash) const;
+
+    /**
+     * Append the hits for a hash, up to limit in total
+     */
+    void find(std::uint64_t hash, std::vector<PositionHit>& hits, size_t limit) const;
+
+    /**
+     * Number of entries for a hash
+     */
+    std::uint64_t count(std::uint64_t hash) const;
+
+    std::uint64_t getEntryCount() const { return header_.entryCount; }
+    std::uint32_t getLevel() const { return header_.level; }
+    const PositionEntry* entries() const { return entries_; }
+
+private:
+    MappedFile file_;
+    PositionRunHeader header_;
+    const PositionEntry* entries_ = nullptr;
+    const std::uint64_t* fences_ = nullptr;
+    const std::uint64_t* bloom_ = nullptr;
+
+    /**
+     * Index of the first entry with this hash or greater
+     */
+    std::uint64_t lowerBound(std::uint64_t hash) const;
+};
+
+/**
+ * Index settings
+ */
+struct PositionIndexOptions {
+    std::string directory;                  // Created if missing
+    size_t memtableEntries = 1 << 22;       // Entries buffered before a run is written
+    size_t mergeFanIn = 8;                  // Runs per level before they are merged
+};
+
+/**
+ * PositionIndexWriter class
+ */
+class PositionIndexWriter {
+public:
+    /**
+     * Open (or create) an index directory; existing runs are kept
+     * @throws std::runtime_error on I/O failure
+     */
+    explicit PositionIndexWriter(const PositionIndexOptions& options);
+    ~PositionIndexWriter();
+
+    PositionIndexWriter(const PositionIndexWriter&) = delete;
+    PositionIndexWriter& operator=(const PositionIndexWriter&) = delete;
+
+    /**
+     * Add every action of a game (thread-safe)
+     */
+    void add(const GameRecord& record);
+
+    /**
+     * Add one entry (thread-safe)
+     */
+    void add(std::uint64_t hash, std::uint64_t gameId, std::uint32_t actionIndex);
+
+    /**
+     * Write the memtable out as a run
+     */
+    void flush();
+
+    /**
+     * Flush and merge all runs into one
+     */
+    void compact();
+
+    /**
+     * Flush remaining entries
+     */
+    void close();
+
+private:
+    /**
+     * One live run in the manifest
+     */
+    struct RunInfo {
+        std::string name;
+        std::uint32_t level = 0;
+        std::uint64_t entries = 0;
+    };
+
+    PositionIndexOptions options_;
+
+    std::mutex memtableMutex_;
+    std::vector<PositionEntry> memtable_;
+
+    std::mutex runsMutex_;                  // Serializes run writes and merges
+    std::vector<RunInfo> runs_;
+    std::uint64_t nextRunId_ = 0;
+    bool closed_ = false;
+
+    /**
+     * Sort entries and write them as a level 0 run, merging as needed
+     */
+    void writeRun(std::vector<PositionEntry>&& entries);
+
+    /**
+     * Merge runs into one run of a given level
+     */
+    void mergeRuns(const std::vector<RunInfo>& inputs, std::uint32_t level);
+
+    /**
+     * Merge every level that has mergeFanIn runs
+     */
+    void mergeFullLevels();
+
+    /**
+     * Replace the manifest with the current run list
+     */
+    void writeManifest();
+
+    std::string runPath(const std::string& name) const;
+    std::string newRunName();
+};
+
+/**
+ * Read-only view of an index directory
+ */
+class PositionIndex {
+public:
+    /**
+     * Map every run listed in the manifest
+     * @throws std::runtime_error on a missing or malformed index
+     */
+    explicit PositionIndex(const std::string& directory);
+
+    /**
+     * Where a position occurred (up to limit hits)
+     */
+    std::vector<PositionHit> lookup(std::uint64_t hash,
+        size_t limit = std::numeric_limits<size_t>::max()) const;
+
+    /**
+     * How often a position occurred
+     */
+    std::uint64_t count(std::uint64_t hash) const;
+
+    size_t getRunCount() const { return runs_.size(); }
+    std::uint64_t getEntryCount() const;
+    const PositionRun& getRun(size_t index) const { return *runs_[index]; }
+
+private:
+    std::vector<std::unique_ptr<PositionRun>> runs_;
+};
+
+#endif // POSITIONINDEX_HPP
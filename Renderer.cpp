@@ -48,7 +48,7 @@ void Renderer::drawCard(const Card& card, float x, float y, bool highlighted, bo
  * Draw a hand of cards horizontally
  */
 void Renderer::drawHand(const Hand& hand, float x, float y, bool faceUp,
-    const std::vector<bool>& highlighted) {
+    const HandHighlights& highlighted) {
     if (hand.isEmpty()) {
         return;
     }
@@ -57,17 +57,51 @@ void Renderer::drawHand(const Hand& hand, float x, float y, bool faceUp,
     float spacing = calculateCardSpacing(cards.size(), getWindowWidth() - 100);
 
     for (size_t i = 0; i < cards.size(); ++i) {
-        bool isHighlighted = i < highlighted.size() ? highlighted[i] : false;
+        bool isHighlighted = highlighted[i];
         float cardX = x + i * spacing;
         drawCard(cards[i], cardX, y, isHighlighted, faceUp);
     }
 }
 
+/**
+ * Index of the card drawn at a point by drawHand
+ */
+std::optional<size_t> Renderer::getHandCardAt(const Hand& hand, float x, float y,
+    float pointX, float pointY) const {
+    if (hand.isEmpty() || pointY < y || pointY > y + CardSprite::CARD_HEIGHT) {
+        return std::nullopt;
+    }
+
+    // Later cards are drawn on top, so test them first
+    float spacing = calculateCardSpacing(hand.size(), getWindowWidth() - 100);
+    for (size_t i = hand.size(); i > 0; --i) {
+        float cardX = x + (i - 1) * spacing;
+        if (pointX >= cardX && pointX <= cardX + CardSprite::CARD_WIDTH) {
+            return i - 1;
+        }
+    }
+    return std::nullopt;
+}
+
+/**
+ * Highlight flags marking the selected cards (each selected copy marks one card)
+ */
+HandHighlights Renderer::selectionHighlights(const Hand& hand, const CardSet& selection) {
+    HandHighlights highlighted;
+
+    CardSet remaining = selection;
+    auto cards = hand.getCards();
+    for (size_t i = 0; i < cards.size(); ++i) {
+        highlighted[i] = remaining.remove(cards[i]);
+    }
+    return highlighted;
+}
+
 /**
  * Draw a hand in an arc
  */
 void Renderer::drawHandArc(const Hand& hand, float centerX, float centerY, float radius,
-    bool faceUp, const std::vector<bool>& highlighted) {
+    bool faceUp, const HandHighlights& highlighted) {
     if (hand.isEmpty()) {
         return;
     }
@@ -90,15 +124,14 @@ void Renderer::drawHandArc(const Hand& hand, float centerX, float centerY, float
         float cardX = centerX + radius * std::sin(radians) - CardSprite::CARD_WIDTH / 2.0f;
         float cardY = centerY - radius * std::cos(radians);
 
-        bool isHighlighted = i < highlighted.size() ? highlighted[i] : false;
-        drawCard(cards[i], cardX, cardY, isHighlighted, faceUp);
+        drawCard(cards[i], cardX, cardY, highlighted[i], faceUp);
     }
 }
 
 /**
  * Draw text on screen
  */
-void Renderer::drawText(const std::string& text, float x, float y,
+void Renderer::drawText(std::string_view text, float x, float y,
     unsigned int size, const sf::Color& color, TextAlign align) {
     UIElements::drawText(window_, text, x, y, size, color, align);
 }
@@ -106,7 +139,7 @@ void Renderer::drawText(const std::string& text, float x, float y,
 /**
  * Draw game status panel
  */
-void Renderer::drawStatusPanel(const std::string& status, float x, float y,
+void Renderer::drawStatusPanel(std::string_view status, float x, float y,
     float width, float height) {
     // Draw panel background
     UIElements::drawRoundedRect(window_, x, y, width, height, 8.0f,
@@ -119,10 +152,31 @@ void Renderer::drawStatusPanel(const std::string& status, float x, float y,
         ColorScheme::TextWhite, TextAlign::Center);
 }
 
+/**
+ * Draw the live verdict on the current card selection
+ */
+void Renderer::drawSelectionStatus(const SelectionValidator& selection, float x, float y) {
+    if (selection.empty()) {
+        drawText("Click cards to select a play", x, y, 18, sf::Color(200, 200, 200));
+        return;
+    }
+
+    TextBuffer text(GameRules::getPlayTypeName(selection.getPlayType(), selection.getFiveCardType()));
+    sf::Color color = sf::Color(120, 230, 120);
+    if (selection.isValid()) {
+        text.append(" - ready to play");
+    }
+    else {
+        text.append(" - ").append(selection.getErrorMessage());
+        color = sf::Color(240, 120, 120);
+    }
+    drawText(text, x, y, 18, color);
+}
+
 /**
  * Draw player info
  */
-void Renderer::drawPlayerInfo(const std::string& name, int cardCount,
+void Renderer::drawPlayerInfo(std::string_view name, int cardCount,
     float x, float y, bool active) {
     // Background color depends on if player is active
     sf::Color bgColor = active ? sf::Color(80, 120, 80, 200) : sf::Color(60, 60, 60, 200);
@@ -137,14 +191,15 @@ void Renderer::drawPlayerInfo(const std::string& name, int cardCount,
     drawText(name, x + 10, y + 10, 18, ColorScheme::TextWhite);
 
     // Draw card count
-    std::string cardCountStr = "Cards: " + std::to_string(cardCount);
-    drawText(cardCountStr, x + 10, y + 35, 16, ColorScheme::TextWhite);
+    TextBuffer cardCountText("Cards: ");
+    cardCountText.append(cardCount);
+    drawText(cardCountText, x + 10, y + 35, 16, ColorScheme::TextWhite);
 }
 
 /**
  * Draw the center play area
  */
-void Renderer::drawPlayArea(const std::vector<Card>& cards, float x, float y) {
+void Renderer::drawPlayArea(std::span<const Card> cards, float x, float y) {
     if (cards.empty()) {
         // Draw empty play area
         float width = 400.0f;
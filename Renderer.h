@@ -9,12 +9,23 @@
 
 #include "Card.h"
 #include "Hand.h"
+#include "SelectionValidator.h"
 #include "CardSprite.h"
 #include "UIElements.h"
+#include "TextBuffer.h"
 #include <SFML/Graphics.hpp>
+#include <bitset>
 #include <vector>
 #include <string>
 #include <memory>
+#include <optional>
+#include <span>
+#include <string_view>
+
+/**
+ * Per-card highlight flags for a hand, in hand order
+ */
+using HandHighlights = std::bitset<HandCards::capacity()>;
 
  /**
   * Main renderer class
@@ -50,35 +61,51 @@ public:
      * Draw a hand of cards (horizontally arranged)
      */
     void drawHand(const Hand& hand, float x, float y, bool faceUp = true,
-        const std::vector<bool>& highlighted = {});
+        const HandHighlights& highlighted = {});
+
+    /**
+     * Index of the card drawn at a point by drawHand (the topmost one where cards overlap)
+     */
+    std::optional<size_t> getHandCardAt(const Hand& hand, float x, float y,
+        float pointX, float pointY) const;
+
+    /**
+     * Highlight flags for drawHand marking the selected cards
+     */
+    static HandHighlights selectionHighlights(const Hand& hand, const CardSet& selection);
 
     /**
      * Draw a hand in an arc (for better visual appeal)
      */
     void drawHandArc(const Hand& hand, float centerX, float centerY, float radius,
-        bool faceUp = true, const std::vector<bool>& highlighted = {});
+        bool faceUp = true, const HandHighlights& highlighted = {});
 
     /**
      * Draw text on screen
      */
-    void drawText(const std::string& text, float x, float y,
+    void drawText(std::string_view text, float x, float y,
         unsigned int size = 24, const sf::Color& color = sf::Color::White,
         TextAlign align = TextAlign::Left);
 
     /**
      * Draw game status/info panel
      */
-    void drawStatusPanel(const std::string& status, float x, float y, float width, float height);
+    void drawStatusPanel(std::string_view status, float x, float y, float width, float height);
+
+    /**
+     * Draw the live verdict on the current card selection
+     */
+    void drawSelectionStatus(const SelectionValidator& selection, float x, float y);
 
     /**
      * Draw player info (name, card count)
      */
-    void drawPlayerInfo(const std::string& name, int cardCount, float x, float y, bool active = false);
+    void drawPlayerInfo(std::string_view name, int cardCount, float x, float y, bool active = false);
 
     /**
      * Draw the center play area (shows last played cards)
      */
-    void drawPlayArea(const std::vector<Card>& cards, float x, float y);
+    void drawPlayArea(std::span<const Card> cards, float x, float y);
 
     /**
      * Draw a button
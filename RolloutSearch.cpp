@@ -0,0 +1,335 @@
+/**
+ * RolloutSearch.cpp
+ * Implementation of RolloutSearch
+ */
+
+#include "RolloutSearch.h"
+#include "Bot.h"
+#include "MoveGenerator.h"
+#include "TraceRecorder.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <random>
+
+namespace {
+
+    /**
+     * Order-independent key of a play (sorted card indices, 6 bits each)
+     */
+    std::uint32_t playKey(std::span<const Card> cards) {
+        std::array<std::uint32_t, 5> indices{};
+        size_t count = std::min(cards.size(), indices.size());
+        for (size_t i = 0; i < count; ++i) {
+            indices[i] = static_cast<std::uint32_t>(cards[i].getIndex()) + 1;
+        }
+        std::sort(indices.begin(), indices.begin() + static_cast<std::ptrdiff_t>(count));
+        std::uint32_t key = 0;
+        for (size_t i = 0; i < count; ++i) {
+            key = (key << 6) | indices[i];
+        }
+        return key;     // 0 = pass
+    }
+
+    bool mustPlayThreeOfDiamonds(const GameState& state, size_t seat) {
+        return state.isFirstPlayOfGame() && state.getSeats().holds(seat, Card(Rank::Three, Suit::Diamonds));
+    }
+
+    bool isTwo(int index) {
+        return Card::fromIndex(index).getRank() == Rank::Two;
+    }
+
+    /**
+     * The cards the searching seat cannot see, 2s first, and how many each
+     * other seat holds (two decks: a card held twice appears twice)
+     */
+    struct HiddenCards {
+        std::array<std::uint8_t, 104> cards{};
+        size_t count = 0;
+        size_t twos = 0;
+        std::array<size_t, SeatTable::MAX_SEATS> held{};
+    };
+
+    HiddenCards collectHiddenCards(const PackedGameState& packed, size_t seat) {
+        HiddenCards hidden;
+        for (size_t other = 0; other < packed.seats.size; ++other) {
+            if (other == seat) {
+                continue;
+            }
+            for (CardMask mask : { packed.seats.hands[other], packed.seats.copies[other] }) {
+                for (; mask != 0; mask &= mask - 1) {
+                    hidden.cards[hidden.count++] = static_cast<std::uint8_t>(std::countr_zero(mask));
+                    ++hidden.held[other];
+                }
+            }
+        }
+        auto twosEnd = std::stable_partition(hidden.cards.begin(), hidden.cards.begin() + static_cast<std::ptrdiff_t>(hidden.count),
+            [](std::uint8_t index) { return isTwo(index); });
+        hidden.twos = static_cast<size_t>(twosEnd - hidden.cards.begin());
+        return hidden;
+    }
+
+    /**
+     * Relative odds that a hidden 2 lies with each other seat, from the
+     * seat's profile and what it did this game (all 1 without a model):
+     *  - down to half its dealt cards without spending a 2 while it had
+     *    more: x (1 - earlyTwoRate), the chance it would have kept one back
+     *  - each pass against a single below the 2s: x its pass rate against
+     *    singles, the chance it would have passed with a 2 in hand
+     */
+    std::array<double, SeatTable::MAX_SEATS> twoWeights(const GameState& state, const PackedGameState& packed, size_t seat) {
+        std::array<double, SeatTable::MAX_SEATS> weights;
+        weights.fill(1.0);
+        const OpponentModel* model = state.getOpponentModel();
+        if (!model) {
+            return weights;
+        }
+
+        const SeatTable& seats = state.getSeats();
+        const size_t numSeats = seats.size();
+        const size_t dealtCards = static_cast<size_t>(packed.numDecks) * 52 / numSeats;
+        std::array<OpponentProfile, SeatTable::MAX_SEATS> profiles{};
+        for (size_t other = 0; other < numSeats; ++other) {
+            if (other != seat) {
+                profiles[other] = model->getProfile(state.getPlayerId(other));
+            }
+        }
+
+        // Cards held when the recorded turns begin: held now plus played since
+        std::span<const TurnDiff> turns = state.getHistory().getTurns();
+        std::array<size_t, SeatTable::MAX_SEATS> held{};
+        for (size_t other = 0; other < numSeats; ++other) {
+            held[other] = seats.getCardCount(other);
+        }
+        for (const TurnDiff& turn : turns) {
+            if (turn.kind() == TurnDiffKind::Play) {
+                held[turn.seat] += turn.getCards().size();
+            }
+        }
+        std::array<size_t, SeatTable::MAX_SEATS> heldAtStart = held;
+
+        std::uint32_t earlyTwoSeats = 0;    // Bit i = seat i spent a 2 while early
+        PlayCards facing;
+        for (const TurnDiff& turn : turns) {
+            switch (turn.kind()) {
+            case TurnDiffKind::Play:
+                facing = turn.getCards();
+                if (held[turn.seat] * 2 > dealtCards) {
+                    for (const auto& card : facing) {
+                        if (card.getRank() == Rank::Two) {
+                            earlyTwoSeats |= 1u << turn.seat;
+                        }
+                    }
+                }
+                held[turn.seat] -= facing.size();
+                break;
+            case TurnDiffKind::Pass:
+            case TurnDiffKind::TrickEnd:
+                if (turn.seat != seat && facing.size() == 1 && facing[0].getRank() != Rank::Two) {
+                    weights[turn.seat] *= profiles[turn.seat].getPassRate(PlayType::Single);
+                }
+                if (turn.kind() == TurnDiffKind::TrickEnd) {
+                    facing.clear();
+                }
+                break;
+            case TurnDiffKind::Reset:
+                facing.clear();
+                break;
+            }
+        }
+
+        for (size_t other = 0; other < numSeats; ++other) {
+            bool pastEarly = heldAtStart[other] * 2 > dealtCards && seats.getCardCount(other) * 2 <= dealtCards;
+            if (other != seat && pastEarly && !((earlyTwoSeats >> other) & 1u)) {
+                weights[other] *= 1.0 - profiles[other].earlyTwoRate;
+            }
+        }
+        return weights;
+    }
+
+    /**
+     * Deal the hidden cards again into the other seats' hands of sample,
+     * keeping every seat's card count: each 2 goes to a seat with odds of
+     * its free places x its weight, the other cards uniformly
+     */
+    void sampleHiddenHands(const HiddenCards& hidden, const std::array<double, SeatTable::MAX_SEATS>& weights,
+        size_t seat, PackedGameState& sample, std::mt19937_64& rng) {
+        std::array<size_t, SeatTable::MAX_SEATS> free = hidden.held;
+        for (size_t other = 0; other < sample.seats.size; ++other) {
+            if (other != seat) {
+                sample.seats.hands[other] = 0;
+                sample.seats.copies[other] = 0;
+            }
+        }
+        auto give = [&](size_t other, std::uint8_t index) {
+            CardMask bit = CardMask{ 1 } << index;
+            if (sample.seats.hands[other] & bit) {
+                sample.seats.copies[other] |= bit;
+            }
+            else {
+                sample.seats.hands[other] |= bit;
+            }
+            --free[other];
+        };
+
+        for (size_t i = 0; i < hidden.twos; ++i) {
+            double total = 0.0;
+            for (size_t other = 0; other < sample.seats.size; ++other) {
+                total += static_cast<double>(free[other]) * weights[other];
+            }
+            double pick = std::uniform_real_distribution<double>(0.0, total)(rng);
+            size_t other = 0;
+            while (other + 1 < sample.seats.size && (pick -= static_cast<double>(free[other]) * weights[other]) >= 0.0) {
+                ++other;
+            }
+            while (free[other] == 0) {
+                --other;    // Rounding ran past the last seat with room
+            }
+            give(other, hidden.cards[i]);
+        }
+
+        std::array<std::uint8_t, 104> rest;
+        std::copy(hidden.cards.begin() + static_cast<std::ptrdiff_t>(hidden.twos),
+            hidden.cards.begin() + static_cast<std::ptrdiff_t>(hidden.count), rest.begin());
+        size_t restCount = hidden.count - hidden.twos;
+        std::shuffle(rest.begin(), rest.begin() + static_cast<std::ptrdiff_t>(restCount), rng);
+        size_t next = 0;
+        for (size_t other = 0; other < sample.seats.size; ++other) {
+            while (free[other] > 0) {
+                give(other, rest[next++]);
+            }
+        }
+    }
+
+    constexpr size_t OUT_OF_TIME = SIZE_MAX - 1;
+
+    /**
+     * Finish a game with the heuristic bot in every seat, checking the
+     * deadline before every move
+     * @return Winning seat, SIZE_MAX if the game did not finish, or
+     *         OUT_OF_TIME if the deadline came first
+     */
+    size_t playOut(GameState& game, RolloutSearch::Clock::time_point deadline, const GameClock& clock) {
+        for (size_t turn = 0; turn < RolloutSearch::MAX_PLAYOUT_TURNS && game.getPhase() == GamePhase::InProgress; ++turn) {
+            if (clock.now() >= deadline) {
+                return OUT_OF_TIME;
+            }
+            size_t seat = game.getCurrentPlayerIndex();
+            PlayCards play = Bot::choosePlayUntraced(game.getSeats().getCards(seat), game.getLastPlay(),
+                mustPlayThreeOfDiamonds(game, seat));
+            if (!play.empty()) {
+                TurnResult result = game.applyTurn(TurnAction::Play, play);
+                if (result == TurnResult::GameWon) {
+                    return seat;
+                }
+                if (result != TurnResult::Rejected) {
+                    continue;
+                }
+            }
+            if (game.applyTurn(TurnAction::Pass) == TurnResult::Rejected) {
+                break;
+            }
+        }
+        return SIZE_MAX;
+    }
+
+} // namespace
+
+/**
+ * Play Bot::choosePlay's move for the seat to move
+ */
+PlayCards RolloutSearch::heuristicPlay(const GameState& state) {
+    size_t seat = state.getCurrentPlayerIndex();
+    return Bot::choosePlay(state.getSeats().getCards(seat), state.getLastPlay(),
+        mustPlayThreeOfDiamonds(state, seat), state.getOpponentProfiles(seat));
+}
+
+/**
+ * Choose a play for the seat to move
+ */
+SearchResult RolloutSearch::choosePlay(const GameState& state, const SearchBudget& budget,
+    std::uint64_t seed, Clock::time_point deadline, const GameClock& clock) {
+    THIRTEEN_TRACE_SCOPE("RolloutSearch::choosePlay");
+
+    SearchResult result;
+    result.play = heuristicPlay(state);
+    if (budget.samples == 0 || state.getPhase() != GamePhase::InProgress) {
+        return result;
+    }
+
+    // Candidates: the heuristic play, the weakest legal plays, and passing when following
+    size_t seat = state.getCurrentPlayerIndex();
+    std::vector<PlayCards> candidates;
+    candidates.push_back(result.play);
+    std::vector<std::uint32_t> keys{ playKey(result.play) };
+    auto plays = MoveGenerator::generatePlays(state.getSeats().getCards(seat), state.getLastPlay(),
+        mustPlayThreeOfDiamonds(state, seat));
+    for (const auto& play : plays) {
+        if (candidates.size() >= static_cast<size_t>(budget.maxCandidates) + 1) {
+            break;
+        }
+        std::uint32_t key = playKey(play);
+        if (std::find(keys.begin(), keys.end(), key) == keys.end()) {
+            keys.push_back(key);
+            candidates.emplace_back(std::span<const Card>(play));
+        }
+    }
+    if (!state.getLastPlay().empty() && std::find(keys.begin(), keys.end(), 0u) == keys.end()) {
+        keys.push_back(0);
+        candidates.emplace_back();
+    }
+    if (candidates.size() == 1) {
+        result.heuristic = false;   // Nothing to choose between; no search needed
+        return result;
+    }
+
+    // Pack once: each sample redeals the hidden cards in the packed masks
+    // and every playout unpacks it into the same scratch table
+    PackedGameState sample = state.pack();
+    sample.opponentModel = nullptr;     // Playouts must not teach the shared model
+    const HiddenCards hidden = collectHiddenCards(sample, seat);
+    const auto weights = twoWeights(state, sample, seat);
+    GameState game;
+
+    std::vector<std::uint32_t> wins(candidates.size(), 0);
+    std::vector<std::uint32_t> sampleWins(candidates.size(), 0);
+    std::mt19937_64 rng(seed);
+    bool outOfTime = false;
+    for (std::uint32_t i = 0; i < budget.samples && !outOfTime; ++i) {
+        sampleHiddenHands(hidden, weights, seat, sample, rng);
+        std::fill(sampleWins.begin(), sampleWins.end(), 0u);
+        for (size_t c = 0; c < candidates.size(); ++c) {
+            if (clock.now() >= deadline) {
+                outOfTime = true;   // A sample cut short would favour the candidates it reached
+                break;
+            }
+            game.unpack(sample);
+            TurnResult first = candidates[c].empty() ? game.applyTurn(TurnAction::Pass)
+                : game.applyTurn(TurnAction::Play, candidates[c]);
+            if (first == TurnResult::Rejected) {
+                continue;
+            }
+            size_t winner = first == TurnResult::GameWon ? seat : playOut(game, deadline, clock);
+            if (winner == OUT_OF_TIME) {
+                outOfTime = true;
+                break;
+            }
+            sampleWins[c] += winner == seat ? 1 : 0;
+            ++result.playouts;
+        }
+        if (!outOfTime) {
+            for (size_t c = 0; c < candidates.size(); ++c) {
+                wins[c] += sampleWins[c];
+            }
+            ++result.samples;
+        }
+    }
+    if (result.samples == 0) {
+        return result;
+    }
+
+    size_t best = static_cast<size_t>(std::max_element(wins.begin(), wins.end()) - wins.begin());
+    result.play = candidates[best];
+    result.heuristic = false;
+    return result;
+}
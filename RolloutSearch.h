@@ -0,0 +1,74 @@
+/**
+ * RolloutSearch.hpp
+ * Budgeted Monte Carlo search over a seat's candidate plays
+ *
+ * Each sample deals the cards the seat cannot see (the other seats' hands)
+ * at random, keeping every seat's card count, then plays each candidate
+ * and finishes the game with Bot::choosePlay in every seat. The candidate
+ * that wins the most playouts is chosen; the heuristic play is tried first
+ * and wins ties. The budget is the number of samples, so a decision costs
+ * samples x candidates playouts.
+ *
+ * With an opponent model the 2s are not dealt uniformly: a seat that has
+ * passed against singles, or got through the early game without spending
+ * a 2, is less likely to hold one, weighted by its profile's pass and
+ * early-2 rates. The other cards are dealt uniformly.
+ *
+ * The table is packed once per decision; samples are dealt into the packed
+ * masks and each playout unpacks into one scratch table. The deadline is
+ * checked before every playout move, so a search overruns it by at most
+ * one bot move; a sample cut short is dropped, and the search answers with
+ * the samples it finished, or the heuristic play if there are none.
+ * Playouts use Bot::choosePlayUntraced and record no trace events.
+ */
+
+#ifndef ROLLOUTSEARCH_H
+#define ROLLOUTSEARCH_H
+
+#include "GameClock.h"
+#include "GameState.h"
+#include <chrono>
+#include <cstdint>
+
+/**
+ * Work a search may do for one decision
+ */
+struct SearchBudget {
+    std::uint32_t samples = 0;          // Hidden-card deals, each played out once per candidate; 0 = heuristic
+    std::uint32_t maxCandidates = 8;    // Plays searched besides passing (heuristic play first, then weakest first)
+};
+
+/**
+ * What one search did
+ */
+struct SearchResult {
+    PlayCards play;                     // Empty to pass
+    std::uint32_t samples = 0;          // Samples finished before the deadline
+    std::uint32_t playouts = 0;
+    bool heuristic = true;              // Search skipped or out of time; the play is Bot::choosePlay's
+};
+
+/**
+ * RolloutSearch class
+ */
+class RolloutSearch {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr size_t MAX_PLAYOUT_TURNS = 2000;   // Safety limit against stuck playouts
+
+    /**
+     * Choose a play for the seat to move
+     * @param seed Seeds the hidden-card deals (same seed, same samples)
+     * @param clock The deadline's clock
+     */
+    static SearchResult choosePlay(const GameState& state, const SearchBudget& budget,
+        std::uint64_t seed, Clock::time_point deadline, const GameClock& clock = GameClock::system());
+
+    /**
+     * Play Bot::choosePlay's move for the seat to move
+     */
+    static PlayCards heuristicPlay(const GameState& state);
+};
+
+#endif // ROLLOUTSEARCH_HPP
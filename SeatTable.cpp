@@ -0,0 +1,239 @@
+/**
+ * SeatTable.cpp
+ * Implementation of SeatTable
+ */
+
+#include "SeatTable.h"
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+
+/**
+ * Constructor
+ */
+SeatTable::SeatTable() : names_(std::make_shared<const std::vector<std::string>>()) {
+    bindViews();
+}
+
+/**
+ * Copy the arrays; views are rebound to the copy
+ */
+SeatTable::SeatTable(const SeatTable& other)
+    : hands_(other.hands_),
+    copies_(other.copies_),
+    counts_(other.counts_),
+    nameIds_(other.nameIds_),
+    scores_(other.scores_),
+    humanSeats_(other.humanSeats_),
+    bySuitSeats_(other.bySuitSeats_),
+    size_(other.size_),
+    names_(other.names_) {
+    bindViews();
+}
+
+SeatTable& SeatTable::operator=(const SeatTable& other) {
+    hands_ = other.hands_;
+    copies_ = other.copies_;
+    counts_ = other.counts_;
+    nameIds_ = other.nameIds_;
+    scores_ = other.scores_;
+    humanSeats_ = other.humanSeats_;
+    bySuitSeats_ = other.bySuitSeats_;
+    size_ = other.size_;
+    names_ = other.names_;
+    return *this;
+}
+
+/**
+ * Remove every seat
+ */
+void SeatTable::clear() {
+    SeatTable empty;
+    *this = empty;
+}
+
+/**
+ * Add a seat with an empty hand
+ */
+size_t SeatTable::addSeat(const std::string& name, PlayerType type) {
+    if (size_ >= MAX_SEATS) {
+        throw std::length_error("Too many seats");
+    }
+
+    size_t seat = size_++;
+    hands_[seat] = 0;
+    copies_[seat] = 0;
+    counts_[seat] = 0;
+    scores_[seat] = 0;
+    nameIds_[seat] = intern(name);
+    humanSeats_ = (humanSeats_ & ~(1u << seat)) | (type == PlayerType::Human ? 1u << seat : 0u);
+    bySuitSeats_ &= ~(1u << seat);
+    return seat;
+}
+
+/**
+ * Empty every hand and restore the default sort order
+ */
+void SeatTable::clearHands() {
+    hands_.fill(0);
+    copies_.fill(0);
+    counts_.fill(0);
+    bySuitSeats_ = 0;
+}
+
+/**
+ * Add a card to a seat's hand
+ */
+void SeatTable::addCard(size_t seat, const Card& card) {
+    CardMask bit = cardBit(card);
+    if (!(hands_[seat] & bit)) {
+        hands_[seat] |= bit;
+    }
+    else if (!(copies_[seat] & bit)) {
+        copies_[seat] |= bit;
+    }
+    else {
+        throw std::length_error("Too many copies of " + card.toString());
+    }
+    ++counts_[seat];
+}
+
+/**
+ * Remove cards from a seat's hand (second copies go first)
+ */
+bool SeatTable::removeCards(size_t seat, std::span<const Card> cards) {
+    if (!getHand(seat).contains(CardSet(cards))) {
+        return false;
+    }
+
+    for (const auto& card : cards) {
+        CardMask bit = cardBit(card);
+        if (copies_[seat] & bit) {
+            copies_[seat] &= ~bit;
+        }
+        else {
+            hands_[seat] &= ~bit;
+        }
+    }
+    counts_[seat] = static_cast<std::uint8_t>(counts_[seat] - cards.size());
+    return true;
+}
+
+/**
+ * Cards held by a seat, in the seat's sort order
+ */
+HandCards SeatTable::getCards(size_t seat) const {
+    HandCards cards;
+    CardMask mask = hands_[seat];
+    while (mask != 0) {
+        Card card = Card::fromIndex(std::countr_zero(mask));
+        cards.push_back(card);
+        if (copies_[seat] & cardBit(card)) {
+            cards.push_back(card);
+        }
+        mask &= mask - 1;
+    }
+    if (getSortOrder(seat) == SortOrder::BySuit) {
+        std::stable_sort(cards.begin(), cards.end(), [](const Card& a, const Card& b) {
+            return a.getSuit() < b.getSuit();
+            });
+    }
+    return cards;
+}
+
+/**
+ * First seat holding a card
+ */
+std::optional<size_t> SeatTable::findHolder(const Card& card) const {
+    CardMask bit = cardBit(card);
+    for (size_t seat = 0; seat < size_; ++seat) {
+        if (hands_[seat] & bit) {
+            return seat;
+        }
+    }
+    return std::nullopt;
+}
+
+/**
+ * First seat with no cards left
+ */
+std::optional<size_t> SeatTable::findEmptyHand() const {
+    for (size_t seat = 0; seat < size_; ++seat) {
+        if (counts_[seat] == 0) {
+            return seat;
+        }
+    }
+    return std::nullopt;
+}
+
+PlayerType SeatTable::getType(size_t seat) const {
+    return (humanSeats_ >> seat) & 1u ? PlayerType::Human : PlayerType::AI;
+}
+
+SortOrder SeatTable::getSortOrder(size_t seat) const {
+    return (bySuitSeats_ >> seat) & 1u ? SortOrder::BySuit : SortOrder::ByRank;
+}
+
+void SeatTable::setSortOrder(size_t seat, SortOrder order) {
+    bySuitSeats_ = (bySuitSeats_ & ~(1u << seat)) | (order == SortOrder::BySuit ? 1u << seat : 0u);
+}
+
+/**
+ * Seats without the Player views
+ */
+SeatTable::Packed SeatTable::pack() const {
+    Packed packed;
+    packed.hands = hands_;
+    packed.copies = copies_;
+    packed.scores = scores_;
+    packed.nameIds = nameIds_;
+    packed.names = names_;
+    packed.humanSeats = static_cast<std::uint8_t>(humanSeats_);
+    packed.bySuitSeats = static_cast<std::uint8_t>(bySuitSeats_);
+    packed.size = static_cast<std::uint8_t>(size_);
+    return packed;
+}
+
+/**
+ * Restore packed seats (views stay bound to this table)
+ */
+void SeatTable::unpack(const Packed& packed) {
+    hands_ = packed.hands;
+    copies_ = packed.copies;
+    scores_ = packed.scores;
+    nameIds_ = packed.nameIds;
+    names_ = packed.names;
+    humanSeats_ = packed.humanSeats;
+    bySuitSeats_ = packed.bySuitSeats;
+    size_ = packed.size;
+    for (size_t seat = 0; seat < MAX_SEATS; ++seat) {
+        counts_[seat] = static_cast<std::uint8_t>(std::popcount(hands_[seat]) + std::popcount(copies_[seat]));
+    }
+}
+
+/**
+ * Point every view at this table
+ */
+void SeatTable::bindViews() {
+    for (size_t seat = 0; seat < MAX_SEATS; ++seat) {
+        views_[seat] = Player(*this, seat);
+    }
+}
+
+/**
+ * Id of a name in the shared table, adding it if new (copy on write)
+ */
+std::uint8_t SeatTable::intern(const std::string& name) {
+    auto it = std::find(names_->begin(), names_->end(), name);
+    if (it != names_->end()) {
+        return static_cast<std::uint8_t>(it - names_->begin());
+    }
+
+    // Sized exactly: the table is kept by every copy and hibernated table
+    auto names = std::make_shared<std::vector<std::string>>();
+    names->reserve(names_->size() + 1);
+    names->assign(names_->begin(), names_->end());
+    names->push_back(name);
+    names_ = std::move(names);
+    return static_cast<std::uint8_t>(names_->size() - 1);
+}
@@ -0,0 +1,150 @@
+/**
+ * SeatTable.hpp
+ * Per-seat game data stored as parallel arrays
+ *
+ * Hands are two card masks per seat (every card held, and cards held a
+ * second time on two-deck tables), card counts and scores sit in their own
+ * arrays, and per-seat flags are bitmasks. Names live in an interned table
+ * shared between copies, so copying or scanning the seats touches a few
+ * cache lines and no strings. Player objects are views into this table.
+ */
+
+#ifndef SEATTABLE_H
+#define SEATTABLE_H
+
+#include "CardSet.h"
+#include "Player.h"
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+/**
+ * SeatTable class
+ */
+class SeatTable {
+public:
+    static constexpr size_t MAX_SEATS = 8;
+    static constexpr size_t MAX_COPIES = CardSet::MAX_COPIES;
+
+    SeatTable();
+    SeatTable(const SeatTable& other);
+    SeatTable& operator=(const SeatTable& other);
+
+    /**
+     * Remove every seat
+     */
+    void clear();
+
+    /**
+     * Add a seat with an empty hand
+     * @return Seat index
+     * @throws std::length_error if the table already has MAX_SEATS seats
+     */
+    size_t addSeat(const std::string& name, PlayerType type);
+
+    /**
+     * Number of seats
+     */
+    size_t size() const { return size_; }
+
+    /**
+     * Player views, one per seat
+     */
+    std::span<Player> players() { return { views_.data(), size_ }; }
+    std::span<const Player> players() const { return { views_.data(), size_ }; }
+
+    /**
+     * Empty every hand and restore the default sort order
+     */
+    void clearHands();
+
+    /**
+     * Add a card to a seat's hand
+     * @throws std::length_error if the seat already holds MAX_COPIES of it
+     */
+    void addCard(size_t seat, const Card& card);
+
+    /**
+     * Remove cards from a seat's hand
+     * @return false (and nothing removed) if any card is not held often enough
+     */
+    bool removeCards(size_t seat, std::span<const Card> cards);
+
+    /**
+     * Cards held by a seat
+     */
+    CardSet getHand(size_t seat) const { return CardSet::fromMask(hands_[seat], copies_[seat]); }
+
+    /**
+     * Cards held by a seat, in the seat's sort order
+     */
+    HandCards getCards(size_t seat) const;
+
+    size_t getCardCount(size_t seat) const { return counts_[seat]; }
+    bool holds(size_t seat, const Card& card) const { return (hands_[seat] & cardBit(card)) != 0; }
+
+    /**
+     * First seat holding a card
+     */
+    std::optional<size_t> findHolder(const Card& card) const;
+
+    /**
+     * First seat with no cards left
+     */
+    std::optional<size_t> findEmptyHand() const;
+
+    const std::string& getName(size_t seat) const { return (*names_)[nameIds_[seat]]; }
+    PlayerType getType(size_t seat) const;
+    SortOrder getSortOrder(size_t seat) const;
+    void setSortOrder(size_t seat, SortOrder order);
+
+    int getScore(size_t seat) const { return scores_[seat]; }
+    void setScore(size_t seat, int score) { scores_[seat] = score; }
+
+    /**
+     * Seats without the Player views, for hibernated tables; card counts
+     * are recomputed from the masks on unpack
+     */
+    struct Packed {
+        std::array<CardMask, MAX_SEATS> hands{};
+        std::array<CardMask, MAX_SEATS> copies{};
+        std::array<std::int32_t, MAX_SEATS> scores{};
+        std::array<std::uint8_t, MAX_SEATS> nameIds{};
+        std::shared_ptr<const std::vector<std::string>> names;
+        std::uint8_t humanSeats = 0;
+        std::uint8_t bySuitSeats = 0;
+        std::uint8_t size = 0;
+    };
+
+    Packed pack() const;
+    void unpack(const Packed& packed);
+
+private:
+    std::array<CardMask, MAX_SEATS> hands_{};       // Every card held
+    std::array<CardMask, MAX_SEATS> copies_{};      // Cards held a second time
+    std::array<std::uint8_t, MAX_SEATS> counts_{};
+    std::array<std::uint8_t, MAX_SEATS> nameIds_{};
+    std::array<std::int32_t, MAX_SEATS> scores_{};
+    std::uint32_t humanSeats_ = 0;                  // Bit i = seat i is human
+    std::uint32_t bySuitSeats_ = 0;                 // Bit i = seat i sorts by suit
+    std::uint32_t size_ = 0;
+
+    std::shared_ptr<const std::vector<std::string>> names_;
+    std::array<Player, MAX_SEATS> views_;
+
+    /**
+     * Point every view at this table
+     */
+    void bindViews();
+
+    /**
+     * Id of a name in the shared table, adding it if new
+     */
+    std::uint8_t intern(const std::string& name);
+};
+
+#endif // SEATTABLE_HPP
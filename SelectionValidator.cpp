@@ -0,0 +1,182 @@
+/**
+ * SelectionValidator.cpp
+ * Implementation of SelectionValidator
+ */
+
+#include "SelectionValidator.h"
+#include <algorithm>
+#include <bit>
+
+/**
+ * Constructor
+ */
+SelectionValidator::SelectionValidator() {
+    update();
+}
+
+/**
+ * Set the play to beat; the selection is kept and re-validated
+ */
+void SelectionValidator::setContext(std::span<const Card> lastPlay, bool mustIncludeThreeOfDiamonds) {
+    lastKey_ = lastPlay.empty() ? 0 : GameRules::getPlayKey(lastPlay);
+    lastSize_ = lastPlay.size();
+    mustIncludeThreeOfDiamonds_ = mustIncludeThreeOfDiamonds;
+    update();
+}
+
+/**
+ * Add one copy of a card to the selection
+ */
+bool SelectionValidator::add(const Card& card) {
+    if (selection_.count(card) >= static_cast<int>(CardSet::MAX_COPIES)) {
+        return false;
+    }
+    selection_.add(card);
+    ++rankCounts_[static_cast<int>(card.getRank()) - static_cast<int>(Rank::Three)];
+    ++suitCounts_[static_cast<int>(card.getSuit())];
+    ++size_;
+    update();
+    return true;
+}
+
+/**
+ * Remove one copy of a card from the selection
+ */
+bool SelectionValidator::remove(const Card& card) {
+    if (!selection_.remove(card)) {
+        return false;
+    }
+    --rankCounts_[static_cast<int>(card.getRank()) - static_cast<int>(Rank::Three)];
+    --suitCounts_[static_cast<int>(card.getSuit())];
+    --size_;
+    update();
+    return true;
+}
+
+/**
+ * Add the card if it is not selected, otherwise remove it
+ */
+void SelectionValidator::toggle(const Card& card) {
+    if (!remove(card)) {
+        add(card);
+    }
+}
+
+/**
+ * Empty the selection
+ */
+void SelectionValidator::clear() {
+    selection_ = CardSet();
+    rankCounts_.fill(0);
+    suitCounts_.fill(0);
+    size_ = 0;
+    update();
+}
+
+/**
+ * Result in the shape GameRules::validatePlay returns
+ */
+PlayValidation SelectionValidator::getValidation() const {
+    PlayValidation result;
+    result.isValid = isValid();
+    result.playType = playType_;
+    result.fiveCardType = fiveCardType_;
+    result.errorMessage = getErrorMessage();
+    return result;
+}
+
+/**
+ * Re-derive the results from the counters, checking in validatePlay's order
+ */
+void SelectionValidator::update() {
+    playType_ = PlayType::Invalid;
+    fiveCardType_ = FiveCardType::None;
+    playKey_ = 0;
+    beatsLastPlay_ = false;
+
+    if (size_ == 0) {
+        errorMessage_ = "No cards selected";
+        return;
+    }
+
+    // Every card of a single, pair or triple shares the top card's rank
+    int highIndex = 63 - std::countl_zero(selection_.plane(0));
+    int topRankCount = rankCounts_[highIndex / 4];
+    switch (size_) {
+    case 1:
+        playType_ = PlayType::Single;
+        break;
+    case 2:
+        playType_ = topRankCount == 2 ? PlayType::Pair : PlayType::Invalid;
+        break;
+    case 3:
+        playType_ = topRankCount == 3 ? PlayType::Triple : PlayType::Invalid;
+        break;
+    case 5:
+        fiveCardType_ = classifyFive();
+        playType_ = fiveCardType_ != FiveCardType::None ? PlayType::FiveCard : PlayType::Invalid;
+        break;
+    default:
+        break;
+    }
+
+    if (playType_ != PlayType::Invalid) {
+        playKey_ = static_cast<std::uint16_t>((static_cast<int>(playType_) << 9) |
+            (GameRules::getFiveCardRank(fiveCardType_) << 6) | highIndex);
+        beatsLastPlay_ = GameRules::playKeyBeats(playKey_, lastKey_) && (lastSize_ == 0 || size_ == lastSize_);
+    }
+
+    if (mustIncludeThreeOfDiamonds_ && !(selection_.plane(0) & cardBit(Card(Rank::Three, Suit::Diamonds)))) {
+        errorMessage_ = "First play must include 3 of Diamonds";
+    }
+    else if (playType_ == PlayType::Invalid) {
+        errorMessage_ = "Invalid card combination";
+    }
+    else if (lastSize_ == 0) {
+        errorMessage_ = nullptr;
+    }
+    else if (size_ != lastSize_) {
+        errorMessage_ = "Must play same number of cards as last play";
+    }
+    else if (!beatsLastPlay_) {
+        errorMessage_ = "Play does not beat the previous play";
+    }
+    else {
+        errorMessage_ = nullptr;
+    }
+}
+
+/**
+ * Five-card combination formed by the counters (same precedence as
+ * GameRules::determineFiveCardType)
+ */
+FiveCardType SelectionValidator::classifyFive() const {
+    int distinctRanks = 0;
+    int maxCount = 0;
+    int lowRank = -1;
+    int highRank = -1;
+    for (int rank = 0; rank < 13; ++rank) {
+        if (rankCounts_[rank] == 0) {
+            continue;
+        }
+        ++distinctRanks;
+        maxCount = std::max<int>(maxCount, rankCounts_[rank]);
+        if (lowRank < 0) {
+            lowRank = rank;
+        }
+        highRank = rank;
+    }
+
+    bool straight = distinctRanks == 5 && highRank - lowRank == 4;
+    bool flush = false;
+    for (std::uint8_t count : suitCounts_) {
+        flush = flush || count == 5;
+    }
+
+    if (straight && flush) return FiveCardType::StraightFlush;
+    if (distinctRanks == 2 && maxCount == 4) return FiveCardType::FourOfAKind;
+    if (distinctRanks == 2 && maxCount == 3) return FiveCardType::FullHouse;
+    if (flush) return FiveCardType::Flush;
+    if (straight) return FiveCardType::Straight;
+    return FiveCardType::None;
+}
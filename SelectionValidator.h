@@ -0,0 +1,121 @@
+/**
+ * SelectionValidator.hpp
+ * Live validation of a card selection as cards are added or removed
+ *
+ * Keeps per-rank and per-suit counts of the selection, so every change
+ * re-derives play type, play key and "beats last play" from a few counters
+ * instead of re-sorting the cards. Results agree with GameRules::validatePlay
+ * and GameRules::getPlayKey.
+ */
+
+#ifndef SELECTIONVALIDATOR_H
+#define SELECTIONVALIDATOR_H
+
+#include "CardSet.h"
+#include "GameRules.h"
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+/**
+ * SelectionValidator class
+ */
+class SelectionValidator {
+public:
+    SelectionValidator();
+
+    /**
+     * Set the play to beat; the selection is kept and re-validated
+     */
+    void setContext(std::span<const Card> lastPlay, bool mustIncludeThreeOfDiamonds);
+
+    /**
+     * Add one copy of a card to the selection
+     * @return false if the card is already selected MAX_COPIES times
+     */
+    bool add(const Card& card);
+
+    /**
+     * Remove one copy of a card from the selection
+     * @return false if the card is not selected
+     */
+    bool remove(const Card& card);
+
+    /**
+     * Add the card if it is not selected, otherwise remove it
+     */
+    void toggle(const Card& card);
+
+    /**
+     * Empty the selection
+     */
+    void clear();
+
+    /**
+     * Selected cards
+     */
+    const CardSet& getSelection() const { return selection_; }
+    std::vector<Card> getCards() const { return selection_.toCards(); }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    /**
+     * Combination formed by the selection (Invalid if none)
+     */
+    PlayType getPlayType() const { return playType_; }
+    FiveCardType getFiveCardType() const { return fiveCardType_; }
+
+    /**
+     * Play key of the selection (GameRules::getPlayKey, 0 if invalid)
+     */
+    std::uint16_t getPlayKey() const { return playKey_; }
+
+    /**
+     * Whether the selection beats the play to beat (true on a new trick)
+     */
+    bool beatsLastPlay() const { return beatsLastPlay_; }
+
+    /**
+     * Whether the selection is a legal play right now
+     */
+    bool isValid() const { return errorMessage_ == nullptr; }
+
+    /**
+     * Why the selection is not a legal play (same wording as validatePlay)
+     */
+    const char* getErrorMessage() const { return errorMessage_ ? errorMessage_ : ""; }
+
+    /**
+     * Result in the shape GameRules::validatePlay returns
+     */
+    PlayValidation getValidation() const;
+
+private:
+    CardSet selection_;
+    std::array<std::uint8_t, 13> rankCounts_{};
+    std::array<std::uint8_t, 4> suitCounts_{};
+    size_t size_ = 0;
+
+    std::uint16_t lastKey_ = 0;
+    size_t lastSize_ = 0;
+    bool mustIncludeThreeOfDiamonds_ = false;
+
+    PlayType playType_ = PlayType::Invalid;
+    FiveCardType fiveCardType_ = FiveCardType::None;
+    std::uint16_t playKey_ = 0;
+    bool beatsLastPlay_ = false;
+    const char* errorMessage_ = nullptr;
+
+    /**
+     * Re-derive the results from the counters
+     */
+    void update();
+
+    /**
+     * Five-card combination formed by the counters
+     */
+    FiveCardType classifyFive() const;
+};
+
+#endif // SELECTIONVALIDATOR_HPP
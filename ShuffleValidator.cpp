@@ -0,0 +1,268 @@
+/**
+ * ShuffleValidator.cpp
+ * Histogram accumulation and chi-square analysis for shuffle validation
+ */
+
+#include "ShuffleValidator.h"
+#include <cmath>
+#include <limits>
+
+namespace {
+
+    constexpr size_t DECK_SIZE = 52;
+
+    /**
+     * Regularized lower incomplete gamma P(a, x) by series expansion
+     */
+    double gammaPSeries(double a, double x) {
+        double sum = 1.0 / a;
+        double term = sum;
+        for (int n = 1; n < 100000; ++n) {
+            term *= x / (a + n);
+            sum += term;
+            if (std::fabs(term) < std::fabs(sum) * 1e-15) {
+                break;
+            }
+        }
+        return sum * std::exp(-x + a * std::log(x) - std::lgamma(a));
+    }
+
+    /**
+     * Regularized upper incomplete gamma Q(a, x) by continued fraction
+     */
+    double gammaQContinuedFraction(double a, double x) {
+        const double tiny = std::numeric_limits<double>::min() / std::numeric_limits<double>::epsilon();
+        double b = x + 1.0 - a;
+        double c = 1.0 / tiny;
+        double d = 1.0 / b;
+        double h = d;
+        for (int i = 1; i < 100000; ++i) {
+            double an = -i * (i - a);
+            b += 2.0;
+            d = an * d + b;
+            if (std::fabs(d) < tiny) d = tiny;
+            c = b + an / c;
+            if (std::fabs(c) < tiny) c = tiny;
+            d = 1.0 / d;
+            double delta = d * c;
+            h *= delta;
+            if (std::fabs(delta - 1.0) < 1e-15) {
+                break;
+            }
+        }
+        return std::exp(-x + a * std::log(x) - std::lgamma(a)) * h;
+    }
+
+    /**
+     * Chi-square of observed counts against expected counts
+     */
+    double chiSquare(const std::uint64_t* observed, const double* expected, size_t count, size_t stride) {
+        double sum = 0.0;
+        for (size_t i = 0; i < count; ++i) {
+            double diff = static_cast<double>(observed[i * stride]) - expected[i];
+            sum += diff * diff / expected[i];
+        }
+        return sum;
+    }
+
+    ChiSquareResult makeResult(double statistic, double degreesOfFreedom) {
+        ChiSquareResult result;
+        result.statistic = statistic;
+        result.degreesOfFreedom = degreesOfFreedom;
+        result.pValue = ShuffleValidator::chiSquarePValue(statistic, degreesOfFreedom);
+        return result;
+    }
+
+} // namespace
+
+/**
+ * Constructor - precompute which seat each deck position is dealt to
+ */
+ShuffleHistogram::ShuffleHistogram(int numPlayers)
+    : numPlayers_(std::max(1, numPlayers)),
+    seatOfPosition_(DECK_SIZE),
+    position32_(DECK_SIZE * DECK_SIZE, 0),
+    pair32_(DECK_SIZE * DECK_SIZE, 0),
+    position_(DECK_SIZE * DECK_SIZE, 0),
+    pair_(DECK_SIZE * DECK_SIZE, 0) {
+    const size_t players = static_cast<size_t>(numPlayers_);
+    const size_t dealt = DECK_SIZE / players * players;
+    seatCategories_ = dealt == DECK_SIZE ? players : players + 1;
+
+    // GameState::dealCards deals from the back of the deck, round-robin
+    for (size_t position = 0; position < DECK_SIZE; ++position) {
+        seatOfPosition_[position] = static_cast<std::uint8_t>(players);
+    }
+    for (size_t i = 0; i < dealt; ++i) {
+        seatOfPosition_[DECK_SIZE - 1 - i] = static_cast<std::uint8_t>(i % players);
+    }
+
+    seatShare_.assign(seatCategories_, 0.0);
+    for (size_t position = 0; position < DECK_SIZE; ++position) {
+        seatShare_[seatOfPosition_[position]] += 1.0 / DECK_SIZE;
+    }
+
+    seat32_.assign(DECK_SIZE * seatCategories_, 0);
+    seat_.assign(DECK_SIZE * seatCategories_, 0);
+}
+
+/**
+ * Count one shuffled deck
+ */
+void ShuffleHistogram::add(const std::vector<Card>& deck) {
+    std::uint8_t index[DECK_SIZE];
+    for (size_t p = 0; p < DECK_SIZE; ++p) {
+        index[p] = static_cast<std::uint8_t>(deck[p].getIndex());
+    }
+
+    std::uint32_t* position = position32_.data();
+    std::uint32_t* seat = seat32_.data();
+    std::uint32_t* pair = pair32_.data();
+    const size_t categories = seatCategories_;
+
+    std::uint32_t sameSuit = 0;
+    for (size_t p = 0; p < DECK_SIZE; ++p) {
+        ++position[p * DECK_SIZE + index[p]];
+        ++seat[index[p] * categories + seatOfPosition_[p]];
+    }
+    for (size_t p = 0; p + 1 < DECK_SIZE; ++p) {
+        ++pair[index[p] * DECK_SIZE + index[p + 1]];
+        sameSuit += static_cast<std::uint32_t>((index[p] & 3) == (index[p + 1] & 3));
+    }
+
+    ++pending_;
+    pendingStreakSum_ += sameSuit;
+    pendingStreakSumSq_ += static_cast<std::uint64_t>(sameSuit) * sameSuit;
+}
+
+/**
+ * Spill 32-bit counters into the 64-bit totals
+ */
+void ShuffleHistogram::flush() {
+    for (size_t i = 0; i < position32_.size(); ++i) {
+        position_[i] += position32_[i];
+        pair_[i] += pair32_[i];
+    }
+    for (size_t i = 0; i < seat32_.size(); ++i) {
+        seat_[i] += seat32_[i];
+    }
+    std::fill(position32_.begin(), position32_.end(), 0);
+    std::fill(pair32_.begin(), pair32_.end(), 0);
+    std::fill(seat32_.begin(), seat32_.end(), 0);
+
+    deals_ += pending_;
+    streakSum_ += pendingStreakSum_;
+    streakSumSq_ += pendingStreakSumSq_;
+    pending_ = 0;
+    pendingStreakSum_ = 0;
+    pendingStreakSumSq_ = 0;
+}
+
+/**
+ * Add another histogram into this one
+ */
+void ShuffleHistogram::merge(const ShuffleHistogram& other) {
+    for (size_t i = 0; i < position_.size(); ++i) {
+        position_[i] += other.position_[i];
+        pair_[i] += other.pair_[i];
+    }
+    for (size_t i = 0; i < seat_.size() && i < other.seat_.size(); ++i) {
+        seat_[i] += other.seat_[i];
+    }
+    deals_ += other.deals_;
+    streakSum_ += other.streakSum_;
+    streakSumSq_ += other.streakSumSq_;
+}
+
+/**
+ * Compute the test statistics
+ */
+ShuffleTestReport ShuffleHistogram::analyze() const {
+    ShuffleTestReport report;
+    report.deals = deals_;
+    if (deals_ == 0) {
+        return report;
+    }
+
+    const double n = static_cast<double>(deals_);
+
+    // Card x position: expected n / 52 in every cell
+    std::vector<double> expected(DECK_SIZE, n / DECK_SIZE);
+    double overall = 0.0;
+    report.worstPosition.pValue = 2.0;
+    for (size_t p = 0; p < DECK_SIZE; ++p) {
+        double stat = chiSquare(&position_[p * DECK_SIZE], expected.data(), DECK_SIZE, 1);
+        overall += stat;
+        ChiSquareResult result = makeResult(stat, DECK_SIZE - 1);
+        if (result.pValue < report.worstPosition.pValue) {
+            report.worstPosition = result;
+            report.worstPositionIndex = p;
+        }
+    }
+    // Both margins are fixed, as in a contingency table
+    report.positionOverall = makeResult(overall, (DECK_SIZE - 1.0) * (DECK_SIZE - 1.0));
+
+    // Card x seat: expected n * (share of positions dealt to the seat)
+    std::vector<double> seatExpected(seatCategories_);
+    for (size_t s = 0; s < seatCategories_; ++s) {
+        seatExpected[s] = n * seatShare_[s];
+    }
+    overall = 0.0;
+    report.worstCardSeat.pValue = 2.0;
+    for (size_t card = 0; card < DECK_SIZE; ++card) {
+        double stat = chiSquare(&seat_[card * seatCategories_], seatExpected.data(), seatCategories_, 1);
+        overall += stat;
+        ChiSquareResult result = makeResult(stat, seatCategories_ - 1.0);
+        if (result.pValue < report.worstCardSeat.pValue) {
+            report.worstCardSeat = result;
+            report.worstCardIndex = card;
+        }
+    }
+    report.seatOverall = makeResult(overall, (DECK_SIZE - 1.0) * (seatCategories_ - 1.0));
+
+    // Adjacent ordered pairs (a != b): expected 51n / (52 * 51) = n / 52
+    double pairStat = 0.0;
+    const double pairExpected = n / DECK_SIZE;
+    for (size_t a = 0; a < DECK_SIZE; ++a) {
+        for (size_t b = 0; b < DECK_SIZE; ++b) {
+            if (a == b) {
+                continue;
+            }
+            double diff = static_cast<double>(pair_[a * DECK_SIZE + b]) - pairExpected;
+            pairStat += diff * diff / pairExpected;
+        }
+    }
+    report.adjacentPairs = makeResult(pairStat, DECK_SIZE * (DECK_SIZE - 1.0) - DECK_SIZE);
+
+    // Same-suit streaks: X = #{i : suit(i) == suit(i+1)} over 51 adjacent slots
+    // P(I_i) = 12/51; overlapping slots share a card, disjoint ones do not
+    const double p = 12.0 / 51.0;
+    const double pAdjacent = p * 11.0 / 50.0;
+    const double pDisjoint = p * 578.0 / 2450.0;
+    const double variance = 51.0 * p * (1.0 - p)
+        + 2.0 * (50.0 * (pAdjacent - p * p) + 1225.0 * (pDisjoint - p * p));
+
+    report.streakExpectedMean = 51.0 * p;
+    report.streakMean = static_cast<double>(streakSum_) / n;
+    double observedVariance = static_cast<double>(streakSumSq_) / n - report.streakMean * report.streakMean;
+    report.streakZScore = (report.streakMean - report.streakExpectedMean) / std::sqrt(variance / n);
+    report.streakVarianceRatio = observedVariance / variance;
+
+    return report;
+}
+
+/**
+ * Upper tail probability of the chi-square distribution
+ */
+double ShuffleValidator::chiSquarePValue(double statistic, double degreesOfFreedom) {
+    if (statistic <= 0.0 || degreesOfFreedom <= 0.0) {
+        return 1.0;
+    }
+
+    double a = degreesOfFreedom / 2.0;
+    double x = statistic / 2.0;
+    if (x < a + 1.0) {
+        return std::clamp(1.0 - gammaPSeries(a, x), 0.0, 1.0);
+    }
+    return std::clamp(gammaQContinuedFraction(a, x), 0.0, 1.0);
+}
@@ -0,0 +1,201 @@
+/**
+ * ShuffleValidator.hpp
+ * Statistical validation of Deck::shuffle and the deal it produces
+ *
+ * Tests (each reported as chi-square statistic, degrees of freedom, p-value):
+ *   - card x position: every card equally likely at every deck position
+ *   - card x seat: every card equally likely in every seat after dealing
+ *     (same round-robin order as GameState::dealCards)
+ *   - adjacent pairs: every ordered pair (a, b) equally likely to be adjacent
+ * plus a same-suit streak test comparing the number of adjacent same-suit
+ * cards per deck with its exact mean and variance under a uniform shuffle.
+ *
+ * Each worker accumulates into its own flat 32-bit histograms, spilled into
+ * 64-bit totals every few million deals and merged once at the end.
+ */
+
+#ifndef SHUFFLEVALIDATOR_H
+#define SHUFFLEVALIDATOR_H
+
+#include "Deck.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Test settings
+ */
+struct ShuffleTestConfig {
+    std::uint64_t deals = 10000000;
+    unsigned numThreads = 0;            // 0 = hardware concurrency
+    int numPlayers = 4;                 // Seats for the per-seat test
+};
+
+/**
+ * One chi-square test
+ */
+struct ChiSquareResult {
+    double statistic = 0.0;
+    double degreesOfFreedom = 0.0;
+    double pValue = 1.0;
+};
+
+/**
+ * Full report
+ */
+struct ShuffleTestReport {
+    std::uint64_t deals = 0;
+    double seconds = 0.0;
+
+    ChiSquareResult positionOverall;
+    ChiSquareResult worstPosition;          // Lowest p-value of the 52 per-position tests
+    size_t worstPositionIndex = 0;
+
+    ChiSquareResult seatOverall;
+    ChiSquareResult worstCardSeat;          // Lowest p-value of the 52 per-card tests
+    size_t worstCardIndex = 0;
+
+    ChiSquareResult adjacentPairs;
+
+    double streakMean = 0.0;                // Adjacent same-suit cards per deck
+    double streakExpectedMean = 0.0;
+    double streakZScore = 0.0;              // Of the observed mean
+    double streakVarianceRatio = 0.0;       // Observed / expected variance
+};
+
+/**
+ * Per-thread histograms
+ */
+class ShuffleHistogram {
+public:
+    explicit ShuffleHistogram(int numPlayers);
+
+    /**
+     * Count one shuffled 52-card deck (deck order as in Deck::getCards)
+     */
+    void add(const std::vector<Card>& deck);
+
+    /**
+     * Spill 32-bit counters into the 64-bit totals
+     */
+    void flush();
+
+    /**
+     * Add another (flushed) histogram into this one
+     */
+    void merge(const ShuffleHistogram& other);
+
+    /**
+     * Compute the test statistics (call after flush)
+     */
+    ShuffleTestReport analyze() const;
+
+    /**
+     * Deals counted since the last flush
+     */
+    std::uint32_t pendingDeals() const { return pending_; }
+
+private:
+    int numPlayers_;
+    size_t seatCategories_;                 // Seats, plus "undealt" if 52 % players != 0
+    std::vector<std::uint8_t> seatOfPosition_;
+    std::vector<double> seatShare_;
+
+    std::vector<std::uint32_t> position32_; // [position * 52 + card]
+    std::vector<std::uint32_t> seat32_;     // [card * seatCategories + seat]
+    std::vector<std::uint32_t> pair32_;     // [card * 52 + nextCard]
+    std::uint32_t pending_ = 0;
+    std::uint64_t pendingStreakSum_ = 0;
+    std::uint64_t pendingStreakSumSq_ = 0;
+
+    std::vector<std::uint64_t> position_;
+    std::vector<std::uint64_t> seat_;
+    std::vector<std::uint64_t> pair_;
+    std::uint64_t deals_ = 0;
+    std::uint64_t streakSum_ = 0;
+    std::uint64_t streakSumSq_ = 0;
+};
+
+/**
+ * ShuffleValidator class
+ */
+class ShuffleValidator {
+public:
+    /**
+     * Deals per worker between 32-bit spills (keeps every counter far below 2^32)
+     */
+    static constexpr std::uint32_t SPILL_INTERVAL = 1u << 24;
+
+    /**
+     * Shuffle config.deals decks across worker threads.
+     * makeEngine(worker) returns a seeded engine for one worker; any uniform
+     * random bit generator usable with std::shuffle works.
+     */
+    template <typename EngineFactory>
+    static ShuffleTestReport run(const ShuffleTestConfig& config, EngineFactory makeEngine);
+
+    /**
+     * Upper tail probability of the chi-square distribution
+     */
+    static double chiSquarePValue(double statistic, double degreesOfFreedom);
+};
+
+template <typename EngineFactory>
+ShuffleTestReport ShuffleValidator::run(const ShuffleTestConfig& config, EngineFactory makeEngine) {
+    auto start = std::chrono::steady_clock::now();
+
+    unsigned numThreads = config.numThreads;
+    if (numThreads == 0) {
+        numThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    std::vector<ShuffleHistogram> histograms(numThreads, ShuffleHistogram(config.numPlayers));
+    std::atomic<std::uint64_t> nextBatch{ 0 };
+    const std::uint64_t batchSize = 4096;
+
+    auto worker = [&](unsigned index) {
+        auto engine = makeEngine(index);
+        ShuffleHistogram& histogram = histograms[index];
+        Deck deck;
+
+        while (true) {
+            std::uint64_t first = nextBatch.fetch_add(batchSize, std::memory_order_relaxed);
+            if (first >= config.deals) {
+                break;
+            }
+            std::uint64_t count = std::min(batchSize, config.deals - first);
+
+            for (std::uint64_t i = 0; i < count; ++i) {
+                deck.reset();
+                deck.shuffle(engine);
+                histogram.add(deck.getCards());
+            }
+            if (histogram.pendingDeals() >= SPILL_INTERVAL) {
+                histogram.flush();
+            }
+        }
+        histogram.flush();
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned i = 0; i < numThreads; ++i) {
+        threads.emplace_back(worker, i);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (unsigned i = 1; i < numThreads; ++i) {
+        histograms[0].merge(histograms[i]);
+    }
+
+    ShuffleTestReport report = histograms[0].analyze();
+    report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return report;
+}
+
+#endif // SHUFFLEVALIDATOR_HPP
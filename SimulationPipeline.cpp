@@ -0,0 +1,310 @@
+/**
+ * SimulationPipeline.cpp
+ * Implementation of SimulationPipeline
+ */
+
+#include "SimulationPipeline.h"
+#include "CpuTopology.h"
+#include "Deck.h"
+#include "MpmcQueue.h"
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * A game's deck, stacked for GameState::startNewGame
+     */
+    struct DealtGame {
+        std::uint64_t gameId = 0;
+        std::vector<Card> deck;
+    };
+
+    /**
+     * Spin, then yield, then sleep while a queue is full or empty
+     */
+    class Backoff {
+    public:
+        void wait() {
+            if (rounds_ < 64) {
+                ++rounds_;
+            }
+            else if (rounds_ < 1024) {
+                ++rounds_;
+                std::this_thread::yield();
+            }
+            else {
+                std::this_thread::sleep_for(std::chrono::microseconds(50));
+            }
+        }
+
+    private:
+        unsigned rounds_ = 0;
+    };
+
+    double secondsSince(Clock::time_point start) {
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    /**
+     * Push, waiting for room; false if the pipeline failed meanwhile
+     */
+    template <typename T>
+    bool pushWait(MpmcQueue<T>& queue, T&& item, const std::atomic<bool>& failed, double& blocked) {
+        if (queue.tryPush(std::move(item))) {
+            return true;
+        }
+        auto start = Clock::now();
+        Backoff backoff;
+        while (!queue.tryPush(std::move(item))) {
+            if (failed.load(std::memory_order_relaxed)) {
+                return false;
+            }
+            backoff.wait();
+        }
+        blocked += secondsSince(start);
+        return true;
+    }
+
+    /**
+     * Pop, waiting for input; false once the queue is closed and drained or the pipeline failed
+     */
+    template <typename T>
+    bool popWait(MpmcQueue<T>& queue, T& item, const std::atomic<bool>& failed, double& starved) {
+        if (queue.tryPop(item)) {
+            return true;
+        }
+        auto start = Clock::now();
+        Backoff backoff;
+        while (!queue.tryPop(item)) {
+            if (failed.load(std::memory_order_relaxed)) {
+                return false;
+            }
+            if (queue.isClosed()) {
+                bool last = queue.tryPop(item);
+                starved += secondsSince(start);
+                return last;
+            }
+            backoff.wait();
+        }
+        starved += secondsSince(start);
+        return true;
+    }
+
+    /**
+     * Per-worker metrics, on a cache line of their own
+     */
+    struct alignas(64) WorkerMetrics {
+        std::uint64_t items = 0;
+        std::uint64_t actions = 0;
+        double busy = 0.0;
+        double starved = 0.0;
+        double blocked = 0.0;
+        size_t stage = 0;
+        int node = 0;
+        bool pinned = false;
+    };
+
+} // namespace
+
+/**
+ * Constructor
+ */
+SimulationPipeline::SimulationPipeline(const PipelineConfig& config) : config_(config) {
+    config_.dealWorkers = std::max(1u, config_.dealWorkers);
+    config_.encodeWorkers = std::max(1u, config_.encodeWorkers);
+    config_.writeWorkers = std::max(1u, config_.writeWorkers);
+    if (config_.playWorkers == 0) {
+        unsigned cpus = std::max(1u, std::thread::hardware_concurrency());
+        unsigned others = config_.dealWorkers + config_.encodeWorkers + config_.writeWorkers;
+        config_.playWorkers = cpus > others ? cpus - others : 1;
+    }
+}
+
+/**
+ * Run every game through the stages
+ */
+PipelineStats SimulationPipeline::run(const Encoder& encode, const Writer& write) {
+    auto start = Clock::now();
+    const SimulationConfig& simulation = config_.simulation;
+
+    MpmcQueue<DealtGame> deals(config_.queueCapacity);
+    MpmcQueue<GameRecord> played(config_.queueCapacity);
+    MpmcQueue<GameRecord> encoded(config_.queueCapacity);
+
+    std::array<unsigned, 4> workerCounts = {
+        config_.dealWorkers, config_.playWorkers, config_.encodeWorkers, config_.writeWorkers
+    };
+    std::array<std::atomic<unsigned>, 4> running{};
+    unsigned totalWorkers = 0;
+    for (size_t stage = 0; stage < workerCounts.size(); ++stage) {
+        running[stage].store(workerCounts[stage]);
+        totalWorkers += workerCounts[stage];
+    }
+
+    CpuTopology topology = CpuTopology::detect();
+    std::vector<CpuTopology::Placement> placements = topology.placeWorkers(totalWorkers);
+    std::vector<WorkerMetrics> metrics(totalWorkers);
+
+    std::atomic<std::uint64_t> nextGame{ 0 };
+    std::atomic<bool> failed{ false };
+    std::exception_ptr error;
+    std::mutex errorMutex;
+
+    // The last worker of a stage ends the stream it feeds
+    auto finishStage = [&](size_t stage) {
+        if (running[stage].fetch_sub(1) == 1) {
+            if (stage == 0) deals.close();
+            if (stage == 1) played.close();
+            if (stage == 2) encoded.close();
+        }
+    };
+
+    auto dealStage = [&](WorkerMetrics& m) {
+        Deck deck((simulation.numPlayers + GameState::PLAYERS_PER_DECK - 1) / GameState::PLAYERS_PER_DECK);
+        while (!failed.load(std::memory_order_relaxed)) {
+            std::uint64_t first = nextGame.fetch_add(SimulationRunner::GAMES_PER_CLAIM, std::memory_order_relaxed);
+            if (first >= simulation.numGames) {
+                break;
+            }
+            std::uint64_t last = std::min(first + SimulationRunner::GAMES_PER_CLAIM, simulation.numGames);
+            for (std::uint64_t gameId = first; gameId < last; ++gameId) {
+                auto begin = Clock::now();
+                deck.seed(simulation.seed + gameId);
+                deck.reset();
+                deck.shuffle();
+                DealtGame game{ gameId, deck.getCards() };
+                m.busy += secondsSince(begin);
+                ++m.items;
+                if (!pushWait(deals, std::move(game), failed, m.blocked)) {
+                    return;
+                }
+            }
+        }
+    };
+
+    auto playStage = [&](WorkerMetrics& m) {
+        GameState state;
+        SimulationRunner::prepareTable(state, simulation);
+        std::optional<StrategyStore::Reader> strategy;
+        if (simulation.strategy) {
+            strategy.emplace(*simulation.strategy);
+        }
+        DealtGame game;
+        while (popWait(deals, game, failed, m.starved)) {
+            auto begin = Clock::now();
+            state.startNewGame(game.deck);
+            GameRecord record = SimulationRunner::playDealtGame(state, game.gameId, simulation.maxActionsPerGame,
+                strategy ? &*strategy : nullptr);
+            m.busy += secondsSince(begin);
+            ++m.items;
+            m.actions += record.actions.size();
+            if (!pushWait(played, std::move(record), failed, m.blocked)) {
+                return;
+            }
+        }
+    };
+
+    auto encodeStage = [&](WorkerMetrics& m) {
+        GameRecord record;
+        while (popWait(played, record, failed, m.starved)) {
+            auto begin = Clock::now();
+            if (encode) {
+                encode(record);
+            }
+            m.busy += secondsSince(begin);
+            ++m.items;
+            if (!pushWait(encoded, std::move(record), failed, m.blocked)) {
+                return;
+            }
+        }
+    };
+
+    auto writeStage = [&](WorkerMetrics& m) {
+        GameRecord record;
+        while (popWait(encoded, record, failed, m.starved)) {
+            auto begin = Clock::now();
+            write(std::move(record));
+            m.busy += secondsSince(begin);
+            ++m.items;
+        }
+    };
+
+    auto worker = [&](unsigned index) {
+        WorkerMetrics& m = metrics[index];
+        if (simulation.pinThreads) {
+            m.pinned = CpuTopology::pinCurrentThread(placements[index].cpu);
+        }
+        try {
+            switch (m.stage) {
+            case 0: dealStage(m); break;
+            case 1: playStage(m); break;
+            case 2: encodeStage(m); break;
+            default: writeStage(m); break;
+            }
+        }
+        catch (...) {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if (!error) {
+                error = std::current_exception();
+            }
+            failed.store(true);
+        }
+        finishStage(m.stage);
+    };
+
+    std::vector<std::thread> threads;
+    unsigned index = 0;
+    for (size_t stage = 0; stage < workerCounts.size(); ++stage) {
+        for (unsigned i = 0; i < workerCounts[stage]; ++i, ++index) {
+            metrics[index].stage = stage;
+            metrics[index].node = placements[index].node;
+        }
+    }
+    for (unsigned i = 0; i < totalWorkers; ++i) {
+        threads.emplace_back(worker, i);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+
+    static constexpr const char* STAGE_NAMES[] = { "deal", "play", "encode", "write" };
+    PipelineStats stats;
+    for (size_t stage = 0; stage < stats.stages.size(); ++stage) {
+        stats.stages[stage].name = STAGE_NAMES[stage];
+        stats.stages[stage].workers = workerCounts[stage];
+    }
+    for (const auto& node : topology.getNodes()) {
+        stats.simulation.nodes.push_back(NodeThroughput{ node.id });
+    }
+    for (const auto& m : metrics) {
+        StageMetrics& stage = stats.stages[m.stage];
+        stage.items += m.items;
+        stage.busySeconds += m.busy;
+        stage.starvedSeconds += m.starved;
+        stage.blockedSeconds += m.blocked;
+        stats.simulation.pinnedThreads += m.pinned;
+
+        if (m.stage == 1) {
+            auto node = std::find_if(stats.simulation.nodes.begin(), stats.simulation.nodes.end(),
+                [&](const NodeThroughput& entry) { return entry.node == m.node; });
+            ++node->threads;
+            node->games += m.items;
+            node->actions += m.actions;
+            stats.simulation.actionsPlayed += m.actions;
+        }
+    }
+    stats.simulation.gamesPlayed = stats.stages[3].items;
+    stats.simulation.seconds = secondsSince(start);
+    return stats;
+}
@@ -0,0 +1,88 @@
+/**
+ * SimulationPipeline.hpp
+ * Self-play as a pipeline of stages joined by bounded lock-free queues
+ *
+ *   deal    - seed and shuffle each game's deck
+ *   play    - bots play the stacked deal to the end (GameRecord)
+ *   encode  - caller's per-game encoder (position index, features)
+ *   write   - caller's sink (columnar export)
+ *
+ * Every stage has its own worker count and hands games to the next stage
+ * through an MpmcQueue. A full queue holds its producers back, an empty
+ * one idles its consumers; both waits are measured per stage alongside
+ * the time spent working, so a starved or blocked stage shows up in the
+ * utilization report. Game i is dealt from seed + i as in SimulationRunner,
+ * so the games played are the same, only the order they reach the sink
+ * differs.
+ */
+
+#ifndef SIMULATIONPIPELINE_H
+#define SIMULATIONPIPELINE_H
+
+#include "GameRecord.h"
+#include "Simulator.h"
+#include <array>
+#include <cstdint>
+#include <functional>
+
+/**
+ * Pipeline settings
+ */
+struct PipelineConfig {
+    SimulationConfig simulation;        // Games, players, seed, limits, pinning (numThreads unused)
+    unsigned dealWorkers = 1;
+    unsigned playWorkers = 0;           // 0 = CPUs left after the other stages (at least 1)
+    unsigned encodeWorkers = 1;
+    unsigned writeWorkers = 1;
+    size_t queueCapacity = 1024;        // Games buffered between two stages
+};
+
+/**
+ * Work and waiting time of one stage, summed over its workers
+ */
+struct StageMetrics {
+    const char* name = "";
+    unsigned workers = 0;
+    std::uint64_t items = 0;
+    double busySeconds = 0.0;
+    double starvedSeconds = 0.0;        // Waiting for input
+    double blockedSeconds = 0.0;        // Waiting for room downstream
+
+    /**
+     * Share of the stage's worker time spent working
+     */
+    double utilization(double wallSeconds) const {
+        return workers > 0 && wallSeconds > 0 ? busySeconds / (wallSeconds * workers) : 0.0;
+    }
+};
+
+/**
+ * Pipeline results
+ */
+struct PipelineStats {
+    SimulationStats simulation;
+    std::array<StageMetrics, 4> stages;
+};
+
+/**
+ * SimulationPipeline class
+ */
+class SimulationPipeline {
+public:
+    using Encoder = std::function<void(GameRecord&)>;   // Must be thread-safe with several encode workers
+    using Writer = std::function<void(GameRecord&&)>;   // Must be thread-safe with several write workers
+
+    explicit SimulationPipeline(const PipelineConfig& config);
+
+    /**
+     * Run every game through the stages
+     * @param encode may be empty (games pass through)
+     * @throws the first exception raised by a stage, after all workers stopped
+     */
+    PipelineStats run(const Encoder& encode, const Writer& write);
+
+private:
+    PipelineConfig config_;
+};
+
+#endif // SIMULATIONPIPELINE_HPP
@@ -0,0 +1,185 @@
+/**
+ * Simulator.cpp
+ * Implementation of the headless simulation runner
+ */
+
+#include "Simulator.h"
+#include "Bot.h"
+#include "CpuTopology.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <array>
+#include <optional>
+
+ /**
+  * Constructor
+  */
+SimulationRunner::SimulationRunner(const SimulationConfig& config) : config_(config) {
+    if (config_.numThreads == 0) {
+        config_.numThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+}
+
+/**
+ * Play all configured games
+ */
+SimulationStats SimulationRunner::run(const GameSink& sink) {
+    auto start = std::chrono::steady_clock::now();
+
+    CpuTopology topology = CpuTopology::detect();
+    std::vector<CpuTopology::Placement> placements = topology.placeWorkers(config_.numThreads);
+
+    // Counters of one worker, on a cache line of its own until the merge
+    struct alignas(64) WorkerSlot {
+        std::uint64_t games = 0;
+        std::uint64_t actions = 0;
+        bool pinned = false;
+    };
+    std::vector<WorkerSlot> slots(config_.numThreads);
+    std::atomic<std::uint64_t> nextGame{ 0 };
+
+    auto worker = [&](unsigned index) {
+        WorkerSlot& slot = slots[index];
+        if (config_.pinThreads) {
+            slot.pinned = CpuTopology::pinCurrentThread(placements[index].cpu);
+        }
+
+        // Built after pinning so first-touch places it on the worker's node
+        GameState state;
+        prepareTable(state, config_);
+        std::optional<StrategyStore::Reader> strategy;
+        if (config_.strategy) {
+            strategy.emplace(*config_.strategy);
+        }
+
+        while (true) {
+            std::uint64_t first = nextGame.fetch_add(GAMES_PER_CLAIM, std::memory_order_relaxed);
+            if (first >= config_.numGames) {
+                break;
+            }
+            std::uint64_t last = std::min(first + GAMES_PER_CLAIM, config_.numGames);
+            for (std::uint64_t gameId = first; gameId < last; ++gameId) {
+                GameRecord record = playGame(state, gameId, config_.seed + gameId,
+                    config_.maxActionsPerGame, strategy ? &*strategy : nullptr);
+                ++slot.games;
+                slot.actions += record.actions.size();
+                sink(std::move(record));
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned i = 0; i < config_.numThreads; ++i) {
+        threads.emplace_back(worker, i);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    SimulationStats stats;
+    stats.gamesPlayed = config_.numGames;
+    for (const auto& node : topology.getNodes()) {
+        stats.nodes.push_back(NodeThroughput{ node.id });
+    }
+    for (unsigned i = 0; i < config_.numThreads; ++i) {
+        auto node = std::find_if(stats.nodes.begin(), stats.nodes.end(),
+            [&](const NodeThroughput& entry) { return entry.node == placements[i].node; });
+        ++node->threads;
+        node->games += slots[i].games;
+        node->actions += slots[i].actions;
+        stats.actionsPlayed += slots[i].actions;
+        stats.pinnedThreads += slots[i].pinned;
+    }
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return stats;
+}
+
+/**
+ * Seat bots at a worker's table
+ */
+void SimulationRunner::prepareTable(GameState& state, const SimulationConfig& config) {
+    state.initializePlayers(config.numPlayers, 0);
+    if (config.opponentModel) {
+        std::array<PlayerId, SeatTable::MAX_SEATS> playerIds{};
+        for (size_t seat = 0; seat < playerIds.size(); ++seat) {
+            playerIds[seat] = static_cast<PlayerId>(seat);
+        }
+        state.setOpponentModel(config.opponentModel, playerIds);
+    }
+}
+
+/**
+ * Deal and play one complete game
+ */
+GameRecord SimulationRunner::playGame(GameState& state, std::uint64_t gameId, std::uint64_t seed,
+    size_t maxActions, StrategyStore::Reader* strategy) {
+    state.getDeck().seed(seed);
+    state.startNewGame();
+
+    return playDealtGame(state, gameId, maxActions, strategy);
+}
+
+/**
+ * Play an already dealt game to the end
+ * Drives GameState::applyTurn the same way as the interactive client (main.cpp)
+ */
+GameRecord SimulationRunner::playDealtGame(GameState& state, std::uint64_t gameId, size_t maxActions,
+    StrategyStore::Reader* strategy) {
+    GameRecorder recorder;
+    recorder.begin(gameId, state);
+
+    // Equity tables cover starting hands
+    std::array<HandCards, SeatTable::MAX_SEATS> dealt;
+    if (strategy) {
+        for (size_t seat = 0; seat < state.getNumPlayers(); ++seat) {
+            dealt[seat] = state.getSeats().getCards(seat);
+        }
+    }
+
+    int winner = -1;
+    for (size_t step = 0; step < maxActions && state.getPhase() == GamePhase::InProgress; ++step) {
+        size_t seat = state.getCurrentPlayerIndex();
+        const SeatTable& seats = state.getSeats();
+        recorder.recordPosition(state);
+
+        // The 3 of Diamonds may be undealt with 3 players
+        bool mustInclude3D = state.isFirstPlayOfGame() && seats.holds(seat, Card(Rank::Three, Suit::Diamonds));
+
+        PlayCards play;
+        if (strategy) {
+            // The decision finishes on the version it started with, even across a reload
+            StrategyStore::Snapshot snapshot = strategy->read();
+            size_t numPlayers = state.getNumPlayers();
+            std::optional<double> equity = snapshot
+                ? snapshot->lookup(dealt[seat], static_cast<int>(numPlayers)) : std::nullopt;
+            play = Bot::choosePlay(seats.getCards(seat), state.getLastPlay(), mustInclude3D,
+                state.getOpponentProfiles(seat), equity, numPlayers);
+        }
+        else {
+            play = Bot::choosePlay(seats.getCards(seat), state.getLastPlay(), mustInclude3D,
+                state.getOpponentProfiles(seat));
+        }
+
+        if (!play.empty()) {
+            TurnResult result = state.applyTurn(TurnAction::Play, play);
+            if (result != TurnResult::Rejected) {
+                recorder.recordPlay(seat, play, seats.getCardCount(seat));
+                if (result == TurnResult::GameWon) {
+                    winner = static_cast<int>(seat);
+                    break;
+                }
+                continue;
+            }
+        }
+
+        if (state.applyTurn(TurnAction::Pass) == TurnResult::Rejected) {
+            break;  // Leading seat without a play; cannot happen with a non-empty hand
+        }
+        recorder.recordPass(seat, seats.getCardCount(seat));
+    }
+
+    return recorder.finish(state, winner);
+}
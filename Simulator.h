@@ -0,0 +1,95 @@
+/**
+ * Simulator.hpp
+ * Headless bot-vs-bot game simulation across worker threads
+ */
+
+#ifndef SIMULATOR_H
+#define SIMULATOR_H
+
+#include "GameRecord.h"
+#include "GameState.h"
+#include "StrategyStore.h"
+#include <functional>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Simulation settings
+ */
+struct SimulationConfig {
+    std::uint64_t numGames = 1000;
+    int numPlayers = 4;
+    unsigned numThreads = 0;            // 0 = hardware concurrency
+    std::uint64_t seed = 1;             // Game i is dealt from seed + i
+    size_t maxActionsPerGame = 2000;    // Safety limit against stuck games
+    OpponentModel* opponentModel = nullptr;     // Shared by every table; seat i plays as player id i
+    bool pinThreads = true;             // Pin workers to CPUs, spread across NUMA nodes
+    StrategyStore* strategy = nullptr;  // Equity data read by the bots; may be reloaded while games run
+};
+
+/**
+ * Work done by the workers of one NUMA node
+ */
+struct NodeThroughput {
+    int node = 0;
+    unsigned threads = 0;
+    std::uint64_t games = 0;
+    std::uint64_t actions = 0;
+};
+
+/**
+ * Simulation results
+ */
+struct SimulationStats {
+    std::uint64_t gamesPlayed = 0;
+    std::uint64_t actionsPlayed = 0;
+    double seconds = 0.0;
+    std::vector<NodeThroughput> nodes;
+    unsigned pinnedThreads = 0;
+};
+
+/**
+ * SimulationRunner class
+ */
+class SimulationRunner {
+public:
+    static constexpr std::uint64_t GAMES_PER_CLAIM = 16;   // Games a worker takes from the shared counter at once
+
+    /**
+     * Called from worker threads with every finished game
+     */
+    using GameSink = std::function<void(GameRecord&&)>;
+
+    /**
+     * Constructor
+     */
+    explicit SimulationRunner(const SimulationConfig& config);
+
+    /**
+     * Play all configured games; sink must be thread-safe
+     */
+    SimulationStats run(const GameSink& sink);
+
+    /**
+     * Seat bots at a worker's table (and attach the configured opponent model)
+     */
+    static void prepareTable(GameState& state, const SimulationConfig& config);
+
+    /**
+     * Deal and play one complete game with bots in every seat
+     */
+    static GameRecord playGame(GameState& state, std::uint64_t gameId, std::uint64_t seed,
+        size_t maxActions = 2000, StrategyStore::Reader* strategy = nullptr);
+
+    /**
+     * Play an already dealt game (GameState::startNewGame) to the end;
+     * with a strategy reader, every bot decision reads the current version
+     */
+    static GameRecord playDealtGame(GameState& state, std::uint64_t gameId, size_t maxActions = 2000,
+        StrategyStore::Reader* strategy = nullptr);
+
+private:
+    SimulationConfig config_;
+};
+
+#endif // SIMULATOR_HPP
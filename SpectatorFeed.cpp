@@ -0,0 +1,345 @@
+/**
+ * SpectatorFeed.cpp
+ * Implementation of SpectatorFeed
+ */
+
+#include "SpectatorFeed.h"
+#include <algorithm>
+#include <stdexcept>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <winsock2.h>
+#pragma comment(lib, "ws2_32.lib")
+#else
+#include <cerrno>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#endif
+
+namespace {
+    constexpr std::uint8_t NO_SEAT = 0xFF;
+
+    /**
+     * Frame under construction: header reserved, payload appended
+     */
+    class FrameWriter {
+    public:
+        explicit FrameWriter(BroadcastKind kind, size_t reserve) {
+            bytes_.reserve(SpectatorFeed::FRAME_HEADER_SIZE + reserve);
+            bytes_.resize(SpectatorFeed::FRAME_HEADER_SIZE);
+            bytes_[2] = static_cast<std::uint8_t>(kind);
+        }
+
+        void u8(std::uint8_t value) { bytes_.push_back(value); }
+
+        void u64(std::uint64_t value) {
+            for (int i = 0; i < 8; ++i) {
+                bytes_.push_back(static_cast<std::uint8_t>(value >> (8 * i)));
+            }
+        }
+
+        void cards(std::span<const Card> cards) {
+            u8(static_cast<std::uint8_t>(cards.size()));
+            for (const auto& card : cards) {
+                u8(static_cast<std::uint8_t>(card.getIndex()));
+            }
+        }
+
+        BroadcastFrame finish() {
+            size_t payload = bytes_.size() - SpectatorFeed::FRAME_HEADER_SIZE;
+            if (payload > 0xFFFF) {
+                throw std::length_error("Spectator frame too large");
+            }
+            bytes_[0] = static_cast<std::uint8_t>(payload);
+            bytes_[1] = static_cast<std::uint8_t>(payload >> 8);
+            return std::make_shared<const std::vector<std::uint8_t>>(std::move(bytes_));
+        }
+
+    private:
+        std::vector<std::uint8_t> bytes_;
+    };
+}
+
+/**
+ * Constructor
+ */
+SpectatorFeed::SpectatorFeed(size_t maxPendingBytes) : maxPendingBytes_(maxPendingBytes) {
+}
+
+/**
+ * Encode the spectator view of a table
+ */
+BroadcastFrame SpectatorFeed::encodeSnapshot(const GameState& state) {
+    const SeatTable& seats = state.getSeats();
+    FrameWriter out(BroadcastKind::Snapshot, 32 + seats.size() * 16);
+
+    const Player* lastPlaying = state.getLastPlayingPlayer();
+    out.u64(state.getVersion());
+    out.u8(static_cast<std::uint8_t>(state.getPhase()));
+    out.u8(static_cast<std::uint8_t>(seats.size()));
+    out.u8(static_cast<std::uint8_t>(state.getCurrentPlayerIndex()));
+    out.u8(lastPlaying ? static_cast<std::uint8_t>(lastPlaying->getSeat()) : NO_SEAT);
+    out.u8(static_cast<std::uint8_t>(state.getPassedSeats()));
+    out.u8(state.isFirstPlayOfGame() ? 1 : 0);
+    out.cards(state.getLastPlay());
+
+    for (size_t seat = 0; seat < seats.size(); ++seat) {
+        const std::string& name = seats.getName(seat);
+        size_t length = std::min<size_t>(name.size(), 0xFF);
+        out.u8(static_cast<std::uint8_t>(seats.getCardCount(seat)));
+        out.u8(static_cast<std::uint8_t>(length));
+        for (size_t i = 0; i < length; ++i) {
+            out.u8(static_cast<std::uint8_t>(name[i]));
+        }
+    }
+    return out.finish();
+}
+
+/**
+ * Encode the last turn applied to a table
+ */
+BroadcastFrame SpectatorFeed::encodeTurn(const GameState& state) {
+    const TurnDiff* diff = state.getHistory().getLastTurn();
+    if (!diff) {
+        throw std::invalid_argument("No turn to encode");
+    }
+
+    FrameWriter out(BroadcastKind::Turn, 24);
+    PlayCards cards = diff->getCards();
+    out.u64(state.getVersion());
+    out.u8(static_cast<std::uint8_t>(diff->kind()));
+    out.u8(diff->seat);
+    out.cards(cards);
+    out.u8(static_cast<std::uint8_t>(state.getSeats().getCardCount(diff->seat)));
+    out.u8(static_cast<std::uint8_t>(state.getCurrentPlayerIndex()));
+    out.u8(static_cast<std::uint8_t>(state.getPhase()));
+    return out.finish();
+}
+
+/**
+ * Add a connection and queue a snapshot for it
+ */
+SpectatorFeed::SubscriberId SpectatorFeed::subscribe(SpectatorSocket socket, const GameState& state) {
+    SubscriberId id;
+    if (!freeIds_.empty()) {
+        id = freeIds_.back();
+        freeIds_.pop_back();
+    }
+    else {
+        id = static_cast<SubscriberId>(subscribers_.size());
+        subscribers_.emplace_back();
+    }
+
+    Subscriber& subscriber = subscribers_[id];
+    subscriber.socket = socket;
+    subscriber.active = true;
+    subscriber.connected = true;
+
+    BroadcastFrame snapshot = encodeSnapshot(state);
+    ++stats_.framesEncoded;
+    ++stats_.snapshotsEncoded;
+    ++stats_.framesQueued;
+    subscriber.pendingBytes = snapshot->size();
+    subscriber.pending.push_back(std::move(snapshot));
+    ++subscriberCount_;
+    return id;
+}
+
+/**
+ * Drop a connection
+ */
+void SpectatorFeed::unsubscribe(SubscriberId id) {
+    if (id >= subscribers_.size() || !subscribers_[id].active) {
+        return;
+    }
+    subscribers_[id] = Subscriber();
+    freeIds_.push_back(id);
+    --subscriberCount_;
+}
+
+bool SpectatorFeed::isConnected(SubscriberId id) const {
+    return id < subscribers_.size() && subscribers_[id].active && subscribers_[id].connected;
+}
+
+size_t SpectatorFeed::getPendingBytes(SubscriberId id) const {
+    return id < subscribers_.size() ? subscribers_[id].pendingBytes : 0;
+}
+
+void SpectatorFeed::notePublished(const GameState& state) {
+    publishedVersion_ = state.getVersion();
+    publishedCursor_ = state.getHistory().getCursor();
+    published_ = true;
+}
+
+/**
+ * Queue the change since the last publish for every subscriber
+ */
+void SpectatorFeed::publish(const GameState& state) {
+    const TurnHistory& history = state.getHistory();
+    bool oneTurn = published_
+        && state.getVersion() == publishedVersion_ + 1
+        && history.getCursor() == publishedCursor_ + 1;
+    if (!oneTurn) {
+        publishSnapshot(state);
+        return;
+    }
+
+    BroadcastFrame frame = encodeTurn(state);
+    ++stats_.framesEncoded;
+    BroadcastFrame snapshot;
+    for (auto& subscriber : subscribers_) {
+        if (subscriber.active && subscriber.connected) {
+            enqueue(subscriber, frame, state, snapshot);
+        }
+    }
+    notePublished(state);
+}
+
+/**
+ * Queue a snapshot for every subscriber
+ */
+void SpectatorFeed::publishSnapshot(const GameState& state) {
+    BroadcastFrame snapshot = encodeSnapshot(state);
+    ++stats_.framesEncoded;
+    ++stats_.snapshotsEncoded;
+    for (auto& subscriber : subscribers_) {
+        if (subscriber.active && subscriber.connected) {
+            enqueue(subscriber, snapshot, state, snapshot);
+        }
+    }
+    notePublished(state);
+}
+
+/**
+ * Queue a frame for a subscriber, or resync it if it is lagging
+ */
+void SpectatorFeed::enqueue(Subscriber& subscriber, const BroadcastFrame& frame, const GameState& state, BroadcastFrame& snapshot) {
+    if (subscriber.pendingBytes + frame->size() <= maxPendingBytes_) {
+        subscriber.pendingBytes += frame->size();
+        subscriber.pending.push_back(frame);
+        ++stats_.framesQueued;
+        return;
+    }
+
+    // The snapshot already includes this update
+    if (!snapshot) {
+        snapshot = encodeSnapshot(state);
+        ++stats_.framesEncoded;
+        ++stats_.snapshotsEncoded;
+    }
+    resync(subscriber, snapshot);
+}
+
+/**
+ * Replace a subscriber's unsent frames with a snapshot
+ */
+void SpectatorFeed::resync(Subscriber& subscriber, const BroadcastFrame& snapshot) {
+    size_t keep = subscriber.sentOffset > 0 ? 1 : 0;
+    stats_.framesDropped += subscriber.queued() - keep;
+    subscriber.pending.resize(subscriber.head + keep);
+    subscriber.pendingBytes = keep ? subscriber.front()->size() - subscriber.sentOffset : 0;
+
+    subscriber.pendingBytes += snapshot->size();
+    subscriber.pending.push_back(snapshot);
+    ++stats_.framesQueued;
+    ++stats_.resyncs;
+}
+
+/**
+ * Write queued frames to every connection without blocking
+ */
+size_t SpectatorFeed::flush() {
+    size_t backlogged = 0;
+    for (auto& subscriber : subscribers_) {
+        if (!subscriber.active || !subscriber.connected || subscriber.queued() == 0) {
+            continue;
+        }
+        flushSubscriber(subscriber);
+        if (subscriber.queued() > 0) {
+            ++backlogged;
+        }
+    }
+    return backlogged;
+}
+
+/**
+ * Write as much of a subscriber's backlog as the socket takes
+ */
+void SpectatorFeed::flushSubscriber(Subscriber& subscriber) {
+    while (subscriber.queued() > 0) {
+        size_t count = std::min(subscriber.queued(), MAX_FRAMES_PER_WRITE);
+
+#ifdef _WIN32
+        WSABUF buffers[MAX_FRAMES_PER_WRITE];
+        for (size_t i = 0; i < count; ++i) {
+            size_t offset = i == 0 ? subscriber.sentOffset : 0;
+            const auto& bytes = *subscriber.pending[subscriber.head + i];
+            buffers[i].buf = const_cast<CHAR*>(reinterpret_cast<const CHAR*>(bytes.data() + offset));
+            buffers[i].len = static_cast<ULONG>(bytes.size() - offset);
+        }
+        DWORD sent = 0;
+        ++stats_.writeCalls;
+        if (WSASend(static_cast<SOCKET>(subscriber.socket), buffers, static_cast<DWORD>(count), &sent, 0, nullptr, nullptr) != 0) {
+            if (WSAGetLastError() == WSAEWOULDBLOCK) {
+                return;
+            }
+            subscriber.connected = false;
+            break;
+        }
+        size_t written = sent;
+#else
+        iovec buffers[MAX_FRAMES_PER_WRITE];
+        for (size_t i = 0; i < count; ++i) {
+            size_t offset = i == 0 ? subscriber.sentOffset : 0;
+            const auto& bytes = *subscriber.pending[subscriber.head + i];
+            buffers[i].iov_base = const_cast<std::uint8_t*>(bytes.data() + offset);
+            buffers[i].iov_len = bytes.size() - offset;
+        }
+        msghdr message{};
+        message.msg_iov = buffers;
+        message.msg_iovlen = static_cast<decltype(message.msg_iovlen)>(count);
+
+        int flags = MSG_DONTWAIT;
+#ifdef MSG_NOSIGNAL
+        flags |= MSG_NOSIGNAL;      // A closed spectator is an error, not a SIGPIPE
+#endif
+        ++stats_.writeCalls;
+        ssize_t sent = ::sendmsg(subscriber.socket, &message, flags);
+        if (sent < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                return;
+            }
+            subscriber.connected = false;
+            break;
+        }
+        size_t written = static_cast<size_t>(sent);
+#endif
+
+        stats_.bytesSent += written;
+        subscriber.pendingBytes -= written;
+        while (written > 0) {
+            size_t left = subscriber.front()->size() - subscriber.sentOffset;
+            if (written < left) {
+                subscriber.sentOffset += written;
+                return;     // Socket buffer full
+            }
+            written -= left;
+            subscriber.sentOffset = 0;
+            subscriber.popFront();
+        }
+    }
+
+    if (!subscriber.connected) {
+        ++stats_.disconnects;
+        subscriber.pending.clear();
+        subscriber.head = 0;
+        subscriber.sentOffset = 0;
+        subscriber.pendingBytes = 0;
+    }
+}
@@ -0,0 +1,187 @@
+/**
+ * SpectatorFeed.hpp
+ * Table updates fanned out to spectator connections
+ *
+ * Each update is encoded once into an immutable, reference-counted frame
+ * and the same frame is queued for every subscriber, so a table with
+ * thousands of spectators pays for one serialization, not thousands.
+ * flush() hands each connection its queued frames in one vectored,
+ * non-blocking write (sendmsg / WSASend) and keeps whatever the socket
+ * would not take. A spectator whose backlog passes maxPendingBytes is not
+ * queued further: its unsent frames are dropped and it gets the latest
+ * snapshot instead, also encoded once and shared by every lagging spectator.
+ *
+ * Wire format (little-endian), one frame per update:
+ *   u16 payload length, u8 kind (1 = snapshot, 2 = turn), payload.
+ * Snapshot: u64 version, u8 phase, u8 seats, u8 current seat, u8 last
+ *   playing seat (0xFF if none), u8 passed seats mask, u8 first play of
+ *   game, u8 n + n card indices (play to beat), then per seat u8 card
+ *   count, u8 name length, name bytes.
+ * Turn: u64 version, u8 TurnDiffKind, u8 seat, u8 n + n card indices,
+ *   u8 cards left in the seat's hand, u8 seat to move, u8 phase.
+ */
+
+#ifndef SPECTATORFEED_H
+#define SPECTATORFEED_H
+
+#include "GameState.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * Connection handle: a SOCKET on Windows, a file descriptor elsewhere
+ */
+#ifdef _WIN32
+using SpectatorSocket = std::uintptr_t;
+#else
+using SpectatorSocket = int;
+#endif
+
+/**
+ * An encoded update, shared by every subscriber it is queued for
+ */
+using BroadcastFrame = std::shared_ptr<const std::vector<std::uint8_t>>;
+
+/**
+ * Kind byte of a frame
+ */
+enum class BroadcastKind : std::uint8_t {
+    Snapshot = 1,
+    Turn = 2
+};
+
+/**
+ * Fan-out counters
+ */
+struct SpectatorFeedStats {
+    std::uint64_t framesEncoded = 0;        // Turn and snapshot frames built
+    std::uint64_t snapshotsEncoded = 0;
+    std::uint64_t framesQueued = 0;         // Frame references handed to subscribers
+    std::uint64_t bytesSent = 0;
+    std::uint64_t writeCalls = 0;           // Vectored writes issued
+    std::uint64_t resyncs = 0;              // Lagging subscribers moved to the latest snapshot
+    std::uint64_t framesDropped = 0;        // Unsent frames discarded by resyncs
+    std::uint64_t disconnects = 0;          // Connections that failed on write
+};
+
+/**
+ * SpectatorFeed class
+ */
+class SpectatorFeed {
+public:
+    using SubscriberId = std::uint32_t;
+
+    static constexpr size_t DEFAULT_MAX_PENDING_BYTES = 64 * 1024;
+    static constexpr size_t MAX_FRAMES_PER_WRITE = 64;     // Within every platform's IOV_MAX
+    static constexpr size_t FRAME_HEADER_SIZE = 3;
+
+    /**
+     * Constructor
+     * @param maxPendingBytes Backlog after which a spectator is resynced from a snapshot
+     */
+    explicit SpectatorFeed(size_t maxPendingBytes = DEFAULT_MAX_PENDING_BYTES);
+
+    /**
+     * Add a connection (not owned; stays open until the caller closes it)
+     * and queue a snapshot of the table for it
+     */
+    SubscriberId subscribe(SpectatorSocket socket, const GameState& state);
+
+    /**
+     * Drop a connection and whatever is queued for it
+     */
+    void unsubscribe(SubscriberId id);
+
+    /**
+     * Queue the change since the last publish for every subscriber: the
+     * turn just applied when there is exactly one, a snapshot otherwise
+     * (new deal, undo, first publish)
+     */
+    void publish(const GameState& state);
+
+    /**
+     * Queue a snapshot for every subscriber
+     */
+    void publishSnapshot(const GameState& state);
+
+    /**
+     * Write queued frames to every connection without blocking
+     * @return Number of subscribers still holding unsent data
+     */
+    size_t flush();
+
+    size_t getSubscriberCount() const { return subscriberCount_; }
+    bool isConnected(SubscriberId id) const;
+    size_t getPendingBytes(SubscriberId id) const;
+    const SpectatorFeedStats& getStats() const { return stats_; }
+
+    /**
+     * Encode the spectator view of a table
+     */
+    static BroadcastFrame encodeSnapshot(const GameState& state);
+
+    /**
+     * Encode the last turn applied to a table
+     * @throws std::invalid_argument if the table has no recorded turn
+     */
+    static BroadcastFrame encodeTurn(const GameState& state);
+
+private:
+    struct Subscriber {
+        SpectatorSocket socket{};
+        std::vector<BroadcastFrame> pending;    // Unsent frames from head on; capacity is reused
+        size_t head = 0;
+        size_t sentOffset = 0;          // Bytes of the head frame already written
+        size_t pendingBytes = 0;        // Unsent bytes across pending
+        bool active = false;
+        bool connected = false;
+
+        size_t queued() const { return pending.size() - head; }
+        const BroadcastFrame& front() const { return pending[head]; }
+
+        void popFront() {
+            pending[head++].reset();
+            if (head == pending.size()) {
+                pending.clear();
+                head = 0;
+            }
+            else if (head >= 64 && head * 2 >= pending.size()) {
+                pending.erase(pending.begin(), pending.begin() + static_cast<std::ptrdiff_t>(head));
+                head = 0;
+            }
+        }
+    };
+
+    std::vector<Subscriber> subscribers_;
+    std::vector<SubscriberId> freeIds_;
+    size_t subscriberCount_ = 0;
+    size_t maxPendingBytes_;
+
+    std::uint64_t publishedVersion_ = 0;
+    size_t publishedCursor_ = 0;
+    bool published_ = false;
+
+    SpectatorFeedStats stats_;
+
+    /**
+     * Queue a frame for a subscriber; a lagging one is resynced instead,
+     * encoding the snapshot on first need
+     */
+    void enqueue(Subscriber& subscriber, const BroadcastFrame& frame, const GameState& state, BroadcastFrame& snapshot);
+
+    /**
+     * Replace a subscriber's unsent frames with a snapshot, keeping a
+     * partly written frame so the stream stays aligned
+     */
+    void resync(Subscriber& subscriber, const BroadcastFrame& snapshot);
+
+    /**
+     * Write as much of a subscriber's backlog as the socket takes
+     */
+    void flushSubscriber(Subscriber& subscriber);
+
+    void notePublished(const GameState& state);
+};
+
+#endif // SPECTATORFEED_HPP
@@ -0,0 +1,126 @@
+/**
+ * StaticVector.hpp
+ * Vector with fixed inline capacity (no heap allocation)
+ *
+ * Holds up to N trivially copyable elements in place, so hands and plays
+ * can live on the stack or inside other objects and be passed around as
+ * std::span. Exceeding the capacity throws std::length_error.
+ */
+
+#ifndef STATICVECTOR_H
+#define STATICVECTOR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+
+/**
+ * StaticVector class
+ */
+template <typename T, std::size_t N>
+class StaticVector {
+    static_assert(std::is_trivially_copyable_v<T>, "StaticVector holds trivially copyable elements");
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    StaticVector() = default;
+
+    StaticVector(std::initializer_list<T> values) {
+        assign(std::span<const T>(values.begin(), values.size()));
+    }
+
+    explicit StaticVector(std::span<const T> values) {
+        assign(values);
+    }
+
+    /**
+     * Replace the contents
+     * @throws std::length_error if values has more than N elements
+     */
+    void assign(std::span<const T> values) {
+        if (values.size() > N) {
+            throw std::length_error("StaticVector capacity exceeded");
+        }
+        std::copy(values.begin(), values.end(), data());
+        size_ = values.size();
+    }
+
+    /**
+     * Append an element
+     * @throws std::length_error if the vector is full
+     */
+    void push_back(const T& value) {
+        if (size_ == N) {
+            throw std::length_error("StaticVector capacity exceeded");
+        }
+        ::new (static_cast<void*>(data() + size_)) T(value);
+        ++size_;
+    }
+
+    /**
+     * Append a range of elements
+     * @throws std::length_error if they do not all fit
+     */
+    void append(std::span<const T> values) {
+        if (values.size() > N - size_) {
+            throw std::length_error("StaticVector capacity exceeded");
+        }
+        std::copy(values.begin(), values.end(), data() + size_);
+        size_ += values.size();
+    }
+
+    void pop_back() { --size_; }
+    void clear() { size_ = 0; }
+
+    /**
+     * Remove one element, keeping the order of the rest
+     */
+    iterator erase(const_iterator position) {
+        iterator target = begin() + (position - cbegin());
+        std::copy(target + 1, end(), target);
+        --size_;
+        return target;
+    }
+
+    size_type size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    static constexpr size_type capacity() { return N; }
+
+    T* data() { return std::launder(reinterpret_cast<T*>(storage_)); }
+    const T* data() const { return std::launder(reinterpret_cast<const T*>(storage_)); }
+
+    iterator begin() { return data(); }
+    iterator end() { return data() + size_; }
+    const_iterator begin() const { return data(); }
+    const_iterator end() const { return data() + size_; }
+    const_iterator cbegin() const { return data(); }
+    const_iterator cend() const { return data() + size_; }
+
+    T& operator[](size_type index) { return data()[index]; }
+    const T& operator[](size_type index) const { return data()[index]; }
+    T& front() { return data()[0]; }
+    const T& front() const { return data()[0]; }
+    T& back() { return data()[size_ - 1]; }
+    const T& back() const { return data()[size_ - 1]; }
+
+    operator std::span<const T>() const { return { data(), size_ }; }
+    operator std::span<T>() { return { data(), size_ }; }
+
+    bool operator==(const StaticVector& other) const {
+        return std::equal(begin(), end(), other.begin(), other.end());
+    }
+
+private:
+    alignas(T) unsigned char storage_[sizeof(T) * N];
+    size_type size_ = 0;
+};
+
+#endif // STATICVECTOR_HPP
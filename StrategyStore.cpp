@@ -0,0 +1,130 @@
+/**
+ * StrategyStore.cpp
+ * Implementation of StrategyStore
+ */
+
+#include "StrategyStore.h"
+#include <algorithm>
+
+/**
+ * Release the pinned version
+ */
+StrategyStore::Snapshot::~Snapshot() {
+    if (slot_) {
+        slot_->epoch.store(IDLE, std::memory_order_release);
+    }
+}
+
+const EquityTable* StrategyStore::Snapshot::get() const {
+    return version_ ? version_->table.get() : nullptr;
+}
+
+std::uint64_t StrategyStore::Snapshot::getVersion() const {
+    return version_ ? version_->number : 0;
+}
+
+/**
+ * Register a reading thread, reusing a slot a finished reader left
+ */
+StrategyStore::Reader::Reader(StrategyStore& store) : store_(store), slot_(nullptr) {
+    std::lock_guard<std::mutex> lock(store_.mutex_);
+    for (auto& slot : store_.slots_) {
+        if (!slot->registered) {
+            slot_ = slot.get();
+            break;
+        }
+    }
+    if (!slot_) {
+        store_.slots_.push_back(std::make_unique<ReaderSlot>());
+        slot_ = store_.slots_.back().get();
+    }
+    slot_->registered = true;
+}
+
+StrategyStore::Reader::~Reader() {
+    std::lock_guard<std::mutex> lock(store_.mutex_);
+    slot_->epoch.store(IDLE, std::memory_order_relaxed);
+    slot_->registered = false;
+}
+
+/**
+ * Pin the current version: publish the epoch, then load the pointer. A
+ * version swapped out after the epoch was read is retired under a later
+ * epoch, so reclaim keeps it while this slot holds the earlier one.
+ */
+StrategyStore::Snapshot StrategyStore::Reader::read() {
+    slot_->epoch.store(store_.epoch_.load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+    return Snapshot(slot_, store_.current_.load(std::memory_order_seq_cst));
+}
+
+StrategyStore::StrategyStore() = default;
+
+/**
+ * Constructor - load the first version
+ */
+StrategyStore::StrategyStore(const std::string& path) {
+    load(path);
+}
+
+/**
+ * Destructor
+ */
+StrategyStore::~StrategyStore() {
+    delete current_.load();
+}
+
+/**
+ * Map a new version and make it current
+ */
+std::uint64_t StrategyStore::load(const std::string& path) {
+    auto version = std::make_unique<Version>();
+    version->table = std::make_unique<EquityTable>(path);   // Mapped and checked before the swap
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    version->number = nextVersion_++;
+    std::uint64_t number = version->number;
+
+    Version* old = current_.exchange(version.release(), std::memory_order_seq_cst);
+    if (old) {
+        old->retiredEpoch = epoch_.fetch_add(1, std::memory_order_seq_cst) + 1;
+        retired_.emplace_back(old);
+    }
+    reclaimLocked();
+    return number;
+}
+
+/**
+ * Unmap retired versions no reader can still be using
+ */
+size_t StrategyStore::reclaim() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return reclaimLocked();
+}
+
+size_t StrategyStore::reclaimLocked() {
+    if (retired_.empty()) {
+        return 0;
+    }
+
+    // A reader that published epoch e may hold any version retired after e
+    std::uint64_t oldestPinned = IDLE;
+    for (const auto& slot : slots_) {
+        oldestPinned = std::min(oldestPinned, slot->epoch.load(std::memory_order_seq_cst));
+    }
+
+    size_t before = retired_.size();
+    retired_.erase(std::remove_if(retired_.begin(), retired_.end(),
+        [oldestPinned](const std::unique_ptr<Version>& version) { return version->retiredEpoch <= oldestPinned; }),
+        retired_.end());
+    return before - retired_.size();
+}
+
+std::uint64_t StrategyStore::getVersion() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return nextVersion_ - 1;
+}
+
+size_t StrategyStore::getRetiredCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return retired_.size();
+}
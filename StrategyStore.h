@@ -0,0 +1,157 @@
+/**
+ * StrategyStore.hpp
+ * Bot strategy data that can be replaced while bots are reading it
+ *
+ * The current version is an EquityTable mapped from a file and reached
+ * through one atomic pointer (read-copy-update). Each reading thread
+ * registers a Reader once; a read publishes the global epoch in the
+ * reader's slot and loads the pointer, two loads and a store with no loop
+ * or lock, so reads are wait-free. load() maps a new version, swaps it in
+ * and retires the old one under the next epoch. reclaim() unmaps a retired
+ * version once every reader is idle or has published a later epoch, so
+ * decisions already in flight finish on the version they started with.
+ */
+
+#ifndef STRATEGYSTORE_H
+#define STRATEGYSTORE_H
+
+#include "EquityTable.h"
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * StrategyStore class
+ */
+class StrategyStore {
+private:
+    struct Version;
+    struct ReaderSlot;
+
+public:
+    /**
+     * A pinned version: valid until the snapshot is destroyed
+     */
+    class Snapshot {
+    public:
+        Snapshot(Snapshot&& other) noexcept : slot_(other.slot_), version_(other.version_) {
+            other.slot_ = nullptr;
+        }
+        Snapshot(const Snapshot&) = delete;
+        Snapshot& operator=(const Snapshot&) = delete;
+        Snapshot& operator=(Snapshot&&) = delete;
+        ~Snapshot();
+
+        /**
+         * Equity table of the pinned version (nullptr before the first load)
+         */
+        const EquityTable* get() const;
+        const EquityTable* operator->() const { return get(); }
+        explicit operator bool() const { return version_ != nullptr; }
+
+        /**
+         * Number of the pinned version (0 before the first load)
+         */
+        std::uint64_t getVersion() const;
+
+    private:
+        friend class StrategyStore;
+        Snapshot(ReaderSlot* slot, const Version* version) : slot_(slot), version_(version) {}
+
+        ReaderSlot* slot_;
+        const Version* version_;
+    };
+
+    /**
+     * A reading thread's registration; one snapshot at a time per reader
+     */
+    class Reader {
+    public:
+        explicit Reader(StrategyStore& store);
+        ~Reader();
+
+        Reader(const Reader&) = delete;
+        Reader& operator=(const Reader&) = delete;
+
+        /**
+         * Pin the current version (wait-free)
+         */
+        Snapshot read();
+
+    private:
+        StrategyStore& store_;
+        ReaderSlot* slot_;
+    };
+
+    StrategyStore();
+
+    /**
+     * Constructor - load the first version
+     * @throws std::runtime_error on a missing or malformed file
+     */
+    explicit StrategyStore(const std::string& path);
+
+    /**
+     * Destructor - every Reader must be gone
+     */
+    ~StrategyStore();
+
+    StrategyStore(const StrategyStore&) = delete;
+    StrategyStore& operator=(const StrategyStore&) = delete;
+
+    /**
+     * Map a new version and make it current; the previous one is retired
+     * @return Number of the new version
+     * @throws std::runtime_error on a missing or malformed file (the current version stays)
+     */
+    std::uint64_t load(const std::string& path);
+
+    /**
+     * Unmap retired versions no reader can still be using
+     * @return Number of versions unmapped
+     */
+    size_t reclaim();
+
+    /**
+     * Number of the current version (0 before the first load)
+     */
+    std::uint64_t getVersion() const;
+
+    /**
+     * Retired versions still mapped
+     */
+    size_t getRetiredCount() const;
+
+private:
+    static constexpr std::uint64_t IDLE = std::numeric_limits<std::uint64_t>::max();
+
+    struct Version {
+        std::unique_ptr<EquityTable> table;
+        std::uint64_t number = 0;
+        std::uint64_t retiredEpoch = 0;
+    };
+
+    struct alignas(64) ReaderSlot {
+        std::atomic<std::uint64_t> epoch{ IDLE };   // Epoch published by the pinning read, or IDLE
+        bool registered = false;
+    };
+
+    std::atomic<Version*> current_{ nullptr };
+    std::atomic<std::uint64_t> epoch_{ 0 };
+
+    mutable std::mutex mutex_;                      // Writers, registration and reclamation
+    std::vector<std::unique_ptr<ReaderSlot>> slots_;
+    std::vector<std::unique_ptr<Version>> retired_;
+    std::uint64_t nextVersion_ = 1;
+
+    /**
+     * Unmap what no reader can see (mutex_ held)
+     */
+    size_t reclaimLocked();
+};
+
+#endif // STRATEGYSTORE_HPP
@@ -0,0 +1,80 @@
+/**
+ * StringDictionary.cpp
+ * Implementation of StringDictionary
+ */
+
+#include "StringDictionary.h"
+#include <fstream>
+#include <stdexcept>
+
+ /**
+  * Get the id of a string, adding it if new
+  */
+std::uint32_t StringDictionary::intern(const std::string& value) {
+    auto it = ids_.find(value);
+    if (it != ids_.end()) {
+        return it->second;
+    }
+
+    std::uint32_t id = static_cast<std::uint32_t>(values_.size());
+    values_.push_back(value);
+    ids_.emplace(value, id);
+    return id;
+}
+
+/**
+ * Look up an id
+ */
+const std::string& StringDictionary::lookup(std::uint32_t id) const {
+    if (id >= values_.size()) {
+        throw std::out_of_range("Unknown dictionary id: " + std::to_string(id));
+    }
+    return values_[id];
+}
+
+/**
+ * Find the id of a string without adding it
+ */
+bool StringDictionary::find(const std::string& value, std::uint32_t& id) const {
+    auto it = ids_.find(value);
+    if (it == ids_.end()) {
+        return false;
+    }
+    id = it->second;
+    return true;
+}
+
+/**
+ * Save as one string per line
+ */
+void StringDictionary::save(const std::string& path) const {
+    std::ofstream out(path, std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("Cannot create dictionary file: " + path);
+    }
+    for (const auto& value : values_) {
+        out << value << '\n';
+    }
+    if (!out) {
+        throw std::runtime_error("Write failed: " + path);
+    }
+}
+
+/**
+ * Load from one string per line
+ */
+StringDictionary StringDictionary::load(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) {
+        throw std::runtime_error("Cannot open dictionary file: " + path);
+    }
+
+    StringDictionary dictionary;
+    std::string line;
+    while (std::getline(in, line)) {
+        std::uint32_t id = static_cast<std::uint32_t>(dictionary.values_.size());
+        dictionary.values_.push_back(line);
+        dictionary.ids_.emplace(line, id);
+    }
+    return dictionary;
+}
@@ -0,0 +1,53 @@
+/**
+ * StringDictionary.hpp
+ * Interns strings to dense 32-bit ids (dictionary encoding)
+ */
+
+#ifndef STRINGDICTIONARY_H
+#define STRINGDICTIONARY_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+/**
+ * StringDictionary class
+ */
+class StringDictionary {
+public:
+    /**
+     * Get the id of a string, adding it if new
+     */
+    std::uint32_t intern(const std::string& value);
+
+    /**
+     * Look up an id
+     * @throws std::out_of_range if the id is unknown
+     */
+    const std::string& lookup(std::uint32_t id) const;
+
+    /**
+     * Find the id of a string without adding it
+     * @return true if found
+     */
+    bool find(const std::string& value, std::uint32_t& id) const;
+
+    /**
+     * Number of distinct strings
+     */
+    size_t size() const { return values_.size(); }
+
+    /**
+     * Save/load as one string per line, line number = id
+     * @throws std::runtime_error on I/O failure
+     */
+    void save(const std::string& path) const;
+    static StringDictionary load(const std::string& path);
+
+private:
+    std::vector<std::string> values_;
+    std::unordered_map<std::string, std::uint32_t> ids_;
+};
+
+#endif // STRINGDICTIONARY_HPP
@@ -0,0 +1,89 @@
+/**
+ * TableStore.cpp
+ * Implementation of TableStore
+ */
+
+#include "TableStore.h"
+#include <stdexcept>
+#include <string>
+
+/**
+ * Constructor
+ */
+TableStore::TableStore(Clock::duration idleTimeout) : idleTimeout_(idleTimeout) {
+}
+
+/**
+ * Take ownership of a table
+ */
+TableStore::TableId TableStore::add(std::unique_ptr<GameState> table, Clock::time_point now) {
+    if (!table) {
+        throw std::invalid_argument("Cannot add a null table");
+    }
+
+    TableId id = nextId_++;
+    Entry& entry = tables_[id];
+    entry.live = std::move(table);
+    entry.lruPosition = lru_.insert(lru_.end(), id);
+    entry.lastUsed = now;
+    return id;
+}
+
+/**
+ * A table, thawed first if it was hibernated
+ */
+GameState& TableStore::acquire(TableId id, Clock::time_point now) {
+    auto it = tables_.find(id);
+    if (it == tables_.end()) {
+        throw std::out_of_range("No table " + std::to_string(id));
+    }
+
+    Entry& entry = it->second;
+    if (entry.live) {
+        lru_.splice(lru_.end(), lru_, entry.lruPosition);
+    }
+    else {
+        auto table = std::make_unique<GameState>();
+        table->unpack(entry.packed);
+        entry.live = std::move(table);
+        entry.packed = PackedGameState();   // Drop the shared names reference
+        entry.lruPosition = lru_.insert(lru_.end(), id);
+        ++stats_.thaws;
+    }
+    entry.lastUsed = now;
+    return *entry.live;
+}
+
+/**
+ * Drop a table
+ */
+bool TableStore::remove(TableId id) {
+    auto it = tables_.find(id);
+    if (it == tables_.end()) {
+        return false;
+    }
+    if (it->second.live) {
+        lru_.erase(it->second.lruPosition);
+    }
+    tables_.erase(it);
+    return true;
+}
+
+/**
+ * Pack every live table unused since now - idleTimeout
+ */
+size_t TableStore::hibernateIdle(Clock::time_point now) {
+    size_t hibernated = 0;
+    while (!lru_.empty()) {
+        Entry& entry = tables_.find(lru_.front())->second;
+        if (now - entry.lastUsed < idleTimeout_) {
+            break;
+        }
+        entry.packed = entry.live->pack();
+        entry.live.reset();
+        lru_.pop_front();
+        ++hibernated;
+    }
+    stats_.hibernations += hibernated;
+    return hibernated;
+}
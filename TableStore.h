@@ -0,0 +1,104 @@
+/**
+ * TableStore.hpp
+ * Tables by id, with idle tables hibernated into their packed form
+ *
+ * A live table is a full GameState, several KB of it the deck's Mersenne
+ * Twister. A table nobody has touched for the idle timeout is packed
+ * (GameState::pack, a few hundred bytes) and its GameState freed; acquire
+ * thaws it back before returning it, so callers only notice that the undo
+ * history is gone. Live tables are kept in least-recently-used order, so
+ * hibernateIdle visits only the tables it packs.
+ *
+ * Not thread-safe: a store belongs to one thread, or to a caller-held lock.
+ */
+
+#ifndef TABLESTORE_H
+#define TABLESTORE_H
+
+#include "GameState.h"
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <unordered_map>
+
+/**
+ * Hibernation counters
+ */
+struct TableStoreStats {
+    std::uint64_t hibernations = 0;
+    std::uint64_t thaws = 0;
+};
+
+/**
+ * TableStore class
+ */
+class TableStore {
+public:
+    using TableId = std::uint64_t;
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * Constructor
+     * @param idleTimeout time since a table's last acquire before hibernateIdle packs it
+     */
+    explicit TableStore(Clock::duration idleTimeout);
+
+    TableStore(const TableStore&) = delete;
+    TableStore& operator=(const TableStore&) = delete;
+
+    /**
+     * Take ownership of a table
+     * @return Id of the table
+     * @throws std::invalid_argument if table is null
+     */
+    TableId add(std::unique_ptr<GameState> table, Clock::time_point now);
+
+    /**
+     * A table, thawed first if it was hibernated; marks it used at now.
+     * The reference stays valid until the table is hibernated or removed.
+     * @throws std::out_of_range if there is no such table
+     */
+    GameState& acquire(TableId id, Clock::time_point now);
+
+    /**
+     * Drop a table
+     * @return false if there is no such table
+     */
+    bool remove(TableId id);
+
+    /**
+     * Pack every live table unused since now - idleTimeout
+     * @return Number of tables hibernated
+     */
+    size_t hibernateIdle(Clock::time_point now);
+
+    bool contains(TableId id) const { return tables_.count(id) != 0; }
+
+    /**
+     * @throws std::out_of_range if there is no such table
+     */
+    bool isHibernated(TableId id) const { return !tables_.at(id).live; }
+
+    size_t size() const { return tables_.size(); }
+    size_t getLiveCount() const { return lru_.size(); }
+    size_t getHibernatedCount() const { return tables_.size() - lru_.size(); }
+    Clock::duration getIdleTimeout() const { return idleTimeout_; }
+    const TableStoreStats& getStats() const { return stats_; }
+
+private:
+    struct Entry {
+        std::unique_ptr<GameState> live;        // Null while hibernated
+        PackedGameState packed;                 // Valid while hibernated
+        std::list<TableId>::iterator lruPosition;
+        Clock::time_point lastUsed;
+    };
+
+    std::unordered_map<TableId, Entry> tables_;
+    std::list<TableId> lru_;                    // Live tables, least recently used first
+    Clock::duration idleTimeout_;
+    TableId nextId_ = 1;
+    TableStoreStats stats_;
+};
+
+#endif // TABLESTORE_HPP
@@ -0,0 +1,108 @@
+/**
+ * TextBuffer.hpp
+ * Fixed-capacity text buffer for allocation-free UI formatting
+ *
+ * Status lines, player info and card lists are appended into an inline
+ * character array (numbers through std::to_chars) and handed to the
+ * renderer as a string_view. Text past the capacity is cut off.
+ */
+
+#ifndef TEXTBUFFER_H
+#define TEXTBUFFER_H
+
+#include "Card.h"
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <span>
+#include <string>
+#include <string_view>
+
+/**
+ * TextBuffer class
+ */
+class TextBuffer {
+public:
+    static constexpr std::size_t CAPACITY = 255;
+
+    TextBuffer() { text_[0] = '\0'; }
+
+    explicit TextBuffer(std::string_view text) : TextBuffer() { append(text); }
+
+    void clear() {
+        size_ = 0;
+        text_[0] = '\0';
+    }
+
+    /**
+     * Replace the contents
+     */
+    TextBuffer& assign(std::string_view text) {
+        clear();
+        return append(text);
+    }
+
+    TextBuffer& append(std::string_view text) {
+        std::size_t count = std::min(text.size(), CAPACITY - size_);
+        std::copy_n(text.data(), count, text_ + size_);
+        size_ += count;
+        text_[size_] = '\0';
+        return *this;
+    }
+
+    TextBuffer& append(char c) {
+        return append(std::string_view(&c, 1));
+    }
+
+    TextBuffer& append(long long value) {
+        char digits[24];
+        auto result = std::to_chars(digits, digits + sizeof(digits), value);
+        return append(std::string_view(digits, static_cast<std::size_t>(result.ptr - digits)));
+    }
+
+    TextBuffer& append(int value) { return append(static_cast<long long>(value)); }
+    TextBuffer& append(std::size_t value) { return append(static_cast<long long>(value)); }
+
+    /**
+     * Append a card like Card::toString, or like Card::toDisplayString with symbols
+     */
+    TextBuffer& appendCard(const Card& card, bool symbols = false) {
+        if (!symbols) {
+            return append(card.getRankChar()).append(card.getSuitChar());
+        }
+        if (card.getRank() == Rank::Ten) {
+            append(std::string_view("10"));
+        }
+        else {
+            append(card.getRankChar());
+        }
+        return append(std::string_view(card.getSuitSymbol()));
+    }
+
+    /**
+     * Append cards separated by spaces
+     */
+    TextBuffer& appendCards(std::span<const Card> cards, bool symbols = false) {
+        for (std::size_t i = 0; i < cards.size(); ++i) {
+            if (i > 0) {
+                append(' ');
+            }
+            appendCard(cards[i], symbols);
+        }
+        return *this;
+    }
+
+    std::string_view view() const { return { text_, size_ }; }
+    const char* c_str() const { return text_; }
+    std::string str() const { return std::string(view()); }
+    std::size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    operator std::string_view() const { return view(); }
+
+private:
+    char text_[CAPACITY + 1];
+    std::size_t size_ = 0;
+};
+
+#endif // TEXTBUFFER_HPP
@@ -0,0 +1,231 @@
+/**
+ * TraceRecorder.cpp
+ * Implementation of TraceRecorder
+ */
+
+#include "TraceRecorder.h"
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+std::atomic<bool> TraceRecorder::enabled_{ false };
+
+namespace {
+
+    /**
+     * One complete event
+     */
+    struct TraceEvent {
+        const char* name;
+        std::int64_t beginTicks;
+        std::int64_t endTicks;
+    };
+
+    /**
+     * Events of one thread; only that thread writes events and count
+     */
+    struct ThreadBuffer {
+        std::uint32_t threadId = 0;
+        std::string name;                           // Guarded by the registry mutex
+        std::atomic<size_t> count{ 0 };
+        std::atomic<size_t> dropped{ 0 };
+        std::unique_ptr<TraceEvent[]> events;
+    };
+
+    /**
+     * Every thread buffer ever created (kept after their threads exit)
+     */
+    struct Registry {
+        std::mutex mutex;
+        std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+        std::int64_t originTicks = 0;               // Clock pair taken by start()
+        std::int64_t originNs = 0;
+    };
+
+    Registry& registry() {
+        static Registry instance;
+        return instance;
+    }
+
+    thread_local ThreadBuffer* localBuffer = nullptr;
+
+    /**
+     * The calling thread's buffer, created on first use
+     */
+    ThreadBuffer& threadBuffer() {
+        if (!localBuffer) {
+            Registry& reg = registry();
+            std::lock_guard<std::mutex> lock(reg.mutex);
+            auto buffer = std::make_unique<ThreadBuffer>();
+            buffer->threadId = static_cast<std::uint32_t>(reg.buffers.size() + 1);
+            buffer->events = std::make_unique<TraceEvent[]>(TraceRecorder::EVENTS_PER_THREAD);
+            localBuffer = buffer.get();
+            reg.buffers.push_back(std::move(buffer));
+        }
+        return *localBuffer;
+    }
+
+    /**
+     * Write a JSON string literal
+     */
+    void writeJsonString(std::ostream& out, const char* text) {
+        out << '"';
+        for (const char* c = text; *c; ++c) {
+            if (*c == '"' || *c == '\\') {
+                out << '\\' << *c;
+            }
+            else if (static_cast<unsigned char>(*c) < 0x20) {
+                char escaped[8];
+                std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(*c));
+                out << escaped;
+            }
+            else {
+                out << *c;
+            }
+        }
+        out << '"';
+    }
+
+    std::int64_t steadyNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    /**
+     * Ticks as trace microseconds
+     */
+    void writeMicros(std::ostream& out, std::int64_t ticks, double nsPerTick) {
+        char text[32];
+        std::snprintf(text, sizeof(text), "%.3f", static_cast<double>(ticks) * nsPerTick / 1000.0);
+        out << text;
+    }
+
+} // namespace
+
+/**
+ * Clear all buffers and start recording
+ */
+void TraceRecorder::start() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (auto& buffer : reg.buffers) {
+        buffer->count.store(0, std::memory_order_relaxed);
+        buffer->dropped.store(0, std::memory_order_relaxed);
+    }
+    reg.originTicks = ticks();
+    reg.originNs = steadyNs();
+    enabled_.store(true, std::memory_order_release);
+}
+
+/**
+ * Stop recording
+ */
+void TraceRecorder::stop() {
+    enabled_.store(false, std::memory_order_release);
+}
+
+/**
+ * Name the calling thread
+ */
+void TraceRecorder::setThreadName(const char* name) {
+    ThreadBuffer& buffer = threadBuffer();
+    std::lock_guard<std::mutex> lock(registry().mutex);
+    buffer.name = name;
+}
+
+/**
+ * Record a complete event on the calling thread
+ */
+void TraceRecorder::record(const char* name, std::int64_t beginTicks, std::int64_t endTicks) {
+    ThreadBuffer& buffer = threadBuffer();
+    size_t index = buffer.count.load(std::memory_order_relaxed);
+    if (index >= EVENTS_PER_THREAD) {
+        buffer.dropped.store(buffer.dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        return;
+    }
+    buffer.events[index] = TraceEvent{ name, beginTicks, endTicks };
+    buffer.count.store(index + 1, std::memory_order_release);
+}
+
+/**
+ * Write every recorded event as Chrome trace JSON
+ */
+size_t TraceRecorder::exportChromeTrace(const std::string& path) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("Cannot write trace file: " + path);
+    }
+
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    // Tick rate measured over the recording (1 where ticks are nanoseconds)
+    std::int64_t elapsedTicks = ticks() - reg.originTicks;
+    std::int64_t elapsedNs = steadyNs() - reg.originNs;
+    double nsPerTick = elapsedTicks > 0 && elapsedNs > 0
+        ? static_cast<double>(elapsedNs) / static_cast<double>(elapsedTicks) : 1.0;
+
+    size_t written = 0;
+    bool first = true;
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    for (const auto& buffer : reg.buffers) {
+        if (!buffer->name.empty()) {
+            out << (first ? "\n" : ",\n");
+            out << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":" << buffer->threadId
+                << ",\"args\":{\"name\":";
+            writeJsonString(out, buffer->name.c_str());
+            out << "}}";
+            first = false;
+        }
+
+        size_t count = buffer->count.load(std::memory_order_acquire);
+        for (size_t i = 0; i < count; ++i) {
+            const TraceEvent& event = buffer->events[i];
+            out << (first ? "\n" : ",\n");
+            out << "{\"ph\":\"X\",\"name\":";
+            writeJsonString(out, event.name);
+            out << ",\"pid\":1,\"tid\":" << buffer->threadId << ",\"ts\":";
+            writeMicros(out, event.beginTicks - reg.originTicks, nsPerTick);
+            out << ",\"dur\":";
+            writeMicros(out, event.endTicks - event.beginTicks, nsPerTick);
+            out << "}";
+            first = false;
+            ++written;
+        }
+    }
+    out << "\n]}\n";
+
+    if (!out) {
+        throw std::runtime_error("Failed writing trace file: " + path);
+    }
+    return written;
+}
+
+/**
+ * Events recorded since start()
+ */
+size_t TraceRecorder::getEventCount() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    size_t total = 0;
+    for (const auto& buffer : reg.buffers) {
+        total += buffer->count.load(std::memory_order_acquire);
+    }
+    return total;
+}
+
+/**
+ * Events dropped on full buffers since start()
+ */
+size_t TraceRecorder::getDroppedCount() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    size_t total = 0;
+    for (const auto& buffer : reg.buffers) {
+        total += buffer->dropped.load(std::memory_order_relaxed);
+    }
+    return total;
+}
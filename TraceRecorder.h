@@ -0,0 +1,126 @@
+/**
+ * TraceRecorder.hpp
+ * Timeline tracing of game loop phases, exported as Chrome trace JSON
+ *
+ * THIRTEEN_TRACE_SCOPE("name") records one complete event (begin and end
+ * timestamps) for the enclosing scope while recording is on. Timestamps are
+ * raw TSC ticks on x86, converted to time against steady_clock on export. Each thread
+ * appends to its own fixed-size buffer without locks; a full buffer drops
+ * further events. Names must be string literals (only the pointer is kept).
+ * Building with THIRTEEN_TRACING=0 removes the scopes entirely.
+ *
+ * Start and stop recording from one control thread; events that race
+ * with start() may be lost.
+ */
+
+#ifndef TRACERECORDER_H
+#define TRACERECORDER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define THIRTEEN_TRACE_TSC 1
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define THIRTEEN_TRACE_TSC 1
+#endif
+
+#ifndef THIRTEEN_TRACING
+#define THIRTEEN_TRACING 1
+#endif
+
+/**
+ * TraceRecorder class
+ */
+class TraceRecorder {
+public:
+    static constexpr size_t EVENTS_PER_THREAD = 1 << 16;
+
+    /**
+     * Clear all buffers and start recording
+     */
+    static void start();
+
+    /**
+     * Stop recording (buffers are kept for export)
+     */
+    static void stop();
+
+    static bool isEnabled() { return enabled_.load(std::memory_order_relaxed); }
+
+    /**
+     * Name the calling thread in exported traces
+     */
+    static void setThreadName(const char* name);
+
+    /**
+     * Record a complete event on the calling thread
+     */
+    static void record(const char* name, std::int64_t beginTicks, std::int64_t endTicks);
+
+    /**
+     * Timestamp on the trace clock (TSC ticks on x86, steady_clock nanoseconds elsewhere)
+     */
+    static std::int64_t ticks() {
+#ifdef THIRTEEN_TRACE_TSC
+        return static_cast<std::int64_t>(__rdtsc());
+#else
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+    }
+
+    /**
+     * Write every recorded event as Chrome trace JSON (Perfetto, chrome://tracing)
+     * @return number of events written
+     * @throws std::runtime_error if the file cannot be written
+     */
+    static size_t exportChromeTrace(const std::string& path);
+
+    /**
+     * Events recorded and dropped (full buffers) since start()
+     */
+    static size_t getEventCount();
+    static size_t getDroppedCount();
+
+private:
+    static std::atomic<bool> enabled_;
+};
+
+/**
+ * Records the lifetime of a scope
+ */
+class TraceScope {
+public:
+    explicit TraceScope(const char* name)
+        : name_(TraceRecorder::isEnabled() ? name : nullptr),
+        beginTicks_(name_ ? TraceRecorder::ticks() : 0) {
+    }
+
+    ~TraceScope() {
+        if (name_) {
+            TraceRecorder::record(name_, beginTicks_, TraceRecorder::ticks());
+        }
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* name_;
+    std::int64_t beginTicks_;
+};
+
+#if THIRTEEN_TRACING
+#define THIRTEEN_TRACE_CONCAT_INNER(a, b) a##b
+#define THIRTEEN_TRACE_CONCAT(a, b) THIRTEEN_TRACE_CONCAT_INNER(a, b)
+#define THIRTEEN_TRACE_SCOPE(name) TraceScope THIRTEEN_TRACE_CONCAT(traceScope_, __LINE__)(name)
+#else
+#define THIRTEEN_TRACE_SCOPE(name) ((void)0)
+#endif
+
+#endif // TRACERECORDER_HPP
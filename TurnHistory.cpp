@@ -0,0 +1,86 @@
+/**
+ * TurnHistory.cpp
+ * Implementation of TurnHistory
+ */
+
+#include "TurnHistory.h"
+
+/**
+ * Cards moved, in the order they were played
+ */
+PlayCards TurnDiff::getCards() const {
+    PlayCards result;
+    for (size_t i = 0; i < MAX_CARDS; ++i) {
+        std::uint32_t index = (cards >> (6 * i)) & 63u;
+        if (index == NO_CARD) {
+            break;
+        }
+        result.push_back(Card::fromIndex(static_cast<int>(index)));
+    }
+    return result;
+}
+
+/**
+ * Forget every recorded turn
+ */
+void TurnHistory::clear(std::span<const Card> lastPlay) {
+    diffs_.clear();
+    cursor_ = 0;
+    firstPlay_ = SIZE_MAX;
+    startPlay_.assign(lastPlay);
+}
+
+/**
+ * Make room for every turn of a game
+ */
+void TurnHistory::reserve(size_t cards, size_t seats) {
+    diffs_.reserve(cards * seats);
+}
+
+/**
+ * Record a turn after the cursor, dropping the redo tail
+ */
+bool TurnHistory::record(TurnDiffKind kind, std::span<const Card> cards, size_t seat,
+    size_t lastSeat, std::uint32_t passedSeats, int passes) {
+    if (cards.size() > TurnDiff::MAX_CARDS) {
+        return false;
+    }
+
+    TurnDiff diff;
+    diff.cards = static_cast<std::uint32_t>(kind) << 30;
+    for (size_t i = 0; i < TurnDiff::MAX_CARDS; ++i) {
+        std::uint32_t index = i < cards.size() ? static_cast<std::uint32_t>(cards[i].getIndex()) : TurnDiff::NO_CARD;
+        diff.cards |= index << (6 * i);
+    }
+    diff.seat = static_cast<std::uint8_t>(seat);
+    diff.lastSeat = static_cast<std::uint8_t>(lastSeat);
+    diff.passedSeats = static_cast<std::uint8_t>(passedSeats);
+    diff.passes = static_cast<std::uint8_t>(passes);
+
+    diffs_.resize(cursor_);
+    if (firstPlay_ >= cursor_) {
+        firstPlay_ = kind == TurnDiffKind::Play ? cursor_ : SIZE_MAX;
+    }
+    diffs_.push_back(diff);
+    ++cursor_;
+    return true;
+}
+
+/**
+ * Play to beat before the turn at the cursor: the nearest earlier play,
+ * unless a trick ended after it (at most one pass per seat to skip)
+ */
+PlayCards TurnHistory::getLastPlayAtCursor() const {
+    for (size_t i = cursor_; i > 0; --i) {
+        switch (diffs_[i - 1].kind()) {
+        case TurnDiffKind::Play:
+            return diffs_[i - 1].getCards();
+        case TurnDiffKind::TrickEnd:
+        case TurnDiffKind::Reset:
+            return {};
+        case TurnDiffKind::Pass:
+            break;
+        }
+    }
+    return startPlay_;
+}
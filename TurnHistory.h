@@ -0,0 +1,127 @@
+/**
+ * TurnHistory.hpp
+ * Undo/redo log of turn transitions as compact diffs
+ *
+ * Each applied turn is stored as an 8-byte TurnDiff: the cards moved (as
+ * dense card indices, like CardMask bits), the seat that acted, and the
+ * trick state the action overwrote. The play to beat before an action is
+ * not stored: it is the cards of the nearest earlier play, unless a trick
+ * ended in between, and at most one pass per seat separates the two.
+ */
+
+#ifndef TURNHISTORY_H
+#define TURNHISTORY_H
+
+#include "Card.h"
+#include "Hand.h"
+#include <cstdint>
+#include <span>
+#include <vector>
+
+/**
+ * What a recorded turn did
+ */
+enum class TurnDiffKind : std::uint8_t {
+    Play,           // Cards moved from the seat's hand to the table
+    Pass,           // Seat dropped out, trick continues
+    TrickEnd,       // Seat passed and the trick was cleared
+    Reset           // Trick cleared without a pass
+};
+
+/**
+ * One recorded turn (8 bytes)
+ */
+struct TurnDiff {
+    std::uint32_t cards;            // Five 6-bit card indices (NO_CARD padded), kind in bits 30-31
+    std::uint8_t seat;              // Seat that acted (the seat to move before the action)
+    std::uint8_t lastSeat;          // Last playing seat before the action
+    std::uint8_t passedSeats;       // Passed seats before the action
+    std::uint8_t passes;            // Consecutive passes before the action
+
+    static constexpr std::uint32_t NO_CARD = 63;
+    static constexpr size_t MAX_CARDS = 5;
+
+    TurnDiffKind kind() const { return static_cast<TurnDiffKind>(cards >> 30); }
+
+    /**
+     * Cards moved, in the order they were played
+     */
+    PlayCards getCards() const;
+};
+
+static_assert(sizeof(TurnDiff) == 8, "TurnDiff must be 8 bytes");
+
+/**
+ * TurnHistory class
+ */
+class TurnHistory {
+public:
+    /**
+     * Forget every recorded turn (the reserved space is kept)
+     * @param lastPlay Play to beat before the next turn recorded (a table
+     *        restored mid-trick); empty at a deal
+     */
+    void clear(std::span<const Card> lastPlay = {});
+
+    /**
+     * Make room for every turn of a game, so recording never allocates.
+     * Each trick opens with a play that sheds at least one card and closes
+     * after at most seats - 1 passes, so a game with cards left in hands
+     * takes at most cards x seats turns (explicit ResetTrick turns aside).
+     */
+    void reserve(size_t cards, size_t seats);
+
+    /**
+     * Record a turn after the cursor, dropping the redo tail
+     * @return false if the play has more than MAX_CARDS cards (nothing recorded)
+     */
+    bool record(TurnDiffKind kind, std::span<const Card> cards, size_t seat,
+        size_t lastSeat, std::uint32_t passedSeats, int passes);
+
+    bool canUndo() const { return cursor_ > 0; }
+    bool canRedo() const { return cursor_ < diffs_.size(); }
+
+    /**
+     * Move the cursor back and return the turn to revert
+     */
+    const TurnDiff& stepBack() { return diffs_[--cursor_]; }
+
+    /**
+     * Move the cursor forward and return the turn to re-apply
+     */
+    const TurnDiff& stepForward() { return diffs_[cursor_++]; }
+
+    /**
+     * Turn just before the cursor (the last one applied), nullptr if none
+     */
+    const TurnDiff* getLastTurn() const { return cursor_ > 0 ? &diffs_[cursor_ - 1] : nullptr; }
+
+    /**
+     * Turns before the cursor, oldest first
+     */
+    std::span<const TurnDiff> getTurns() const { return { diffs_.data(), cursor_ }; }
+
+    /**
+     * Play to beat before the turn at the cursor
+     */
+    PlayCards getLastPlayAtCursor() const;
+
+    /**
+     * Whether any turn before the cursor was a play
+     */
+    bool hasPlayBeforeCursor() const { return firstPlay_ < cursor_; }
+
+    /**
+     * Number of turns before the cursor
+     */
+    size_t getCursor() const { return cursor_; }
+    size_t size() const { return diffs_.size(); }
+
+private:
+    std::vector<TurnDiff> diffs_;
+    size_t cursor_ = 0;
+    size_t firstPlay_ = SIZE_MAX;   // Index of the first play
+    PlayCards startPlay_;           // Play to beat before the first turn
+};
+
+#endif // TURNHISTORY_HPP
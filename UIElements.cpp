@@ -69,7 +69,7 @@ const sf::Font& UIElements::getFont() {
  */
 void UIElements::drawText(
     sf::RenderWindow& window,
-    const std::string& text,
+    std::string_view text,
     float x, float y,
     unsigned int size,
     const sf::Color& color,
@@ -189,7 +189,7 @@ void UIElements::drawLine(
 /**
  * Get text bounds
  */
-sf::FloatRect UIElements::getTextBounds(const std::string& text, unsigned int size) {
+sf::FloatRect UIElements::getTextBounds(std::string_view text, unsigned int size) {
     sf::Text sfText = createText(text, 0, 0, size);
     return sfText.getLocalBounds();
 }
@@ -198,13 +198,13 @@ sf::FloatRect UIElements::getTextBounds(const std::string& text, unsigned int si
  * Create a text object
  */
 sf::Text UIElements::createText(
-    const std::string& text,
+    std::string_view text,
     float x, float y,
     unsigned int size,
     const sf::Color& color
 ) {
     sf::Text sfText(getFont());
-    sfText.setString(text);
+    sfText.setString(sf::String::fromUtf8(text.begin(), text.end()));
     sfText.setCharacterSize(size);
     sfText.setFillColor(color);
     sfText.setPosition(sf::Vector2f(x, y));
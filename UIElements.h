@@ -8,6 +8,7 @@
 
 #include <SFML/Graphics.hpp>
 #include <string>
+#include <string_view>
 #include <memory>
 
  /**
@@ -55,7 +56,7 @@ public:
      */
     static void drawText(
         sf::RenderWindow& window,
-        const std::string& text,
+        std::string_view text,
         float x, float y,
         unsigned int size = 24,
         const sf::Color& color = sf::Color::White,
@@ -99,15 +100,15 @@ public:
      * Get text bounds (useful for centering)
      */
     static sf::FloatRect getTextBounds(
-        const std::string& text,
+        std::string_view text,
         unsigned int size = 24
     );
 
     /**
-     * Create a text object (for more control)
+     * Create a text object (for more control; text is UTF-8)
      */
     static sf::Text createText(
-        const std::string& text,
+        std::string_view text,
         float x, float y,
         unsigned int size = 24,
         const sf::Color& color = sf::Color::White
@@ -10,6 +10,7 @@
 #include <atomic>
 #include <queue>
 #include <mutex>
+#include <cstdio>
 
  // Include our game components
 #include "Card.h"
@@ -17,15 +18,25 @@
 #include "Hand.h"
 #include "GameState.h"
 #include "GameRules.h"
+#include "SelectionValidator.h"
+#include "Bot.h"
 #include "Renderer.h"
+#include "TraceRecorder.h"
+#include "LatencyTracker.h"
+#include "GameClock.h"
 
 class Game {
 public:
-    Game() :
+    /**
+     * Constructor
+     * @param gameClock Game time: frame and bot pacing waits (a virtual clock skips them)
+     */
+    explicit Game(GameClock& gameClock = GameClock::system()) :
         window(sf::VideoMode({ 1280, 720 }), "Thirteen - Big Two"),
         renderer(window),
         running(true),
-        needsRedraw(true) {
+        needsRedraw(true),
+        clock(gameClock) {
 
         window.setFramerateLimit(60);
 
@@ -38,7 +49,7 @@ public:
         initializeTestGame();
 
         std::cout << "=== Thirteen (Big Two) ===" << std::endl;
-        std::cout << "Commands: play <cards>, pass, sort, quit" << std::endl;
+        std::cout << "Commands: play <cards>, select <cards>, play, pass, undo, redo, sort, quit" << std::endl;
         std::cout << "Example: play 3H 3D (play pair of threes)" << std::endl;
         std::cout << "> " << std::flush;
     }
@@ -56,9 +67,10 @@ public:
                 render();
                 needsRedraw = false;
             }
+            finishRenderedSpans();
 
             // Small sleep to prevent busy waiting
-            std::this_thread::sleep_for(std::chrono::milliseconds(16));
+            clock.sleepFor(FRAME_INTERVAL);
         }
 
         // Cleanup
@@ -74,13 +86,34 @@ private:
     std::atomic<bool> running;
     std::atomic<bool> needsRedraw;
 
+    // Game time: the frame and bot pacing waits run on it
+    GameClock& clock;
+    static constexpr std::chrono::milliseconds FRAME_INTERVAL{ 16 };
+    static constexpr std::chrono::milliseconds BOT_MOVE_DELAY{ 500 };
+
+    // A typed command and the latency span it carries from the input thread
+    struct QueuedCommand {
+        std::string line;
+        ActionSpan span;
+    };
+
     // Thread-safe command queue
-    std::queue<std::string> commandQueue;
+    std::queue<QueuedCommand> commandQueue;
     std::mutex queueMutex;
 
-    // Game state
+    // Per-action latency: the command being handled, and those waiting for the next frame
+    LatencyTracker latency;
+    ActionSpan currentSpan;
+    std::vector<ActionSpan> spansToRender;
+
+    // Game state; bots adapt to tendencies learned across games
     GameState gameState;
-    std::string gameStatus = "Welcome! Starting a new game...";
+    OpponentModel opponentModel;
+    TextBuffer gameStatus{ "Welcome! Starting a new game..." };
+    std::uint64_t statusVersion = 0;    // Game state version gameStatus was written at
+
+    // Cards the human has picked for the next play, validated as they change
+    SelectionValidator selection;
 
     /**
      * Initialize game with proper game state
@@ -88,11 +121,13 @@ private:
     void initializeTestGame() {
         // Initialize with 4 players (1 human, 3 AI)
         gameState.initializePlayers(4, 1);
+        const PlayerId playerIds[] = { 0, 1, 2, 3 };
+        gameState.setOpponentModel(&opponentModel, playerIds);
 
         // Start the game
         gameState.startNewGame();
 
-        gameStatus = "Game started! " + gameState.getStatusMessage();
+        showGameStatus("Game started! ");
 
         // Print game info to console
         std::cout << "\n=== Game Started ===" << std::endl;
@@ -103,8 +138,13 @@ private:
                 std::cout << "  " << player->toString() << std::endl;
             }
         }
-        std::cout << "\n" << gameStatus << std::endl;
+        std::cout << "\n" << gameStatus.view() << std::endl;
         std::cout << "=====================\n" << std::endl;
+
+        // AI seats move until the human's turn (one of them may hold the 3 of Diamonds)
+        playAITurns();
+        showGameStatus();
+        refreshSelection();
     }
 
     /**
@@ -117,10 +157,13 @@ private:
         while (running) {
             if (std::getline(std::cin, line)) {
                 if (!line.empty()) {
+                    ActionSpan span = latency.begin();
+
                     // Add command to queue
                     {
                         std::lock_guard<std::mutex> lock(queueMutex);
-                        commandQueue.push(line);
+                        latency.mark(span, LatencyStage::Receive);
+                        commandQueue.push({ line, span });
                     }
                     needsRedraw = true;
                 }
@@ -142,6 +185,7 @@ private:
      * Handle SFML window events
      */
     void handleEvents() {
+        THIRTEEN_TRACE_SCOPE("Game::handleEvents");
         while (auto event = window.pollEvent()) {
             if (event->is<sf::Event::Closed>()) {
                 window.close();
@@ -154,29 +198,114 @@ private:
                     running = false;
                 }
             }
+
+            if (const auto* pressed = event->getIf<sf::Event::MouseButtonPressed>()) {
+                if (pressed->button == sf::Mouse::Button::Left) {
+                    handleHandClick(static_cast<float>(pressed->position.x), static_cast<float>(pressed->position.y));
+                }
+            }
+        }
+    }
+
+    /**
+     * Y coordinate of the human's hand
+     */
+    float getHandY() const {
+        return renderer.getWindowHeight() - CardSprite::CARD_HEIGHT - 20;
+    }
+
+    /**
+     * Toggle the clicked card of the human's hand in the selection
+     */
+    void handleHandClick(float x, float y) {
+        const Player* humanPlayer = gameState.getPlayer(0);
+        if (!humanPlayer) {
+            return;
+        }
+
+        Hand hand = humanPlayer->getHand();
+        std::optional<size_t> index = renderer.getHandCardAt(hand, 50, getHandY(), x, y);
+        if (!index) {
+            return;
+        }
+
+        // With two decks, the clicked copy is selected if its highlight is on
+        const Card& card = hand.at(*index);
+        if (Renderer::selectionHighlights(hand, selection.getSelection())[*index]) {
+            selection.remove(card);
+        }
+        else {
+            selection.add(card);
+        }
+        needsRedraw = true;
+    }
+
+    /**
+     * Re-validate the selection against the current trick, dropping cards
+     * that have left the human's hand
+     */
+    void refreshSelection() {
+        const Player* humanPlayer = gameState.getPlayer(0);
+        if (humanPlayer) {
+            CardSet hand = gameState.getSeats().getHand(humanPlayer->getSeat());
+            if (!hand.contains(selection.getSelection())) {
+                selection.clear();
+            }
         }
+        selection.setContext(gameState.getLastPlay(), humanMustPlayThreeOfDiamonds());
+    }
+
+    /**
+     * The opening play must include the 3 of Diamonds, unless it was left
+     * undealt (3 players, or two decks over 5-7) and the lead fell to seat 0
+     */
+    bool humanMustPlayThreeOfDiamonds() const {
+        const Player* humanPlayer = gameState.getPlayer(0);
+        return humanPlayer && gameState.isFirstPlayOfGame()
+            && gameState.getSeats().holds(humanPlayer->getSeat(), Card(Rank::Three, Suit::Diamonds));
     }
 
     /**
      * Process queued commands from input thread
      */
     void processCommands() {
+        THIRTEEN_TRACE_SCOPE("Game::processCommands");
         std::lock_guard<std::mutex> lock(queueMutex);
 
         while (!commandQueue.empty()) {
-            std::string command = commandQueue.front();
+            std::string command = std::move(commandQueue.front().line);
+            currentSpan = commandQueue.front().span;
             commandQueue.pop();
+            latency.mark(currentSpan, LatencyStage::QueueWait);
 
             handleCommand(command);
+            refreshSelection();
             needsRedraw = true;
+
+            if (currentSpan) {
+                spansToRender.push_back(currentSpan);
+                currentSpan = ActionSpan();
+            }
         }
     }
 
+    /**
+     * Close the spans of the commands the last frame showed
+     */
+    void finishRenderedSpans() {
+        for (auto& span : spansToRender) {
+            latency.mark(span, LatencyStage::Broadcast);
+            latency.finish(span);
+        }
+        spansToRender.clear();
+    }
+
     /**
      * Handle a single command
      * This is where we'll integrate CommandParser later
      */
     void handleCommand(const std::string& command) {
+        THIRTEEN_TRACE_SCOPE("Game::handleCommand");
         std::cout << "Processing: " << command << std::endl;
 
         // Parse command (simplified for now)
@@ -186,51 +315,112 @@ private:
             running = false;
         }
         else if (command == "pass") {
+            currentSpan.action = "pass";
+            latency.mark(currentSpan, LatencyStage::Parse);
             Player* currentPlayer = gameState.getCurrentPlayer();
             if (currentPlayer && currentPlayer->getType() == PlayerType::Human) {
-                currentPlayer->setHasPassed(true);
-                gameState.incrementPasses();
-                gameStatus = "You passed.";
-                std::cout << gameStatus << std::endl;
-
-                // Move to next turn
-                gameState.nextTurn();
-
-                // Check if all others have passed AFTER moving to next player
-                if (gameState.allOthersHavePassed()) {
-                    const Player* roundWinner = gameState.getLastPlayingPlayer();
-                    if (roundWinner) {
-                        std::cout << "All others passed. " << roundWinner->getName() << " wins the round!" << std::endl;
-                    }
-                    gameState.clearLastPlay();
+                TurnResult result = gameState.applyTurn(TurnAction::Pass);
+                latency.mark(currentSpan, LatencyStage::Mutate);
+                if (result == TurnResult::Rejected) {
+                    setStatus("You are leading - play some cards.");
+                    std::cout << gameStatus.view() << std::endl;
+                    return;
                 }
+                std::cout << "You passed." << std::endl;
+                announceTrickWinner(result);
 
                 playAITurns();
 
-                gameStatus = gameState.getStatusMessage();
+                showGameStatus();
             }
             else {
                 std::cout << "It's not your turn!" << std::endl;
             }
         }
         else if (command.starts_with("play ")) {
+            currentSpan.action = "play";
             std::string cardsStr = command.substr(5);
             handlePlayCommand(cardsStr);
         }
+        else if (command == "play") {
+            currentSpan.action = "play";
+            latency.mark(currentSpan, LatencyStage::Parse);
+            playSelection();
+        }
+        else if (command.starts_with("select ")) {
+            handleSelectCommand(command.substr(7));
+        }
+        else if (command == "undo") {
+            undoToHumanTurn();
+        }
+        else if (command == "redo") {
+            redoToHumanTurn();
+        }
+        else if (command == "clear") {
+            selection.clear();
+            std::cout << "Selection cleared." << std::endl;
+        }
         else if (command == "sort" || command == "sort rank") {
             Player* currentPlayer = gameState.getPlayer(0);  // Human is always player 0
             if (currentPlayer) {
-                currentPlayer->getHand().sort(SortOrder::ByRank);
-                gameStatus = "Hand sorted by rank.";
-                std::cout << gameStatus << std::endl;
+                currentPlayer->sortHand(SortOrder::ByRank);
+                setStatus("Hand sorted by rank.");
+                std::cout << gameStatus.view() << std::endl;
             }
         }
         else if (command == "sort suit") {
             Player* currentPlayer = gameState.getPlayer(0);  // Human is always player 0
             if (currentPlayer) {
-                currentPlayer->getHand().sort(SortOrder::BySuit);
-                gameStatus = "Hand sorted by suit.";
-                std::cout << gameStatus << std::endl;
+                currentPlayer->sortHand(SortOrder::BySuit);
+                setStatus("Hand sorted by suit.");
+                std::cout << gameStatus.view() << std::endl;
+            }
+        }
+        else if (command == "trace start") {
+            TraceRecorder::start();
+            TraceRecorder::setThreadName("game loop");
+            std::cout << "Tracing started." << std::endl;
+        }
+        else if (command == "trace stop" || command.starts_with("trace stop ")) {
+            TraceRecorder::stop();
+            std::string path = command.size() > 11 ? command.substr(11) : "thirteen-trace.json";
+            try {
+                size_t events = TraceRecorder::exportChromeTrace(path);
+                std::cout << "Wrote " << events << " trace events to " << path
+                    << " (" << TraceRecorder::getDroppedCount() << " dropped)" << std::endl;
+            }
+            catch (const std::exception& e) {
+                std::cout << "Trace export failed: " << e.what() << std::endl;
+            }
+        }
+        else if (command == "latency start" || command.starts_with("latency start ")) {
+            std::uint32_t sampleEvery = 1;
+            if (command.size() > 14) {
+                try {
+                    sampleEvery = static_cast<std::uint32_t>(std::stoul(command.substr(14)));
+                }
+                catch (const std::exception&) {
+                    std::cout << "Usage: latency start [sample every N actions]" << std::endl;
+                    return;
+                }
+            }
+            latency.start(sampleEvery);
+            std::cout << "Latency tracing started (sampling 1 in " << std::max(1u, sampleEvery) << ")." << std::endl;
+        }
+        else if (command == "latency") {
+            printLatency();
+        }
+        else if (command == "latency stop" || command.starts_with("latency stop ")) {
+            latency.stop();
+            printLatency();
+            std::string path = command.size() > 13 ? command.substr(13) : "thirteen-latency.jsonl";
+            try {
+                size_t spans = latency.exportSamples(path);
+                std::cout << "Wrote " << spans << " sampled actions to " << path
+                    << " (" << latency.getDroppedCount() << " dropped)" << std::endl;
+            }
+            catch (const std::exception& e) {
+                std::cout << "Latency export failed: " << e.what() << std::endl;
             }
         }
         else if (command == "help") {
@@ -254,7 +444,7 @@ private:
         // Only allow human player to play
         if (currentPlayer->getType() != PlayerType::Human) {
             std::cout << "It's not your turn! Current player: " << currentPlayer->getName() << std::endl;
-            gameStatus = "Not your turn!";
+            setStatus("Not your turn!");
             return;
         }
 
@@ -268,108 +458,246 @@ private:
 
         // Find cards in hand
         auto cards = currentPlayer->getHand().findCards(cardStrs);
+        latency.mark(currentSpan, LatencyStage::Parse);
 
         if (cards.empty()) {
             std::cout << "No valid cards found in hand." << std::endl;
-            gameStatus = "Invalid cards specified.";
+            setStatus("Invalid cards specified.");
             return;
         }
 
         if (cards.size() != cardStrs.size()) {
             std::cout << "Some cards not found in hand." << std::endl;
-            gameStatus = "Some cards not in your hand.";
+            setStatus("Some cards not in your hand.");
             return;
         }
 
-        // Validate the play using GameRules
-        bool isFirstPlay = gameState.getLastPlay().empty();
-        bool mustInclude3D = gameState.isFirstPlayOfGame();
+        // Typed cards replace the selection
+        selection.clear();
+        for (const auto& card : cards) {
+            selection.add(card);
+        }
+        playSelection();
+    }
 
-        PlayValidation validation = GameRules::validatePlay(
-            cards,
-            gameState.getLastPlay(),
-            isFirstPlay,
-            mustInclude3D
-        );
+    /**
+     * Add typed cards to the selection and report what it forms
+     */
+    void handleSelectCommand(const std::string& cardsStr) {
+        const Player* humanPlayer = gameState.getPlayer(0);
+        if (!humanPlayer) {
+            return;
+        }
+
+        std::vector<std::string> cardStrs;
+        std::istringstream iss(cardsStr);
+        std::string cardStr;
+        while (iss >> cardStr) {
+            cardStrs.push_back(cardStr);
+        }
 
-        if (!validation.isValid) {
-            std::cout << "Invalid play: " << validation.errorMessage << std::endl;
-            gameStatus = "Invalid: " + validation.errorMessage;
+        // Cards already selected are not available again
+        CardSet available = gameState.getSeats().getHand(humanPlayer->getSeat());
+        for (const auto& card : selection.getCards()) {
+            available.remove(card);
+        }
+        for (const auto& card : humanPlayer->getHand().findCards(cardStrs)) {
+            if (available.remove(card)) {
+                selection.add(card);
+            }
+        }
+
+        std::cout << GameRules::getPlayTypeName(selection.getPlayType(), selection.getFiveCardType());
+        if (selection.isValid()) {
+            std::cout << " - ready to play" << std::endl;
+        }
+        else {
+            std::cout << " - " << selection.getErrorMessage() << std::endl;
+        }
+    }
+
+    /**
+     * Play the selected cards
+     */
+    void playSelection() {
+        Player* currentPlayer = gameState.getCurrentPlayer();
+        if (!currentPlayer || currentPlayer->getType() != PlayerType::Human) {
+            std::cout << "It's not your turn!" << std::endl;
+            setStatus("Not your turn!");
+            return;
+        }
+
+        // The selection is already validated against the current trick
+        selection.setContext(gameState.getLastPlay(), humanMustPlayThreeOfDiamonds());
+        latency.mark(currentSpan, LatencyStage::Validate);
+        if (!selection.isValid()) {
+            std::cout << "Invalid play: " << selection.getErrorMessage() << std::endl;
+            setStatus("Invalid: ");
+            gameStatus.append(selection.getErrorMessage());
             return;
         }
 
         // Remove cards from hand and update game state
-        if (currentPlayer->getHand().removeCards(cards)) {
-            gameState.setLastPlay(cards, gameState.getCurrentPlayerIndex());
+        std::vector<Card> cards = selection.getCards();
+        TurnResult result = gameState.applyTurn(TurnAction::Play, cards);
+        latency.mark(currentSpan, LatencyStage::Mutate);
+        if (result == TurnResult::Rejected) {
+            std::cout << "Error removing cards from hand." << std::endl;
+            setStatus("Error playing cards.");
+            return;
+        }
 
-            // Mark that the first play of the game has been made
-            if (gameState.isFirstPlayOfGame()) {
-                gameState.setFirstPlayMade();
-            }
+        setStatus(currentPlayer->getName());
+        gameStatus.append(" played ")
+            .append(GameRules::getPlayTypeName(selection.getPlayType(), selection.getFiveCardType()))
+            .append(": ").appendCards(cards);
+        selection.clear();
+        std::cout << gameStatus.view() << std::endl;
+
+        // Check for winner
+        if (result == TurnResult::GameWon) {
+            setStatus(currentPlayer->getName());
+            gameStatus.append(" wins!");
+            std::cout << "\n🎉 " << gameStatus.view() << " 🎉\n" << std::endl;
+            return;
+        }
 
-            std::string playName = GameRules::getPlayTypeName(validation.playType, validation.fiveCardType);
-            gameStatus = currentPlayer->getName() + " played " + playName + ": " + cardsStr;
-            std::cout << gameStatus << std::endl;
+        // Auto-play AI turns
+        playAITurns();
 
-            // Check for winner
-            if (currentPlayer->hasWon()) {
-                gameStatus = currentPlayer->getName() + " wins!";
-                gameState.setPhase(GamePhase::Finished);
-                std::cout << "\n🎉 " << gameStatus << " 🎉\n" << std::endl;
-                return;
-            }
+        showGameStatus();
+        std::cout << "Cards remaining: " << currentPlayer->getCardCount() << std::endl;
+    }
 
-            // Move to next turn
-            gameState.nextTurn();
+    /**
+     * Take back the human's last turn and the AI turns after it
+     */
+    void undoToHumanTurn() {
+        if (!gameState.undoTurn()) {
+            setStatus("Nothing to undo.");
+            std::cout << gameStatus.view() << std::endl;
+            return;
+        }
+        while (!isHumanTurn() && gameState.undoTurn()) {
+        }
 
-            // Auto-play AI turns
-            playAITurns();
+        // Back at the deal with an AI seat leading: redo its recorded turns
+        // rather than choosing them again, so the table replays as it was
+        while (!isHumanTurn() && gameState.getPhase() == GamePhase::InProgress && gameState.redoTurn()) {
+        }
+        playAITurns();
+        selection.clear();
+        showGameStatus("Undone. ");
+        std::cout << gameStatus.view() << std::endl;
+    }
 
-            gameStatus = gameState.getStatusMessage();
-            std::cout << "Cards remaining: " << currentPlayer->getHand().size() << std::endl;
+    /**
+     * Replay undone turns up to the human's next turn
+     */
+    void redoToHumanTurn() {
+        if (!gameState.redoTurn()) {
+            setStatus("Nothing to redo.");
+            std::cout << gameStatus.view() << std::endl;
+            return;
         }
-        else {
-            std::cout << "Error removing cards from hand." << std::endl;
-            gameStatus = "Error playing cards.";
+        while (!isHumanTurn() && gameState.getPhase() == GamePhase::InProgress && gameState.redoTurn()) {
         }
+        showGameStatus("Redone. ");
+        std::cout << gameStatus.view() << std::endl;
+    }
+
+    bool isHumanTurn() const {
+        const Player* currentPlayer = gameState.getCurrentPlayer();
+        return currentPlayer && currentPlayer->getType() == PlayerType::Human;
     }
 
     /**
      * Handle AI turns automatically
      */
     void playAITurns() {
+        THIRTEEN_TRACE_SCOPE("Game::playAITurns");
         while (gameState.getPhase() == GamePhase::InProgress) {
             Player* currentPlayer = gameState.getCurrentPlayer();
             if (!currentPlayer || currentPlayer->getType() == PlayerType::Human) {
                 break;  // Stop when it's human's turn
             }
 
-            // Simple AI: just pass for now
-            std::cout << currentPlayer->getName() << " passes." << std::endl;
-            currentPlayer->setHasPassed(true);
-            gameState.incrementPasses();
-
-            // Move to next turn BEFORE checking round win
-            gameState.nextTurn();
+            // The 3 of Diamonds may be undealt with 3 players
+            Hand hand = currentPlayer->getHand();
+            bool mustInclude3D = gameState.isFirstPlayOfGame() && hand.hasThreeOfDiamonds();
+            PlayCards play = Bot::choosePlay(hand.getCards(), gameState.getLastPlay(), mustInclude3D,
+                gameState.getOpponentProfiles(gameState.getCurrentPlayerIndex()));
+
+            TurnResult result = play.empty() ? TurnResult::Rejected
+                : gameState.applyTurn(TurnAction::Play, play);
+            if (result != TurnResult::Rejected) {
+                std::cout << currentPlayer->getName() << " plays";
+                for (const auto& card : play) {
+                    std::cout << " " << card.toString();
+                }
+                std::cout << std::endl;
 
-            // Check if all others have passed (check AFTER moving to next player)
-            if (gameState.allOthersHavePassed()) {
-                const Player* roundWinner = gameState.getLastPlayingPlayer();
-                if (roundWinner) {
-                    std::cout << "All others passed. " << roundWinner->getName() << " wins the round!" << std::endl;
+                if (result == TurnResult::GameWon) {
+                    std::cout << "\n" << currentPlayer->getName() << " wins!\n" << std::endl;
+                    break;
                 }
-                gameState.clearLastPlay();
+            }
+            else {
+                result = gameState.applyTurn(TurnAction::Pass);
+                if (result == TurnResult::Rejected) {
+                    break;
+                }
+                std::cout << currentPlayer->getName() << " passes." << std::endl;
+                announceTrickWinner(result);
             }
 
             // Small delay for readability
-            std::this_thread::sleep_for(std::chrono::milliseconds(500));
+            clock.sleepFor(BOT_MOVE_DELAY);
+        }
+        latency.mark(currentSpan, LatencyStage::Bots);
+    }
+
+    /**
+     * Report the end of a trick after a pass
+     */
+    void announceTrickWinner(TurnResult result) {
+        if (result != TurnResult::TrickWon) {
+            return;
+        }
+        if (const Player* roundWinner = gameState.getLastPlayingPlayer()) {
+            std::cout << "All others passed. " << roundWinner->getName() << " wins the round!" << std::endl;
         }
     }
 
+    /**
+     * Show a message until the game state next changes
+     */
+    void setStatus(std::string_view message) {
+        gameStatus.assign(message);
+        statusVersion = gameState.getVersion();
+    }
+
+    /**
+     * Show the game's status message after an optional prefix
+     */
+    void showGameStatus(std::string_view prefix = {}) {
+        TextBuffer status;
+        gameState.formatStatusMessage(status);
+        gameStatus.assign(prefix).append(status);
+        statusVersion = gameState.getVersion();
+    }
+
     /**
      * Render game state to SFML window
      */
     void render() {
+        THIRTEEN_TRACE_SCOPE("Game::render");
+
+        // Status text is only rebuilt when the game state has moved on
+        if (statusVersion != gameState.getVersion()) {
+            showGameStatus();
+        }
+
         renderer.clear();
 
         // Draw status panel at top
@@ -387,7 +715,7 @@ private:
                 bool isActive = (i == gameState.getCurrentPlayerIndex());
                 float x = 50 + (i % 2) * 600;  // Two columns
                 float y = playerInfoY + (i / 2) * 70;
-                renderer.drawPlayerInfo(player->getName(), player->getHand().size(), x, y, isActive);
+                renderer.drawPlayerInfo(player->getName(), player->getCardCount(), x, y, isActive);
             }
         }
 
@@ -397,11 +725,13 @@ private:
         // Draw human player's hand at bottom (player 0 is always human)
         const Player* humanPlayer = gameState.getPlayer(0);
         if (humanPlayer) {
-            float handY = renderer.getWindowHeight() - CardSprite::CARD_HEIGHT - 20;
-            renderer.drawHand(humanPlayer->getHand(), 50, handY, true);
+            float handY = getHandY();
+            Hand hand = humanPlayer->getHand();
+            renderer.drawHand(hand, 50, handY, true, Renderer::selectionHighlights(hand, selection.getSelection()));
 
-            // Draw label
+            // Draw label and what the selection forms
             renderer.drawText("Your Hand:", 50, handY - 25, 18, sf::Color::White);
+            renderer.drawSelectionStatus(selection, 170, handY - 25);
         }
 
         // Draw helpful text at bottom
@@ -412,14 +742,41 @@ private:
         renderer.present();
     }
 
+    /**
+     * Print p50/p99/p999 of each stage of the traced actions
+     */
+    void printLatency() const {
+        std::cout << "Stage        count      p50 us     p99 us    p999 us" << std::endl;
+        for (size_t i = 0; i < LATENCY_STAGE_COUNT; ++i) {
+            LatencyStage stage = static_cast<LatencyStage>(i);
+            const LatencyHistogram& histogram = latency.getHistogram(stage);
+            char line[96];
+            std::snprintf(line, sizeof(line), "%-10s %7llu %10.1f %10.1f %10.1f", LatencyTracker::getStageName(stage),
+                static_cast<unsigned long long>(histogram.getCount()),
+                static_cast<double>(histogram.percentile(0.50)) / 1000.0,
+                static_cast<double>(histogram.percentile(0.99)) / 1000.0,
+                static_cast<double>(histogram.percentile(0.999)) / 1000.0);
+            std::cout << line << std::endl;
+        }
+    }
+
     /**
      * Print help text
      */
     void printHelp() {
         std::cout << "\n=== Commands ===" << std::endl;
         std::cout << "  play <cards>  - Play cards (e.g., 'play 3H 4H' for pair)" << std::endl;
+        std::cout << "  select <cards> - Add cards to the selection (or click them)" << std::endl;
+        std::cout << "  play          - Play the selected cards" << std::endl;
+        std::cout << "  clear         - Clear the selection" << std::endl;
+        std::cout << "  undo / redo   - Take back or replay your last turn" << std::endl;
         std::cout << "  pass          - Pass your turn" << std::endl;
         std::cout << "  sort [rank|suit] - Sort your hand" << std::endl;
+        std::cout << "  trace start   - Record a timeline of the game loop" << std::endl;
+        std::cout << "  trace stop [file] - Save it as Chrome trace JSON (default thirteen-trace.json)" << std::endl;
+        std::cout << "  latency start [N] - Time each action by stage, keeping every Nth in full" << std::endl;
+        std::cout << "  latency       - Show p50/p99/p999 per stage" << std::endl;
+        std::cout << "  latency stop [file] - Save the kept actions as JSON lines (default thirteen-latency.jsonl)" << std::endl;
         std::cout << "  help          - Show this help" << std::endl;
         std::cout << "  quit          - Exit game" << std::endl;
         std::cout << std::endl;
@@ -0,0 +1,197 @@
+/**
+ * Thirteen (Big Two) constrained deal benchmark
+ * Samples deals for common scenarios with ConstrainedDealer and with
+ * rejection sampling (shuffle until the constraints hold), checks every
+ * dealt hand against the constraints, and reports deals per second.
+ * Each scenario also starts one game through GameState to check that the
+ * stacked deck lands in the intended seats.
+ *
+ * Usage: thirteen-dealbench [--deals N] [--reject-seconds S] [--seed S]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "ConstrainedDealer.h"
+#include "GameState.h"
+
+namespace {
+
+    /**
+     * One benchmark scenario
+     */
+    struct Scenario {
+        const char* name;
+        DealConstraints constraints;
+    };
+
+    void printUsage() {
+        std::cout << "Usage: thirteen-dealbench [options]" << std::endl;
+        std::cout << "  --deals N           Constrained deals per scenario (default 100000)" << std::endl;
+        std::cout << "  --reject-seconds S  Time budget for rejection sampling (default 2)" << std::endl;
+        std::cout << "  --seed S            Random seed (default 1)" << std::endl;
+    }
+
+    std::vector<Scenario> buildScenarios() {
+        std::vector<Scenario> scenarios;
+        std::vector<Card> threeOfDiamondsAndTwos = {
+            Card("3D"), Card("2D"), Card("2C"), Card("2H"), Card("2S")
+        };
+
+        Scenario straightFlush{ "seat 0 straight flush", {} };
+        straightFlush.constraints.requireAnyOf(0, DealConstraints::straightFlushes());
+        scenarios.push_back(straightFlush);
+
+        Scenario twos{ "seat 2 3D + all 2s", {} };
+        twos.constraints.require(2, threeOfDiamondsAndTwos);
+        scenarios.push_back(twos);
+
+        Scenario noBombs{ "no four of a kind", {} };
+        noBombs.constraints.forbidFourOfAKindAnywhere();
+        scenarios.push_back(noBombs);
+
+        Scenario combined{ "seat 0 SF, no 4oak elsewhere", {} };
+        combined.constraints.requireAnyOf(0, DealConstraints::straightFlushes());
+        for (size_t seat = 1; seat < 4; ++seat) {
+            combined.constraints.forbidFourOfAKind(seat);
+        }
+        scenarios.push_back(combined);
+
+        Scenario puzzle{ "3p: seat 1 2S, seat 0 no 2s", {} };
+        puzzle.constraints.numPlayers = 3;
+        puzzle.constraints.require(1, std::vector<Card>{ Card("2S") });
+        puzzle.constraints.forbid(0, std::vector<Card>{ Card("2D"), Card("2C"), Card("2H"), Card("2S") });
+        scenarios.push_back(puzzle);
+
+        return scenarios;
+    }
+
+    /**
+     * Shuffle whole decks until a deal satisfies the dealer's constraints
+     * @return accepted deals per second
+     */
+    double rejectionRate(const ConstrainedDealer& dealer, double budgetSeconds, std::mt19937& rng,
+                         size_t& accepted, size_t& shuffles) {
+        int numPlayers = dealer.getNumPlayers();
+        size_t perSeat = dealer.getCardsPerPlayer();
+        std::vector<int> deck(52);
+        std::iota(deck.begin(), deck.end(), 0);
+        std::vector<CardMask> hands(numPlayers);
+
+        accepted = 0;
+        shuffles = 0;
+        auto start = std::chrono::steady_clock::now();
+        std::chrono::duration<double> elapsed{ 0 };
+        while (elapsed.count() < budgetSeconds) {
+            for (int batch = 0; batch < 1024; ++batch) {
+                std::shuffle(deck.begin(), deck.end(), rng);
+                ++shuffles;
+                for (int seat = 0; seat < numPlayers; ++seat) {
+                    hands[seat] = 0;
+                    for (size_t i = 0; i < perSeat; ++i) {
+                        hands[seat] |= CardMask{ 1 } << deck[seat * perSeat + i];
+                    }
+                }
+                accepted += dealer.satisfies(hands);
+            }
+            elapsed = std::chrono::steady_clock::now() - start;
+        }
+        return static_cast<double>(accepted) / elapsed.count();
+    }
+
+    /**
+     * Start one game from the dealer and compare seats with the sampled hands
+     */
+    bool checkGameDeal(ConstrainedDealer& dealer, std::uint32_t seed) {
+        GameState state;
+        state.initializePlayers(dealer.getNumPlayers(), 0);
+
+        std::mt19937 dealRng(seed);
+        std::mt19937 gameRng(seed);
+        std::vector<CardMask> hands = dealer.deal(dealRng);
+        state.startNewGame(dealer, gameRng);
+
+        for (size_t seat = 0; seat < hands.size(); ++seat) {
+            if (state.getSeats().getHand(seat).plane(0) != hands[seat]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t numDeals = 100000;
+    double rejectSeconds = 2.0;
+    std::uint32_t seed = 1;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (arg == "--deals" && hasValue) {
+            numDeals = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (arg == "--reject-seconds" && hasValue) {
+            rejectSeconds = std::atof(argv[++i]);
+        }
+        else if (arg == "--seed" && hasValue) {
+            seed = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else {
+            printUsage();
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+    if (numDeals == 0 || rejectSeconds <= 0) {
+        printUsage();
+        return 1;
+    }
+
+    bool allValid = true;
+    std::cout << std::fixed;
+    for (const auto& scenario : buildScenarios()) {
+        auto setupStart = std::chrono::steady_clock::now();
+        ConstrainedDealer dealer(scenario.constraints);
+        std::chrono::duration<double, std::milli> setup = std::chrono::steady_clock::now() - setupStart;
+
+        std::mt19937 rng(seed);
+        size_t violations = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < numDeals; ++i) {
+            violations += !dealer.satisfies(dealer.deal(rng));
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        double dealerRate = static_cast<double>(numDeals) / elapsed.count();
+
+        size_t accepted = 0;
+        size_t shuffles = 0;
+        double rejectRate = rejectionRate(dealer, rejectSeconds, rng, accepted, shuffles);
+        bool gameDeal = checkGameDeal(dealer, seed);
+        allValid = allValid && violations == 0 && gameDeal;
+
+        std::cout << scenario.name << std::endl;
+        std::cout << std::setprecision(1)
+            << "  dealer:    " << std::setw(12) << dealerRate << " deals/s (setup " << setup.count() << " ms, "
+            << violations << " violations)" << std::endl;
+        std::cout << "  rejection: " << std::setw(12) << rejectRate << " deals/s (" << accepted << " of "
+            << shuffles << " shuffles, " << std::setprecision(5)
+            << 100.0 * static_cast<double>(accepted) / static_cast<double>(shuffles) << "%)" << std::endl;
+        if (accepted > 0) {
+            std::cout << "  speedup:   " << std::setprecision(1) << dealerRate / rejectRate << "x" << std::endl;
+        }
+        std::cout << "  game deal: " << (gameDeal ? "ok" : "MISMATCH") << std::endl;
+    }
+
+    return allValid ? 0 : 1;
+}
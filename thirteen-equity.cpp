@@ -0,0 +1,169 @@
+/**
+ * Thirteen (Big Two) starting-hand equity tool
+ * Builds the equity table by bot rollouts, or looks hands up in it.
+ *
+ * Usage: thirteen-equity build --out <file> [options]
+ *        thirteen-equity lookup <file> --players P --hand 3D,4S,...
+ */
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "EquityBuilder.h"
+
+namespace {
+
+    void printUsage() {
+        std::cout << "Usage: thirteen-equity build --out <file> [options]" << std::endl;
+        std::cout << "  --players 2,3,4     Player counts to build (default 2,3,4)" << std::endl;
+        std::cout << "  --rollouts N        Games per hand profile (default 200)" << std::endl;
+        std::cout << "  --threads T         Worker threads (default: all cores)" << std::endl;
+        std::cout << "  --seed S            Base seed (default 1)" << std::endl;
+        std::cout << "  --block N           Profiles per work unit (default 1024)" << std::endl;
+        std::cout << "  --max-profiles N    Stop after N profiles per player count" << std::endl;
+        std::cout << "  --checkpoint FILE   Resume from / save progress to FILE" << std::endl;
+        std::cout << "  --interval SECONDS  Checkpoint interval (default 60)" << std::endl;
+        std::cout << "Usage: thirteen-equity lookup <file> --players P --hand 3D,4S,..." << std::endl;
+    }
+
+    std::vector<Card> parseCards(const std::string& list) {
+        std::vector<Card> cards;
+        std::istringstream iss(list);
+        std::string cardStr;
+        while (std::getline(iss, cardStr, ',')) {
+            if (!cardStr.empty()) {
+                cards.emplace_back(cardStr);
+            }
+        }
+        return cards;
+    }
+
+    int runBuild(int argc, char* argv[]) {
+        EquityBuildConfig config;
+
+        for (int i = 2; i < argc; ++i) {
+            std::string arg = argv[i];
+            bool hasValue = i + 1 < argc;
+
+            if (arg == "--out" && hasValue) {
+                config.outputPath = argv[++i];
+            }
+            else if (arg == "--players" && hasValue) {
+                config.playerCounts.clear();
+                std::istringstream iss(argv[++i]);
+                std::string count;
+                while (std::getline(iss, count, ',')) {
+                    config.playerCounts.push_back(std::atoi(count.c_str()));
+                }
+            }
+            else if (arg == "--rollouts" && hasValue) {
+                config.rolloutsPerHand = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+            }
+            else if (arg == "--threads" && hasValue) {
+                config.numThreads = static_cast<unsigned>(std::atoi(argv[++i]));
+            }
+            else if (arg == "--seed" && hasValue) {
+                config.seed = std::strtoull(argv[++i], nullptr, 10);
+            }
+            else if (arg == "--block" && hasValue) {
+                config.blockSize = std::strtoull(argv[++i], nullptr, 10);
+            }
+            else if (arg == "--max-profiles" && hasValue) {
+                config.maxProfiles = std::strtoull(argv[++i], nullptr, 10);
+            }
+            else if (arg == "--checkpoint" && hasValue) {
+                config.checkpointPath = argv[++i];
+            }
+            else if (arg == "--interval" && hasValue) {
+                config.checkpointSeconds = std::atof(argv[++i]);
+            }
+            else {
+                printUsage();
+                return 1;
+            }
+        }
+
+        if (config.outputPath.empty()) {
+            printUsage();
+            return 1;
+        }
+
+        EquityTableBuilder builder(config);
+        EquityBuildStats stats = builder.build([](std::uint64_t done, std::uint64_t total) {
+            std::cerr << "  " << done << " / " << total << " profiles" << std::endl;
+        });
+
+        std::cout << "Computed " << stats.profilesComputed << " profiles (" << stats.profilesResumed
+            << " resumed), " << stats.rollouts << " rollouts in " << stats.seconds << " s" << std::endl;
+        if (stats.seconds > 0.0) {
+            std::cout << "  " << static_cast<std::uint64_t>(stats.rollouts / stats.seconds)
+                << " games/s" << std::endl;
+        }
+        return 0;
+    }
+
+    int runLookup(int argc, char* argv[]) {
+        if (argc < 3) {
+            printUsage();
+            return 1;
+        }
+
+        std::string path = argv[2];
+        int players = 4;
+        std::vector<Card> hand;
+
+        for (int i = 3; i < argc; ++i) {
+            std::string arg = argv[i];
+            bool hasValue = i + 1 < argc;
+
+            if (arg == "--players" && hasValue) {
+                players = std::atoi(argv[++i]);
+            }
+            else if (arg == "--hand" && hasValue) {
+                hand = parseCards(argv[++i]);
+            }
+            else {
+                printUsage();
+                return 1;
+            }
+        }
+
+        EquityTable table(path);
+        auto equity = table.lookup(hand, players);
+        if (!equity) {
+            std::cout << "No entry for this hand" << std::endl;
+            return 1;
+        }
+
+        std::cout << std::fixed << std::setprecision(4) << *equity
+            << " (even share " << 1.0 / players << ")" << std::endl;
+        return 0;
+    }
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        printUsage();
+        return 1;
+    }
+
+    try {
+        std::string command = argv[1];
+        if (command == "build") {
+            return runBuild(argc, argv);
+        }
+        if (command == "lookup") {
+            return runLookup(argc, argv);
+        }
+        printUsage();
+        return command == "--help" ? 0 : 1;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
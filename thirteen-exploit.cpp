@@ -0,0 +1,122 @@
+/**
+ * Thirteen (Big Two) exploitability evaluator
+ * For every sampled deal and seat, searches for a best response against the
+ * bot in all other seats and compares its win rate with the bot's own in
+ * that seat. The responder sees every hand, so the gap is an upper bound on
+ * the bot's exploitability over the sampled deals.
+ *
+ * Usage: thirteen-exploit [--deals N] [--players P] [--threads T] [--seed S]
+ *                         [--node-budget B] [--table-bits K]
+ */
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <string>
+
+#include "BestResponse.h"
+
+namespace {
+
+    void printUsage() {
+        std::cout << "Usage: thirteen-exploit [options]" << std::endl;
+        std::cout << "  --deals N        Deals to evaluate (default 100)" << std::endl;
+        std::cout << "  --players P      Players per game, 2-8 (default 4)" << std::endl;
+        std::cout << "  --threads T      Worker threads (default: all cores)" << std::endl;
+        std::cout << "  --seed S         Base deal seed, as thirteen-sim (default 1)" << std::endl;
+        std::cout << "  --node-budget B  Responder nodes per deal and seat (default 1000000)" << std::endl;
+        std::cout << "  --table-bits K   Shared table of 2^K solved positions (default 24)" << std::endl;
+    }
+
+    double percent(std::uint64_t part, std::uint64_t whole) {
+        return whole > 0 ? 100.0 * static_cast<double>(part) / static_cast<double>(whole) : 0.0;
+    }
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    ExploitabilityConfig config;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (arg == "--deals" && hasValue) {
+            config.numDeals = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (arg == "--players" && hasValue) {
+            config.numPlayers = std::atoi(argv[++i]);
+        }
+        else if (arg == "--threads" && hasValue) {
+            config.numThreads = static_cast<unsigned>(std::atoi(argv[++i]));
+        }
+        else if (arg == "--seed" && hasValue) {
+            config.seed = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (arg == "--node-budget" && hasValue) {
+            config.nodeBudget = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (arg == "--table-bits" && hasValue) {
+            config.tableLog2Entries = static_cast<unsigned>(std::atoi(argv[++i]));
+        }
+        else {
+            printUsage();
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+    if (config.numDeals == 0 || config.numPlayers < 2 || config.numPlayers > 8
+        || config.tableLog2Entries > 34) {
+        printUsage();
+        return 1;
+    }
+
+    try {
+        std::mutex outputMutex;
+        std::uint64_t step = std::max<std::uint64_t>(1, config.numDeals / 20);
+        ExploitabilityRunner runner(config);
+        ExploitabilityStats stats = runner.run([&](std::uint64_t done) {
+            if (done % step == 0) {
+                std::lock_guard<std::mutex> lock(outputMutex);
+                std::cerr << "  " << done << " / " << config.numDeals << " deals" << std::endl;
+            }
+            });
+
+        std::uint64_t deals = 0;
+        std::uint64_t policyWins = 0;
+        std::uint64_t responseWins = 0;
+        std::uint64_t unresolved = 0;
+        std::uint64_t inconsistent = 0;
+
+        std::cout << std::fixed << std::setprecision(2);
+        for (size_t seat = 0; seat < stats.seats.size(); ++seat) {
+            const SeatExploitability& result = stats.seats[seat];
+            std::cout << "Seat " << seat << ": bot wins " << percent(result.policyWins, result.deals)
+                << "%, best response wins " << percent(result.responseWins, result.deals)
+                << "%, gap " << percent(result.responseWins - result.policyWins, result.deals)
+                << " points (" << result.unresolved << " unresolved)" << std::endl;
+            deals += result.deals;
+            policyWins += result.policyWins;
+            responseWins += result.responseWins;
+            unresolved += result.unresolved;
+            inconsistent += result.inconsistent;
+        }
+
+        std::cout << "Exploitability gap: " << percent(responseWins - policyWins, deals)
+            << " win-rate points per seat (upper bound, " << percent(unresolved, deals)
+            << "% of solves unresolved)" << std::endl;
+        std::cout << "Search: " << stats.nodes << " nodes, " << percent(stats.tableHits, stats.nodes)
+            << "% table hits, " << stats.seconds << " s ("
+            << (stats.seconds > 0 ? static_cast<double>(stats.nodes) / stats.seconds : 0.0) << " nodes/s)" << std::endl;
+        if (inconsistent != 0) {
+            std::cerr << "Error: " << inconsistent << " solves missed the bot's own winning line" << std::endl;
+            return 1;
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,416 @@
+/**
+ * Thirteen (Big Two) spectator fan-out benchmark
+ * Plays bot games at one table watched by many local spectator connections
+ * (Unix stream sockets to a reader process), publishes every turn through a
+ * SpectatorFeed, and reports the cost per update, the bytes and writes it
+ * took, how often slow spectators were resynced, and whether every
+ * spectator received a well-formed stream. A few spectators read slowly on
+ * purpose so their backlog overflows.
+ *
+ * Usage: thirteen-fanoutbench [--spectators N] [--games G] [--players P]
+ *        [--slow-percent S] [--flush-every K] [--max-pending B] [--sndbuf B] [--seed S]
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "Bot.h"
+#include "GameState.h"
+#include "LatencyTracker.h"
+#include "SpectatorFeed.h"
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    void printUsage() {
+        std::cout << "Usage: thirteen-fanoutbench [options]" << std::endl;
+        std::cout << "  --spectators N   Spectator connections (default 10000)" << std::endl;
+        std::cout << "  --games G        Games played at the table (default 20)" << std::endl;
+        std::cout << "  --players P      Seats, 2-8 (default 4)" << std::endl;
+        std::cout << "  --slow-percent S Spectators that read slowly (default 1)" << std::endl;
+        std::cout << "  --flush-every K  Updates published between flushes (default 4)" << std::endl;
+        std::cout << "  --max-pending B  Backlog bytes before a resync (default 4096)" << std::endl;
+        std::cout << "  --sndbuf B       Socket send buffer bytes (default 16384)" << std::endl;
+        std::cout << "  --seed S         Deal seed (default 1)" << std::endl;
+    }
+
+    /**
+     * What the reader process saw
+     */
+    struct ReaderStats {
+        std::uint64_t bytes = 0;
+        std::uint64_t frames = 0;
+        std::uint64_t snapshots = 0;
+        std::uint64_t turns = 0;
+        std::uint64_t malformed = 0;
+        std::uint64_t connections = 0;
+        std::uint64_t slowConnections = 0;
+    };
+
+    /**
+     * A spectator's end of the stream, split back into frames
+     */
+    struct Spectator {
+        int fd = -1;
+        bool slow = false;
+        std::uint8_t header[SpectatorFeed::FRAME_HEADER_SIZE] = {};
+        size_t headerBytes = 0;
+        size_t payloadLeft = 0;
+
+        void consume(const std::uint8_t* data, size_t size, ReaderStats& stats) {
+            stats.bytes += size;
+            while (size > 0) {
+                if (payloadLeft > 0) {
+                    size_t take = std::min(payloadLeft, size);
+                    payloadLeft -= take;
+                    data += take;
+                    size -= take;
+                    continue;
+                }
+                header[headerBytes++] = *data++;
+                --size;
+                if (headerBytes < SpectatorFeed::FRAME_HEADER_SIZE) {
+                    continue;
+                }
+                headerBytes = 0;
+                payloadLeft = header[0] | (static_cast<size_t>(header[1]) << 8);
+                ++stats.frames;
+                if (header[2] == static_cast<std::uint8_t>(BroadcastKind::Snapshot)) {
+                    ++stats.snapshots;
+                }
+                else if (header[2] == static_cast<std::uint8_t>(BroadcastKind::Turn)) {
+                    ++stats.turns;
+                }
+                else {
+                    ++stats.malformed;
+                }
+                if (payloadLeft < 8) {
+                    ++stats.malformed;      // Every payload starts with the version
+                }
+            }
+        }
+
+        /**
+         * Read up to limit bytes; false once the stream has ended
+         */
+        bool read(size_t limit, ReaderStats& stats) {
+            std::uint8_t buffer[64 * 1024];
+            while (limit > 0) {
+                ssize_t got = ::read(fd, buffer, std::min(limit, sizeof(buffer)));
+                if (got > 0) {
+                    consume(buffer, static_cast<size_t>(got), stats);
+                    limit -= static_cast<size_t>(got);
+                    continue;
+                }
+                if (got < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+                    return true;
+                }
+                if (payloadLeft > 0 || headerBytes > 0) {
+                    ++stats.malformed;      // Stream cut inside a frame
+                }
+                ::close(fd);
+                fd = -1;
+                return false;
+            }
+            return true;
+        }
+    };
+
+    /**
+     * Reader process: connect every spectator, then read until all streams end;
+     * slow spectators catch up at full speed once the games are over
+     */
+    int runReader(const std::string& path, size_t numSpectators, int slowPercent, int doneFd, int resultFd) {
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        std::snprintf(address.sun_path, sizeof(address.sun_path), "%s", path.c_str());
+
+        ReaderStats stats;
+        std::vector<Spectator> spectators(numSpectators);
+        for (size_t i = 0; i < numSpectators; ++i) {
+            int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+            if (fd < 0 || ::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+                std::perror("connect");
+                return 1;
+            }
+            ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+            spectators[i].fd = fd;
+            spectators[i].slow = static_cast<int>(i % 100) < slowPercent;
+            stats.slowConnections += spectators[i].slow;
+        }
+        stats.connections = numSpectators;
+
+        // Slow spectators take 16 bytes every 100 ms
+        constexpr size_t SLOW_READ_BYTES = 16;
+        constexpr auto SLOW_READ_PERIOD = std::chrono::milliseconds(100);
+
+        std::vector<pollfd> polled;
+        std::vector<size_t> polledIndex;
+        size_t open = numSpectators;
+        Clock::time_point nextSlowRead = Clock::now();
+        bool gamesOver = false;
+        while (open > 0) {
+            polled.clear();
+            polledIndex.clear();
+            for (size_t i = 0; i < numSpectators; ++i) {
+                if (spectators[i].fd >= 0 && (!spectators[i].slow || gamesOver)) {
+                    polled.push_back(pollfd{ spectators[i].fd, POLLIN, 0 });
+                    polledIndex.push_back(i);
+                }
+            }
+            if (!gamesOver) {
+                polled.push_back(pollfd{ doneFd, POLLIN, 0 });
+            }
+
+            ::poll(polled.data(), polled.size(), 5);
+            for (size_t p = 0; p < polledIndex.size(); ++p) {
+                if (polled[p].revents != 0 && !spectators[polledIndex[p]].read(SIZE_MAX, stats)) {
+                    --open;
+                }
+            }
+            if (!gamesOver && polled.back().revents != 0) {
+                gamesOver = true;
+            }
+
+            if (!gamesOver && Clock::now() >= nextSlowRead) {
+                nextSlowRead += SLOW_READ_PERIOD;
+                for (auto& spectator : spectators) {
+                    if (spectator.fd >= 0 && spectator.slow && !spectator.read(SLOW_READ_BYTES, stats)) {
+                        --open;
+                    }
+                }
+            }
+        }
+
+        return ::write(resultFd, &stats, sizeof(stats)) == sizeof(stats) ? 0 : 1;
+    }
+
+    /**
+     * Let the bot to move take its turn
+     */
+    void playTurn(GameState& state) {
+        size_t seat = state.getCurrentPlayerIndex();
+        const SeatTable& seats = state.getSeats();
+        bool mustInclude3D = state.isFirstPlayOfGame() && seats.holds(seat, Card(Rank::Three, Suit::Diamonds));
+        PlayCards play = Bot::choosePlay(seats.getCards(seat), state.getLastPlay(), mustInclude3D);
+        if (play.empty() || state.applyTurn(TurnAction::Play, play) == TurnResult::Rejected) {
+            state.applyTurn(TurnAction::Pass);
+        }
+    }
+
+    double micros(std::uint64_t nanos) {
+        return static_cast<double>(nanos) / 1000.0;
+    }
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t numSpectators = 10000;
+    size_t numGames = 20;
+    int numPlayers = 4;
+    int slowPercent = 1;
+    size_t flushEvery = 4;
+    size_t maxPending = 4096;
+    int sndbuf = 16384;
+    std::uint64_t seed = 1;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (arg == "--spectators" && hasValue) {
+            numSpectators = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (arg == "--games" && hasValue) {
+            numGames = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (arg == "--players" && hasValue) {
+            numPlayers = std::atoi(argv[++i]);
+        }
+        else if (arg == "--slow-percent" && hasValue) {
+            slowPercent = std::atoi(argv[++i]);
+        }
+        else if (arg == "--flush-every" && hasValue) {
+            flushEvery = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (arg == "--max-pending" && hasValue) {
+            maxPending = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (arg == "--sndbuf" && hasValue) {
+            sndbuf = std::atoi(argv[++i]);
+        }
+        else if (arg == "--seed" && hasValue) {
+            seed = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else {
+            printUsage();
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+    if (numSpectators == 0 || numPlayers < 2 || numPlayers > GameState::MAX_PLAYERS
+        || slowPercent < 0 || slowPercent > 100 || flushEvery == 0) {
+        printUsage();
+        return 1;
+    }
+
+    // Listening socket the reader process connects every spectator to
+    std::string path = "/tmp/thirteen-fanout-" + std::to_string(::getpid()) + ".sock";
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::snprintf(address.sun_path, sizeof(address.sun_path), "%s", path.c_str());
+    int listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    ::unlink(path.c_str());
+    if (listener < 0 || ::bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0
+        || ::listen(listener, 128) != 0) {
+        std::perror("listen");
+        return 1;
+    }
+
+    int resultPipe[2];
+    int donePipe[2];
+    if (::pipe(resultPipe) != 0 || ::pipe(donePipe) != 0) {
+        std::perror("pipe");
+        return 1;
+    }
+    pid_t reader = ::fork();
+    if (reader < 0) {
+        std::perror("fork");
+        return 1;
+    }
+    if (reader == 0) {
+        ::close(listener);
+        ::close(resultPipe[0]);
+        ::close(donePipe[1]);
+        ::_exit(runReader(path, numSpectators, slowPercent, donePipe[0], resultPipe[1]));
+    }
+    ::close(resultPipe[1]);
+    ::close(donePipe[0]);
+
+    GameState state;
+    state.initializePlayers(numPlayers, 0);
+    state.getDeck().seed(seed);
+    state.startNewGame();
+
+    SpectatorFeed feed(maxPending);
+    std::vector<int> sockets;
+    sockets.reserve(numSpectators);
+    for (size_t i = 0; i < numSpectators; ++i) {
+        pollfd ready{ listener, POLLIN, 0 };
+        int fd = ::poll(&ready, 1, 5000) == 1 ? ::accept(listener, nullptr, nullptr) : -1;
+        if (fd < 0) {
+            std::cerr << "Spectator " << i << " did not connect (open file limit?)" << std::endl;
+            ::kill(reader, SIGTERM);
+            ::unlink(path.c_str());
+            return 1;
+        }
+        ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+        ::setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &sndbuf, sizeof(sndbuf));
+        sockets.push_back(fd);
+        feed.subscribe(fd, state);
+    }
+    ::close(listener);
+    ::unlink(path.c_str());
+
+    // Play, publishing every turn and flushing every few
+    LatencyHistogram publishTime;
+    LatencyHistogram flushTime;
+    std::uint64_t updates = 0;
+    std::uint64_t perSpectatorNanos = 0;
+    std::uint64_t perSpectatorEncodes = 0;
+    auto start = Clock::now();
+    for (size_t game = 0; game < numGames; ++game) {
+        if (game > 0) {
+            state.getDeck().seed(seed + game);
+            state.startNewGame();
+        }
+        while (state.getPhase() == GamePhase::InProgress) {
+            playTurn(state);
+
+            std::int64_t publishStart = LatencyTracker::nowNs();
+            feed.publish(state);
+            publishTime.record(static_cast<std::uint64_t>(LatencyTracker::nowNs() - publishStart));
+
+            if (++updates % flushEvery == 0) {
+                std::int64_t flushStart = LatencyTracker::nowNs();
+                feed.flush();
+                flushTime.record(static_cast<std::uint64_t>(LatencyTracker::nowNs() - flushStart));
+            }
+
+            // What one encoding per spectator would cost, sampled once a game
+            if (updates % 64 == 0 && state.getHistory().getLastTurn()) {
+                std::int64_t encodeStart = LatencyTracker::nowNs();
+                for (size_t i = 0; i < numSpectators; ++i) {
+                    BroadcastFrame frame = SpectatorFeed::encodeTurn(state);
+                }
+                perSpectatorNanos += static_cast<std::uint64_t>(LatencyTracker::nowNs() - encodeStart);
+                ++perSpectatorEncodes;
+            }
+        }
+    }
+
+    // Let every spectator, slow ones included, catch up
+    ::close(donePipe[1]);
+    while (feed.flush() > 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    std::chrono::duration<double> elapsed = Clock::now() - start - std::chrono::nanoseconds(perSpectatorNanos);
+    for (int fd : sockets) {
+        ::close(fd);
+    }
+
+    ReaderStats seen;
+    bool gotResult = ::read(resultPipe[0], &seen, sizeof(seen)) == sizeof(seen);
+    int readerStatus = 0;
+    ::waitpid(reader, &readerStatus, 0);
+
+    const SpectatorFeedStats& stats = feed.getStats();
+    double megabytes = static_cast<double>(stats.bytesSent) / 1e6;
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << numSpectators << " spectators, " << numGames << " games, " << updates << " updates in "
+        << elapsed.count() << " s" << std::endl;
+    std::cout << "  encoded:     " << stats.framesEncoded << " frames (" << stats.snapshotsEncoded << " snapshots), "
+        << stats.framesQueued << " queued to spectators" << std::endl;
+    std::cout << "  sent:        " << megabytes << " MB in " << stats.writeCalls << " vectored writes ("
+        << megabytes / elapsed.count() << " MB/s, "
+        << static_cast<double>(stats.framesQueued - stats.framesDropped) / static_cast<double>(std::max<std::uint64_t>(1, stats.writeCalls))
+        << " frames per write)" << std::endl;
+    std::cout << "  publish:     p50 " << micros(publishTime.percentile(0.5)) << " us, p99 "
+        << micros(publishTime.percentile(0.99)) << " us per update" << std::endl;
+    std::cout << "  flush:       p50 " << micros(flushTime.percentile(0.5)) << " us, p99 "
+        << micros(flushTime.percentile(0.99)) << " us per " << flushEvery << " updates" << std::endl;
+    if (perSpectatorEncodes > 0) {
+        std::cout << "  per-spectator encoding would cost "
+            << micros(perSpectatorNanos / perSpectatorEncodes) << " us per update" << std::endl;
+    }
+    std::cout << "  slow:        " << seen.slowConnections << " spectators, " << stats.resyncs << " resyncs, "
+        << stats.framesDropped << " frames dropped, " << stats.disconnects << " disconnects" << std::endl;
+
+    if (!gotResult || !WIFEXITED(readerStatus) || WEXITSTATUS(readerStatus) != 0) {
+        std::cerr << "Reader process failed" << std::endl;
+        return 1;
+    }
+    std::cout << "  received:    " << seen.frames << " frames (" << seen.snapshots << " snapshots, " << seen.turns
+        << " turns), " << static_cast<double>(seen.bytes) / 1e6 << " MB, " << seen.malformed << " malformed" << std::endl;
+
+    bool consistent = seen.malformed == 0 && seen.bytes == stats.bytesSent
+        && seen.frames == stats.framesQueued - stats.framesDropped;
+    return consistent ? 0 : 1;
+}
@@ -0,0 +1,225 @@
+/**
+ * Thirteen (Big Two) bot overload benchmark
+ * Opens bot tables at a base rate, then a peak rate, then the base rate
+ * again; every bot decision goes through a BotPool with a turn deadline.
+ * Prints, once a second, the overload controller's level, the queue depth,
+ * the p99 decision latency of its last window and what the tables got,
+ * then totals: decisions answered at each level, decisions past their
+ * deadline, and tables refused.
+ *
+ * Usage: thirteen-loadbench [--threads N] [--base-rate R] [--peak-rate R] [--phase-seconds S]
+ *        [--turn-ms T] [--target-p99-ms T] [--players P] [--seed S]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "BotPool.h"
+#include "GameState.h"
+#include "MpmcQueue.h"
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    void printUsage() {
+        std::cout << "Usage: thirteen-loadbench [options]" << std::endl;
+        std::cout << "  --threads N        Decision workers (default: hardware concurrency)" << std::endl;
+        std::cout << "  --base-rate R      Tables opened per second before and after the peak (default 0.5)" << std::endl;
+        std::cout << "  --peak-rate R      Tables opened per second at the peak (default 8)" << std::endl;
+        std::cout << "  --phase-seconds S  Length of each phase (default 5)" << std::endl;
+        std::cout << "  --turn-ms T        Time a table gives a bot to move (default 250)" << std::endl;
+        std::cout << "  --target-p99-ms T  Decision latency the controller defends (default 100)" << std::endl;
+        std::cout << "  --players P        Seats per table, 2-8 (default 4)" << std::endl;
+        std::cout << "  --seed S           Deal seed (default 1)" << std::endl;
+    }
+
+    struct Table {
+        GameState state;
+        std::uint64_t decisions = 0;
+    };
+
+    /**
+     * A move handed back by the pool
+     */
+    struct Completion {
+        size_t table = 0;
+        PlayCards play;
+    };
+
+    double millis(std::uint64_t nanos) {
+        return static_cast<double>(nanos) / 1e6;
+    }
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    BotPoolConfig poolConfig;
+    OverloadPolicy policy;
+    double baseRate = 0.5;
+    double peakRate = 8.0;
+    double phaseSeconds = 5.0;
+    int turnMs = 250;
+    int numPlayers = 4;
+    std::uint64_t seed = 1;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (arg == "--threads" && hasValue) {
+            poolConfig.numThreads = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if (arg == "--base-rate" && hasValue) {
+            baseRate = std::atof(argv[++i]);
+        }
+        else if (arg == "--peak-rate" && hasValue) {
+            peakRate = std::atof(argv[++i]);
+        }
+        else if (arg == "--phase-seconds" && hasValue) {
+            phaseSeconds = std::atof(argv[++i]);
+        }
+        else if (arg == "--turn-ms" && hasValue) {
+            turnMs = std::atoi(argv[++i]);
+        }
+        else if (arg == "--target-p99-ms" && hasValue) {
+            policy.targetP99 = std::chrono::milliseconds(std::atoi(argv[++i]));
+        }
+        else if (arg == "--players" && hasValue) {
+            numPlayers = std::atoi(argv[++i]);
+        }
+        else if (arg == "--seed" && hasValue) {
+            seed = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else {
+            printUsage();
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+    if (baseRate <= 0 || peakRate <= 0 || phaseSeconds <= 0 || turnMs <= 2
+        || numPlayers < 2 || numPlayers > GameState::MAX_PLAYERS) {
+        printUsage();
+        return 1;
+    }
+
+    MpmcQueue<Completion> completions(1 << 16);     // Outlives the pool, whose workers push to it
+    OverloadController controller(policy);
+    BotPool pool(poolConfig, controller);
+    std::vector<std::unique_ptr<Table>> tables;
+    size_t openTables = 0;
+    std::uint64_t finishedTables = 0;
+    const auto turnTime = std::chrono::milliseconds(turnMs);
+
+    auto submit = [&](size_t index) {
+        Table& table = *tables[index];
+        pool.submit(table.state, Clock::now() + turnTime, seed ^ (index << 20) ^ table.decisions,
+            [&completions, index](const PlayCards& play, DegradationLevel) {
+                while (!completions.tryPush(Completion{ index, play })) {
+                    std::this_thread::yield();
+                }
+            });
+    };
+
+    std::cout << pool.getThreadCount() << " workers, " << turnMs << " ms turns, p99 target "
+        << policy.targetP99.count() << " ms, tables/s " << baseRate << " -> " << peakRate << " -> " << baseRate << std::endl;
+    std::cout << "    t    rate  level       queue  p99 ms  decisions  tables  refused" << std::endl;
+
+    const double rates[] = { baseRate, peakRate, baseRate };
+    auto start = Clock::now();
+    auto end = start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(phaseSeconds * 3));
+    auto drainLimit = end + std::chrono::seconds(60);
+    auto nextArrival = start;
+    auto nextReport = start + std::chrono::seconds(1);
+    std::uint64_t reportedDecisions = 0;
+    size_t phase = 0;
+
+    for (;;) {
+        auto now = Clock::now();
+        if (now >= drainLimit || (now >= end && openTables == 0)) {
+            break;
+        }
+        bool worked = false;
+        phase = std::min<size_t>(2, static_cast<size_t>(std::chrono::duration<double>(now - start).count() / phaseSeconds));
+
+        // New tables
+        auto interval = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / rates[phase]));
+        nextArrival = std::min(nextArrival, now + interval);   // A faster phase starts at once
+        if (now < end && now >= nextArrival) {
+            nextArrival += interval;
+            if (pool.admitTable()) {
+                auto table = std::make_unique<Table>();
+                table->state.initializePlayers(numPlayers, 0);
+                table->state.getDeck().seed(seed + tables.size());
+                table->state.startNewGame();
+                tables.push_back(std::move(table));
+                ++openTables;
+                submit(tables.size() - 1);
+            }
+            worked = true;
+        }
+
+        // Moves back from the pool
+        Completion completion;
+        while (completions.tryPop(completion)) {
+            Table& table = *tables[completion.table];
+            ++table.decisions;
+            if (completion.play.empty() || table.state.applyTurn(TurnAction::Play, completion.play) == TurnResult::Rejected) {
+                table.state.applyTurn(TurnAction::Pass);
+            }
+            if (table.state.getPhase() == GamePhase::InProgress) {
+                submit(completion.table);
+            }
+            else {
+                tables[completion.table].reset();
+                --openTables;
+                ++finishedTables;
+            }
+            worked = true;
+        }
+
+        if (now >= nextReport) {
+            nextReport += std::chrono::seconds(1);
+            OverloadMetrics metrics = controller.getMetrics();
+            std::uint64_t decisions = pool.getStats().decisions;
+            std::cout << std::fixed << std::setprecision(1)
+                << std::setw(5) << std::chrono::duration<double>(now - start).count()
+                << std::setw(8) << (now < end ? rates[phase] : 0.0) << "  "
+                << std::left << std::setw(10) << OverloadController::getLevelName(metrics.level) << std::right
+                << std::setw(7) << pool.getQueueDepth()
+                << std::setw(8) << millis(metrics.windowP99Ns)
+                << std::setw(11) << decisions - reportedDecisions
+                << std::setw(8) << openTables
+                << std::setw(9) << metrics.rejectedTables << std::endl;
+            reportedDecisions = decisions;
+        }
+
+        if (!worked) {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+    }
+
+    OverloadMetrics metrics = controller.getMetrics();
+    BotPoolStats stats = pool.getStats();
+    std::cout << std::setprecision(2);
+    std::cout << "Tables: " << tables.size() << " opened, " << finishedTables << " finished, "
+        << metrics.rejectedTables << " refused" << std::endl;
+    std::cout << "Decisions: " << stats.decisions << " (" << stats.searched << " searched, " << stats.expired
+        << " expired in queue, " << stats.inlineAnswers << " answered inline)" << std::endl;
+    std::cout << "By level:";
+    for (size_t i = 0; i < DEGRADATION_LEVEL_COUNT; ++i) {
+        std::cout << " " << OverloadController::getLevelName(static_cast<DegradationLevel>(i)) << " " << metrics.decisions[i];
+    }
+    std::cout << std::endl;
+    std::cout << "Level changes: " << metrics.levelChanges << std::endl;
+    std::cout << "Late moves: " << stats.late << " of " << stats.decisions << " (max decision latency "
+        << millis(stats.maxLatencyNs) << " ms, turn " << turnMs << " ms)" << std::endl;
+    return 0;
+}
@@ -0,0 +1,165 @@
+/**
+ * Thirteen (Big Two) position index tool
+ * Finds every game that reached a given position, using an index written
+ * by thirteen-sim --index.
+ *
+ * Usage: thirteen-positions <dir> lookup (--hash HEX | --seat N CARDS ... [--last CARDS] --turn N)
+ *        thirteen-positions <dir> stats
+ *        thirteen-positions <dir> compact
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "PositionHash.h"
+#include "PositionIndex.h"
+
+namespace {
+
+    void printUsage() {
+        std::cout << "Usage: thirteen-positions <dir> <command> [options]" << std::endl;
+        std::cout << "Commands:" << std::endl;
+        std::cout << "  lookup    Games that reached a position" << std::endl;
+        std::cout << "  stats     Runs and entries in the index" << std::endl;
+        std::cout << "  compact   Merge all runs into one" << std::endl;
+        std::cout << "Lookup options:" << std::endl;
+        std::cout << "  --hash HEX             Position hash" << std::endl;
+        std::cout << "  --seat N 3D,4S,...     Hand of seat N (repeat for every seat)" << std::endl;
+        std::cout << "  --last 5H,5S           Play to beat (omit for a new trick)" << std::endl;
+        std::cout << "  --turn N               Seat to move" << std::endl;
+        std::cout << "  --limit N              Hits to show (default 20)" << std::endl;
+    }
+
+    /**
+     * Parse a comma-separated card list (e.g. "2S,2H"; repeat a card for two-deck tables)
+     */
+    CardSet parseCards(const std::string& list) {
+        CardSet cards;
+        std::istringstream iss(list);
+        std::string cardStr;
+        while (std::getline(iss, cardStr, ',')) {
+            if (!cardStr.empty()) {
+                cards.add(Card(cardStr));
+            }
+        }
+        return cards;
+    }
+
+    int runLookup(const std::string& directory, int argc, char* argv[]) {
+        std::uint64_t hash = 0;
+        bool hasHash = false;
+        std::vector<CardSet> hands;
+        CardSet lastPlay;
+        size_t turn = 0;
+        size_t limit = 20;
+
+        for (int i = 3; i < argc; ++i) {
+            std::string arg = argv[i];
+            bool hasValue = i + 1 < argc;
+
+            if (arg == "--hash" && hasValue) {
+                hash = std::strtoull(argv[++i], nullptr, 16);
+                hasHash = true;
+            }
+            else if (arg == "--seat" && i + 2 < argc) {
+                size_t seat = static_cast<size_t>(std::atoi(argv[++i]));
+                if (seat >= PositionHash::MAX_SEATS) {
+                    std::cerr << "Seat out of range: " << seat << std::endl;
+                    return 1;
+                }
+                if (hands.size() <= seat) {
+                    hands.resize(seat + 1);
+                }
+                hands[seat] = parseCards(argv[++i]);
+            }
+            else if (arg == "--last" && hasValue) {
+                lastPlay = parseCards(argv[++i]);
+            }
+            else if (arg == "--turn" && hasValue) {
+                turn = static_cast<size_t>(std::atoi(argv[++i]));
+            }
+            else if (arg == "--limit" && hasValue) {
+                limit = static_cast<size_t>(std::atoi(argv[++i]));
+            }
+            else {
+                printUsage();
+                return 1;
+            }
+        }
+
+        if (!hasHash) {
+            if (hands.empty()) {
+                printUsage();
+                return 1;
+            }
+            hash = PositionHash::hash(hands, lastPlay, turn);
+        }
+
+        PositionIndex index(directory);
+
+        auto start = std::chrono::steady_clock::now();
+        std::uint64_t total = index.count(hash);
+        std::vector<PositionHit> hits = index.lookup(hash, limit);
+        double micros = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << "Position " << std::hex << std::setw(16) << std::setfill('0') << hash
+            << std::dec << std::setfill(' ') << ": " << total << " occurrences" << std::endl;
+        for (const auto& hit : hits) {
+            std::cout << "  game " << hit.gameId << ", action " << hit.actionIndex << std::endl;
+        }
+        std::cerr << "Looked up in " << micros << " us over " << index.getRunCount() << " runs" << std::endl;
+        return 0;
+    }
+
+    int runStats(const std::string& directory) {
+        PositionIndex index(directory);
+        std::cout << "Runs:    " << index.getRunCount() << std::endl;
+        std::cout << "Entries: " << index.getEntryCount() << std::endl;
+        for (size_t i = 0; i < index.getRunCount(); ++i) {
+            const PositionRun& run = index.getRun(i);
+            std::cout << "  level " << run.getLevel() << "\t" << run.getEntryCount() << " entries" << std::endl;
+        }
+        return 0;
+    }
+
+    int runCompact(const std::string& directory) {
+        PositionIndexOptions options;
+        options.directory = directory;
+        PositionIndexWriter writer(options);
+        writer.compact();
+        return runStats(directory);
+    }
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        printUsage();
+        return 1;
+    }
+
+    std::string directory = argv[1];
+    std::string command = argv[2];
+
+    try {
+        if (command == "lookup") {
+            return runLookup(directory, argc, argv);
+        }
+        if (command == "stats") {
+            return runStats(directory);
+        }
+        if (command == "compact") {
+            return runCompact(directory);
+        }
+        printUsage();
+        return 1;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,251 @@
+/**
+ * Thirteen (Big Two) history query tool
+ * Answers questions over directories written by thirteen-sim.
+ *
+ * Usage: thirteen-query <dir> <query> [options]
+ *   winrate     Win rate of matching seats          (seat options)
+ *   cards-left  Average cards left of matching seats (seat options)
+ *   top-plays   Most common plays                    (action options)
+ *   count       Number of matching actions           (action options)
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "HistoryQuery.h"
+
+namespace {
+
+    void printUsage() {
+        std::cout << "Usage: thirteen-query <dir> <query> [options]" << std::endl;
+        std::cout << "Queries:" << std::endl;
+        std::cout << "  winrate | cards-left   Seat aggregates" << std::endl;
+        std::cout << "  top-plays | count      Action aggregates" << std::endl;
+        std::cout << "Seat options:" << std::endl;
+        std::cout << "  --holding 2S,2H        Seat was dealt these cards" << std::endl;
+        std::cout << "  --without 2S           Seat was not dealt these cards" << std::endl;
+        std::cout << "  --seat N | --human | --ai | --player NAME" << std::endl;
+        std::cout << "  --by seat|type|player  Group results" << std::endl;
+        std::cout << "Action options:" << std::endl;
+        std::cout << "  --play single|pair|triple|five" << std::endl;
+        std::cout << "  --five straight|flush|fullhouse|four|straightflush" << std::endl;
+        std::cout << "  --contains 2S,2H | --any 2S,2H | --seat N | --passes" << std::endl;
+        std::cout << "  --opening              Only the first play of each game" << std::endl;
+        std::cout << "  --winning              Only actions by the eventual winner" << std::endl;
+        std::cout << "  --group cards|key      Group top plays by exact cards or play strength" << std::endl;
+        std::cout << "  --limit N              Rows to show (default 10)" << std::endl;
+        std::cout << "  --threads N            Worker threads (default: all cores)" << std::endl;
+    }
+
+    /**
+     * Parse a comma-separated card list (e.g. "2S,2H")
+     */
+    CardMask parseCards(const std::string& list) {
+        CardMask mask = 0;
+        std::istringstream iss(list);
+        std::string cardStr;
+        while (std::getline(iss, cardStr, ',')) {
+            if (!cardStr.empty()) {
+                mask |= cardBit(Card(cardStr));
+            }
+        }
+        return mask;
+    }
+
+    PlayType parsePlayType(const std::string& name) {
+        if (name == "single") return PlayType::Single;
+        if (name == "pair") return PlayType::Pair;
+        if (name == "triple") return PlayType::Triple;
+        if (name == "five") return PlayType::FiveCard;
+        throw std::invalid_argument("Unknown play type: " + name);
+    }
+
+    FiveCardType parseFiveCardType(const std::string& name) {
+        if (name == "straight") return FiveCardType::Straight;
+        if (name == "flush") return FiveCardType::Flush;
+        if (name == "fullhouse") return FiveCardType::FullHouse;
+        if (name == "four") return FiveCardType::FourOfAKind;
+        if (name == "straightflush") return FiveCardType::StraightFlush;
+        throw std::invalid_argument("Unknown five-card type: " + name);
+    }
+
+    /**
+     * Describe a play key, e.g. "Pair, high 2S"
+     */
+    std::string describePlayKey(std::uint64_t key) {
+        static const FiveCardType byRank[] = {
+            FiveCardType::None, FiveCardType::Straight, FiveCardType::Flush,
+            FiveCardType::FullHouse, FiveCardType::FourOfAKind, FiveCardType::StraightFlush
+        };
+        PlayType type = GameRules::getPlayTypeFromKey(static_cast<std::uint16_t>(key));
+        size_t fiveRank = (key >> 6) & 7;
+        FiveCardType fiveType = fiveRank < 6 ? byRank[fiveRank] : FiveCardType::None;
+        return GameRules::getPlayTypeName(type, fiveType) + ", high " +
+            Card::fromIndex(static_cast<int>(key & 63)).toString();
+    }
+
+    /**
+     * Describe a card mask, e.g. "3D 3H"
+     */
+    std::string describeCards(CardMask mask) {
+        std::string text;
+        for (const auto& card : fromCardMask(mask)) {
+            if (!text.empty()) {
+                text += " ";
+            }
+            text += card.toString();
+        }
+        return text;
+    }
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        printUsage();
+        return 1;
+    }
+
+    std::string directory = argv[1];
+    std::string query = argv[2];
+
+    try {
+        SeatFilter seatFilter;
+        ActionFilter actionFilter;
+        SeatGroupBy seatGroupBy = SeatGroupBy::None;
+        PlayGroupBy playGroupBy = PlayGroupBy::Cards;
+        std::string playerName;
+        size_t limit = 10;
+        unsigned threads = 0;
+
+        for (int i = 3; i < argc; ++i) {
+            std::string arg = argv[i];
+            bool hasValue = i + 1 < argc;
+
+            if (arg == "--holding" && hasValue) {
+                seatFilter.dealtAll = parseCards(argv[++i]);
+            }
+            else if (arg == "--without" && hasValue) {
+                seatFilter.dealtNone = parseCards(argv[++i]);
+            }
+            else if (arg == "--seat" && hasValue) {
+                std::uint8_t seat = static_cast<std::uint8_t>(std::atoi(argv[++i]));
+                seatFilter.seat = seat;
+                actionFilter.seat = seat;
+            }
+            else if (arg == "--human") {
+                seatFilter.playerType = PlayerType::Human;
+            }
+            else if (arg == "--ai") {
+                seatFilter.playerType = PlayerType::AI;
+            }
+            else if (arg == "--player" && hasValue) {
+                playerName = argv[++i];
+            }
+            else if (arg == "--by" && hasValue) {
+                std::string by = argv[++i];
+                seatGroupBy = by == "seat" ? SeatGroupBy::Seat
+                    : by == "type" ? SeatGroupBy::PlayerType
+                    : by == "player" ? SeatGroupBy::Player
+                    : SeatGroupBy::None;
+            }
+            else if (arg == "--play" && hasValue) {
+                actionFilter.playType = parsePlayType(argv[++i]);
+            }
+            else if (arg == "--five" && hasValue) {
+                actionFilter.fiveCardType = parseFiveCardType(argv[++i]);
+            }
+            else if (arg == "--contains" && hasValue) {
+                actionFilter.cardsAll = parseCards(argv[++i]);
+            }
+            else if (arg == "--any" && hasValue) {
+                actionFilter.cardsAny = parseCards(argv[++i]);
+            }
+            else if (arg == "--passes") {
+                actionFilter.type = ActionType::Pass;
+            }
+            else if (arg == "--opening") {
+                actionFilter.openingOnly = true;
+            }
+            else if (arg == "--winning") {
+                actionFilter.winnerOnly = true;
+            }
+            else if (arg == "--group" && hasValue) {
+                playGroupBy = std::string(argv[++i]) == "key" ? PlayGroupBy::PlayKey : PlayGroupBy::Cards;
+            }
+            else if (arg == "--limit" && hasValue) {
+                limit = static_cast<size_t>(std::atoi(argv[++i]));
+            }
+            else if (arg == "--threads" && hasValue) {
+                threads = static_cast<unsigned>(std::atoi(argv[++i]));
+            }
+            else {
+                printUsage();
+                return 1;
+            }
+        }
+
+        HistoryQuery engine(directory, threads);
+
+        if (!playerName.empty()) {
+            std::uint32_t id = 0;
+            if (!engine.getPlayers().find(playerName, id)) {
+                std::cerr << "Unknown player: " << playerName << std::endl;
+                return 1;
+            }
+            seatFilter.player = id;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        std::cout << std::fixed << std::setprecision(4);
+
+        if (query == "winrate" || query == "cards-left") {
+            bool winRate = query == "winrate";
+            for (const auto& group : engine.seatStats(seatFilter, seatGroupBy)) {
+                switch (seatGroupBy) {
+                case SeatGroupBy::Seat:
+                    std::cout << "seat " << group.key << "\t";
+                    break;
+                case SeatGroupBy::PlayerType:
+                    std::cout << (group.key == static_cast<std::uint64_t>(PlayerType::Human) ? "human" : "ai") << "\t";
+                    break;
+                case SeatGroupBy::Player:
+                    std::cout << engine.getPlayers().lookup(static_cast<std::uint32_t>(group.key)) << "\t";
+                    break;
+                default:
+                    break;
+                }
+                std::cout << (winRate ? group.winRate() : group.averageCardsLeft())
+                    << "\t(" << group.rows << " seats)" << std::endl;
+            }
+        }
+        else if (query == "top-plays") {
+            for (const auto& play : engine.topPlays(actionFilter, playGroupBy, limit)) {
+                std::cout << play.count << "\t"
+                    << (playGroupBy == PlayGroupBy::PlayKey ? describePlayKey(play.key) : describeCards(play.key))
+                    << std::endl;
+            }
+        }
+        else if (query == "count") {
+            std::cout << engine.countActions(actionFilter) << std::endl;
+        }
+        else {
+            printUsage();
+            return 1;
+        }
+
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cerr << "Scanned " << engine.getActionCount() << " actions / " << engine.getGameCount()
+            << " games in " << seconds << " s on " << engine.getNumThreads() << " threads" << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,314 @@
+/**
+ * Thirteen (Big Two) server rehearsal in virtual time
+ * Runs a day (or any span) of table traffic on one thread against a
+ * VirtualClock: tables open on a daily curve, bots move after the same
+ * pacing delay as the game client, the human seat thinks for a random time
+ * and is played for when its turn timer runs out, players take a break
+ * between games and may leave, and a TableStore hibernates the tables left
+ * idle. Nothing sleeps; the clock jumps from one event to the next, so the
+ * run takes as long as the moves take to compute. Prints an hourly report
+ * and a checksum of every move played: the same options give the same run.
+ *
+ * Usage: thirteen-rehearsal [--hours H] [--peak-rate R] [--players P] [--bot-delay-ms T]
+ *        [--turn-timeout-s T] [--think-s T] [--away-share F] [--idle-timeout-s T]
+ *        [--rematch-share F] [--break-s T] [--seed S]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_map>
+
+#include "GameClock.h"
+#include "GameState.h"
+#include "RolloutSearch.h"
+#include "TableStore.h"
+
+namespace {
+
+    using Seconds = std::chrono::duration<double>;
+
+    void printUsage() {
+        std::cout << "Usage: thirteen-rehearsal [options]" << std::endl;
+        std::cout << "  --hours H            Virtual time to run (default 24)" << std::endl;
+        std::cout << "  --peak-rate R        Tables opened per second at the daily peak (default 1)" << std::endl;
+        std::cout << "  --players P          Seats per table, one of them human, 2-8 (default 4)" << std::endl;
+        std::cout << "  --bot-delay-ms T     Bot pacing before each move (default 500)" << std::endl;
+        std::cout << "  --turn-timeout-s T   Human turn timer; the bot plays for them when it runs out (default 30)" << std::endl;
+        std::cout << "  --think-s T          Mean human thinking time (default 6)" << std::endl;
+        std::cout << "  --away-share F       Share of human turns missed entirely (default 0.02)" << std::endl;
+        std::cout << "  --idle-timeout-s T   Table idle time before hibernation (default 60)" << std::endl;
+        std::cout << "  --rematch-share F    Share of finished games followed by another (default 0.7)" << std::endl;
+        std::cout << "  --break-s T          Mean break between games (default 90)" << std::endl;
+        std::cout << "  --seed S             Traffic and deal seed (default 1)" << std::endl;
+    }
+
+    struct Options {
+        double hours = 24;
+        double peakRate = 1;
+        int numPlayers = 4;
+        std::chrono::milliseconds botDelay{ 500 };
+        Seconds turnTimeout{ 30 };
+        Seconds meanThink{ 6 };
+        double awayShare = 0.02;
+        Seconds idleTimeout{ 60 };
+        double rematchShare = 0.7;
+        Seconds meanBreak{ 90 };
+        std::uint64_t seed = 1;
+    };
+
+    struct Counters {
+        std::uint64_t opened = 0;
+        std::uint64_t closed = 0;
+        std::uint64_t games = 0;
+        std::uint64_t moves = 0;
+        std::uint64_t timeouts = 0;
+    };
+
+    /**
+     * The simulated server: every method runs from a clock timer
+     */
+    class Server {
+    public:
+        Server(const Options& options, VirtualClock& clock)
+            : options_(options), clock_(clock), rng_(options.seed),
+            store_(std::chrono::duration_cast<GameClock::duration>(options.idleTimeout)) {
+        }
+
+        void start(GameClock::time_point end) {
+            end_ = end;
+            scheduleArrival();
+            clock_.scheduleAfter(SWEEP_INTERVAL, [this] { sweep(); });
+        }
+
+        const Counters& getCounters() const { return counters_; }
+        const TableStore& getStore() const { return store_; }
+        std::uint64_t getChecksum() const { return checksum_; }
+
+    private:
+        static constexpr std::chrono::seconds SWEEP_INTERVAL{ 10 };
+
+        Options options_;
+        VirtualClock& clock_;
+        std::mt19937_64 rng_;
+        TableStore store_;
+        GameClock::time_point end_;
+        std::unordered_map<TableStore::TableId, VirtualClock::TimerId> turnTimers_;    // Pending human turn timeouts
+        Counters counters_;
+        std::uint64_t checksum_ = 0xcbf29ce484222325ULL;
+
+        GameClock::duration randomDuration(Seconds mean) {
+            std::exponential_distribution<double> distribution(1.0 / mean.count());
+            return std::chrono::duration_cast<GameClock::duration>(Seconds(distribution(rng_)));
+        }
+
+        bool chance(double share) {
+            return std::uniform_real_distribution<double>(0.0, 1.0)(rng_) < share;
+        }
+
+        /**
+         * Table arrival rate over the day: a tenth of the peak at midnight, the peak at noon
+         */
+        double arrivalRate(GameClock::time_point when) const {
+            double day = std::fmod(Seconds(when.time_since_epoch()).count() / 86400.0, 1.0);
+            return options_.peakRate * (0.55 - 0.45 * std::cos(2.0 * 3.14159265358979323846 * day));
+        }
+
+        /**
+         * Poisson arrivals at the peak rate, thinned to the rate of the hour
+         */
+        void scheduleArrival() {
+            auto when = clock_.now() + randomDuration(Seconds(1.0 / options_.peakRate));
+            if (when >= end_) {
+                return;
+            }
+            clock_.schedule(when, [this] {
+                if (chance(arrivalRate(clock_.now()) / options_.peakRate)) {
+                    openTable();
+                }
+                scheduleArrival();
+            });
+        }
+
+        void openTable() {
+            auto table = std::make_unique<GameState>();
+            table->initializePlayers(options_.numPlayers, 1);
+            table->getDeck().seed(options_.seed + counters_.opened);
+            table->startNewGame();
+            GameState& state = *table;
+            TableStore::TableId id = store_.add(std::move(table), clock_.now());
+            ++counters_.opened;
+            scheduleTurn(id, state);
+        }
+
+        /**
+         * Bots move after the pacing delay; the human moves after thinking,
+         * unless the turn timer runs out first
+         */
+        void scheduleTurn(TableStore::TableId id, const GameState& state) {
+            if (state.getSeats().getType(state.getCurrentPlayerIndex()) != PlayerType::Human) {
+                clock_.scheduleAfter(options_.botDelay, [this, id] { move(id); });
+                return;
+            }
+
+            auto timeout = std::chrono::duration_cast<GameClock::duration>(options_.turnTimeout);
+            turnTimers_[id] = clock_.scheduleAfter(timeout, [this, id] {
+                turnTimers_.erase(id);
+                ++counters_.timeouts;
+                move(id);
+            });
+            auto think = randomDuration(options_.meanThink);
+            if (think < timeout && !chance(options_.awayShare)) {
+                clock_.scheduleAfter(think, [this, id] {
+                    auto timer = turnTimers_.find(id);
+                    clock_.cancel(timer->second);
+                    turnTimers_.erase(timer);
+                    move(id);
+                });
+            }
+        }
+
+        void move(TableStore::TableId id) {
+            GameState& state = store_.acquire(id, clock_.now());
+            PlayCards play = RolloutSearch::heuristicPlay(state);
+            if (play.empty() || state.applyTurn(TurnAction::Play, play) == TurnResult::Rejected) {
+                play.clear();
+                state.applyTurn(TurnAction::Pass);
+            }
+            ++counters_.moves;
+            checksum_ = (checksum_ ^ id) * 0x100000001b3ULL;
+            for (const Card& card : play) {
+                checksum_ = (checksum_ ^ card.getIndex()) * 0x100000001b3ULL;
+            }
+
+            if (state.getPhase() == GamePhase::InProgress) {
+                scheduleTurn(id, state);
+                return;
+            }
+            ++counters_.games;
+            if (chance(options_.rematchShare)) {
+                clock_.scheduleAfter(randomDuration(options_.meanBreak), [this, id] {
+                    GameState& table = store_.acquire(id, clock_.now());
+                    table.startNewGame();
+                    scheduleTurn(id, table);
+                });
+            }
+            else {
+                store_.remove(id);
+                ++counters_.closed;
+            }
+        }
+
+        void sweep() {
+            store_.hibernateIdle(clock_.now());
+            if (clock_.now() + SWEEP_INTERVAL < end_) {
+                clock_.scheduleAfter(SWEEP_INTERVAL, [this] { sweep(); });
+            }
+        }
+    };
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (arg == "--hours" && hasValue) {
+            options.hours = std::atof(argv[++i]);
+        }
+        else if (arg == "--peak-rate" && hasValue) {
+            options.peakRate = std::atof(argv[++i]);
+        }
+        else if (arg == "--players" && hasValue) {
+            options.numPlayers = std::atoi(argv[++i]);
+        }
+        else if (arg == "--bot-delay-ms" && hasValue) {
+            options.botDelay = std::chrono::milliseconds(std::atoi(argv[++i]));
+        }
+        else if (arg == "--turn-timeout-s" && hasValue) {
+            options.turnTimeout = Seconds(std::atof(argv[++i]));
+        }
+        else if (arg == "--think-s" && hasValue) {
+            options.meanThink = Seconds(std::atof(argv[++i]));
+        }
+        else if (arg == "--away-share" && hasValue) {
+            options.awayShare = std::atof(argv[++i]);
+        }
+        else if (arg == "--idle-timeout-s" && hasValue) {
+            options.idleTimeout = Seconds(std::atof(argv[++i]));
+        }
+        else if (arg == "--rematch-share" && hasValue) {
+            options.rematchShare = std::atof(argv[++i]);
+        }
+        else if (arg == "--break-s" && hasValue) {
+            options.meanBreak = Seconds(std::atof(argv[++i]));
+        }
+        else if (arg == "--seed" && hasValue) {
+            options.seed = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else {
+            printUsage();
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+    if (options.hours <= 0 || options.peakRate <= 0 || options.numPlayers < 2 || options.numPlayers > GameState::MAX_PLAYERS
+        || options.botDelay.count() < 0 || options.turnTimeout.count() <= 0 || options.meanThink.count() <= 0
+        || options.meanBreak.count() <= 0 || options.idleTimeout.count() <= 0) {
+        printUsage();
+        return 1;
+    }
+
+    VirtualClock clock;
+    Server server(options, clock);
+    auto start = clock.now();
+    auto end = start + std::chrono::duration_cast<GameClock::duration>(Seconds(options.hours * 3600.0));
+    server.start(end);
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << options.hours << " virtual hours, " << options.numPlayers << " seats, peak "
+        << options.peakRate << " tables/s, seed " << options.seed << std::endl;
+    std::cout << " hour  opened     moves  timeouts  tables    live  hibernated  wall s" << std::endl;
+
+    auto wallStart = std::chrono::steady_clock::now();
+    Counters reported;
+    for (int hour = 1; clock.now() < end; ++hour) {
+        clock.runUntil(std::min(end, start + std::chrono::hours(hour)));
+        const Counters& counters = server.getCounters();
+        const TableStore& store = server.getStore();
+        std::cout << std::setw(5) << hour
+            << std::setw(8) << counters.opened - reported.opened
+            << std::setw(10) << counters.moves - reported.moves
+            << std::setw(10) << counters.timeouts - reported.timeouts
+            << std::setw(8) << store.size()
+            << std::setw(8) << store.getLiveCount()
+            << std::setw(12) << store.getHibernatedCount()
+            << std::setw(8) << Seconds(std::chrono::steady_clock::now() - wallStart).count() << std::endl;
+        reported = counters;
+    }
+    double wallSeconds = Seconds(std::chrono::steady_clock::now() - wallStart).count();
+    double virtualSeconds = Seconds(clock.now() - start).count();
+
+    const Counters& counters = server.getCounters();
+    const TableStoreStats& storeStats = server.getStore().getStats();
+    std::cout << std::setprecision(2);
+    std::cout << "Tables: " << counters.opened << " opened, " << counters.closed << " closed, "
+        << server.getStore().size() << " still open" << std::endl;
+    std::cout << "Games: " << counters.games << " finished, " << counters.moves << " moves, "
+        << counters.timeouts << " human turns timed out" << std::endl;
+    std::cout << "Hibernation: " << storeStats.hibernations << " packed, " << storeStats.thaws << " thawed" << std::endl;
+    std::cout << "Timers: " << clock.getFiredCount() << " fired" << std::endl;
+    std::cout << "Time: " << virtualSeconds << " virtual s in " << wallSeconds << " wall s ("
+        << std::setprecision(0) << virtualSeconds / std::max(wallSeconds, 1e-9) << "x)" << std::endl;
+    std::cout << "Checksum: " << std::hex << server.getChecksum() << std::dec << std::endl;
+    return 0;
+}
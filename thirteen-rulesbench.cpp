@@ -0,0 +1,264 @@
+/**
+ * Thirteen (Big Two) rules benchmark and differential check
+ * Generates random plays from two decks (biased towards legal combinations),
+ * checks that the size-specialized classifiers behind GameRules::getPlayKey,
+ * validatePlay and doesPlayBeat agree with the generic per-predicate path,
+ * then times both paths over the same plays.
+ *
+ * Usage: thirteen-rulesbench [--plays N] [--rounds R] [--seed S]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "GameRules.h"
+
+namespace {
+
+    /**
+     * One validation case: a play against the play to beat
+     */
+    struct RuleCase {
+        PlayCards cards;
+        PlayCards lastPlay;
+        bool isFirstPlay = false;
+        bool mustInclude3D = false;
+    };
+
+    void printUsage() {
+        std::cout << "Usage: thirteen-rulesbench [options]" << std::endl;
+        std::cout << "  --plays N      Random cases to check and time (default 1000000)" << std::endl;
+        std::cout << "  --rounds R     Timing passes over the cases (default 5)" << std::endl;
+        std::cout << "  --seed S       Random seed (default 1)" << std::endl;
+    }
+
+    /**
+     * Random play of 0-5 cards: ranks from a narrow window and suits from a
+     * small set, so pairs, straights, flushes and full houses come up often.
+     * At most two copies of a card (two decks).
+     */
+    PlayCards randomPlay(std::mt19937& rng) {
+        static constexpr size_t SIZES[] = { 0, 1, 2, 2, 3, 3, 4, 5, 5, 5, 5, 5 };
+        size_t size = SIZES[rng() % std::size(SIZES)];
+
+        int window = 1 + static_cast<int>(rng() % 6);
+        int low = static_cast<int>(rng() % (14 - window));
+        int suits = 1 + static_cast<int>(rng() % 4);
+
+        PlayCards play;
+        int copies[52] = {};
+        while (play.size() < size) {
+            int rank = low + static_cast<int>(rng() % window);
+            int suit = static_cast<int>(rng() % suits);
+            int index = rank * 4 + suit;
+            if (copies[index] == 2) {
+                window = std::min(window + 1, 13 - low);
+                suits = std::min(suits + 1, 4);
+                continue;
+            }
+            ++copies[index];
+            play.push_back(Card::fromIndex(index));
+        }
+        std::shuffle(play.begin(), play.end(), rng);
+        return play;
+    }
+
+    /**
+     * Play key through the generic predicates
+     */
+    std::uint16_t referenceKey(std::span<const Card> cards) {
+        PlayType type = GameRules::determinePlayType(cards);
+        if (type == PlayType::Invalid) {
+            return 0;
+        }
+
+        int fiveRank = 0;
+        if (type == PlayType::FiveCard) {
+            fiveRank = GameRules::getFiveCardRank(GameRules::determineFiveCardType(cards));
+        }
+
+        int highIndex = GameRules::getHighestCard(cards).getIndex();
+        return static_cast<std::uint16_t>(
+            (static_cast<int>(type) << 9) | (fiveRank << 6) | highIndex);
+    }
+
+    /**
+     * doesPlayBeat through the generic comparisons
+     */
+    bool referenceBeats(std::span<const Card> newPlay, std::span<const Card> lastPlay) {
+        if (lastPlay.empty()) {
+            return true;
+        }
+        if (newPlay.size() != lastPlay.size()) {
+            return false;
+        }
+
+        switch (GameRules::determinePlayType(newPlay)) {
+        case PlayType::Single:   return GameRules::singleBeats(newPlay[0], lastPlay[0]);
+        case PlayType::Pair:     return GameRules::pairBeats(newPlay, lastPlay);
+        case PlayType::Triple:   return GameRules::tripleBeats(newPlay, lastPlay);
+        case PlayType::FiveCard: return GameRules::fiveCardBeats(newPlay, lastPlay);
+        default:                 return false;
+        }
+    }
+
+    /**
+     * validatePlay through the generic predicates (one pass per check)
+     */
+    PlayValidation referenceValidate(const RuleCase& rule) {
+        PlayValidation result;
+        std::span<const Card> cards = rule.cards;
+        std::span<const Card> lastPlay = rule.lastPlay;
+
+        if (cards.empty()) {
+            result.errorMessage = "No cards selected";
+            return result;
+        }
+        if (rule.mustInclude3D && !GameRules::containsThreeOfDiamonds(cards)) {
+            result.errorMessage = "First play must include 3 of Diamonds";
+            return result;
+        }
+
+        result.playType = GameRules::determinePlayType(cards);
+        if (result.playType == PlayType::Invalid) {
+            result.errorMessage = "Invalid card combination";
+            return result;
+        }
+        if (result.playType == PlayType::FiveCard) {
+            result.fiveCardType = GameRules::determineFiveCardType(cards);
+        }
+
+        if (rule.isFirstPlay || lastPlay.empty()) {
+            result.isValid = true;
+            return result;
+        }
+        if (cards.size() != lastPlay.size()) {
+            result.errorMessage = "Must play same number of cards as last play";
+            return result;
+        }
+        if (!referenceBeats(cards, lastPlay)) {
+            result.errorMessage = "Play does not beat the previous play";
+            return result;
+        }
+
+        result.isValid = true;
+        return result;
+    }
+
+    PlayValidation specializedValidate(const RuleCase& rule) {
+        return GameRules::validatePlay(rule.cards, rule.lastPlay, rule.isFirstPlay, rule.mustInclude3D);
+    }
+
+    std::string describe(std::span<const Card> cards) {
+        std::string text;
+        for (const auto& card : cards) {
+            text += text.empty() ? "" : " ";
+            text += card.toString();
+        }
+        return text.empty() ? "-" : text;
+    }
+
+    /**
+     * Nanoseconds per case for one validation path
+     */
+    template <typename Validate>
+    double timePath(const std::vector<RuleCase>& cases, int rounds, Validate validate, std::uint64_t& sink) {
+        auto start = std::chrono::steady_clock::now();
+        for (int round = 0; round < rounds; ++round) {
+            for (const auto& rule : cases) {
+                PlayValidation result = validate(rule);
+                sink += result.isValid + static_cast<std::uint64_t>(result.fiveCardType);
+            }
+        }
+        std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count() / (static_cast<double>(cases.size()) * rounds);
+    }
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t numPlays = 1000000;
+    int rounds = 5;
+    std::uint32_t seed = 1;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (arg == "--plays" && hasValue) {
+            numPlays = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (arg == "--rounds" && hasValue) {
+            rounds = std::atoi(argv[++i]);
+        }
+        else if (arg == "--seed" && hasValue) {
+            seed = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else {
+            printUsage();
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+    if (numPlays == 0 || rounds <= 0) {
+        printUsage();
+        return 1;
+    }
+
+    // The game only ever leaves a legal play (or nothing) on the table
+    std::mt19937 rng(seed);
+    std::vector<RuleCase> cases(numPlays);
+    for (auto& rule : cases) {
+        rule.cards = randomPlay(rng);
+        if (rng() % 5 != 0) {
+            do {
+                rule.lastPlay = randomPlay(rng);
+            } while (rule.lastPlay.empty() || referenceKey(rule.lastPlay) == 0);
+        }
+        rule.isFirstPlay = rng() % 16 == 0;
+        rule.mustInclude3D = rule.isFirstPlay && rng() % 2 == 0;
+    }
+
+    // Differential check
+    size_t mismatches = 0;
+    size_t valid = 0;
+    for (const auto& rule : cases) {
+        PlayValidation expected = referenceValidate(rule);
+        PlayValidation actual = specializedValidate(rule);
+        valid += expected.isValid;
+
+        bool same = expected.isValid == actual.isValid
+            && expected.playType == actual.playType
+            && expected.fiveCardType == actual.fiveCardType
+            && expected.errorMessage == actual.errorMessage
+            && referenceKey(rule.cards) == GameRules::getPlayKey(rule.cards)
+            && referenceBeats(rule.cards, rule.lastPlay) == GameRules::doesPlayBeat(rule.cards, rule.lastPlay);
+        if (!same && ++mismatches <= 10) {
+            std::cerr << "Mismatch: " << describe(rule.cards) << " vs " << describe(rule.lastPlay)
+                << ": expected \"" << expected.errorMessage << "\", got \"" << actual.errorMessage << "\"" << std::endl;
+        }
+    }
+
+    std::cout << "Cases: " << cases.size() << " (" << valid << " legal), mismatches: " << mismatches << std::endl;
+    if (mismatches != 0) {
+        return 1;
+    }
+
+    // Timing
+    std::uint64_t sink = 0;
+    double generic = timePath(cases, rounds, referenceValidate, sink);
+    double specialized = timePath(cases, rounds, specializedValidate, sink);
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "Generic validatePlay:     " << generic << " ns/play" << std::endl;
+    std::cout << "Specialized validatePlay: " << specialized << " ns/play ("
+        << std::setprecision(2) << generic / specialized << "x)" << std::endl;
+    std::cout << "(checksum " << sink << ")" << std::endl;
+    return 0;
+}
@@ -0,0 +1,251 @@
+/**
+ * Thirteen (Big Two) headless simulator
+ * Plays bot-vs-bot games across worker threads and exports the histories
+ * as columnar tables for analytics.
+ *
+ * Usage: thirteen-sim --out <dir> [--games N] [--players P] [--threads T]
+ *                     [--seed S] [--row-group R] [--index <dir>] [--trace <file>]
+ *                     [--opponent-model] [--no-pin] [--strategy <file> [--reload-ms N]]
+ *                     [--pipeline [--deal-workers N] [--play-workers N]
+ *                      [--encode-workers N] [--write-workers N] [--queue N]]
+ */
+
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+
+#include "Simulator.h"
+#include "SimulationPipeline.h"
+#include "HistoryExporter.h"
+#include "PositionIndex.h"
+#include "TraceRecorder.h"
+
+namespace {
+
+    void printUsage() {
+        std::cout << "Usage: thirteen-sim --out <dir> [options]" << std::endl;
+        std::cout << "  --games N       Number of games to play (default 1000)" << std::endl;
+        std::cout << "  --players P     Players per game, 2-8 (default 4)" << std::endl;
+        std::cout << "  --threads T     Worker threads (default: all cores)" << std::endl;
+        std::cout << "  --seed S        Base deal seed (default 1)" << std::endl;
+        std::cout << "  --row-group R   Rows per column chunk (default 65536)" << std::endl;
+        std::cout << "  --index DIR     Also add every position to a position index" << std::endl;
+        std::cout << "  --trace FILE    Record bot decisions as Chrome trace JSON" << std::endl;
+        std::cout << "  --opponent-model  Learn per-seat tendencies and let bots use them" << std::endl;
+        std::cout << "  --no-pin        Let the OS place worker threads" << std::endl;
+        std::cout << "  --strategy FILE Equity table the bots read (thirteen-equity build)" << std::endl;
+        std::cout << "  --reload-ms N   Re-map the strategy file every N ms while games run" << std::endl;
+        std::cout << "  --pipeline      Run deal, play, encode and write as separate stages" << std::endl;
+        std::cout << "  --deal-workers N, --play-workers N, --encode-workers N, --write-workers N" << std::endl;
+        std::cout << "                  Workers per pipeline stage (default 1, remaining CPUs, 1, 1)" << std::endl;
+        std::cout << "  --queue N       Games buffered between pipeline stages (default 1024)" << std::endl;
+    }
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    SimulationConfig config;
+    PipelineConfig pipelineConfig;
+    bool pipeline = false;
+    HistoryExportOptions exportOptions;
+    PositionIndexOptions indexOptions;
+    std::string tracePath;
+    std::unique_ptr<OpponentModel> opponentModel;
+    std::string strategyPath;
+    unsigned reloadMillis = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (arg == "--out" && hasValue) {
+            exportOptions.directory = argv[++i];
+        }
+        else if (arg == "--games" && hasValue) {
+            config.numGames = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (arg == "--players" && hasValue) {
+            config.numPlayers = std::atoi(argv[++i]);
+        }
+        else if (arg == "--threads" && hasValue) {
+            config.numThreads = static_cast<unsigned>(std::atoi(argv[++i]));
+        }
+        else if (arg == "--seed" && hasValue) {
+            config.seed = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (arg == "--row-group" && hasValue) {
+            exportOptions.rowGroupSize = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if (arg == "--index" && hasValue) {
+            indexOptions.directory = argv[++i];
+        }
+        else if (arg == "--trace" && hasValue) {
+            tracePath = argv[++i];
+        }
+        else if (arg == "--pipeline") {
+            pipeline = true;
+        }
+        else if (arg == "--deal-workers" && hasValue) {
+            pipelineConfig.dealWorkers = static_cast<unsigned>(std::atoi(argv[++i]));
+        }
+        else if (arg == "--play-workers" && hasValue) {
+            pipelineConfig.playWorkers = static_cast<unsigned>(std::atoi(argv[++i]));
+        }
+        else if (arg == "--encode-workers" && hasValue) {
+            pipelineConfig.encodeWorkers = static_cast<unsigned>(std::atoi(argv[++i]));
+        }
+        else if (arg == "--write-workers" && hasValue) {
+            pipelineConfig.writeWorkers = static_cast<unsigned>(std::atoi(argv[++i]));
+        }
+        else if (arg == "--queue" && hasValue) {
+            pipelineConfig.queueCapacity = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (arg == "--no-pin") {
+            config.pinThreads = false;
+        }
+        else if (arg == "--strategy" && hasValue) {
+            strategyPath = argv[++i];
+        }
+        else if (arg == "--reload-ms" && hasValue) {
+            reloadMillis = static_cast<unsigned>(std::atoi(argv[++i]));
+        }
+        else if (arg == "--opponent-model") {
+            opponentModel = std::make_unique<OpponentModel>();
+            config.opponentModel = opponentModel.get();
+        }
+        else {
+            printUsage();
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+
+    if (exportOptions.directory.empty()) {
+        printUsage();
+        return 1;
+    }
+
+    try {
+        HistoryExporter exporter(exportOptions);
+        std::unique_ptr<PositionIndexWriter> index;
+        if (!indexOptions.directory.empty()) {
+            index = std::make_unique<PositionIndexWriter>(indexOptions);
+        }
+        if (!tracePath.empty()) {
+            TraceRecorder::start();
+        }
+
+        // Reloads swap the version under running games, as a server picking up new bot data would
+        std::unique_ptr<StrategyStore> strategy;
+        std::atomic<unsigned> reloads{ 0 };
+        std::jthread reloader;
+        if (!strategyPath.empty()) {
+            strategy = std::make_unique<StrategyStore>(strategyPath);
+            config.strategy = strategy.get();
+            if (reloadMillis > 0) {
+                reloader = std::jthread([&](std::stop_token stop) {
+                    while (!stop.stop_requested()) {
+                        std::this_thread::sleep_for(std::chrono::milliseconds(reloadMillis));
+                        try {
+                            strategy->load(strategyPath);
+                            reloads.fetch_add(1);
+                        }
+                        catch (const std::exception& e) {
+                            std::cerr << "Reload failed, keeping version " << strategy->getVersion()
+                                << ": " << e.what() << std::endl;
+                        }
+                    }
+                    });
+            }
+        }
+
+        SimulationStats stats;
+        PipelineStats pipelineStats;
+        if (pipeline) {
+            pipelineConfig.simulation = config;
+            SimulationPipeline stages(pipelineConfig);
+            auto encode = [&index](GameRecord& record) {
+                if (index) {
+                    index->add(record);
+                }
+            };
+            pipelineStats = stages.run(encode, [&exporter](GameRecord&& record) {
+                exporter.submit(std::move(record));
+                });
+            stats = pipelineStats.simulation;
+        }
+        else {
+            SimulationRunner runner(config);
+            stats = runner.run([&exporter, &index](GameRecord&& record) {
+                if (index) {
+                    index->add(record);
+                }
+                exporter.submit(std::move(record));
+                });
+        }
+        if (reloader.joinable()) {
+            reloader.request_stop();
+            reloader.join();
+        }
+        exporter.close();
+        if (index) {
+            index->close();
+        }
+
+        std::cout << "Games:   " << stats.gamesPlayed << std::endl;
+        std::cout << "Actions: " << stats.actionsPlayed << std::endl;
+        std::cout << "Time:    " << stats.seconds << " s ("
+            << (stats.seconds > 0 ? stats.gamesPlayed / stats.seconds : 0.0) << " games/s)" << std::endl;
+        for (const auto& node : stats.nodes) {
+            if (node.threads == 0) {
+                continue;
+            }
+            std::cout << "Node " << node.node << ":  " << node.threads << " threads, " << node.games << " games ("
+                << (stats.seconds > 0 ? node.games / stats.seconds : 0.0) << " games/s)" << std::endl;
+        }
+        std::cout << "Pinned:  " << stats.pinnedThreads << " threads" << std::endl;
+        if (pipeline) {
+            for (const auto& stage : pipelineStats.stages) {
+                std::cout << "Stage " << stage.name << ": " << stage.workers << " workers, " << stage.items
+                    << " games, " << static_cast<int>(100.0 * stage.utilization(stats.seconds) + 0.5) << "% busy, "
+                    << stage.starvedSeconds << " s starved, " << stage.blockedSeconds << " s blocked" << std::endl;
+            }
+        }
+        if (strategy) {
+            strategy->reclaim();
+            std::cout << "Strategy: version " << strategy->getVersion() << ", " << reloads.load() << " reloads, "
+                << strategy->getRetiredCount() << " retired versions still mapped" << std::endl;
+        }
+        std::cout << "Written to " << exportOptions.directory << std::endl;
+
+        if (!tracePath.empty()) {
+            TraceRecorder::stop();
+            size_t events = TraceRecorder::exportChromeTrace(tracePath);
+            std::cout << "Trace:   " << events << " events (" << TraceRecorder::getDroppedCount()
+                << " dropped) written to " << tracePath << std::endl;
+        }
+
+        if (opponentModel) {
+            std::cout << std::fixed << std::setprecision(3);
+            for (int seat = 0; seat < config.numPlayers; ++seat) {
+                OpponentProfile profile = opponentModel->getProfile(static_cast<PlayerId>(seat));
+                std::cout << "Seat " << seat << ": pass rate single " << profile.getPassRate(PlayType::Single)
+                    << " pair " << profile.getPassRate(PlayType::Pair)
+                    << " triple " << profile.getPassRate(PlayType::Triple)
+                    << " five " << profile.getPassRate(PlayType::FiveCard)
+                    << ", early 2s " << profile.earlyTwoRate
+                    << ", splits " << profile.comboBreakRate << std::endl;
+            }
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,216 @@
+/**
+ * Thirteen (Big Two) idle table benchmark
+ * Fills a TableStore with tables a few bot turns into their games, measures
+ * the heap each table holds live and hibernated, times thawing hibernated
+ * tables one by one, and checks that thawed tables match the originals:
+ * same position and trick state, the same rest of the game, and the same
+ * next shuffle.
+ *
+ * Usage: thirteen-tablebench [--tables N] [--players P] [--turns T] [--thaws N] [--seed S]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+#include "Bot.h"
+#include "GameState.h"
+#include "PositionHash.h"
+#include "TableStore.h"
+
+namespace {
+
+    using Clock = TableStore::Clock;
+
+    void printUsage() {
+        std::cout << "Usage: thirteen-tablebench [options]" << std::endl;
+        std::cout << "  --tables N   Tables in the store (default 100000)" << std::endl;
+        std::cout << "  --players P  Seats per table, 2-8 (default 4)" << std::endl;
+        std::cout << "  --turns T    Bot turns played before a table goes idle (default 8)" << std::endl;
+        std::cout << "  --thaws N    Tables thawed for the latency figures (default 10000)" << std::endl;
+        std::cout << "  --seed S     Deal seed (default 1)" << std::endl;
+    }
+
+    /**
+     * Heap bytes in use (0 where the allocator cannot tell)
+     */
+    size_t heapInUse() {
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+        return mallinfo2().uordblks;
+#else
+        return 0;
+#endif
+    }
+
+    /**
+     * Let bots take up to maxTurns turns
+     */
+    void playTurns(GameState& state, size_t maxTurns) {
+        for (size_t turn = 0; turn < maxTurns && state.getPhase() == GamePhase::InProgress; ++turn) {
+            size_t seat = state.getCurrentPlayerIndex();
+            const SeatTable& seats = state.getSeats();
+            bool mustInclude3D = state.isFirstPlayOfGame() && seats.holds(seat, Card(Rank::Three, Suit::Diamonds));
+            PlayCards play = Bot::choosePlay(seats.getCards(seat), state.getLastPlay(), mustInclude3D);
+            if (play.empty() || state.applyTurn(TurnAction::Play, play) == TurnResult::Rejected) {
+                state.applyTurn(TurnAction::Pass);
+            }
+        }
+    }
+
+    /**
+     * Everything a thawed table must reproduce, apart from the deck
+     */
+    struct Fingerprint {
+        std::uint64_t position = 0;
+        std::uint64_t version = 0;
+        std::uint32_t passedSeats = 0;
+        int passes = 0;
+        size_t lastPlayer = 0;
+        GamePhase phase = GamePhase::NotStarted;
+        bool firstPlay = false;
+
+        bool operator==(const Fingerprint&) const = default;
+    };
+
+    Fingerprint fingerprint(const GameState& state) {
+        const Player* lastPlayer = state.getLastPlayingPlayer();
+        return Fingerprint{ PositionHash::hash(state), state.getVersion(), state.getPassedSeats(),
+            state.getConsecutivePasses(), lastPlayer ? lastPlayer->getSeat() : SIZE_MAX,
+            state.getPhase(), state.isFirstPlayOfGame() };
+    }
+
+    /**
+     * Finish the game, deal the next one, and fingerprint the result
+     */
+    Fingerprint playOn(GameState& state) {
+        playTurns(state, 1000);
+        state.startNewGame();
+        playTurns(state, 4);
+        return fingerprint(state);
+    }
+
+    double percentile(std::vector<double>& values, double fraction) {
+        size_t index = std::min(values.size() - 1, static_cast<size_t>(fraction * static_cast<double>(values.size())));
+        std::nth_element(values.begin(), values.begin() + index, values.end());
+        return values[index];
+    }
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t numTables = 100000;
+    int numPlayers = 4;
+    size_t turns = 8;
+    size_t numThaws = 10000;
+    std::uint64_t seed = 1;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (arg == "--tables" && hasValue) {
+            numTables = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (arg == "--players" && hasValue) {
+            numPlayers = std::atoi(argv[++i]);
+        }
+        else if (arg == "--turns" && hasValue) {
+            turns = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (arg == "--thaws" && hasValue) {
+            numThaws = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (arg == "--seed" && hasValue) {
+            seed = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else {
+            printUsage();
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+    if (numTables == 0 || numPlayers < 2 || numPlayers > GameState::MAX_PLAYERS) {
+        printUsage();
+        return 1;
+    }
+    numThaws = std::min(numThaws, numTables);
+
+    const auto timeout = std::chrono::seconds(30);
+    TableStore store(timeout);
+    Clock::time_point now = Clock::now();
+
+    // Live tables
+    std::vector<TableStore::TableId> ids;
+    ids.reserve(numTables);
+    size_t heapBefore = heapInUse();
+    for (size_t i = 0; i < numTables; ++i) {
+        auto table = std::make_unique<GameState>();
+        table->initializePlayers(numPlayers, 1);
+        table->getDeck().seed(seed + i);
+        table->startNewGame();
+        playTurns(*table, turns);
+        ids.push_back(store.add(std::move(table), now));
+    }
+    size_t heapLive = heapInUse();
+
+    // Reference copies: a copy shuffles like the table it was copied from
+    std::vector<Fingerprint> before(numThaws);
+    std::vector<GameState> references(numThaws);
+    for (size_t i = 0; i < numThaws; ++i) {
+        GameState& table = store.acquire(ids[i], now);
+        before[i] = fingerprint(table);
+        references[i] = table;
+    }
+
+    // Hibernate everything
+    size_t heapReferences = heapInUse();
+    auto start = Clock::now();
+    size_t hibernated = store.hibernateIdle(now + timeout);
+    std::chrono::duration<double> hibernateTime = Clock::now() - start;
+    size_t heapIdle = heapInUse();
+
+    // Thaw one table at a time
+    std::vector<double> thawMicros;
+    thawMicros.reserve(numThaws);
+    size_t stateMismatches = 0;
+    size_t playMismatches = 0;
+    now += timeout * 2;
+    for (size_t i = 0; i < numThaws; ++i) {
+        auto thawStart = Clock::now();
+        GameState& table = store.acquire(ids[i], now);
+        thawMicros.push_back(std::chrono::duration<double, std::micro>(Clock::now() - thawStart).count());
+
+        stateMismatches += !(fingerprint(table) == before[i]);
+        playMismatches += !(playOn(table) == playOn(references[i]));
+    }
+
+    double liveBytes = static_cast<double>(heapLive - heapBefore) / static_cast<double>(numTables);
+    double idleBytes = static_cast<double>(heapIdle - (heapReferences - heapLive) - heapBefore)
+        / static_cast<double>(numTables);
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << numTables << " tables, " << numPlayers << " players, " << turns << " turns each" << std::endl;
+    std::cout << "  hibernated:  " << hibernated << " in " << hibernateTime.count() * 1000.0 << " ms ("
+        << hibernateTime.count() * 1e9 / static_cast<double>(std::max<size_t>(1, hibernated)) << " ns each)" << std::endl;
+    if (heapLive > 0) {
+        std::cout << "  live table:  " << liveBytes << " bytes" << std::endl;
+        std::cout << "  idle table:  " << idleBytes << " bytes (" << liveBytes / idleBytes << "x smaller)" << std::endl;
+    }
+    if (!thawMicros.empty()) {
+        std::cout << std::setprecision(2) << "  thaw:        p50 " << percentile(thawMicros, 0.5) << " us, p99 "
+            << percentile(thawMicros, 0.99) << " us, max " << percentile(thawMicros, 1.0) << " us" << std::endl;
+    }
+    std::cout << "  thawed:      " << numThaws << " tables, " << stateMismatches << " state mismatches, "
+        << playMismatches << " play mismatches" << std::endl;
+
+    return stateMismatches == 0 && playMismatches == 0 ? 0 : 1;
+}